@@ -22,7 +22,15 @@ Application::Application(Parameters const& par,
   set_node();
 }
 
-Application::~Application() {}
+Application::~Application() {
+  for (auto& tsb : timeslice_buffers_) {
+    if (tsb->has_tap()) {
+      L_(info) << "monitoring tap: " << tsb->get_num_tap_sampled()
+               << " timeslices sampled (1 in " << par_.tap_sampling()
+               << "), " << tsb->get_num_tap_lost() << " lost";
+    }
+  }
+}
 
 void Application::create_timeslice_buffers() {
   unsigned input_size = static_cast<unsigned>(par_.inputs().size());
@@ -56,7 +64,9 @@ void Application::create_timeslice_buffers() {
                     sizeof(fles::TimesliceComponentDescriptor));
 
     std::unique_ptr<TimesliceBuffer> tsb(
-        new TimesliceBuffer(shm_identifier, datasize, descsize, input_size));
+        new TimesliceBuffer(shm_identifier, datasize, descsize, input_size,
+                            par_.component_events(), par_.tap_sampling(),
+                            par_.straggler_timeout() != 0));
 
     start_processes(shm_identifier);
     ChildProcessManager::get().allow_stop_processes(this);
@@ -66,14 +76,30 @@ void Application::create_timeslice_buffers() {
           new TimesliceBuilderZeromq(i, *tsb, input_server_addresses,
                                      output_size, par_.timeslice_size(),
                                      par_.max_timeslice_number(),
-                                     signal_status_, zmq_context_.get()));
+                                     signal_status_, zmq_context_.get(),
+                                     par_.zeromq_window()));
       timeslice_builders_zeromq_.push_back(std::move(builder));
+    } else if (par_.transport() == Transport::TCP) {
+      std::unique_ptr<TimesliceBuilderTcp> builder(new TimesliceBuilderTcp(
+          i, *tsb, par_.base_port() + i, input_size, output_size,
+          par_.timeslice_size(), signal_status_));
+      timeslice_builders_tcp_.push_back(std::move(builder));
+    } else if (par_.transport() == Transport::Local) {
+      std::vector<ComponentSenderLocal*> senders(input_size);
+      for (auto& sender : component_senders_local_)
+        senders.at(sender->input_index()) = sender.get();
+      std::unique_ptr<TimesliceBuilderLocal> builder(new TimesliceBuilderLocal(
+          i, *tsb, senders, output_size, par_.timeslice_size(),
+          par_.max_timeslice_number(), signal_status_));
+      timeslice_builders_local_.push_back(std::move(builder));
     } else if (par_.transport() == Transport::LibFabric) {
 #ifdef HAVE_LIBFABRIC
       std::unique_ptr<tl_libfabric::TimesliceBuilder> builder(
           new tl_libfabric::TimesliceBuilder(
-              i, *tsb, par_.base_port() + i, input_size, par_.timeslice_size(),
-              signal_status_, false, par_.outputs().at(i).host));
+              i, *tsb, par_.base_port() + i, input_size, output_size,
+              par_.timeslice_size(), signal_status_, false,
+              par_.libfabric_cq_data(), par_.outputs().at(i).host,
+              par_.shed_threshold() / 100.0));
       timeslice_builders_.push_back(std::move(builder));
 #else
       L_(fatal) << "flesnet built without LIBFABRIC support";
@@ -82,7 +108,11 @@ void Application::create_timeslice_buffers() {
 #ifdef HAVE_RDMA
       std::unique_ptr<TimesliceBuilder> builder(
           new TimesliceBuilder(i, *tsb, par_.base_port() + i, input_size,
-                               par_.timeslice_size(), signal_status_, false));
+                               output_size, par_.timeslice_size(),
+                               signal_status_, false, par_.builder_shards(),
+                               std::chrono::milliseconds(
+                                   par_.straggler_timeout()),
+                               par_.shed_threshold() / 100.0));
       timeslice_builders_.push_back(std::move(builder));
 #else
       L_(fatal) << "flesnet built without RDMA support";
@@ -102,6 +132,10 @@ void Application::create_input_channel_senders() {
   for (unsigned int i = 0; i < par_.outputs().size(); ++i)
     output_services.push_back(std::to_string(par_.base_port() + i));
 
+#ifdef HAVE_RDMA
+  InputChannelSenderGroup* sender_group = nullptr;
+#endif
+
   for (size_t c = 0; c < par_.input_indexes().size(); ++c) {
     unsigned index = par_.input_indexes().at(c);
 
@@ -177,13 +211,27 @@ void Application::create_input_channel_senders() {
           par_.timeslice_size(), overlap_size, par_.max_timeslice_number(),
           signal_status_, zmq_context_.get()));
       component_senders_zeromq_.push_back(std::move(sender));
+    } else if (par_.transport() == Transport::TCP) {
+      std::unique_ptr<ComponentSenderTcp> sender(new ComponentSenderTcp(
+          index, *(data_sources_.at(c).get()), output_hosts, output_services,
+          par_.timeslice_size(), overlap_size, par_.max_timeslice_number(),
+          signal_status_, par_.tcp_zerocopy()));
+      component_senders_tcp_.push_back(std::move(sender));
+    } else if (par_.transport() == Transport::Local) {
+      std::unique_ptr<ComponentSenderLocal> sender(new ComponentSenderLocal(
+          index, *(data_sources_.at(c).get()),
+          static_cast<uint32_t>(par_.outputs().size()), par_.timeslice_size(),
+          overlap_size, par_.max_timeslice_number(), signal_status_));
+      component_senders_local_.push_back(std::move(sender));
     } else if (par_.transport() == Transport::LibFabric) {
 #ifdef HAVE_LIBFABRIC
       std::unique_ptr<tl_libfabric::InputChannelSender> sender(
           new tl_libfabric::InputChannelSender(
               index, *(data_sources_.at(c).get()), output_hosts,
               output_services, par_.timeslice_size(), overlap_size,
-              par_.max_timeslice_number(), par_.inputs().at(c).host));
+              par_.max_timeslice_number(), par_.libfabric_cq_data(),
+              par_.stagger_window(), par_.pacing_rate(),
+              par_.inputs().at(c).host));
       input_channel_senders_.push_back(std::move(sender));
 #else
       L_(fatal) << "flesnet built without LIBFABRIC support";
@@ -193,7 +241,18 @@ void Application::create_input_channel_senders() {
       std::unique_ptr<InputChannelSender> sender(new InputChannelSender(
           index, *(data_sources_.at(c).get()), output_hosts, output_services,
           par_.timeslice_size(), overlap_size, par_.max_timeslice_number()));
-      input_channel_senders_.push_back(std::move(sender));
+      uint32_t inputs_per_thread = par_.inputs_per_thread();
+      if (inputs_per_thread > 1) {
+        // consecutive input channels share a thread and completion queue
+        if (c % inputs_per_thread == 0) {
+          sender_group = new InputChannelSenderGroup();
+          input_channel_senders_.push_back(
+              std::unique_ptr<ConnectionGroupWorker>(sender_group));
+        }
+        sender_group->add(std::move(sender));
+      } else {
+        input_channel_senders_.push_back(std::move(sender));
+      }
 #else
       L_(fatal) << "flesnet built without RDMA support";
 #endif
@@ -248,6 +307,30 @@ void Application::run() {
     threads.add_thread(new boost::thread(std::move(task)));
   }
 
+  for (auto& buffer : timeslice_builders_tcp_) {
+    boost::packaged_task<void> task(std::ref(*buffer));
+    futures.push_back(task.get_future());
+    threads.add_thread(new boost::thread(std::move(task)));
+  }
+
+  for (auto& buffer : component_senders_tcp_) {
+    boost::packaged_task<void> task(std::ref(*buffer));
+    futures.push_back(task.get_future());
+    threads.add_thread(new boost::thread(std::move(task)));
+  }
+
+  for (auto& buffer : timeslice_builders_local_) {
+    boost::packaged_task<void> task(std::ref(*buffer));
+    futures.push_back(task.get_future());
+    threads.add_thread(new boost::thread(std::move(task)));
+  }
+
+  for (auto& buffer : component_senders_local_) {
+    boost::packaged_task<void> task(std::ref(*buffer));
+    futures.push_back(task.get_future());
+    threads.add_thread(new boost::thread(std::move(task)));
+  }
+
   L_(debug) << "threads started: " << threads.size();
 
   while (!futures.empty()) {
@@ -1,15 +1,20 @@
 // Copyright 2012-2016 Jan de Cuveland <cmail@cuveland.de>
 #pragma once
 
+#include "ComponentSenderLocal.hpp"
+#include "ComponentSenderTcp.hpp"
 #include "ComponentSenderZeromq.hpp"
 #include "ConnectionGroupWorker.hpp"
 #include "Parameters.hpp"
 #include "ThreadContainer.hpp"
 #include "TimesliceBuffer.hpp"
+#include "TimesliceBuilderLocal.hpp"
+#include "TimesliceBuilderTcp.hpp"
 #include "TimesliceBuilderZeromq.hpp"
 #include "shm_device_client.hpp"
 #if defined(HAVE_RDMA)
 #include "fles_rdma/InputChannelSender.hpp"
+#include "fles_rdma/InputChannelSenderGroup.hpp"
 #include "fles_rdma/TimesliceBuilder.hpp"
 #endif
 #if defined(HAVE_LIBFABRIC)
@@ -68,5 +73,13 @@ private:
       timeslice_builders_zeromq_;
   std::vector<std::unique_ptr<ComponentSenderZeromq>> component_senders_zeromq_;
 
+  /// The application's TCP transport objects
+  std::vector<std::unique_ptr<TimesliceBuilderTcp>> timeslice_builders_tcp_;
+  std::vector<std::unique_ptr<ComponentSenderTcp>> component_senders_tcp_;
+
+  /// The application's same-host transport objects
+  std::vector<std::unique_ptr<TimesliceBuilderLocal>> timeslice_builders_local_;
+  std::vector<std::unique_ptr<ComponentSenderLocal>> component_senders_local_;
+
   void start_processes(const std::string shared_memory_identifier);
 };
@@ -27,6 +27,10 @@ std::istream& operator>>(std::istream& in, Transport& transport) {
     transport = Transport::LibFabric;
   else if (token == "zeromq" || token == "z")
     transport = Transport::ZeroMQ;
+  else if (token == "tcp" || token == "t")
+    transport = Transport::TCP;
+  else if (token == "local" || token == "l")
+    transport = Transport::Local;
   else
     throw po::invalid_option_value(token);
   return in;
@@ -43,6 +47,12 @@ std::ostream& operator<<(std::ostream& out, const Transport& transport) {
   case Transport::ZeroMQ:
     out << "ZeroMQ";
     break;
+  case Transport::TCP:
+    out << "TCP";
+    break;
+  case Transport::Local:
+    out << "Local";
+    break;
   }
   return out;
 }
@@ -129,6 +139,27 @@ void Parameters::parse_options(int argc, char* argv[]) {
                  ->default_value(processor_instances_)
                  ->value_name("<n>"),
              "number of instances of the timeslice processor executable");
+  config_add("component-events",
+             po::value<bool>(&component_events_)
+                 ->default_value(component_events_)
+                 ->value_name("<bool>"),
+             "publish the arrival of individual timeslice components to the "
+             "timeslice buffer for streaming consumers (RDMA and LibFabric "
+             "transports)");
+  config_add("tap-sampling",
+             po::value<uint32_t>(&tap_sampling_)
+                 ->default_value(tap_sampling_)
+                 ->value_name("<n>"),
+             "offer a copy of every n-th timeslice to lossy monitoring "
+             "consumers (tsclient --tap), 0 to disable");
+  config_add("shed-threshold",
+             po::value<uint32_t>(&shed_threshold_)
+                 ->default_value(shed_threshold_)
+                 ->value_name("<percent>"),
+             "timeslice buffer fill at which a growing share of timeslices "
+             "is completed without processing while the processors fall "
+             "behind (at most three quarters), 0 to disable (RDMA and "
+             "LibFabric transports)");
   config_add("base-port",
              po::value<uint32_t>(&base_port_)
                  ->default_value(base_port_)
@@ -139,7 +170,56 @@ void Parameters::parse_options(int argc, char* argv[]) {
                  ->default_value(transport_)
                  ->value_name("<id>"),
              "select transport implementation; possible values "
-             "(case-insensitive) are: RDMA, LibFabric, ZeroMQ");
+             "(case-insensitive) are: RDMA, LibFabric, ZeroMQ, TCP, Local");
+  config_add("zeromq-window",
+             po::value<uint32_t>(&zeromq_window_)
+                 ->default_value(zeromq_window_)
+                 ->value_name("<n>"),
+             "number of timeslice requests a compute node keeps outstanding "
+             "with each input (ZeroMQ transport)");
+  config_add("tcp-zerocopy",
+             po::value<bool>(&tcp_zerocopy_)
+                 ->default_value(tcp_zerocopy_)
+                 ->value_name("<bool>"),
+             "send timeslice data without copying, if supported by the "
+             "system (TCP transport)");
+  config_add("builder-shards",
+             po::value<uint32_t>(&builder_shards_)
+                 ->default_value(builder_shards_)
+                 ->value_name("<n>"),
+             "number of threads sharing the input connections of a compute "
+             "node, each with its own completion queue (RDMA transport)");
+  config_add("straggler-timeout",
+             po::value<uint32_t>(&straggler_timeout_)
+                 ->default_value(straggler_timeout_)
+                 ->value_name("<ms>"),
+             "time after which a timeslice is built without the missing "
+             "components of lagging inputs, 0 to wait forever (RDMA "
+             "transport)");
+  config_add("inputs-per-thread",
+             po::value<uint32_t>(&inputs_per_thread_)
+                 ->default_value(inputs_per_thread_)
+                 ->value_name("<n>"),
+             "number of input channels served by one sender thread with a "
+             "shared completion queue (RDMA transport)");
+  config_add("libfabric-cq-data",
+             po::value<bool>(&libfabric_cq_data_)
+                 ->default_value(libfabric_cq_data_)
+                 ->value_name("<bool>"),
+             "signal new timeslice components by remote completion queue "
+             "data instead of status messages (LibFabric transport)");
+  config_add("stagger-window",
+             po::value<uint32_t>(&stagger_window_)
+                 ->default_value(stagger_window_)
+                 ->value_name("<n>"),
+             "send timeslices in blocks of n, each input starting at a "
+             "different compute node to avoid incast (LibFabric transport)");
+  config_add("pacing-rate",
+             po::value<uint64_t>(&pacing_rate_)
+                 ->default_value(pacing_rate_)
+                 ->value_name("<bytes/s>"),
+             "maximum data rate per compute node, 0 for unlimited "
+             "(LibFabric transport)");
 
   po::options_description cmdline_options("Allowed options");
   cmdline_options.add(generic).add(config);
@@ -187,6 +267,10 @@ void Parameters::parse_options(int argc, char* argv[]) {
     throw ParametersException("timeslice size cannot be zero");
   }
 
+  if (shed_threshold_ > 100) {
+    throw ParametersException("shed threshold cannot exceed 100 percent");
+  }
+
 #ifndef HAVE_RDMA
   if (transport_ == Transport::RDMA) {
     throw ParametersException("flesnet built without RDMA support");
@@ -246,6 +330,11 @@ void Parameters::parse_options(int argc, char* argv[]) {
     }
   }
 
+  if (transport_ == Transport::Local && !local_only()) {
+    throw ParametersException(
+        "local transport requires all inputs and outputs in one process");
+  }
+
   if (!outputs_.empty() && processor_executable_.empty())
     throw ParametersException("processor executable not specified");
 
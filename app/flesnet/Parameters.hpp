@@ -26,7 +26,7 @@ struct InterfaceSpecification {
 };
 
 /// Transport implementation enum.
-enum class Transport { RDMA, LibFabric, ZeroMQ };
+enum class Transport { RDMA, LibFabric, ZeroMQ, TCP, Local };
 
 std::istream& operator>>(std::istream& in, Transport& transport);
 std::ostream& operator<<(std::ostream& out, const Transport& transport);
@@ -55,12 +55,45 @@ public:
   /// Retrieve the number of instances of the timeslice processor executable.
   uint32_t processor_instances() const { return processor_instances_; }
 
+  /// Retrieve whether to publish timeslice component arrival events.
+  bool component_events() const { return component_events_; }
+
+  /// Retrieve the sampling interval of the monitoring tap.
+  uint32_t tap_sampling() const { return tap_sampling_; }
+
+  /// Retrieve the timeslice buffer fill at which timeslices are shed.
+  uint32_t shed_threshold() const { return shed_threshold_; }
+
   /// Retrieve the global base port.
   uint32_t base_port() const { return base_port_; }
 
   /// Retrieve the selected transport implementation.
   Transport transport() const { return transport_; }
 
+  /// Retrieve the number of outstanding requests per input (ZeroMQ).
+  uint32_t zeromq_window() const { return zeromq_window_; }
+
+  /// Retrieve whether to use zero-copy transmission (TCP).
+  bool tcp_zerocopy() const { return tcp_zerocopy_; }
+
+  /// Retrieve the number of connection shards per compute node (RDMA).
+  uint32_t builder_shards() const { return builder_shards_; }
+
+  /// Retrieve the time to wait for a missing timeslice component (RDMA).
+  uint32_t straggler_timeout() const { return straggler_timeout_; }
+
+  /// Retrieve the number of input channels per sender thread (RDMA).
+  uint32_t inputs_per_thread() const { return inputs_per_thread_; }
+
+  /// Retrieve whether to signal write progress by remote CQ data (LibFabric).
+  bool libfabric_cq_data() const { return libfabric_cq_data_; }
+
+  /// Retrieve the number of timeslices per staggered block (LibFabric).
+  uint32_t stagger_window() const { return stagger_window_; }
+
+  /// Retrieve the maximum data rate per compute node (LibFabric).
+  uint64_t pacing_rate() const { return pacing_rate_; }
+
   /// Retrieve the list of participating inputs.
   std::vector<InterfaceSpecification> const inputs() const { return inputs_; }
 
@@ -94,12 +127,46 @@ private:
   /// The number of instances of the timeslice processor executable.
   uint32_t processor_instances_ = 1;
 
+  /// Publish timeslice component arrival events to streaming consumers.
+  bool component_events_ = false;
+
+  /// Offer every n-th timeslice to a monitoring tap (zero if disabled).
+  uint32_t tap_sampling_ = 0;
+
+  /// The timeslice buffer fill in percent at which timeslices are shed (zero
+  /// if disabled).
+  uint32_t shed_threshold_ = 0;
+
   /// The global base port.
   uint32_t base_port_ = 20079;
 
   /// The selected transport implementation.
   Transport transport_ = Transport::RDMA;
 
+  /// The number of outstanding requests per input (ZeroMQ).
+  uint32_t zeromq_window_ = 8;
+
+  /// Use zero-copy transmission if supported (TCP).
+  bool tcp_zerocopy_ = true;
+
+  /// The number of connection shards per compute node (RDMA).
+  uint32_t builder_shards_ = 1;
+
+  /// The time to wait for a missing timeslice component in ms (RDMA).
+  uint32_t straggler_timeout_ = 0;
+
+  /// The number of input channels per sender thread (RDMA).
+  uint32_t inputs_per_thread_ = 1;
+
+  /// Signal write progress by remote CQ data (LibFabric).
+  bool libfabric_cq_data_ = false;
+
+  /// The number of timeslices per staggered block (LibFabric).
+  uint32_t stagger_window_ = 1;
+
+  /// The maximum data rate per compute node in bytes/s (LibFabric).
+  uint64_t pacing_rate_ = 0;
+
   /// The list of participating inputs.
   std::vector<InterfaceSpecification> inputs_;
 
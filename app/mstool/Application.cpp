@@ -44,7 +44,12 @@ Application::Application(Parameters const& par) : par_(par) {
   if (data_source_) {
     source_.reset(new fles::MicrosliceReceiver(*data_source_));
   } else if (!par_.input_archive.empty()) {
-    source_.reset(new fles::MicrosliceInputArchive(par_.input_archive));
+    if (par_.input_archive_prefetch > 0) {
+      source_.reset(new fles::MicrosliceInputArchivePrefetch(
+          par_.input_archive, 1, par_.input_archive_prefetch));
+    } else {
+      source_.reset(new fles::MicrosliceInputArchive(par_.input_archive));
+    }
   }
 
   // Sink setup
@@ -43,6 +43,10 @@ void Parameters::parse_options(int argc, char* argv[]) {
              "name of a shared memory to use as data source");
   source_add("input-archive,i", po::value<std::string>(&input_archive),
              "name of an input file archive to read");
+  source_add("input-archive-prefetch",
+             po::value<size_t>(&input_archive_prefetch),
+             "read ahead given number of microslices from input archive in a "
+             "background thread (default: 0, disabled)");
 
   po::options_description sink("Sink options");
   auto sink_add = sink.add_options();
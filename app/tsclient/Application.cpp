@@ -5,26 +5,78 @@
 #include "TimesliceDebugger.hpp"
 #include "TimesliceInputArchive.hpp"
 #include "TimesliceOutputArchive.hpp"
+#include "TimesliceProjection.hpp"
 #include "TimeslicePublisher.hpp"
 #include "TimesliceReceiver.hpp"
+#include "TimesliceSelectiveInputArchive.hpp"
 #include "TimesliceSubscriber.hpp"
+#include "TimesliceWorker.hpp"
 #include "Utility.hpp"
+#include <algorithm>
 #include <boost/lexical_cast.hpp>
 #include <thread>
 
-Application::Application(Parameters const& par) : par_(par) {
-  if (!par_.shm_identifier().empty()) {
-    source_.reset(new fles::TimesliceReceiver(par_.shm_identifier()));
+Application::Application(Parameters const& par)
+    : par_(par), selection_(par.select()) {
+  if (!par_.shm_identifier().empty() && par_.tap()) {
+    tap_ = new fles::TimesliceTap(par_.shm_identifier());
+    source_.reset(tap_);
+    project_ = !selection_.all();
+    L_(info) << "monitoring tap: 1 in " << tap_->sampling()
+             << " timeslices sampled";
+  } else if (!par_.shm_identifier().empty()) {
+    source_.reset(new fles::TimesliceReceiver(par_.shm_identifier(),
+                                              selection_.predicate()));
   } else if (!par_.input_archive().empty()) {
-    if (par_.input_archive_cycles() <= 1) {
+    if (par_.input_archive().find_first_of("%*?[") != std::string::npos) {
+      // the read-ahead byte limit is shared by the files read in parallel
+      std::size_t parallel =
+          std::max<std::size_t>(par_.input_archive_parallel(), 1);
+      std::size_t bytes_per_file = 0;
+      if (par_.input_archive_prefetch_bytes() > 0) {
+        bytes_per_file = std::max<std::size_t>(
+            par_.input_archive_prefetch_bytes() / parallel, 1);
+      }
+      sequence_ = new fles::TimesliceInputArchiveSequence(
+          par_.input_archive(), par_.input_archive_cycles(), parallel,
+          !par_.input_archive_unordered(),
+          par_.input_archive_prefetch() > 0 ? par_.input_archive_prefetch()
+                                            : 16,
+          bytes_per_file);
+      source_.reset(sequence_);
+      project_ = !selection_.all();
+      L_(info) << "reading input archive sequence of "
+               << sequence_->filenames().size() << " files";
+    } else if (par_.input_archive_prefetch() > 0) {
+      prefetch_ = new fles::TimesliceInputArchivePrefetch(
+          par_.input_archive(), par_.input_archive_cycles(),
+          par_.input_archive_prefetch(), par_.input_archive_prefetch_bytes());
+      source_.reset(prefetch_);
+      project_ = !selection_.all();
+    } else if (par_.input_archive_cycles() <= 1 && !selection_.all()) {
+      source_.reset(new fles::TimesliceSelectiveInputArchive(
+          par_.input_archive(), selection_.predicate()));
+    } else if (par_.input_archive_cycles() <= 1) {
       source_.reset(new fles::TimesliceInputArchive(par_.input_archive()));
     } else {
       source_.reset(new fles::TimesliceInputArchiveLoop(
           par_.input_archive(), par_.input_archive_cycles()));
+      project_ = !selection_.all();
     }
   } else if (!par_.subscribe_address().empty()) {
-    source_.reset(new fles::TimesliceSubscriber(par_.subscribe_address(),
-                                                par_.subscribe_hwm()));
+    if (par_.distribute()) {
+      worker_ = new fles::TimesliceWorker(par_.subscribe_address(),
+                                          par_.subscribe_hwm());
+      source_.reset(worker_);
+      project_ = !selection_.all();
+    } else {
+      subscriber_ = new fles::TimesliceSubscriber(
+          par_.subscribe_address(), selection_, par_.subscribe_hwm());
+      source_.reset(subscriber_);
+    }
+  }
+  if (!selection_.all()) {
+    L_(info) << "component selection: " << selection_.to_string();
   }
 
   if (par_.analyze()) {
@@ -52,10 +104,14 @@ Application::Application(Parameters const& par) : par_(par) {
     }
   }
 
-  if (!par_.publish_address().empty()) {
+  if (!par_.publish_address().empty() && par_.distribute()) {
+    distributor_ = new fles::TimesliceDistributor(par_.publish_address());
+    sinks_.push_back(std::unique_ptr<fles::TimesliceSink>(distributor_));
+  } else if (!par_.publish_address().empty()) {
     sinks_.push_back(
         std::unique_ptr<fles::TimesliceSink>(new fles::TimeslicePublisher(
-            par_.publish_address(), par_.publish_hwm())));
+            par_.publish_address(), par_.publish_hwm(),
+            par_.publish_multipart())));
   }
 
   if (par_.benchmark()) {
@@ -78,6 +134,44 @@ Application::~Application() {
     L_(info) << "tsclient " << par_.client_index() << ": ";
   }
   L_(info) << "total timeslices processed: " << count_;
+  if (prefetch_ != nullptr) {
+    L_(info) << "input archive prefetch: consumer waited "
+             << prefetch_->consumer_waits() << " times, reader waited "
+             << prefetch_->reader_waits() << " times";
+  }
+  if (sequence_ != nullptr) {
+    L_(info) << "input archive sequence: consumer waited "
+             << sequence_->consumer_waits() << " times, readers waited "
+             << sequence_->reader_waits() << " times";
+  }
+  if (subscriber_ != nullptr && subscriber_->malformed_messages() > 0) {
+    L_(warning) << "subscriber: skipped " << subscriber_->malformed_messages()
+                << " malformed messages";
+  }
+  if (worker_ != nullptr && worker_->malformed_messages() > 0) {
+    L_(warning) << "worker: skipped " << worker_->malformed_messages()
+                << " malformed messages";
+  }
+  if (tap_ != nullptr) {
+    L_(info) << "monitoring tap: " << tap_->received() << " received, "
+             << tap_->overwritten() << " overwritten before copying; "
+             << tap_->sampled() << " sampled (1 in " << tap_->sampling()
+             << "), " << tap_->lost() << " lost in total";
+  }
+  if (distributor_ != nullptr) {
+    size_t i = 0;
+    for (auto& worker : distributor_->worker_status()) {
+      L_(info) << "worker " << i++ << ": " << worker.sent << " sent, "
+               << worker.acked << " acked, "
+               << human_readable_count(worker.bytes) << ", "
+               << human_readable_count(worker.rate(), true, "Hz")
+               << (worker.disconnected ? " (disconnected)" : "");
+    }
+    if (distributor_->lost() > 0) {
+      L_(warning) << "distributor: " << distributor_->lost()
+                  << " timeslices lost on disconnected workers";
+    }
+  }
 }
 
 void Application::rate_limit_delay() const {
@@ -102,6 +196,10 @@ void Application::run() {
 
   while (auto timeslice = source_->get()) {
     std::shared_ptr<const fles::Timeslice> ts(std::move(timeslice));
+    if (project_) {
+      ts = std::make_shared<fles::TimesliceProjection>(std::move(ts),
+                                                       selection_.predicate());
+    }
     if (par_.rate_limit() != 0.0) {
       rate_limit_delay();
     }
@@ -113,4 +211,8 @@ void Application::run() {
       break;
     }
   }
+
+  for (auto& sink : sinks_) {
+    sink->end_stream();
+  }
 }
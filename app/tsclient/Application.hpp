@@ -2,9 +2,15 @@
 #pragma once
 
 #include "Benchmark.hpp"
+#include "ComponentSelection.hpp"
 #include "Parameters.hpp"
 #include "Sink.hpp"
+#include "TimesliceDistributor.hpp"
+#include "TimesliceInputArchive.hpp"
 #include "TimesliceSource.hpp"
+#include "TimesliceSubscriber.hpp"
+#include "TimesliceTap.hpp"
+#include "TimesliceWorker.hpp"
 #include "log.hpp"
 #include <chrono>
 #include <memory>
@@ -25,7 +31,24 @@ public:
 private:
   Parameters const& par_;
 
+  /// The selected timeslice components.
+  fles::ComponentSelection selection_;
+  /// Select components after reception if the source cannot do it.
+  bool project_ = false;
+
   std::unique_ptr<fles::TimesliceSource> source_;
+  /// Non-owning pointer to source_ if it is a prefetching input archive.
+  fles::TimesliceInputArchivePrefetch* prefetch_ = nullptr;
+  /// Non-owning pointer to source_ if it is an input archive sequence.
+  fles::TimesliceInputArchiveSequence* sequence_ = nullptr;
+  /// Non-owning pointer to source_ if it is a timeslice subscriber.
+  fles::TimesliceSubscriber* subscriber_ = nullptr;
+  /// Non-owning pointer to source_ if it is a timeslice worker.
+  fles::TimesliceWorker* worker_ = nullptr;
+  /// Non-owning pointer to source_ if it is a monitoring tap.
+  fles::TimesliceTap* tap_ = nullptr;
+  /// Non-owning pointer to the distributor sink, if any.
+  fles::TimesliceDistributor* distributor_ = nullptr;
   std::vector<std::unique_ptr<fles::TimesliceSink>> sinks_;
   std::unique_ptr<Benchmark> benchmark_;
 
@@ -36,10 +36,31 @@ void Parameters::parse_options(int argc, char* argv[]) {
   desc_add("verbose,v", po::value<size_t>(&verbosity_), "set output verbosity");
   desc_add("shm-identifier,s", po::value<std::string>(&shm_identifier_),
            "shared memory identifier used for receiving timeslices");
+  desc_add("tap", po::value<bool>(&tap_)->implicit_value(true),
+           "receive copies of sampled timeslices from the shared memory "
+           "without affecting the timeslice processors (lossy, requires "
+           "flesnet --tap-sampling)");
   desc_add("input-archive,i", po::value<std::string>(&input_archive_),
-           "name of an input file archive to read");
+           "name of an input file archive to read, or of a sequence of input "
+           "file archives (use placeholder %n or wildcards)");
   desc_add("input-archive-cycles", po::value<uint64_t>(&input_archive_cycles_),
            "repeat reading input archive in a loop (for performance testing)");
+  desc_add("input-archive-prefetch",
+           po::value<size_t>(&input_archive_prefetch_),
+           "read ahead given number of timeslices from input archive in a "
+           "background thread (default: 0, disabled)");
+  desc_add("input-archive-prefetch-bytes",
+           po::value<size_t>(&input_archive_prefetch_bytes_),
+           "limit input archive read-ahead to given number of bytes "
+           "(default: 0, unlimited)");
+  desc_add("input-archive-parallel",
+           po::value<size_t>(&input_archive_parallel_),
+           "number of files of an input archive sequence to read "
+           "concurrently (default: 4)");
+  desc_add("input-archive-unordered",
+           po::value<bool>(&input_archive_unordered_)->implicit_value(true),
+           "do not merge input archive sequence files in timeslice index "
+           "order");
   desc_add("output-archive,o", po::value<std::string>(&output_archive_),
            "name of an output file archive to write");
   desc_add("output-archive-items", po::value<size_t>(&output_archive_items_),
@@ -57,6 +78,10 @@ void Parameters::parse_options(int argc, char* argv[]) {
   desc_add("publish-hwm", po::value<uint32_t>(&publish_hwm_),
            "High-water mark for the publisher, in TS, TS drop happens if more "
            "buffered (default: 1)");
+  desc_add("publish-multipart",
+           po::value<bool>(&publish_multipart_)->implicit_value(true),
+           "publish timeslices as zero-copy multipart messages instead of "
+           "serialized");
   desc_add("subscribe,S",
            po::value<std::string>(&subscribe_address_)
                ->implicit_value("tcp://localhost:5556"),
@@ -64,6 +89,15 @@ void Parameters::parse_options(int argc, char* argv[]) {
   desc_add("subscribe-hwm", po::value<uint32_t>(&subscribe_hwm_),
            "High-water mark for the subscriber, in TS, TS drop happens if more "
            "buffered (default: 1)");
+  desc_add("distribute,D",
+           po::value<bool>(&distribute_)->implicit_value(true),
+           "with publish/subscribe, distribute each timeslice to exactly one "
+           "subscriber instead of broadcasting (subscribe-hwm sets the number "
+           "of timeslices requested in advance)");
+  desc_add("select", po::value<std::string>(&select_),
+           "process only the timeslice components of given subsystems or "
+           "equipments (comma-separated hexadecimal sys_id or sys_id:eq_id "
+           "entries, e.g., 10,40:e001)");
   desc_add("maximum-number,n", po::value<uint64_t>(&maximum_number_),
            "set the maximum number of timeslices to process (default: "
            "unlimited)");
@@ -24,10 +24,22 @@ public:
 
   std::string shm_identifier() const { return shm_identifier_; }
 
+  bool tap() const { return tap_; }
+
   std::string input_archive() const { return input_archive_; }
 
   uint64_t input_archive_cycles() const { return input_archive_cycles_; }
 
+  size_t input_archive_prefetch() const { return input_archive_prefetch_; }
+
+  size_t input_archive_prefetch_bytes() const {
+    return input_archive_prefetch_bytes_;
+  }
+
+  size_t input_archive_parallel() const { return input_archive_parallel_; }
+
+  bool input_archive_unordered() const { return input_archive_unordered_; }
+
   std::string output_archive() const { return output_archive_; }
 
   size_t output_archive_items() const { return output_archive_items_; }
@@ -44,10 +56,16 @@ public:
 
   uint32_t publish_hwm() const { return publish_hwm_; }
 
+  bool publish_multipart() const { return publish_multipart_; }
+
   std::string subscribe_address() const { return subscribe_address_; }
 
   uint32_t subscribe_hwm() const { return subscribe_hwm_; }
 
+  bool distribute() const { return distribute_; }
+
+  std::string select() const { return select_; }
+
   uint64_t maximum_number() const { return maximum_number_; }
 
   double rate_limit() const { return rate_limit_; }
@@ -57,8 +75,13 @@ private:
 
   int32_t client_index_ = -1;
   std::string shm_identifier_;
+  bool tap_ = false;
   std::string input_archive_;
   uint64_t input_archive_cycles_ = 1;
+  size_t input_archive_prefetch_ = 0;
+  size_t input_archive_prefetch_bytes_ = 0;
+  size_t input_archive_parallel_ = 4;
+  bool input_archive_unordered_ = false;
   std::string output_archive_;
   size_t output_archive_items_ = SIZE_MAX;
   size_t output_archive_bytes_ = SIZE_MAX;
@@ -67,8 +90,11 @@ private:
   size_t verbosity_ = 0;
   std::string publish_address_;
   uint32_t publish_hwm_ = 1;
+  bool publish_multipart_ = false;
   std::string subscribe_address_;
   uint32_t subscribe_hwm_ = 1;
+  bool distribute_ = false;
+  std::string select_;
   uint64_t maximum_number_ = UINT64_MAX;
   double rate_limit_ = 0.0;
 };
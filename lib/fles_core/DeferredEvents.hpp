@@ -0,0 +1,51 @@
+// Copyright 2026 agent <agent@local>
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+/// Events held back until their owner is released.
+/** A DeferredEvents object keeps the events of a number of owners while
+    they are held, so that they can be handled later in the order of their
+    arrival. The RDMA TimesliceBuilder holds back the connection management
+    events of the connections served by a shard thread until the thread has
+    stopped, so that a connection is never torn down while its shard may
+    still use it. */
+
+template <typename Event> class DeferredEvents {
+public:
+  /// The DeferredEvents constructor. No owner is held initially.
+  explicit DeferredEvents(std::size_t num_owners)
+      : held_(num_owners, false), events_(num_owners) {}
+
+  /// Hold back the events of an owner from now on.
+  void hold(std::size_t owner) { held_.at(owner) = true; }
+
+  /// Check whether the events of an owner are held back.
+  bool held(std::size_t owner) const { return held_.at(owner); }
+
+  /// Keep an event if its owner is held. Returns true if the event has been
+  /// deferred, false if it is to be handled right away.
+  bool defer(std::size_t owner, const Event& event) {
+    if (!held_.at(owner)) {
+      return false;
+    }
+    events_[owner].push_back(event);
+    return true;
+  }
+
+  /// Release an owner. Returns its deferred events in order of arrival.
+  std::vector<Event> release(std::size_t owner) {
+    held_.at(owner) = false;
+    std::vector<Event> events;
+    events.swap(events_[owner]);
+    return events;
+  }
+
+private:
+  /// Flags, true if the events of the owner are held back.
+  std::vector<bool> held_;
+
+  /// The deferred events of each owner.
+  std::vector<std::vector<Event>> events_;
+};
@@ -6,6 +6,8 @@
 
 #include "Sink.hpp"
 #include "Source.hpp"
+#include <algorithm>
+#include <chrono>
 #include <deque>
 #include <memory>
 #include <queue>
@@ -74,6 +76,25 @@ private:
   using filter_output_t = typename Filter<Input, Output>::filter_output_t;
 
   Output* do_get() override {
+    return next([this] { return source.get(); });
+  }
+
+  Output* do_try_get() override {
+    return next([this] { return source.try_get(); });
+  }
+
+  Output* do_get_for(std::chrono::nanoseconds timeout) override {
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    return next([this, deadline] {
+      auto remaining = deadline - std::chrono::steady_clock::now();
+      return source.get_for(std::max(
+          remaining, std::chrono::steady_clock::duration::zero()));
+    });
+  }
+
+  /// Retrieve the next output item, feeding the filter with input items
+  /// retrieved by the given function.
+  template <class Fetch> Output* next(Fetch fetch) {
     if (eos_flag) {
       return nullptr;
     }
@@ -83,9 +104,10 @@ private:
       filter_output = filter.exchange_item();
     } else {
       do {
-        auto item = source.get();
+        auto item = fetch();
         if (!item) {
-          eos_flag = true;
+          // the input is not available yet unless end-of-stream is reached
+          eos_flag = source.eos();
           return nullptr;
         }
         filter_output = filter.exchange_item(std::move(item));
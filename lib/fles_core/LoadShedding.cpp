@@ -0,0 +1,46 @@
+// Copyright 2026 agent <agent@local>
+
+#include "LoadShedding.hpp"
+#include <algorithm>
+#include <cmath>
+
+constexpr uint32_t LoadShedding::steps;
+
+LoadShedding::LoadShedding(uint64_t capacity,
+                           double high,
+                           double low,
+                           double max_share)
+    : high_(static_cast<uint64_t>(
+          std::ceil(static_cast<double>(capacity) * std::max(high, 0.0)))),
+      low_(static_cast<uint64_t>(static_cast<double>(capacity) *
+                                 std::max(std::min(low, high), 0.0))),
+      holdoff_(std::max<uint64_t>(capacity / steps, 1)),
+      max_level_(static_cast<uint32_t>(std::min(
+          std::floor(static_cast<double>(steps) * std::max(max_share, 0.0)),
+          static_cast<double>(steps - 1)))) {}
+
+bool LoadShedding::update(uint64_t position,
+                          uint64_t outstanding,
+                          uint64_t queued) {
+  if (!enabled() || position < last_change_ + holdoff_) {
+    return false;
+  }
+  if (outstanding >= high_ && queued > 0 && level_ < max_level_) {
+    ++level_;
+  } else if (outstanding <= low_ && level_ > 0) {
+    --level_;
+  } else {
+    return false;
+  }
+  last_change_ = position;
+  return true;
+}
+
+uint32_t LoadShedding::bucket(uint64_t ts_index) {
+  // splitmix64 finalizer, spreads consecutive indexes evenly
+  uint64_t z = ts_index + UINT64_C(0x9e3779b97f4a7c15);
+  z = (z ^ (z >> 30)) * UINT64_C(0xbf58476d1ce4e5b9);
+  z = (z ^ (z >> 27)) * UINT64_C(0x94d049bb133111eb);
+  z ^= z >> 31;
+  return static_cast<uint32_t>(z % steps);
+}
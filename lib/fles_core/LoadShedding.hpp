@@ -0,0 +1,83 @@
+// Copyright 2026 agent <agent@local>
+#pragma once
+
+#include <cstdint>
+
+/// Adaptive load shedding policy of a compute node.
+/** If the timeslice processors fall behind, the timeslice buffer fills up
+    and the resulting backpressure eventually leads to data truncation at
+    the front end. To avoid this, a compute node may complete some
+    timeslices without handing them to the processors.
+
+    The shedding level is raised by one step whenever the buffer fill
+    reaches the high watermark while work items are waiting for the
+    processors, and lowered by one step when it has fallen to the low
+    watermark. Between two changes, at least a sixteenth of the buffer
+    capacity has to be built. At level l, a timeslice is shed if the hash of
+    its index falls into the lowest l of `steps` buckets. The set of shed
+    timeslices thus depends only on the level, so compute nodes at the same
+    level shed consistently, and each level includes the timeslices shed at
+    all lower levels. The level is limited by a maximum share of shed
+    timeslices, so that some data is always processed. */
+
+class LoadShedding {
+public:
+  /// Number of hash buckets (level l sheds l of them).
+  static constexpr uint32_t steps = 16;
+
+  /// The LoadShedding constructor.
+  /** The watermarks are given as fractions of the buffer capacity (in
+      timeslices). A high watermark of zero disables load shedding. The
+      maximum share of shed timeslices is rounded down to whole steps and
+      kept below one. */
+  LoadShedding(uint64_t capacity,
+               double high,
+               double low,
+               double max_share = 0.75);
+
+  /// Check if load shedding is enabled.
+  bool enabled() const { return high_ > 0; }
+
+  /// Retrieve the current shedding level.
+  uint32_t level() const { return level_; }
+
+  /// Retrieve the highest shedding level.
+  uint32_t max_level() const { return max_level_; }
+
+  /// Retrieve the share of timeslices shed at the current level.
+  double share() const {
+    return static_cast<double>(level_) / static_cast<double>(steps);
+  }
+
+  /// Adapt the shedding level to the current buffer state. Returns true if
+  /// the level has changed.
+  /** \param position  timeslice position of the next timeslice to be built
+      \param outstanding  number of timeslices built but not yet completed
+      \param queued  number of work items not yet taken by a processor */
+  bool update(uint64_t position, uint64_t outstanding, uint64_t queued);
+
+  /// Check if a timeslice is to be shed at the current level.
+  bool shed(uint64_t ts_index) const {
+    return level_ > 0 && bucket(ts_index) < level_;
+  }
+
+  /// Retrieve the hash bucket of a timeslice index.
+  static uint32_t bucket(uint64_t ts_index);
+
+private:
+  /// Watermarks in number of outstanding timeslices.
+  const uint64_t high_;
+  const uint64_t low_;
+
+  /// Minimum number of timeslices between two level changes.
+  const uint64_t holdoff_;
+
+  /// The highest shedding level.
+  const uint32_t max_level_;
+
+  /// The current shedding level.
+  uint32_t level_ = 0;
+
+  /// The timeslice position of the last level change.
+  uint64_t last_change_ = 0;
+};
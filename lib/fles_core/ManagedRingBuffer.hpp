@@ -24,7 +24,7 @@ public:
   }
 
   std::size_t size_available() const {
-    assert(this->size() > size_used());
+    assert(this->size() >= size_used());
     return this->size() - size_used();
   }
 
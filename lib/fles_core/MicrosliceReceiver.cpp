@@ -1,6 +1,7 @@
 // Copyright 2015 Jan de Cuveland <cmail@cuveland.de>
 
 #include "MicrosliceReceiver.hpp"
+#include <algorithm>
 #include <chrono>
 #include <thread>
 
@@ -9,9 +10,12 @@ namespace fles {
 MicrosliceReceiver::MicrosliceReceiver(InputBufferReadInterface& data_source)
     : data_source_(data_source),
       write_index_desc_(data_source_.get_write_index().desc),
-      read_index_desc_(data_source_.get_read_index().desc) {}
+      read_index_desc_(data_source_.get_read_index().desc),
+      read_index_data_(data_source_.get_read_index().data) {}
 
-StorableMicroslice* MicrosliceReceiver::try_get() {
+constexpr std::chrono::milliseconds MicrosliceReceiver::poll_interval;
+
+StorableMicroslice* MicrosliceReceiver::receive() {
   // update write_index if needed
   if (write_index_desc_ <= read_index_desc_) {
     write_index_desc_ = data_source_.get_write_index().desc;
@@ -51,34 +55,75 @@ StorableMicroslice* MicrosliceReceiver::try_get() {
     }
 
     ++read_index_desc_;
-
-    data_source_.set_read_index({read_index_desc_, offset_end});
+    read_index_data_ = offset_end;
 
     return sms;
   }
   return nullptr;
 }
 
-StorableMicroslice* MicrosliceReceiver::do_get() {
+void MicrosliceReceiver::release() {
+  data_source_.set_read_index({read_index_desc_, read_index_data_});
+}
+
+bool MicrosliceReceiver::at_eos() {
+  return data_source_.get_eof() &&
+         read_index_desc_ == data_source_.get_write_index().desc;
+}
+
+StorableMicroslice* MicrosliceReceiver::do_try_get() {
   if (eos_) {
     return nullptr;
   }
 
+  data_source_.proceed();
+  StorableMicroslice* sms = receive();
+  if (sms != nullptr) {
+    release();
+  } else if (at_eos()) {
+    eos_ = true;
+  }
+  return sms;
+}
+
+StorableMicroslice* MicrosliceReceiver::do_get() {
   // wait until a microslice is available in the input buffer
-  StorableMicroslice* sms = nullptr;
-  while (sms == nullptr) {
-    data_source_.proceed();
-    sms = try_get();
-    if (sms == nullptr) {
-      if (data_source_.get_eof() &&
-          read_index_desc_ == data_source_.get_write_index().desc) {
-        eos_ = true;
-        return nullptr;
-      }
-      std::this_thread::sleep_for(std::chrono::milliseconds(10));
-    }
+  StorableMicroslice* sms = do_try_get();
+  while (sms == nullptr && !eos_) {
+    std::this_thread::sleep_for(poll_interval);
+    sms = do_try_get();
   }
+  return sms;
+}
 
+StorableMicroslice*
+MicrosliceReceiver::do_get_for(std::chrono::nanoseconds timeout) {
+  const auto deadline = std::chrono::steady_clock::now() + timeout;
+  StorableMicroslice* sms = do_try_get();
+  while (sms == nullptr && !eos_) {
+    auto now = std::chrono::steady_clock::now();
+    if (now >= deadline) {
+      break;
+    }
+    std::this_thread::sleep_for(std::min<std::chrono::nanoseconds>(
+        poll_interval, deadline - now));
+    sms = do_try_get();
+  }
   return sms;
 }
+
+void MicrosliceReceiver::do_get_batch(
+    std::vector<std::unique_ptr<Microslice>>& items, std::size_t max_items) {
+  StorableMicroslice* sms = do_get();
+  if (sms == nullptr) {
+    return;
+  }
+  items.emplace_back(sms);
+
+  // release the input buffer space once for the whole batch
+  while (items.size() < max_items && (sms = receive()) != nullptr) {
+    items.emplace_back(sms);
+  }
+  release();
+}
 } // namespace fles
@@ -7,8 +7,11 @@
 #include "MicrosliceSource.hpp"
 #include "RingBuffer.hpp"
 #include "StorableMicroslice.hpp"
+#include <chrono>
+#include <cstddef>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace fles {
 
@@ -43,14 +46,29 @@ public:
 
 private:
   StorableMicroslice* do_get() override;
+  StorableMicroslice* do_try_get() override;
+  StorableMicroslice* do_get_for(std::chrono::nanoseconds timeout) override;
+  void do_get_batch(std::vector<std::unique_ptr<Microslice>>& items,
+                    std::size_t max_items) override;
 
-  StorableMicroslice* try_get();
+  /// Copy the next microslice from the input buffer, if available.
+  StorableMicroslice* receive();
+
+  /// Release the input buffer space of the received microslices.
+  void release();
+
+  /// Check whether the data source is completely consumed.
+  bool at_eos();
+
+  /// Interval to poll the data source while waiting for data.
+  static constexpr std::chrono::milliseconds poll_interval{10};
 
   /// Data source (e.g., FLIB).
   InputBufferReadInterface& data_source_;
 
   uint64_t write_index_desc_;
   uint64_t read_index_desc_;
+  uint64_t read_index_data_;
 
   bool eos_ = false;
 };
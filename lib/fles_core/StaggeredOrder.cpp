@@ -0,0 +1,18 @@
+// Copyright 2026 agent <agent@local>
+
+#include "StaggeredOrder.hpp"
+#include <algorithm>
+#include <cassert>
+
+StaggeredOrder::StaggeredOrder(uint64_t input_index,
+                               uint32_t window,
+                               uint64_t end)
+    : input_index_(input_index), window_(std::max<uint32_t>(window, 1)),
+      end_(end) {}
+
+uint64_t StaggeredOrder::timeslice(uint64_t position) const {
+  assert(position < end_);
+  uint64_t begin = position - position % window_;
+  uint64_t size = std::min<uint64_t>(window_, end_ - begin);
+  return begin + (position - begin + input_index_) % size;
+}
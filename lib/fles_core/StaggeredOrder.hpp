@@ -0,0 +1,35 @@
+// Copyright 2026 agent <agent@local>
+#pragma once
+
+#include <cstdint>
+
+/// Staggered sending order of the timeslices of an input channel.
+/** Timeslices are sent in blocks of `window` consecutive timeslices. Within
+    a block, an input channel starts with the timeslice selected by its
+    index and continues cyclically. Since consecutive timeslices are
+    assigned to different compute nodes, the input channels then tend to
+    send to different compute nodes at the same time instead of all
+    targeting the same one (incast). A window of 1 keeps the natural
+    order. */
+
+class StaggeredOrder {
+public:
+  /// The StaggeredOrder constructor.
+  StaggeredOrder(uint64_t input_index, uint32_t window, uint64_t end);
+
+  /// Retrieve the timeslice sent at a given position in the sending order.
+  uint64_t timeslice(uint64_t position) const;
+
+  /// Retrieve the block size.
+  uint32_t window() const { return window_; }
+
+private:
+  /// The offset of this input channel within each block.
+  const uint64_t input_index_;
+
+  /// The number of timeslices per block.
+  const uint32_t window_;
+
+  /// The number of timeslices to send (the last block may be shorter).
+  const uint64_t end_;
+};
@@ -1,15 +1,20 @@
 // Copyright 2016 Jan de Cuveland <cmail@cuveland.de>
 
 #include "TimesliceBuffer.hpp"
+#include <algorithm>
+#include <new>
 
 TimesliceBuffer::TimesliceBuffer(std::string shm_identifier,
                                  uint32_t data_buffer_size_exp,
                                  uint32_t desc_buffer_size_exp,
-                                 uint32_t num_input_nodes)
+                                 uint32_t num_input_nodes,
+                                 bool component_events,
+                                 uint32_t tap_sampling,
+                                 bool absent_markers)
     : shm_identifier_(shm_identifier),
       data_buffer_size_exp_(data_buffer_size_exp),
       desc_buffer_size_exp_(desc_buffer_size_exp),
-      num_input_nodes_(num_input_nodes) {
+      num_input_nodes_(num_input_nodes), absent_markers_(absent_markers) {
   boost::interprocess::shared_memory_object::remove(
       (shm_identifier_ + "data_").c_str());
   boost::interprocess::shared_memory_object::remove(
@@ -34,7 +39,9 @@ TimesliceBuffer::TimesliceBuffer(std::string shm_identifier,
 
   std::size_t desc_buffer_size = (UINT64_C(1) << desc_buffer_size_exp_);
 
-  std::size_t desc_size = desc_buffer_size * num_input_nodes_ *
+  // descriptor buffers, optionally followed by absent markers
+  std::size_t desc_size = (absent_markers_ ? 2 : 1) * desc_buffer_size *
+                          num_input_nodes_ *
                           sizeof(fles::TimesliceComponentDescriptor);
   assert(desc_size != 0);
   desc_shm_->truncate(static_cast<boost::interprocess::offset_t>(desc_size));
@@ -49,6 +56,14 @@ TimesliceBuffer::TimesliceBuffer(std::string shm_identifier,
                                              boost::interprocess::read_write));
   desc_region_ = std::move(desc_region);
 
+  // no position is marked initially
+  if (absent_markers_) {
+    const fles::TimesliceComponentDescriptor unmarked = {
+        UINT64_MAX, UINT64_MAX, 0, 0};
+    std::fill(get_desc_ptr(num_input_nodes_),
+              get_desc_ptr(2 * num_input_nodes_), unmarked);
+  }
+
 // # TODO[jan]: with-valgrind optional in cmake
 #if 0
 #pragma GCC diagnostic push
@@ -60,24 +75,80 @@ TimesliceBuffer::TimesliceBuffer(std::string shm_identifier,
 #pragma GCC diagnostic pop
 #endif
 
-  boost::interprocess::message_queue::remove(
-      (shm_identifier_ + "work_items_").c_str());
-  boost::interprocess::message_queue::remove(
-      (shm_identifier_ + "completions_").c_str());
-
-  std::unique_ptr<boost::interprocess::message_queue> work_items_mq(
-      new boost::interprocess::message_queue(
-          boost::interprocess::create_only,
-          (shm_identifier_ + "work_items_").c_str(), desc_buffer_size,
-          sizeof(fles::TimesliceWorkItem)));
-  work_items_mq_ = std::move(work_items_mq);
-
-  std::unique_ptr<boost::interprocess::message_queue> completions_mq(
-      new boost::interprocess::message_queue(
-          boost::interprocess::create_only,
-          (shm_identifier_ + "completions_").c_str(), desc_buffer_size,
-          sizeof(fles::TimesliceCompletion)));
-  completions_mq_ = std::move(completions_mq);
+  fles::SharedMemoryQueue<fles::TimesliceWorkItem>::remove(shm_identifier_ +
+                                                          "work_items_");
+  fles::SharedMemoryQueue<fles::TimesliceCompletion>::remove(shm_identifier_ +
+                                                            "completions_");
+  fles::SharedMemoryQueue<fles::TimesliceComponentEvent>::remove(
+      shm_identifier_ + "component_events_");
+  boost::interprocess::shared_memory_object::remove(
+      (shm_identifier_ + "component_pins_").c_str());
+  boost::interprocess::shared_memory_object::remove(
+      (shm_identifier_ + "tap_").c_str());
+  fles::SharedMemoryQueue<fles::TimesliceWorkItem>::remove(shm_identifier_ +
+                                                          "tap_items_");
+
+  work_items_ =
+      std::unique_ptr<fles::SharedMemoryQueue<fles::TimesliceWorkItem>>(
+          new fles::SharedMemoryQueue<fles::TimesliceWorkItem>(
+              boost::interprocess::create_only,
+              shm_identifier_ + "work_items_", desc_buffer_size));
+
+  completions_ =
+      std::unique_ptr<fles::SharedMemoryQueue<fles::TimesliceCompletion>>(
+          new fles::SharedMemoryQueue<fles::TimesliceCompletion>(
+              boost::interprocess::create_only,
+              shm_identifier_ + "completions_", desc_buffer_size));
+
+  if (component_events) {
+    component_events_ = std::unique_ptr<
+        fles::SharedMemoryQueue<fles::TimesliceComponentEvent>>(
+        new fles::SharedMemoryQueue<fles::TimesliceComponentEvent>(
+            boost::interprocess::create_only,
+            shm_identifier_ + "component_events_",
+            desc_buffer_size * num_input_nodes_));
+
+    std::size_t entries =
+        fles::TimesliceComponentPins::entries(desc_buffer_size_exp_);
+    pins_shm_ = std::unique_ptr<boost::interprocess::shared_memory_object>(
+        new boost::interprocess::shared_memory_object(
+            boost::interprocess::create_only,
+            (shm_identifier_ + "component_pins_").c_str(),
+            boost::interprocess::read_write));
+    pins_shm_->truncate(static_cast<boost::interprocess::offset_t>(
+        entries * sizeof(std::atomic<uint64_t>)));
+    pins_region_ = std::unique_ptr<boost::interprocess::mapped_region>(
+        new boost::interprocess::mapped_region(
+            *pins_shm_, boost::interprocess::read_write));
+    auto* pins =
+        static_cast<std::atomic<uint64_t>*>(pins_region_->get_address());
+    for (std::size_t i = 0; i < entries; ++i) {
+      new (&pins[i]) std::atomic<uint64_t>(0);
+    }
+    pins_ = std::unique_ptr<fles::TimesliceComponentPins>(
+        new fles::TimesliceComponentPins(pins, desc_buffer_size_exp_));
+  }
+
+  if (tap_sampling != 0) {
+    tap_shm_ = std::unique_ptr<boost::interprocess::shared_memory_object>(
+        new boost::interprocess::shared_memory_object(
+            boost::interprocess::create_only,
+            (shm_identifier_ + "tap_").c_str(),
+            boost::interprocess::read_write));
+    tap_shm_->truncate(sizeof(fles::TimesliceTapStatus));
+    tap_region_ = std::unique_ptr<boost::interprocess::mapped_region>(
+        new boost::interprocess::mapped_region(
+            *tap_shm_, boost::interprocess::read_write));
+    tap_status_ = new (tap_region_->get_address()) fles::TimesliceTapStatus;
+    tap_status_->sampling = tap_sampling;
+
+    // a few pending copies are sufficient for monitoring
+    tap_items_ =
+        std::unique_ptr<fles::SharedMemoryQueue<fles::TimesliceWorkItem>>(
+            new fles::SharedMemoryQueue<fles::TimesliceWorkItem>(
+                boost::interprocess::create_only,
+                shm_identifier_ + "tap_items_", 16));
+  }
 }
 
 TimesliceBuffer::~TimesliceBuffer() {
@@ -85,10 +156,22 @@ TimesliceBuffer::~TimesliceBuffer() {
       (shm_identifier_ + "data_").c_str());
   boost::interprocess::shared_memory_object::remove(
       (shm_identifier_ + "desc_").c_str());
-  boost::interprocess::message_queue::remove(
-      (shm_identifier_ + "work_items_").c_str());
-  boost::interprocess::message_queue::remove(
-      (shm_identifier_ + "completions_").c_str());
+  fles::SharedMemoryQueue<fles::TimesliceWorkItem>::remove(shm_identifier_ +
+                                                          "work_items_");
+  fles::SharedMemoryQueue<fles::TimesliceCompletion>::remove(shm_identifier_ +
+                                                            "completions_");
+  if (component_events_) {
+    fles::SharedMemoryQueue<fles::TimesliceComponentEvent>::remove(
+        shm_identifier_ + "component_events_");
+    boost::interprocess::shared_memory_object::remove(
+        (shm_identifier_ + "component_pins_").c_str());
+  }
+  if (tap_status_ != nullptr) {
+    boost::interprocess::shared_memory_object::remove(
+        (shm_identifier_ + "tap_").c_str());
+    fles::SharedMemoryQueue<fles::TimesliceWorkItem>::remove(shm_identifier_ +
+                                                            "tap_items_");
+  }
 }
 
 uint8_t* TimesliceBuffer::get_data_ptr(uint_fast16_t index) {
@@ -113,3 +196,43 @@ TimesliceBuffer::get_desc(uint_fast16_t index, uint64_t offset) {
   offset &= (UINT64_C(1) << desc_buffer_size_exp_) - 1;
   return get_desc_ptr(index)[offset];
 }
+
+void TimesliceBuffer::mark_absent(uint_fast16_t index,
+                                  uint64_t offset,
+                                  uint64_t ts_num) {
+  assert(absent_markers_);
+  get_desc(num_input_nodes_ + index, offset) = {ts_num, offset, 0, 0};
+}
+
+bool TimesliceBuffer::is_absent(uint_fast16_t index, uint64_t offset) {
+  return absent_markers_ &&
+         get_desc(num_input_nodes_ + index, offset).offset == offset;
+}
+
+const fles::TimesliceComponentDescriptor*
+TimesliceBuffer::get_absent_ptr(uint_fast16_t index) {
+  return absent_markers_ ? get_desc_ptr(num_input_nodes_ + index) : nullptr;
+}
+
+uint64_t TimesliceBuffer::get_releasable(uint64_t acked) {
+  if (!pins_) {
+    return acked;
+  }
+  // a view pins its slot before checking the acknowledged position, so a
+  // zero count observed here cannot belong to a view of this timeslice
+  while (releasable_ < acked && pins_->count(releasable_).load() == 0) {
+    ++releasable_;
+  }
+  return releasable_;
+}
+
+void TimesliceBuffer::send_tap_item(const fles::TimesliceWorkItem& wi) {
+  // sample by index, so that all compute nodes select the same timeslices
+  if (wi.ts_desc.index % tap_status_->sampling != 0) {
+    return;
+  }
+  tap_status_->sampled.fetch_add(1, std::memory_order_relaxed);
+  if (!tap_items_->try_push(wi)) {
+    tap_status_->lost.fetch_add(1, std::memory_order_relaxed);
+  }
+}
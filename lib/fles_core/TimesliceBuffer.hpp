@@ -1,19 +1,31 @@
 // Copyright 2016 Jan de Cuveland <cmail@cuveland.de>
 #pragma once
 
+#include "SharedMemoryQueue.hpp"
 #include "TimesliceCompletion.hpp"
 #include "TimesliceComponentDescriptor.hpp"
+#include "TimesliceComponentEvent.hpp"
+#include "TimesliceComponentPins.hpp"
+#include "TimesliceTapStatus.hpp"
 #include "TimesliceWorkItem.hpp"
 
-#include <boost/interprocess/ipc/message_queue.hpp>
 #include <boost/interprocess/mapped_region.hpp>
 #include <boost/interprocess/shared_memory_object.hpp>
 
+#include <atomic>
 #include <csignal>
 
 /// Timeslice buffer container class.
 /** A TimesliceBuffer object represents the compute node's timeslice buffer
-   (filled by the input nodes). */
+   (filled by the input nodes).
+
+   The descriptor memory holds a descriptor buffer for each input node. If
+   the timeslice builder applies a straggler timeout, they are followed by
+   a buffer of absent markers for each input node, written only by the
+   timeslice builder. A marker applies to the
+   timeslice position stored in its offset field, and replaces the
+   descriptor of the component at that position (see fles::TimesliceView).
+   This keeps a late write from the input node from tearing the marker. */
 
 class TimesliceBuffer {
 public:
@@ -21,7 +33,10 @@ public:
   TimesliceBuffer(std::string shm_identifier,
                   uint32_t data_buffer_size_exp,
                   uint32_t desc_buffer_size_exp,
-                  uint32_t num_input_nodes);
+                  uint32_t num_input_nodes,
+                  bool component_events = false,
+                  uint32_t tap_sampling = 0,
+                  bool absent_markers = false);
 
   TimesliceBuffer(const TimesliceBuffer&) = delete;
   void operator=(const TimesliceBuffer&) = delete;
@@ -39,40 +54,110 @@ public:
   fles::TimesliceComponentDescriptor& get_desc(uint_fast16_t index,
                                                uint64_t offset);
 
+  /// Check whether the buffer holds absent markers.
+  bool has_absent_markers() const { return absent_markers_; }
+
+  /// Mark the component of an input node at a timeslice position as
+  /// absent. Requires absent markers.
+  void mark_absent(uint_fast16_t index, uint64_t offset, uint64_t ts_num);
+
+  /// Check whether the component of an input node at a timeslice position
+  /// has been marked as absent.
+  bool is_absent(uint_fast16_t index, uint64_t offset);
+
+  /// Retrieve the absent markers of an input node, nullptr if the buffer
+  /// holds none.
+  const fles::TimesliceComponentDescriptor*
+  get_absent_ptr(uint_fast16_t index);
+
   uint32_t get_num_input_nodes() const { return num_input_nodes_; }
 
   void send_work_item(fles::TimesliceWorkItem wi) {
-    work_items_mq_->send(&wi, sizeof(wi), 0);
+    if (tap_status_ != nullptr) {
+      send_tap_item(wi);
+    }
+    work_items_->push(wi);
+  }
+
+  void send_completion(fles::TimesliceCompletion c) { completions_->push(c); }
+
+  void send_end_work_item() {
+    if (tap_items_) {
+      tap_items_->close();
+    }
+    work_items_->close();
   }
 
-  void send_completion(fles::TimesliceCompletion c) {
-    completions_mq_->send(&c, sizeof(c), 0);
+  void send_end_completion() { completions_->close(); }
+
+  /// Check whether component arrival events are published.
+  bool has_component_events() const { return component_events_ != nullptr; }
+
+  /// Publish the arrival of a single timeslice component. Never blocks, the
+  /// event is discarded if the consumers do not keep up.
+  void send_component_event(fles::TimesliceComponentEvent e) {
+    if (!component_events_->try_push(e)) {
+      component_events_lost_.fetch_add(1, std::memory_order_relaxed);
+    }
   }
 
-  void send_end_work_item() { work_items_mq_->send(nullptr, 0, 0); }
+  /// Retrieve the number of discarded component arrival events.
+  uint64_t get_num_component_events_lost() const {
+    return component_events_lost_.load(std::memory_order_relaxed);
+  }
 
-  void send_end_completion() { completions_mq_->send(nullptr, 0, 0); }
+  /// Check whether timeslices are offered to monitoring taps.
+  bool has_tap() const { return tap_status_ != nullptr; }
+
+  /// Publish the acknowledged position. Must be called before the buffer
+  /// space of completed timeslices is released to the input nodes.
+  void set_acked(uint64_t ts_pos) {
+    if (tap_status_ != nullptr) {
+      tap_status_->acked.store(ts_pos, std::memory_order_release);
+    }
+    if (pins_) {
+      pins_->acked().store(ts_pos);
+    }
+  }
 
-  std::size_t get_num_work_items() const {
-    return work_items_mq_->get_num_msg();
+  /// Retrieve the position up to which the buffer space may be released to
+  /// the input nodes, given the acknowledged position published before.
+  /// Timeslices with components still in use by a component view are held
+  /// back.
+  uint64_t get_releasable(uint64_t acked);
+
+  /// Retrieve the number of timeslices offered to monitoring taps.
+  uint64_t get_num_tap_sampled() const {
+    return tap_status_ != nullptr
+               ? tap_status_->sampled.load(std::memory_order_relaxed)
+               : 0;
   }
 
-  std::size_t get_num_completions() const {
-    return completions_mq_->get_num_msg();
+  /// Retrieve the number of sampled timeslices not queued for the taps.
+  uint64_t get_num_tap_lost() const {
+    return tap_status_ != nullptr
+               ? tap_status_->lost.load(std::memory_order_relaxed)
+               : 0;
   }
 
+  std::size_t get_num_work_items() const { return work_items_->size(); }
+
+  std::size_t get_num_completions() const { return completions_->size(); }
+
   bool try_receive_completion(fles::TimesliceCompletion& c) {
-    std::size_t recvd_size;
-    unsigned int priority;
-    if (!completions_mq_->try_receive(&c, sizeof(c), recvd_size, priority))
-      return false;
-    if (recvd_size == 0)
-      return false;
-    assert(recvd_size == sizeof(c));
-    return true;
+    return completions_->try_pop(c);
   };
 
+  /// Receive up to max_count pending completions at once.
+  std::size_t try_receive_completions(fles::TimesliceCompletion* c,
+                                      std::size_t max_count) {
+    return completions_->try_pop_batch(c, max_count);
+  }
+
 private:
+  /// Offer a sampled timeslice to the monitoring taps without blocking.
+  void send_tap_item(const fles::TimesliceWorkItem& wi);
+
   std::string shm_identifier_;
 
   uint32_t data_buffer_size_exp_;
@@ -80,12 +165,39 @@ private:
 
   uint32_t num_input_nodes_;
 
+  /// Flag, true if absent markers follow the descriptor buffers.
+  bool absent_markers_;
+
   std::unique_ptr<boost::interprocess::shared_memory_object> data_shm_;
   std::unique_ptr<boost::interprocess::shared_memory_object> desc_shm_;
 
   std::unique_ptr<boost::interprocess::mapped_region> data_region_;
   std::unique_ptr<boost::interprocess::mapped_region> desc_region_;
 
-  std::unique_ptr<boost::interprocess::message_queue> work_items_mq_;
-  std::unique_ptr<boost::interprocess::message_queue> completions_mq_;
+  std::unique_ptr<fles::SharedMemoryQueue<fles::TimesliceWorkItem>>
+      work_items_;
+  std::unique_ptr<fles::SharedMemoryQueue<fles::TimesliceCompletion>>
+      completions_;
+
+  /// The optional queue of component arrival events.
+  std::unique_ptr<fles::SharedMemoryQueue<fles::TimesliceComponentEvent>>
+      component_events_;
+
+  /// Number of discarded component arrival events.
+  std::atomic<uint64_t> component_events_lost_{0};
+
+  /// The optional pin counts of the component views.
+  std::unique_ptr<boost::interprocess::shared_memory_object> pins_shm_;
+  std::unique_ptr<boost::interprocess::mapped_region> pins_region_;
+  std::unique_ptr<fles::TimesliceComponentPins> pins_;
+
+  /// The position up to which the buffer space may be released.
+  uint64_t releasable_ = 0;
+
+  /// The optional shared state and queue of the monitoring taps.
+  std::unique_ptr<boost::interprocess::shared_memory_object> tap_shm_;
+  std::unique_ptr<boost::interprocess::mapped_region> tap_region_;
+  fles::TimesliceTapStatus* tap_status_ = nullptr;
+  std::unique_ptr<fles::SharedMemoryQueue<fles::TimesliceWorkItem>>
+      tap_items_;
 };
@@ -0,0 +1,116 @@
+// Copyright 2026 agent <agent@local>
+
+#include "TimesliceSchedule.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <numeric>
+
+constexpr uint32_t TimesliceSchedule::max_weight;
+
+TimesliceSchedule::TimesliceSchedule(uint32_t num_compute_nodes,
+                                     uint32_t timeslices_per_node,
+                                     uint32_t lookahead)
+    : num_compute_nodes_(num_compute_nodes),
+      epoch_size_(num_compute_nodes * std::max<uint32_t>(timeslices_per_node, 1)),
+      lookahead_(std::max<uint32_t>(lookahead, 1)) {
+  assert(num_compute_nodes_ > 0);
+}
+
+void TimesliceSchedule::set_weight(uint32_t compute_node,
+                                   uint64_t epoch,
+                                   uint32_t weight) {
+  assert(compute_node < num_compute_nodes_);
+  assert(weight > 0 && weight <= max_weight);
+  if (!epochs_.empty() && epoch < epochs_.begin()->first) {
+    return;
+  }
+  Epoch& e = get_epoch(epoch);
+  if (e.weights[compute_node] == 0) {
+    ++e.known;
+  }
+  e.weights[compute_node] = weight;
+}
+
+bool TimesliceSchedule::ready(uint64_t timeslice) {
+  uint64_t epoch = this->epoch(timeslice);
+  epochs_.erase(epochs_.begin(), epochs_.lower_bound(epoch));
+  Epoch& e = get_epoch(epoch);
+  if (e.known < num_compute_nodes_) {
+    return false;
+  }
+  if (e.assignment.empty()) {
+    assign(e);
+  }
+  return true;
+}
+
+uint32_t TimesliceSchedule::compute_node(uint64_t timeslice) const {
+  auto it = epochs_.find(epoch(timeslice));
+  assert(it != epochs_.end() && !it->second.assignment.empty());
+  return it->second.assignment[timeslice % epoch_size_];
+}
+
+uint32_t TimesliceSchedule::weight(double free_fraction,
+                                   uint64_t backlog) const {
+  // a backlog of one epoch's share halves the weight
+  double share = static_cast<double>(epoch_size_ / num_compute_nodes_);
+  double weight = max_weight * std::max(free_fraction, 0.0) * share /
+                  (share + static_cast<double>(backlog));
+  return std::min<uint32_t>(
+      std::max<uint32_t>(static_cast<uint32_t>(std::lround(weight)), 1),
+      max_weight);
+}
+
+TimesliceSchedule::Epoch& TimesliceSchedule::get_epoch(uint64_t epoch) {
+  Epoch& e = epochs_[epoch];
+  if (e.weights.empty()) {
+    if (epoch < lookahead_) {
+      e.weights.assign(num_compute_nodes_, max_weight);
+      e.known = num_compute_nodes_;
+    } else {
+      e.weights.assign(num_compute_nodes_, 0);
+    }
+  }
+  return e;
+}
+
+void TimesliceSchedule::assign(Epoch& e) const {
+  // one timeslice per compute node, distribute the remaining timeslices
+  // by largest remainder
+  uint64_t total = std::accumulate(e.weights.begin(), e.weights.end(),
+                                   UINT64_C(0));
+  uint64_t remaining = epoch_size_ - num_compute_nodes_;
+  std::vector<uint64_t> count(num_compute_nodes_, 1);
+  std::vector<uint64_t> remainder(num_compute_nodes_);
+  uint64_t distributed = 0;
+  for (uint32_t i = 0; i < num_compute_nodes_; ++i) {
+    uint64_t share = remaining * e.weights[i];
+    count[i] += share / total;
+    remainder[i] = share % total;
+    distributed += share / total;
+  }
+  std::vector<uint32_t> order(num_compute_nodes_);
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+    return remainder[a] > remainder[b];
+  });
+  for (uint64_t i = 0; i < remaining - distributed; ++i) {
+    ++count[order[i]];
+  }
+
+  // interleave the timeslices (smooth weighted round robin)
+  std::vector<int64_t> current(num_compute_nodes_, 0);
+  e.assignment.resize(epoch_size_);
+  for (uint32_t slot = 0; slot < epoch_size_; ++slot) {
+    uint32_t best = 0;
+    for (uint32_t i = 0; i < num_compute_nodes_; ++i) {
+      current[i] += static_cast<int64_t>(count[i]);
+      if (current[i] > current[best]) {
+        best = i;
+      }
+    }
+    current[best] -= epoch_size_;
+    e.assignment[slot] = best;
+  }
+}
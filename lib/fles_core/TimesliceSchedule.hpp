@@ -0,0 +1,90 @@
+// Copyright 2026 agent <agent@local>
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <vector>
+
+/// Load-aware assignment of timeslices to compute nodes.
+/** Timeslices are assigned to compute nodes in epochs of a fixed number of
+    timeslices. Within an epoch, every compute node receives at least one
+    timeslice, and the remaining timeslices are distributed in proportion to
+    weights announced by the compute nodes. The assignment depends only on
+    the announced weights, so all input nodes derive the same schedule.
+
+    A compute node announces its weight for epoch e + lookahead as soon as
+    it receives a timeslice of epoch e. The first epochs use equal weights,
+    which results in plain round robin assignment.
+
+    The schedule is used by the TCP, RDMA, and libfabric transports, where
+    the weights travel with the compute nodes' status messages. The ZeroMQ
+    transport, in which compute nodes request timeslices by index, keeps
+    round robin assignment. So does the local transport
+    (TimesliceBuilderLocal): its builders pull the components of their
+    timeslices from input buffers in the same process, without status
+    messages that could carry the weights, and ComponentSenderLocal tracks
+    the progress of each builder as a count of released timeslices, which
+    relies on the fixed assignment. */
+
+class TimesliceSchedule {
+public:
+  /// Maximum weight of a compute node.
+  static constexpr uint32_t max_weight = 16;
+
+  /// The TimesliceSchedule constructor.
+  TimesliceSchedule(uint32_t num_compute_nodes,
+                    uint32_t timeslices_per_node = 8,
+                    uint32_t lookahead = 2);
+
+  /// Retrieve the number of timeslices in an epoch.
+  uint32_t epoch_size() const { return epoch_size_; }
+
+  /// Retrieve the number of epochs announced in advance.
+  uint32_t lookahead() const { return lookahead_; }
+
+  /// Retrieve the epoch of a timeslice.
+  uint64_t epoch(uint64_t timeslice) const { return timeslice / epoch_size_; }
+
+  /// Store the weight announced by a compute node for an epoch.
+  void set_weight(uint32_t compute_node, uint64_t epoch, uint32_t weight);
+
+  /// Check if the assignment of a timeslice is known. Information on
+  /// earlier epochs is discarded, so timeslices have to be queried in
+  /// ascending order.
+  bool ready(uint64_t timeslice);
+
+  /// Retrieve the compute node assigned to a timeslice (requires ready()).
+  uint32_t compute_node(uint64_t timeslice) const;
+
+  /// Calculate the weight a compute node announces, based on the free
+  /// fraction of its buffer and the number of timeslices not yet processed.
+  uint32_t weight(double free_fraction, uint64_t backlog) const;
+
+private:
+  struct Epoch {
+    /// Announced weights (zero if not yet known).
+    std::vector<uint32_t> weights;
+    /// Number of announced weights.
+    uint32_t known = 0;
+    /// Compute node of each timeslice (empty if not yet known).
+    std::vector<uint32_t> assignment;
+  };
+
+  /// Number of compute nodes.
+  const uint32_t num_compute_nodes_;
+
+  /// Number of timeslices in an epoch.
+  const uint32_t epoch_size_;
+
+  /// Number of epochs announced in advance.
+  const uint32_t lookahead_;
+
+  /// Information on the current and future epochs.
+  std::map<uint64_t, Epoch> epochs_;
+
+  /// Retrieve the information on an epoch, creating it if required.
+  Epoch& get_epoch(uint64_t epoch);
+
+  /// Calculate the assignment of an epoch from its weights.
+  void assign(Epoch& e) const;
+};
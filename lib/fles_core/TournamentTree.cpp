@@ -0,0 +1,30 @@
+// Copyright 2026 agent <agent@local>
+
+#include "TournamentTree.hpp"
+#include <algorithm>
+#include <cassert>
+
+TournamentTree::TournamentTree(std::size_t size) : size_(size), leaves_(1) {
+  assert(size_ > 0);
+  while (leaves_ < size_) {
+    leaves_ *= 2;
+  }
+  // padding leaves never win
+  values_.assign(leaves_, UINT64_MAX);
+  std::fill(values_.begin(), values_.begin() + size_, 0);
+  winners_.resize(2 * leaves_);
+  for (std::size_t i = 0; i < leaves_; ++i) {
+    winners_[leaves_ + i] = i;
+  }
+  for (std::size_t node = leaves_ - 1; node > 0; --node) {
+    winners_[node] = match(winners_[2 * node], winners_[2 * node + 1]);
+  }
+}
+
+void TournamentTree::update(std::size_t index, uint64_t value) {
+  assert(index < size_);
+  values_[index] = value;
+  for (std::size_t node = (leaves_ + index) / 2; node > 0; node /= 2) {
+    winners_[node] = match(winners_[2 * node], winners_[2 * node + 1]);
+  }
+}
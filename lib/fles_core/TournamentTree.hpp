@@ -0,0 +1,51 @@
+// Copyright 2026 agent <agent@local>
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// Tournament tree tracking the minimum of a set of values.
+/** Each inner node stores the index of the smaller value of its two
+    children (the lower index on ties), so the root holds the index of the
+    overall minimum. Updating a single value replays the matches on its path
+    to the root in O(log N). */
+
+class TournamentTree {
+public:
+  /// The TournamentTree constructor. All values are initially zero.
+  explicit TournamentTree(std::size_t size);
+
+  /// Set a value and update the tree.
+  void update(std::size_t index, uint64_t value);
+
+  /// Retrieve a value.
+  uint64_t value(std::size_t index) const { return values_[index]; }
+
+  /// Retrieve the index of the minimum value.
+  std::size_t min_index() const { return winners_[1]; }
+
+  /// Retrieve the minimum value.
+  uint64_t min_value() const { return values_[winners_[1]]; }
+
+  /// Retrieve the number of values.
+  std::size_t size() const { return size_; }
+
+private:
+  /// Retrieve the index of the smaller of two values.
+  std::size_t match(std::size_t a, std::size_t b) const {
+    return (values_[b] < values_[a]) ? b : a;
+  }
+
+  /// The number of values.
+  std::size_t size_;
+
+  /// The number of leaves (a power of two).
+  std::size_t leaves_;
+
+  /// The values, padded to the number of leaves.
+  std::vector<uint64_t> values_;
+
+  /// The winner (index of the minimum value) of each subtree.
+  std::vector<std::size_t> winners_;
+};
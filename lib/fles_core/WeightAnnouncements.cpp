@@ -0,0 +1,23 @@
+// Copyright 2026 agent <agent@local>
+
+#include "WeightAnnouncements.hpp"
+#include <cassert>
+
+WeightAnnouncements::WeightAnnouncements(uint32_t capacity_exp,
+                                         uint64_t first_epoch)
+    : weights_(UINT64_C(1) << capacity_exp), end_(first_epoch) {}
+
+void WeightAnnouncements::announce(uint64_t epoch, uint32_t weight) {
+  uint64_t end = end_.load(std::memory_order_relaxed);
+  for (; end <= epoch; ++end) {
+    weights_[end & (weights_.size() - 1)].store(weight,
+                                                std::memory_order_relaxed);
+  }
+  end_.store(end, std::memory_order_release);
+}
+
+uint32_t WeightAnnouncements::weight(uint64_t epoch) const {
+  assert(epoch < end() && end() - epoch <= weights_.size());
+  return weights_[epoch & (weights_.size() - 1)].load(
+      std::memory_order_relaxed);
+}
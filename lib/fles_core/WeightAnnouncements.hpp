@@ -0,0 +1,42 @@
+// Copyright 2026 agent <agent@local>
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+/// Weights announced by a compute node for future timeslice epochs.
+/** A WeightAnnouncements object keeps the weights a compute node has
+    announced for the assignment of timeslices (see TimesliceSchedule) until
+    they have been passed on to the input nodes, one epoch per status
+    message. The builder thread announces the weights, the connections read
+    them, possibly from other threads.
+
+    Only the weights of the most recent epochs are kept, so a connection
+    must not fall behind by more than the capacity. */
+
+class WeightAnnouncements {
+public:
+  /// The WeightAnnouncements constructor. The epochs before first_epoch
+  /// are implicitly announced.
+  WeightAnnouncements(uint32_t capacity_exp, uint64_t first_epoch);
+
+  WeightAnnouncements(const WeightAnnouncements&) = delete;
+  void operator=(const WeightAnnouncements&) = delete;
+
+  /// Announce a weight for all epochs up to and including the given one.
+  void announce(uint64_t epoch, uint32_t weight);
+
+  /// Retrieve the first epoch not yet announced.
+  uint64_t end() const { return end_.load(std::memory_order_acquire); }
+
+  /// Retrieve the weight announced for an epoch (requires epoch < end()).
+  uint32_t weight(uint64_t epoch) const;
+
+private:
+  /// The announced weights, indexed by epoch modulo the capacity.
+  std::vector<std::atomic<uint32_t>> weights_;
+
+  /// The first epoch not yet announced.
+  std::atomic<uint64_t> end_;
+};
@@ -17,6 +17,9 @@ enum class ArchiveType { TimesliceArchive, MicrosliceArchive };
 template <class Base, class Derived, ArchiveType archive_type>
 class InputArchive;
 
+template <class Base, class Derived, ArchiveType archive_type>
+class InputArchivePrefetch;
+
 /**
  * \brief The ArchiveDescriptor class contains metadata on an archive.
  *
@@ -57,6 +60,9 @@ private:
   friend class InputArchive;
   template <class Base, class Derived, ArchiveType archive_type>
   friend class InputArchiveLoop;
+  template <class Base, class Derived, ArchiveType archive_type>
+  friend class InputArchivePrefetch;
+  friend class TimesliceSelectiveInputArchive;
 
   ArchiveDescriptor(){};
 
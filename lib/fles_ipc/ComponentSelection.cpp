@@ -0,0 +1,121 @@
+// Copyright 2026 agent <agent@local>
+
+#include "ComponentSelection.hpp"
+#include "Timeslice.hpp"
+#include <algorithm>
+#include <boost/algorithm/string.hpp>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include <tuple>
+
+namespace fles {
+
+namespace {
+/// Parse a hexadecimal identifier with given maximum value.
+unsigned long parse_id(const std::string& text, unsigned long max) {
+  std::size_t pos = 0;
+  unsigned long value = 0;
+  try {
+    value = std::stoul(text, &pos, 16);
+  } catch (std::logic_error&) {
+    pos = 0;
+  }
+  if (text.empty() || pos != text.size() || value > max) {
+    throw std::invalid_argument("invalid component identifier \"" + text +
+                                "\"");
+  }
+  return value;
+}
+} // namespace
+
+ComponentSelection::ComponentSelection(const std::string& text) {
+  std::vector<std::string> items;
+  boost::split(items, text, boost::is_any_of(","));
+  for (auto& item : items) {
+    boost::trim(item);
+    if (item.empty()) {
+      continue;
+    }
+    std::size_t colon = item.find(':');
+    auto sys_id = static_cast<uint8_t>(parse_id(item.substr(0, colon), 0xff));
+    if (colon == std::string::npos) {
+      add(sys_id);
+    } else {
+      add(sys_id,
+          static_cast<uint16_t>(parse_id(item.substr(colon + 1), 0xffff)));
+    }
+  }
+}
+
+ComponentSelection& ComponentSelection::add(uint8_t sys_id) {
+  entries_.push_back({sys_id, true, 0});
+  return *this;
+}
+
+ComponentSelection& ComponentSelection::add(uint8_t sys_id, uint16_t eq_id) {
+  entries_.push_back({sys_id, false, eq_id});
+  return *this;
+}
+
+bool ComponentSelection::operator()(const MicrosliceDescriptor& desc) const {
+  if (entries_.empty()) {
+    return true;
+  }
+  for (const auto& entry : entries_) {
+    if (entry.sys_id == desc.sys_id &&
+        (entry.all_eq_ids || entry.eq_id == desc.eq_id)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+ComponentPredicate ComponentSelection::predicate() const {
+  if (all()) {
+    return ComponentPredicate();
+  }
+  return *this;
+}
+
+std::string ComponentSelection::to_string() const {
+  std::vector<Entry> entries = entries_;
+  auto key = [](const Entry& e) {
+    return std::make_tuple(e.sys_id, !e.all_eq_ids, e.eq_id);
+  };
+  std::sort(entries.begin(), entries.end(),
+            [&](const Entry& a, const Entry& b) { return key(a) < key(b); });
+  entries.erase(std::unique(entries.begin(), entries.end(),
+                            [&](const Entry& a, const Entry& b) {
+                              return key(a) == key(b);
+                            }),
+                entries.end());
+
+  std::ostringstream s;
+  s << std::hex << std::setfill('0');
+  for (std::size_t i = 0; i < entries.size(); ++i) {
+    if (i > 0) {
+      s << ",";
+    }
+    s << std::setw(2) << static_cast<unsigned int>(entries[i].sys_id);
+    if (!entries[i].all_eq_ids) {
+      s << ":" << std::setw(4) << entries[i].eq_id;
+    }
+  }
+  return s.str();
+}
+
+std::vector<uint64_t> select_components(const Timeslice& timeslice,
+                                        const ComponentPredicate& predicate) {
+  std::vector<uint64_t> components;
+  components.reserve(timeslice.num_components());
+  for (uint64_t c = 0; c < timeslice.num_components(); ++c) {
+    if (!predicate || (timeslice.num_microslices(c) > 0 &&
+                       predicate(timeslice.descriptor(c, 0)))) {
+      components.push_back(c);
+    }
+  }
+  return components;
+}
+
+} // namespace fles
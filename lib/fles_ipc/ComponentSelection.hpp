@@ -0,0 +1,77 @@
+// Copyright 2026 agent <agent@local>
+/// \file
+/// \brief Defines the fles::ComponentSelection class.
+#pragma once
+
+#include "MicrosliceDescriptor.hpp"
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace fles {
+
+class Timeslice;
+
+/**
+ * \brief Predicate to select a timeslice component, evaluated on the
+ * descriptor of its first microslice.
+ *
+ * An empty predicate selects all components.
+ */
+using ComponentPredicate = std::function<bool(const MicrosliceDescriptor&)>;
+
+/**
+ * \brief The ComponentSelection class selects timeslice components by
+ * subsystem and equipment identifier.
+ *
+ * A component is identified by the sys_id and eq_id fields of its first
+ * microslice descriptor. An empty selection selects all components, otherwise
+ * components without microslices are never selected.
+ *
+ * The text form is a comma-separated list of hexadecimal "sys_id" or
+ * "sys_id:eq_id" entries, e.g., "10,40:e001".
+ */
+class ComponentSelection {
+public:
+  /// Construct an empty selection (selects all components).
+  ComponentSelection() = default;
+
+  /// Construct a selection from its text form.
+  /** Throws std::invalid_argument on syntax errors. */
+  explicit ComponentSelection(const std::string& text);
+
+  /// Select all components of a subsystem.
+  ComponentSelection& add(uint8_t sys_id);
+
+  /// Select the components of a single equipment of a subsystem.
+  ComponentSelection& add(uint8_t sys_id, uint16_t eq_id);
+
+  /// Check whether all components are selected.
+  bool all() const { return entries_.empty(); }
+
+  /// Check whether the component with given first microslice is selected.
+  bool operator()(const MicrosliceDescriptor& desc) const;
+
+  /// Retrieve the selection as a predicate (empty if all are selected).
+  ComponentPredicate predicate() const;
+
+  /// Retrieve the canonical text form of the selection.
+  std::string to_string() const;
+
+private:
+  struct Entry {
+    uint8_t sys_id;
+    bool all_eq_ids;
+    uint16_t eq_id;
+  };
+
+  std::vector<Entry> entries_;
+};
+
+/// Retrieve the indices of the components of a timeslice selected by a
+/// predicate.
+std::vector<uint64_t> select_components(const Timeslice& timeslice,
+                                        const ComponentPredicate& predicate);
+
+} // namespace fles
@@ -6,6 +6,7 @@
 #include "ArchiveDescriptor.hpp"
 #include "Source.hpp"
 #include <boost/archive/binary_iarchive.hpp>
+#include <chrono>
 #include <fstream>
 #include <memory>
 #include <string>
@@ -79,6 +80,13 @@ private:
     return sts;
   }
 
+  // reading from a file never waits for external input
+  Derived* do_try_get() override { return do_get(); }
+
+  Derived* do_get_for(std::chrono::nanoseconds /* timeout */) override {
+    return do_get();
+  }
+
   std::unique_ptr<std::ifstream> ifstream_;
   std::unique_ptr<boost::archive::binary_iarchive> iarchive_;
   ArchiveDescriptor descriptor_;
@@ -0,0 +1,389 @@
+// Copyright 2026 agent <agent@local>
+/// \file
+/// \brief Defines the fles::InputArchivePrefetch template class.
+#pragma once
+
+#include "ArchiveDescriptor.hpp"
+#include "ItemSize.hpp"
+#include "Source.hpp"
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/iostreams/categories.hpp>
+#include <boost/iostreams/stream.hpp>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <fcntl.h>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+
+namespace fles {
+
+/**
+ * \brief The InputArchivePrefetch class deserializes data sets from an input
+ * file in a background thread.
+ *
+ * Up to a configurable number of items (and, optionally, bytes) are read ahead
+ * of the consumer and kept in a bounded queue, so that file I/O and
+ * deserialization overlap with processing. The kernel is advised of the
+ * sequential access pattern. Each object reads a single file; several objects
+ * can be used side by side to ingest multiple files in parallel.
+ */
+template <class Base, class Derived, ArchiveType archive_type>
+class InputArchivePrefetch : public Source<Base> {
+public:
+  /**
+   * \brief Construct an input archive object, open the given archive file for
+   * reading, read the archive descriptor, and start the reader thread.
+   *
+   * \param filename  File name of the archive file
+   * \param cycles    Number of times to loop over the archive file
+   * \param max_items Maximum number of items to read ahead
+   * \param max_bytes Maximum size of items to read ahead (0: unlimited)
+   */
+  InputArchivePrefetch(const std::string& filename,
+                       uint64_t cycles = 1,
+                       size_t max_items = 16,
+                       size_t max_bytes = 0)
+      : filename_(filename), cycles_(cycles),
+        max_items_(max_items > 0 ? max_items : 1), max_bytes_(max_bytes) {
+    try {
+      init();
+    } catch (...) {
+      close_file();
+      throw;
+    }
+    reader_ = std::thread(&InputArchivePrefetch::read_ahead, this);
+  }
+
+  /// Delete copy constructor (non-copyable).
+  InputArchivePrefetch(const InputArchivePrefetch&) = delete;
+  /// Delete assignment operator (non-copyable).
+  void operator=(const InputArchivePrefetch&) = delete;
+
+  ~InputArchivePrefetch() override {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    space_available_.notify_all();
+    reader_.join();
+    close_file();
+  }
+
+  /// Read the next data set.
+  std::unique_ptr<Derived> get() { return std::unique_ptr<Derived>(do_get()); };
+
+  /// Retrieve the archive descriptor.
+  const ArchiveDescriptor& descriptor() const { return descriptor_; };
+
+  bool eos() const override { return eos_; }
+
+  /// Retrieve the number of times the consumer had to wait for the reader.
+  uint64_t consumer_waits() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return consumer_waits_;
+  }
+
+  /// Retrieve the number of times the reader had to wait for the consumer.
+  uint64_t reader_waits() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return reader_waits_;
+  }
+
+private:
+  /// Minimal boost::iostreams source device on a POSIX file descriptor.
+  class FileSource {
+  public:
+    using char_type = char;
+    using category = boost::iostreams::source_tag;
+
+    explicit FileSource(InputArchivePrefetch* owner) : owner_(owner) {}
+
+    std::streamsize read(char* s, std::streamsize n) {
+      return owner_->read_file(s, n);
+    }
+
+  private:
+    InputArchivePrefetch* owner_;
+  };
+
+  using FileStream = boost::iostreams::stream<FileSource>;
+
+  struct Item {
+    std::unique_ptr<Derived> item;
+    size_t bytes;
+  };
+
+  /// Size of the stream buffer between file and deserializer.
+  static constexpr std::streamsize buffer_size = 1 << 20;
+  /// Size of the file region to advise the kernel to read ahead.
+  static constexpr uint64_t advise_size = 64 << 20;
+
+  void close_file() {
+    iarchive_ = nullptr;
+    stream_ = nullptr;
+    if (fd_ >= 0) {
+      ::close(fd_);
+      fd_ = -1;
+    }
+  }
+
+  void init() {
+    close_file();
+
+    fd_ = ::open(filename_.c_str(), O_RDONLY);
+    if (fd_ < 0) {
+      throw std::ios_base::failure("error opening file \"" + filename_ + "\"");
+    }
+    offset_ = 0;
+    advised_ = 0;
+    ::posix_fadvise(fd_, 0, 0, POSIX_FADV_SEQUENTIAL);
+    advise();
+
+    stream_ =
+        std::unique_ptr<FileStream>(new FileStream(FileSource(this), buffer_size));
+    iarchive_ = std::unique_ptr<boost::archive::binary_iarchive>(
+        new boost::archive::binary_iarchive(*stream_));
+
+    // The consumer may access descriptor_ once the reader thread is running
+    ArchiveDescriptor descriptor;
+    *iarchive_ >> descriptor;
+
+    if (descriptor.archive_type() != archive_type) {
+      throw std::runtime_error("File \"" + filename_ +
+                               "\" is not of correct archive type");
+    }
+
+    if (cycle_ == 0) {
+      descriptor_ = descriptor;
+    }
+    ++cycle_;
+    archive_has_data_ = false;
+  }
+
+  /// Keep the kernel reading ahead of the current file position.
+  void advise() {
+    if (advised_ < offset_ + advise_size / 2) {
+      ::posix_fadvise(fd_, static_cast<off_t>(advised_),
+                      static_cast<off_t>(advise_size), POSIX_FADV_WILLNEED);
+      advised_ = offset_ + advise_size;
+    }
+  }
+
+  std::streamsize read_file(char* s, std::streamsize n) {
+    advise();
+    ssize_t len;
+    do {
+      len = ::read(fd_, s, static_cast<size_t>(n));
+    } while (len < 0 && errno == EINTR);
+    if (len < 0) {
+      throw std::ios_base::failure("error reading file \"" + filename_ +
+                                   "\": " + std::strerror(errno));
+    }
+    if (len == 0) {
+      return -1;
+    }
+    offset_ += static_cast<uint64_t>(len);
+    return len;
+  }
+
+  /// Deserialize the next data set from the file (reader thread).
+  Derived* read_item() {
+    while (true) {
+      std::unique_ptr<Derived> sts(new Derived());
+      try {
+        *iarchive_ >> *sts;
+        archive_has_data_ = true;
+        return sts.release();
+      } catch (boost::archive::archive_exception& e) {
+        if (e.code == boost::archive::archive_exception::input_stream_error) {
+          if (archive_has_data_ && cycle_ < cycles_) {
+            init();
+            continue;
+          }
+          return nullptr;
+        }
+        throw;
+      }
+    }
+  }
+
+  /// The reader thread main function.
+  void read_ahead() {
+    try {
+      while (true) {
+        std::unique_ptr<Derived> sts(read_item());
+        if (!sts) {
+          break;
+        }
+        size_t bytes = item_size(*sts);
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (!has_space(bytes)) {
+          ++reader_waits_;
+          space_available_.wait(lock,
+                                [&] { return stop_ || has_space(bytes); });
+        }
+        if (stop_) {
+          return;
+        }
+        queue_.push_back({std::move(sts), bytes});
+        queued_bytes_ += bytes;
+        lock.unlock();
+        item_available_.notify_one();
+      }
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      exception_ = std::current_exception();
+    }
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      finished_ = true;
+    }
+    item_available_.notify_one();
+  }
+
+  bool has_space(size_t bytes) const {
+    if (queue_.empty()) {
+      return true;
+    }
+    if (queue_.size() >= max_items_) {
+      return false;
+    }
+    return max_bytes_ == 0 || queued_bytes_ + bytes <= max_bytes_;
+  }
+
+  /// Take the first item from the queue, or detect the end of the stream.
+  /** Called with mutex_ held, after the queue has been filled or finished. */
+  Derived* pop_front() {
+    if (queue_.empty()) {
+      eos_ = true;
+      if (exception_) {
+        std::rethrow_exception(std::move(exception_));
+      }
+      return nullptr;
+    }
+
+    Item item = std::move(queue_.front());
+    queue_.pop_front();
+    queued_bytes_ -= item.bytes;
+    return item.item.release();
+  }
+
+  /// Wait for the reader thread to provide an item. Called with mutex_ held.
+  void wait_for_item(std::unique_lock<std::mutex>& lock) {
+    if (queue_.empty() && !finished_) {
+      ++consumer_waits_;
+      item_available_.wait(lock, [&] { return !queue_.empty() || finished_; });
+    }
+  }
+
+  Derived* do_get() override {
+    if (eos_) {
+      return nullptr;
+    }
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    wait_for_item(lock);
+    Derived* item = pop_front();
+    lock.unlock();
+    space_available_.notify_one();
+    return item;
+  }
+
+  Derived* do_try_get() override {
+    if (eos_) {
+      return nullptr;
+    }
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (queue_.empty() && !finished_) {
+      return nullptr;
+    }
+    Derived* item = pop_front();
+    lock.unlock();
+    space_available_.notify_one();
+    return item;
+  }
+
+  Derived* do_get_for(std::chrono::nanoseconds timeout) override {
+    if (eos_) {
+      return nullptr;
+    }
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (queue_.empty() && !finished_) {
+      ++consumer_waits_;
+      if (!item_available_.wait_for(
+              lock, timeout, [&] { return !queue_.empty() || finished_; })) {
+        return nullptr;
+      }
+    }
+    Derived* item = pop_front();
+    lock.unlock();
+    space_available_.notify_one();
+    return item;
+  }
+
+  void do_get_batch(std::vector<std::unique_ptr<Base>>& items,
+                    std::size_t max_items) override {
+    if (eos_) {
+      return;
+    }
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    wait_for_item(lock);
+    do {
+      Derived* item = pop_front();
+      if (item == nullptr) {
+        break;
+      }
+      items.emplace_back(item);
+    } while (items.size() < max_items && !queue_.empty());
+    lock.unlock();
+    space_available_.notify_one();
+  }
+
+  std::string filename_;
+  uint64_t cycles_;
+  size_t max_items_;
+  size_t max_bytes_;
+
+  // State owned by the reader thread after construction
+  int fd_ = -1;
+  uint64_t offset_ = 0;
+  uint64_t advised_ = 0;
+  std::unique_ptr<FileStream> stream_;
+  std::unique_ptr<boost::archive::binary_iarchive> iarchive_;
+  ArchiveDescriptor descriptor_;
+  uint64_t cycle_ = 0;
+  bool archive_has_data_ = false;
+
+  // State shared between reader thread and consumer
+  mutable std::mutex mutex_;
+  std::condition_variable item_available_;
+  std::condition_variable space_available_;
+  std::deque<Item> queue_;
+  size_t queued_bytes_ = 0;
+  bool finished_ = false;
+  bool stop_ = false;
+  std::exception_ptr exception_;
+  uint64_t consumer_waits_ = 0;
+  uint64_t reader_waits_ = 0;
+
+  std::thread reader_;
+
+  bool eos_ = false;
+};
+
+} // namespace fles
@@ -0,0 +1,424 @@
+// Copyright 2026 agent <agent@local>
+/// \file
+/// \brief Defines the fles::InputArchiveSequence template class.
+#pragma once
+
+#include "ArchiveDescriptor.hpp"
+#include "InputArchive.hpp"
+#include "ItemSize.hpp"
+#include "Source.hpp"
+#include <algorithm>
+#include <boost/algorithm/string.hpp>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <fstream>
+#include <glob.h>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace fles {
+
+/**
+ * \brief The InputArchiveSequence class deserializes data sets from a sequence
+ * of input files, e.g., as written by OutputArchiveSequence.
+ *
+ * Several files are read concurrently in background threads. The data sets are
+ * either merged in index order or passed on in order of arrival. For the
+ * ordered merge, a data set must not have a smaller index than any data set in
+ * a file more than parallel_files positions earlier in the sequence. This
+ * holds for sequences written by a single OutputArchiveSequence and for
+ * sequences written by up to parallel_files interleaved writers.
+ */
+template <class Base, class Derived, ArchiveType archive_type>
+class InputArchiveSequence : public Source<Base> {
+public:
+  /**
+   * \brief Construct an input archive sequence object, find the matching
+   * archive files, read the archive descriptor of the first file, and start
+   * the reader threads.
+   *
+   * The filename template either contains the placeholder "%n", which is
+   * replaced by consecutive sequence numbers starting at zero, or is a shell
+   * wildcard pattern, which is expanded in lexicographical order.
+   *
+   * \param filename_template File name pattern of the archive files
+   * \param cycles            Number of times to loop over the file sequence
+   * \param parallel_files    Number of files to read concurrently
+   * \param ordered           Merge data sets in index order
+   * \param items_per_file    Maximum number of items to read ahead per file
+   * \param bytes_per_file    Maximum size of items to read ahead per file
+   *                          (0: unlimited)
+   */
+  InputArchiveSequence(const std::string& filename_template,
+                       uint64_t cycles = 1,
+                       std::size_t parallel_files = 4,
+                       bool ordered = true,
+                       std::size_t items_per_file = 16,
+                       std::size_t bytes_per_file = 0)
+      : filenames_(find_files(filename_template)),
+        cycles_(std::max<uint64_t>(cycles, 1)),
+        parallel_files_(std::max<std::size_t>(parallel_files, 1)),
+        ordered_(ordered),
+        items_per_file_(std::max<std::size_t>(items_per_file, 1)),
+        bytes_per_file_(bytes_per_file),
+        descriptor_(read_descriptor(filenames_.front())),
+        end_(filenames_.size() * cycles_), slots_(parallel_files_) {
+    for (std::size_t i = 0; i < std::min(parallel_files_, end_); ++i) {
+      readers_.emplace_back(&InputArchiveSequence::read_files, this);
+    }
+  }
+
+  /// Delete copy constructor (non-copyable).
+  InputArchiveSequence(const InputArchiveSequence&) = delete;
+  /// Delete assignment operator (non-copyable).
+  void operator=(const InputArchiveSequence&) = delete;
+
+  ~InputArchiveSequence() override {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    space_available_.notify_all();
+    for (auto& reader : readers_) {
+      reader.join();
+    }
+  }
+
+  /// Read the next data set.
+  std::unique_ptr<Derived> get() { return std::unique_ptr<Derived>(do_get()); };
+
+  /// Retrieve the archive descriptor of the first file.
+  const ArchiveDescriptor& descriptor() const { return descriptor_; };
+
+  /// Retrieve the names of the files in the sequence.
+  const std::vector<std::string>& filenames() const { return filenames_; }
+
+  bool eos() const override { return eos_; }
+
+  /// Retrieve the number of times the consumer had to wait for the readers.
+  uint64_t consumer_waits() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return consumer_waits_;
+  }
+
+  /// Retrieve the number of times a reader had to wait for the consumer.
+  uint64_t reader_waits() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return reader_waits_;
+  }
+
+private:
+  /// Read-ahead queue of a single file in the sequence.
+  struct Slot {
+    std::deque<std::unique_ptr<Derived>> items;
+    std::size_t bytes = 0;
+    bool done = false;
+
+    /// Check if an item of the given size may be read ahead.
+    bool has_space(std::size_t size,
+                   std::size_t max_items,
+                   std::size_t max_bytes) const {
+      if (items.empty()) {
+        return true;
+      }
+      return items.size() < max_items &&
+             (max_bytes == 0 || bytes + size <= max_bytes);
+    }
+  };
+
+  static std::vector<std::string> find_files(const std::string& pattern) {
+    std::vector<std::string> files;
+    if (pattern.find("%n") != std::string::npos) {
+      for (std::size_t n = 0;; ++n) {
+        std::ostringstream number;
+        number << std::setw(4) << std::setfill('0') << n;
+        std::string name = boost::replace_all_copy(pattern, "%n", number.str());
+        if (!std::ifstream(name.c_str())) {
+          break;
+        }
+        files.push_back(name);
+      }
+    } else {
+      glob_t result;
+      if (::glob(pattern.c_str(), 0, nullptr, &result) == 0) {
+        files.assign(result.gl_pathv, result.gl_pathv + result.gl_pathc);
+      }
+      ::globfree(&result);
+    }
+    if (files.empty()) {
+      throw std::ios_base::failure("no files matching \"" + pattern + "\"");
+    }
+    return files;
+  }
+
+  static ArchiveDescriptor read_descriptor(const std::string& filename) {
+    InputArchive<Base, Derived, archive_type> archive(filename);
+    return archive.descriptor();
+  }
+
+  /// Retrieve the index of a timeslice.
+  template <class T>
+  static auto item_index(const T& item, int) -> decltype(item.index()) {
+    return item.index();
+  }
+
+  /// Retrieve the index of a microslice.
+  template <class T> static uint64_t item_index(const T& item, long) {
+    return item.desc().idx;
+  }
+
+  /// Retrieve the slot of a sequence position.
+  Slot& slot_at(std::size_t pos) { return slots_[pos % parallel_files_]; }
+  const Slot& slot_at(std::size_t pos) const {
+    return slots_[pos % parallel_files_];
+  }
+
+  /// Sort key of the first data set in a slot (cycle, index).
+  std::pair<std::size_t, uint64_t> key(std::size_t slot) const {
+    return {slot / filenames_.size(),
+            item_index(*slot_at(slot).items.front(), 0)};
+  }
+
+  /// The reader thread main function.
+  void read_files() {
+    try {
+      while (true) {
+        std::size_t slot;
+        {
+          std::unique_lock<std::mutex> lock(mutex_);
+          space_available_.wait(lock, [&] {
+            return stop_ || next_slot_ == end_ ||
+                   next_slot_ < first_slot_ + parallel_files_;
+          });
+          if (stop_ || next_slot_ == end_) {
+            return;
+          }
+          slot = next_slot_++;
+        }
+
+        InputArchive<Base, Derived, archive_type> archive(
+            filenames_[slot % filenames_.size()]);
+        while (auto item = archive.get()) {
+          std::size_t bytes = item_size(*item);
+          std::unique_lock<std::mutex> lock(mutex_);
+          Slot& s = slot_at(slot);
+          if (!s.has_space(bytes, items_per_file_, bytes_per_file_)) {
+            ++reader_waits_;
+            space_available_.wait(lock, [&] {
+              return stop_ ||
+                     s.has_space(bytes, items_per_file_, bytes_per_file_);
+            });
+          }
+          if (stop_) {
+            return;
+          }
+          s.items.push_back(std::move(item));
+          s.bytes += bytes;
+          lock.unlock();
+          item_available_.notify_one();
+        }
+
+        {
+          std::lock_guard<std::mutex> lock(mutex_);
+          slot_at(slot).done = true;
+        }
+        item_available_.notify_one();
+      }
+    } catch (...) {
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        exception_ = std::current_exception();
+      }
+      item_available_.notify_one();
+    }
+  }
+
+  /// Skip completely consumed files. Called with mutex_ held.
+  void advance() {
+    std::size_t first_slot = first_slot_;
+    while (first_slot_ < end_ && slot_at(first_slot_).done &&
+           slot_at(first_slot_).items.empty()) {
+      // prepare the slot for the file parallel_files_ positions later
+      slot_at(first_slot_).done = false;
+      ++first_slot_;
+    }
+    if (first_slot_ != first_slot) {
+      space_available_.notify_all();
+    }
+  }
+
+  /// Find the slot to take the next data set from. Called with mutex_ held.
+  /** \return slot index, or end_ if none is available yet */
+  std::size_t select() const {
+    std::size_t end = std::min(first_slot_ + parallel_files_, end_);
+    std::size_t best = end_;
+    for (std::size_t s = first_slot_; s < end; ++s) {
+      if (slot_at(s).items.empty()) {
+        if (ordered_ && !slot_at(s).done) {
+          return end_;
+        }
+      } else if (!ordered_) {
+        return s;
+      } else if (best == end_ || key(s) < key(best)) {
+        best = s;
+      }
+    }
+    return best;
+  }
+
+  /// Find the slot to take the next data set from, or detect the end of the
+  /// stream. Called with mutex_ held.
+  /** \return slot index, or end_ if none is available (yet) */
+  std::size_t next_slot() {
+    advance();
+    if (exception_) {
+      eos_ = true;
+      std::rethrow_exception(exception_);
+    }
+    if (first_slot_ == end_) {
+      eos_ = true;
+      return end_;
+    }
+    return select();
+  }
+
+  /// Wait for the next data set to become available. Called with mutex_ held.
+  /** \return slot index, or end_ at the end of the stream */
+  std::size_t wait_for_slot(std::unique_lock<std::mutex>& lock) {
+    bool waited = false;
+    std::size_t slot;
+    while ((slot = next_slot()) == end_ && !eos_) {
+      if (!waited) {
+        ++consumer_waits_;
+        waited = true;
+      }
+      item_available_.wait(lock);
+    }
+    return slot;
+  }
+
+  /// Take the first data set from a slot. Called with mutex_ held.
+  Derived* take(std::size_t slot) {
+    Slot& s = slot_at(slot);
+    std::unique_ptr<Derived> item = std::move(s.items.front());
+    s.items.pop_front();
+    s.bytes -= item_size(*item);
+    advance();
+    return item.release();
+  }
+
+  Derived* do_get() override {
+    if (eos_) {
+      return nullptr;
+    }
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    std::size_t slot = wait_for_slot(lock);
+    if (slot == end_) {
+      return nullptr;
+    }
+    Derived* item = take(slot);
+    lock.unlock();
+    space_available_.notify_all();
+    return item;
+  }
+
+  Derived* do_try_get() override {
+    if (eos_) {
+      return nullptr;
+    }
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    std::size_t slot = next_slot();
+    if (slot == end_) {
+      return nullptr;
+    }
+    Derived* item = take(slot);
+    lock.unlock();
+    space_available_.notify_all();
+    return item;
+  }
+
+  Derived* do_get_for(std::chrono::nanoseconds timeout) override {
+    if (eos_) {
+      return nullptr;
+    }
+
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    std::unique_lock<std::mutex> lock(mutex_);
+    std::size_t slot;
+    while ((slot = next_slot()) == end_ && !eos_) {
+      if (item_available_.wait_until(lock, deadline) ==
+          std::cv_status::timeout) {
+        slot = next_slot();
+        break;
+      }
+    }
+    if (slot == end_) {
+      return nullptr;
+    }
+    Derived* item = take(slot);
+    lock.unlock();
+    space_available_.notify_all();
+    return item;
+  }
+
+  void do_get_batch(std::vector<std::unique_ptr<Base>>& items,
+                    std::size_t max_items) override {
+    if (eos_) {
+      return;
+    }
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    std::size_t slot = wait_for_slot(lock);
+    while (slot != end_) {
+      items.emplace_back(take(slot));
+      if (items.size() == max_items) {
+        break;
+      }
+      slot = next_slot();
+    }
+    lock.unlock();
+    space_available_.notify_all();
+  }
+
+  const std::vector<std::string> filenames_;
+  const uint64_t cycles_;
+  const std::size_t parallel_files_;
+  const bool ordered_;
+  const std::size_t items_per_file_;
+  const std::size_t bytes_per_file_;
+  const ArchiveDescriptor descriptor_;
+  /// Number of sequence positions (files times cycles).
+  const std::size_t end_;
+
+  mutable std::mutex mutex_;
+  std::condition_variable item_available_;
+  std::condition_variable space_available_;
+  /// Slots of the files currently read, indexed by sequence position modulo
+  /// parallel_files_.
+  std::vector<Slot> slots_;
+  /// First slot not yet completely consumed.
+  std::size_t first_slot_ = 0;
+  /// Next slot to be read by a reader thread.
+  std::size_t next_slot_ = 0;
+  bool stop_ = false;
+  std::exception_ptr exception_;
+  uint64_t consumer_waits_ = 0;
+  uint64_t reader_waits_ = 0;
+
+  std::vector<std::thread> readers_;
+
+  bool eos_ = false;
+};
+
+} // namespace fles
@@ -0,0 +1,26 @@
+// Copyright 2026 agent <agent@local>
+/// \file
+/// \brief Defines the fles::item_size functions.
+#pragma once
+
+#include "Microslice.hpp"
+#include "Timeslice.hpp"
+#include <cstddef>
+
+namespace fles {
+
+/// Retrieve the size (in bytes) of the data of a timeslice.
+inline std::size_t item_size(const Timeslice& ts) {
+  std::size_t size = sizeof(TimesliceDescriptor);
+  for (uint64_t c = 0; c < ts.num_components(); ++c) {
+    size += sizeof(TimesliceComponentDescriptor) + ts.component_size(c);
+  }
+  return size;
+}
+
+/// Retrieve the size (in bytes) of the data of a microslice.
+inline std::size_t item_size(const Microslice& ms) {
+  return sizeof(MicrosliceDescriptor) + ms.desc().size;
+}
+
+} // namespace fles
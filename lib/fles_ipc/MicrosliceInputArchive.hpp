@@ -6,6 +6,8 @@
 #include "ArchiveDescriptor.hpp"
 #include "InputArchive.hpp"
 #include "InputArchiveLoop.hpp"
+#include "InputArchivePrefetch.hpp"
+#include "InputArchiveSequence.hpp"
 
 namespace fles {
 
@@ -25,4 +27,14 @@ using MicrosliceInputArchiveLoop =
                      StorableMicroslice,
                      ArchiveType::MicrosliceArchive>;
 
+using MicrosliceInputArchivePrefetch =
+    InputArchivePrefetch<Microslice,
+                         StorableMicroslice,
+                         ArchiveType::MicrosliceArchive>;
+
+using MicrosliceInputArchiveSequence =
+    InputArchiveSequence<Microslice,
+                         StorableMicroslice,
+                         ArchiveType::MicrosliceArchive>;
+
 } // namespace fles
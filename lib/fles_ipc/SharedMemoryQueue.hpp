@@ -0,0 +1,347 @@
+// Copyright 2026 agent <agent@local>
+/// \file
+/// \brief Defines the fles::SharedMemoryQueue template class.
+#pragma once
+
+#include <atomic>
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/interprocess/shared_memory_object.hpp>
+#include <chrono>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <linux/futex.h>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace fles {
+
+/**
+ * \brief The SharedMemoryQueue class implements a bounded lock-free
+ * multi-producer multi-consumer queue in a named shared memory segment.
+ *
+ * Producers and consumers in any process attached to the segment exchange
+ * items of the trivially copyable type T without locking. Blocking operations
+ * spin shortly and then sleep on a futex in the shared segment. Wakeup system
+ * calls are only issued if a peer is actually sleeping, so a busy queue is
+ * operated entirely in user space.
+ *
+ * The end of the stream is signaled by closing the queue. Consumers receive
+ * all items pushed before close() and then see the end of the stream.
+ */
+template <class T> class SharedMemoryQueue {
+  static_assert(ATOMIC_LLONG_LOCK_FREE == 2,
+                "64-bit atomics have to be lock-free in shared memory");
+
+public:
+  /**
+   * \brief Create a new queue in a shared memory segment of the given name.
+   *
+   * \param name     Name of the shared memory segment
+   * \param capacity Minimum number of items the queue can hold
+   */
+  SharedMemoryQueue(boost::interprocess::create_only_t /* tag */,
+                    const std::string& name,
+                    std::size_t capacity) {
+    std::size_t size = 1;
+    while (size < capacity) {
+      size <<= 1;
+    }
+    shm_ = std::unique_ptr<boost::interprocess::shared_memory_object>(
+        new boost::interprocess::shared_memory_object(
+            boost::interprocess::create_only, name.c_str(),
+            boost::interprocess::read_write));
+    shm_->truncate(
+        static_cast<boost::interprocess::offset_t>(segment_size(size)));
+    map();
+
+    header_ = new (region_->get_address()) Header();
+    cells_ = reinterpret_cast<Cell*>(header_ + 1);
+    for (std::size_t i = 0; i < size; ++i) {
+      new (&cells_[i]) Cell();
+      cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    mask_ = size - 1;
+    header_->item_size = sizeof(T);
+    header_->capacity = size;
+    header_->magic.store(magic_value, std::memory_order_release);
+  }
+
+  /// Attach to an existing queue in the shared memory segment of given name.
+  SharedMemoryQueue(boost::interprocess::open_only_t /* tag */,
+                    const std::string& name) {
+    shm_ = std::unique_ptr<boost::interprocess::shared_memory_object>(
+        new boost::interprocess::shared_memory_object(
+            boost::interprocess::open_only, name.c_str(),
+            boost::interprocess::read_write));
+    map();
+
+    header_ = static_cast<Header*>(region_->get_address());
+    if (region_->get_size() < sizeof(Header) ||
+        header_->magic.load(std::memory_order_acquire) != magic_value ||
+        header_->item_size != sizeof(T) ||
+        region_->get_size() < segment_size(header_->capacity)) {
+      throw std::runtime_error("shared memory \"" + name +
+                               "\" does not contain a matching queue");
+    }
+    cells_ = reinterpret_cast<Cell*>(header_ + 1);
+    mask_ = header_->capacity - 1;
+  }
+
+  /// Delete copy constructor (non-copyable).
+  SharedMemoryQueue(const SharedMemoryQueue&) = delete;
+  /// Delete assignment operator (non-copyable).
+  void operator=(const SharedMemoryQueue&) = delete;
+
+  /// Remove the shared memory segment of the given name.
+  static bool remove(const std::string& name) {
+    return boost::interprocess::shared_memory_object::remove(name.c_str());
+  }
+
+  /// Append an item to the queue, blocking while the queue is full.
+  void push(const T& item) {
+    for (unsigned int spins = 0; !try_push(item); ++spins) {
+      if (spins >= spin_limit) {
+        wait(header_->space_futex, header_->space_waiters,
+             [this] { return size() < capacity(); });
+      }
+    }
+  }
+
+  /// Append an item to the queue if there is space.
+  /** \return true if the item has been appended */
+  bool try_push(const T& item) {
+    uint64_t pos = header_->enqueue_pos.load(std::memory_order_relaxed);
+    while (true) {
+      Cell& cell = cells_[pos & mask_];
+      uint64_t seq = cell.sequence.load(std::memory_order_acquire);
+      int64_t diff = static_cast<int64_t>(seq - pos);
+      if (diff == 0) {
+        if (header_->enqueue_pos.compare_exchange_weak(
+                pos, pos + 1, std::memory_order_relaxed)) {
+          cell.item = item;
+          cell.sequence.store(pos + 1, std::memory_order_release);
+          notify(header_->items_futex, header_->item_waiters);
+          return true;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = header_->enqueue_pos.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  /**
+   * \brief Remove the first item from the queue, blocking while the queue is
+   * empty.
+   *
+   * \return true if an item has been received, false at the end of the stream
+   */
+  bool pop(T& item) {
+    for (unsigned int spins = 0; !try_pop(item); ++spins) {
+      if (is_closed()) {
+        // items pushed before close() are visible now
+        return try_pop(item);
+      }
+      if (spins >= spin_limit) {
+        wait(header_->items_futex, header_->item_waiters,
+             [this] { return size() > 0 || is_closed(); });
+      }
+    }
+    return true;
+  }
+
+  /**
+   * \brief Remove the first item from the queue, waiting at most for the
+   * given duration while the queue is empty.
+   *
+   * \return true if an item has been received, false on timeout or at the end
+   * of the stream
+   */
+  bool pop_for(T& item, std::chrono::nanoseconds timeout) {
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    for (unsigned int spins = 0; !try_pop(item); ++spins) {
+      if (is_closed()) {
+        return try_pop(item);
+      }
+      if (spins >= spin_limit) {
+        auto now = std::chrono::steady_clock::now();
+        if (now >= deadline) {
+          return false;
+        }
+        wait(header_->items_futex, header_->item_waiters,
+             [this] { return size() > 0 || is_closed(); }, deadline - now);
+      }
+    }
+    return true;
+  }
+
+  /// Remove the first item from the queue if there is one.
+  /** \return true if an item has been received */
+  bool try_pop(T& item) { return try_pop_batch(&item, 1) == 1; }
+
+  /**
+   * \brief Remove up to max_items items from the queue without blocking.
+   *
+   * The items are claimed with a single atomic operation.
+   *
+   * \return the number of items received
+   */
+  std::size_t try_pop_batch(T* items, std::size_t max_items) {
+    if (max_items == 0) {
+      return 0;
+    }
+    uint64_t pos = header_->dequeue_pos.load(std::memory_order_relaxed);
+    while (true) {
+      std::size_t count = 0;
+      while (count < max_items && count <= mask_ &&
+             cells_[(pos + count) & mask_].sequence.load(
+                 std::memory_order_acquire) == pos + count + 1) {
+        ++count;
+      }
+      if (count == 0) {
+        uint64_t seq =
+            cells_[pos & mask_].sequence.load(std::memory_order_acquire);
+        if (static_cast<int64_t>(seq - (pos + 1)) < 0) {
+          return 0;
+        }
+        pos = header_->dequeue_pos.load(std::memory_order_relaxed);
+        continue;
+      }
+      if (header_->dequeue_pos.compare_exchange_weak(
+              pos, pos + count, std::memory_order_relaxed)) {
+        for (std::size_t i = 0; i < count; ++i) {
+          Cell& cell = cells_[(pos + i) & mask_];
+          items[i] = cell.item;
+          cell.sequence.store(pos + i + mask_ + 1, std::memory_order_release);
+        }
+        notify(header_->space_futex, header_->space_waiters);
+        return count;
+      }
+    }
+  }
+
+  /// Signal the end of the stream to all consumers.
+  void close() {
+    header_->closed.store(1, std::memory_order_seq_cst);
+    wake(header_->items_futex);
+    wake(header_->space_futex);
+  }
+
+  /// Check whether the queue has been closed.
+  bool is_closed() const {
+    return header_->closed.load(std::memory_order_acquire) != 0;
+  }
+
+  /// Retrieve the (approximate) number of items in the queue.
+  std::size_t size() const {
+    uint64_t dequeue_pos = header_->dequeue_pos.load();
+    uint64_t enqueue_pos = header_->enqueue_pos.load();
+    return enqueue_pos > dequeue_pos
+               ? static_cast<std::size_t>(enqueue_pos - dequeue_pos)
+               : 0;
+  }
+
+  /// Retrieve the maximum number of items in the queue.
+  std::size_t capacity() const { return mask_ + 1; }
+
+private:
+  static constexpr uint64_t magic_value = UINT64_C(0x3151454d4853454c);
+  /// Number of unsuccessful attempts before going to sleep.
+  static constexpr unsigned int spin_limit = 256;
+
+  struct Header {
+    std::atomic<uint64_t> magic{0};
+    uint64_t item_size = 0;
+    uint64_t capacity = 0;
+    alignas(64) std::atomic<uint64_t> enqueue_pos{0};
+    alignas(64) std::atomic<uint64_t> dequeue_pos{0};
+    alignas(64) std::atomic<uint32_t> items_futex{0};
+    std::atomic<uint32_t> item_waiters{0};
+    std::atomic<uint32_t> space_futex{0};
+    std::atomic<uint32_t> space_waiters{0};
+    std::atomic<uint32_t> closed{0};
+  };
+
+  struct Cell {
+    std::atomic<uint64_t> sequence{0};
+    T item;
+  };
+
+  static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t),
+                "futex word has to be a plain 32-bit integer");
+
+  static std::size_t segment_size(std::size_t capacity) {
+    return sizeof(Header) + capacity * sizeof(Cell);
+  }
+
+  void map() {
+    region_ = std::unique_ptr<boost::interprocess::mapped_region>(
+        new boost::interprocess::mapped_region(
+            *shm_, boost::interprocess::read_write));
+  }
+
+  static void wake(std::atomic<uint32_t>& futex) {
+    futex.fetch_add(1);
+    ::syscall(SYS_futex, reinterpret_cast<uint32_t*>(&futex), FUTEX_WAKE,
+              INT_MAX, nullptr, nullptr, 0);
+  }
+
+  /// Wake sleeping peers, if any.
+  static void notify(std::atomic<uint32_t>& futex,
+                     std::atomic<uint32_t>& waiters) {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (waiters.load(std::memory_order_relaxed) != 0) {
+      wake(futex);
+    }
+  }
+
+  /// Sleep until notified, unless the condition is already met.
+  template <class Predicate>
+  static void wait(std::atomic<uint32_t>& futex,
+                   std::atomic<uint32_t>& waiters,
+                   Predicate ready) {
+    wait(futex, waiters, ready, nullptr);
+  }
+
+  /// Sleep until notified or timed out, unless the condition is already met.
+  template <class Predicate>
+  static void wait(std::atomic<uint32_t>& futex,
+                   std::atomic<uint32_t>& waiters,
+                   Predicate ready,
+                   std::chrono::nanoseconds timeout) {
+    const auto seconds =
+        std::chrono::duration_cast<std::chrono::seconds>(timeout);
+    timespec ts{static_cast<time_t>(seconds.count()),
+                static_cast<long>((timeout - seconds).count())};
+    wait(futex, waiters, ready, &ts);
+  }
+
+  template <class Predicate>
+  static void wait(std::atomic<uint32_t>& futex,
+                   std::atomic<uint32_t>& waiters,
+                   Predicate ready,
+                   const timespec* timeout) {
+    waiters.fetch_add(1);
+    uint32_t value = futex.load();
+    if (!ready()) {
+      ::syscall(SYS_futex, reinterpret_cast<uint32_t*>(&futex), FUTEX_WAIT,
+                value, timeout, nullptr, 0);
+    }
+    waiters.fetch_sub(1);
+  }
+
+  std::unique_ptr<boost::interprocess::shared_memory_object> shm_;
+  std::unique_ptr<boost::interprocess::mapped_region> region_;
+  Header* header_ = nullptr;
+  Cell* cells_ = nullptr;
+  std::size_t mask_ = 0;
+};
+
+} // namespace fles
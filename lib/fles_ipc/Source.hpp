@@ -3,7 +3,10 @@
 /// \brief Defines the fles::Source template class.
 #pragma once
 
+#include <chrono>
+#include <cstddef>
 #include <memory>
+#include <vector>
 
 namespace fles {
 
@@ -12,6 +15,11 @@ namespace fles {
  *
  * This class is an abstract base class for several classes using an item-based
  * input interface.
+ *
+ * Besides the blocking get(), items can be retrieved without blocking, with a
+ * timeout, or in batches. Every source implements the non-blocking and timed
+ * variants; sources that never have to wait for external input (e.g., plain
+ * archive files) may implement them using get().
  */
 template <class T> class Source {
 public:
@@ -24,12 +32,66 @@ public:
    */
   std::unique_ptr<T> get() { return std::unique_ptr<T>(do_get()); };
 
+  /**
+   * \brief Retrieve the next item if it is available without waiting.
+   *
+   * \return pointer to the item, or nullptr if no item is available or
+   * end-of-file (cf. eos())
+   */
+  std::unique_ptr<T> try_get() { return std::unique_ptr<T>(do_try_get()); };
+
+  /**
+   * \brief Retrieve the next item, waiting at most for the given duration.
+   *
+   * \return pointer to the item, or nullptr on timeout or end-of-file (cf.
+   * eos())
+   */
+  template <class Rep, class Period>
+  std::unique_ptr<T>
+  get_for(const std::chrono::duration<Rep, Period>& timeout) {
+    return std::unique_ptr<T>(do_get_for(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(timeout)));
+  }
+
+  /**
+   * \brief Retrieve a batch of items.
+   *
+   * This function blocks until at least one item is available and then
+   * returns all items available without further waiting, up to max_items.
+   *
+   * \return vector of items, empty if end-of-file
+   */
+  std::vector<std::unique_ptr<T>> get_batch(std::size_t max_items) {
+    std::vector<std::unique_ptr<T>> items;
+    if (max_items > 0) {
+      items.reserve(max_items);
+      do_get_batch(items, max_items);
+    }
+    return items;
+  };
+
   virtual bool eos() const = 0;
 
   virtual ~Source() = default;
 
 private:
   virtual T* do_get() = 0;
+
+  virtual T* do_try_get() = 0;
+
+  virtual T* do_get_for(std::chrono::nanoseconds timeout) = 0;
+
+  virtual void do_get_batch(std::vector<std::unique_ptr<T>>& items,
+                            std::size_t max_items) {
+    T* item = do_get();
+    while (item != nullptr) {
+      items.emplace_back(item);
+      if (items.size() == max_items) {
+        break;
+      }
+      item = do_try_get();
+    }
+  }
 };
 
 } // namespace fles
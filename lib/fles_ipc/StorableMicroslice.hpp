@@ -80,6 +80,9 @@ private:
   friend class InputArchiveLoop<Microslice,
                                 StorableMicroslice,
                                 ArchiveType::MicrosliceArchive>;
+  friend class InputArchivePrefetch<Microslice,
+                                    StorableMicroslice,
+                                    ArchiveType::MicrosliceArchive>;
 
   StorableMicroslice();
 
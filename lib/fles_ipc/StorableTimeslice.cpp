@@ -5,13 +5,15 @@
 namespace fles {
 
 StorableTimeslice::StorableTimeslice(const StorableTimeslice& ts)
-    : Timeslice(ts), data_(ts.data_), desc_(ts.desc_) {
+    : Timeslice(ts), data_(ts.data_), desc_(ts.desc_), buffer_(ts.buffer_),
+      offsets_(ts.offsets_) {
   init_pointers();
 }
 
 StorableTimeslice::StorableTimeslice(StorableTimeslice&& ts) noexcept
     : Timeslice(std::move(ts)), data_(std::move(ts.data_)),
-      desc_(std::move(ts.desc_)) {
+      desc_(std::move(ts.desc_)), buffer_(std::move(ts.buffer_)),
+      offsets_(std::move(ts.offsets_)) {
   init_pointers();
 }
 
@@ -6,11 +6,15 @@
 #include "ArchiveDescriptor.hpp"
 #include "StorableMicroslice.hpp"
 #include "Timeslice.hpp"
+#include "TimesliceComponentData.hpp"
+#include <cstddef>
 #include <cstdint>
 #include <fstream>
+#include <utility>
 #include <vector>
 
 #include <boost/serialization/access.hpp>
+#include <boost/serialization/split_member.hpp>
 #include <boost/serialization/vector.hpp>
 // Note: <fstream> has to precede boost/serialization includes for non-obvious
 // reasons to avoid segfault similar to
@@ -25,6 +29,10 @@ class InputArchiveLoop;
 
 /**
  * \brief The StorableTimeslice class contains the data of a single timeslice.
+ *
+ * The components are stored in separate buffers, or, if created by a
+ * StorableTimesliceBuilder, in a single contiguous buffer located through an
+ * offset table. The serialized form does not depend on the storage.
  */
 class StorableTimeslice : public Timeslice {
 public:
@@ -51,6 +59,7 @@ public:
   /// Append a single component to fill using append_microslice.
   uint32_t append_component(uint64_t num_microslices,
                             uint64_t /* dummy */ = 0) {
+    split_buffer();
     TimesliceComponentDescriptor ts_desc = TimesliceComponentDescriptor();
     ts_desc.ts_num = timeslice_descriptor_.index;
     ts_desc.offset = 0;
@@ -79,6 +88,7 @@ public:
                              MicrosliceDescriptor descriptor,
                              const uint8_t* content) {
     assert(component < timeslice_descriptor_.num_components);
+    split_buffer();
     std::vector<uint8_t>& this_data = data_[component];
     TimesliceComponentDescriptor& this_desc = desc_[component];
 
@@ -119,30 +129,94 @@ private:
   friend class InputArchiveLoop<Timeslice,
                                 StorableTimeslice,
                                 ArchiveType::TimesliceArchive>;
+  friend class InputArchivePrefetch<Timeslice,
+                                    StorableTimeslice,
+                                    ArchiveType::TimesliceArchive>;
   friend class TimesliceSubscriber;
+  friend class TimesliceSelectiveInputArchive;
+  friend class TimesliceTap;
+  friend class StorableTimesliceBuilder;
 
   StorableTimeslice();
 
+  /// Construct from complete timeslice contents.
+  StorableTimeslice(const TimesliceDescriptor& timeslice_descriptor,
+                    std::vector<std::vector<uint8_t>> data,
+                    std::vector<TimesliceComponentDescriptor> desc)
+      : data_(std::move(data)), desc_(std::move(desc)) {
+    timeslice_descriptor_ = timeslice_descriptor;
+    init_pointers();
+  }
+
+  /// Construct by adopting a contiguous buffer holding all components at
+  /// the given offsets.
+  StorableTimeslice(const TimesliceDescriptor& timeslice_descriptor,
+                    std::vector<uint8_t> buffer,
+                    std::vector<std::size_t> offsets,
+                    std::vector<TimesliceComponentDescriptor> desc)
+      : desc_(std::move(desc)), buffer_(std::move(buffer)),
+        offsets_(std::move(offsets)) {
+    timeslice_descriptor_ = timeslice_descriptor;
+    init_pointers();
+  }
+
+  template <class Archive>
+  void save(Archive& ar, const unsigned int /* version */) const {
+    // written like the member vectors, independent of the storage
+    ar << timeslice_descriptor_;
+    const TimesliceComponentDataList data{data_ptr_, desc_ptr_};
+    ar << data;
+    const TimesliceComponentDescriptorList desc{desc_ptr_};
+    ar << desc;
+  }
+
   template <class Archive>
-  void serialize(Archive& ar, const unsigned int /* version */) {
-    ar& timeslice_descriptor_;
-    ar& data_;
-    ar& desc_;
+  void load(Archive& ar, const unsigned int /* version */) {
+    ar >> timeslice_descriptor_;
+    ar >> data_;
+    ar >> desc_;
+    buffer_.clear();
+    offsets_.clear();
 
     init_pointers();
   }
 
+  BOOST_SERIALIZATION_SPLIT_MEMBER()
+
+  /// Copy the components from the contiguous buffer to separate buffers
+  /// before modifying them.
+  void split_buffer() {
+    if (offsets_.empty()) {
+      return;
+    }
+    data_.resize(num_components());
+    for (size_t c = 0; c < num_components(); ++c) {
+      const uint8_t* begin = buffer_.data() + offsets_[c];
+      data_[c].assign(begin, begin + desc_[c].size);
+    }
+    buffer_.clear();
+    offsets_.clear();
+    init_pointers();
+  }
+
   void init_pointers() {
+    invalidate_index();
     data_ptr_.resize(num_components());
     desc_ptr_.resize(num_components());
     for (size_t c = 0; c < num_components(); ++c) {
       desc_ptr_[c] = &desc_[c];
-      data_ptr_[c] = data_[c].data();
+      data_ptr_[c] = offsets_.empty() ? data_[c].data()
+                                      : buffer_.data() + offsets_[c];
     }
   }
 
   std::vector<std::vector<uint8_t>> data_;
   std::vector<TimesliceComponentDescriptor> desc_;
+
+  /// Contiguous buffer holding all components (if created by a builder)
+  std::vector<uint8_t> buffer_;
+  /// Offsets of the components in the contiguous buffer
+  std::vector<std::size_t> offsets_;
 };
 
 } // namespace fles
@@ -0,0 +1,119 @@
+// Copyright 2026 agent <agent@local>
+
+#include "StorableTimesliceBuilder.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <utility>
+
+namespace fles {
+
+StorableTimesliceBuilder::StorableTimesliceBuilder(
+    uint32_t num_core_microslices,
+    uint64_t index,
+    uint64_t ts_pos,
+    std::size_t capacity) {
+  timeslice_descriptor_.index = index;
+  timeslice_descriptor_.ts_pos = ts_pos;
+  timeslice_descriptor_.num_core_microslices = num_core_microslices;
+  timeslice_descriptor_.num_components = 0;
+  buffer_.reserve(capacity);
+}
+
+uint32_t StorableTimesliceBuilder::append_component(uint64_t num_microslices,
+                                                    uint64_t content_capacity) {
+  std::size_t desc_size = num_microslices * sizeof(MicrosliceDescriptor);
+
+  Component c;
+  c.offset = buffer_.size();
+  c.capacity = desc_size + content_capacity;
+  c.desc.ts_num = timeslice_descriptor_.index;
+  c.desc.offset = 0;
+  c.desc.size = desc_size;
+  c.desc.num_microslices = num_microslices;
+
+  // microslice descriptors are zero-initialized as in StorableTimeslice
+  buffer_.resize(c.offset + c.capacity);
+  std::memset(buffer_.data() + c.offset, 0, desc_size);
+
+  components_.push_back(c);
+  return timeslice_descriptor_.num_components++;
+}
+
+void StorableTimesliceBuilder::make_space(Component& c, std::size_t bytes) {
+  std::size_t required = c.desc.size + bytes;
+  if (required <= c.capacity) {
+    return;
+  }
+  std::size_t capacity = std::max(required, 2 * c.capacity);
+
+  if (c.offset + c.capacity == buffer_.size()) {
+    // last component in buffer: grow in place
+    buffer_.resize(c.offset + capacity);
+  } else {
+    // move component to the end, leaving a gap
+    std::size_t offset = buffer_.size();
+    buffer_.resize(offset + capacity);
+    std::memcpy(buffer_.data() + offset, buffer_.data() + c.offset, c.desc.size);
+    c.offset = offset;
+  }
+  c.capacity = capacity;
+}
+
+uint64_t StorableTimesliceBuilder::append_microslice(
+    uint32_t component,
+    uint64_t microslice,
+    MicrosliceDescriptor descriptor,
+    const uint8_t* content) {
+  assert(component < timeslice_descriptor_.num_components);
+  Component& c = components_[component];
+  assert(microslice < c.desc.num_microslices);
+
+  make_space(c, descriptor.size);
+  uint8_t* data = buffer_.data() + c.offset;
+
+  // set offset relative to first microslice
+  if (microslice > 0) {
+    uint64_t offset =
+        c.desc.size - c.desc.num_microslices * sizeof(MicrosliceDescriptor);
+    uint64_t first_offset = reinterpret_cast<MicrosliceDescriptor*>(data)->offset;
+    descriptor.offset = offset + first_offset;
+  }
+
+  std::memcpy(data + microslice * sizeof(MicrosliceDescriptor), &descriptor,
+              sizeof(MicrosliceDescriptor));
+  if (descriptor.size > 0) {
+    std::memcpy(data + c.desc.size, content, descriptor.size);
+  }
+  c.desc.size += descriptor.size;
+
+  return microslice;
+}
+
+uint64_t StorableTimesliceBuilder::size() const {
+  uint64_t size = 0;
+  for (auto& c : components_) {
+    size += c.desc.size;
+  }
+  return size;
+}
+
+StorableTimeslice StorableTimesliceBuilder::finalize() {
+  std::vector<std::size_t> offsets(components_.size());
+  std::vector<TimesliceComponentDescriptor> desc(components_.size());
+  for (std::size_t i = 0; i < components_.size(); ++i) {
+    offsets[i] = components_[i].offset;
+    desc[i] = components_[i].desc;
+  }
+
+  // the timeslice adopts the buffer, the data is not copied
+  StorableTimeslice ts(timeslice_descriptor_, std::move(buffer_),
+                       std::move(offsets), std::move(desc));
+
+  timeslice_descriptor_.num_components = 0;
+  components_.clear();
+  buffer_.clear();
+  return ts;
+}
+
+} // namespace fles
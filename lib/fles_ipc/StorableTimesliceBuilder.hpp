@@ -0,0 +1,112 @@
+// Copyright 2026 agent <agent@local>
+/// \file
+/// \brief Defines the fles::StorableTimesliceBuilder class.
+#pragma once
+
+#include "Microslice.hpp"
+#include "MicrosliceDescriptor.hpp"
+#include "StorableTimeslice.hpp"
+#include "TimesliceComponentDescriptor.hpp"
+#include "TimesliceDescriptor.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace fles {
+
+/**
+ * \brief The StorableTimesliceBuilder class assembles a StorableTimeslice
+ * from individual microslices.
+ *
+ * All components are laid out in a single contiguous buffer, located through
+ * an offset table. Given sufficient capacity hints, no reallocation takes
+ * place while appending. A component that outgrows its capacity is moved to
+ * the end of the buffer. finalize() hands the buffer and the offset table over
+ * to the resulting StorableTimeslice without copying the data. The result is
+ * identical to a StorableTimeslice built using append_component() and
+ * append_microslice().
+ */
+class StorableTimesliceBuilder {
+public:
+  /**
+   * \brief Construct an empty timeslice builder.
+   *
+   * \param num_core_microslices Number of core microslices
+   * \param index                Global index of the timeslice
+   * \param ts_pos               Start offset (in items) of the timeslice
+   * \param capacity             Expected total size (in bytes) of all
+   *                             components, including microslice descriptors
+   */
+  explicit StorableTimesliceBuilder(uint32_t num_core_microslices,
+                                    uint64_t index = UINT64_MAX,
+                                    uint64_t ts_pos = UINT64_MAX,
+                                    std::size_t capacity = 0);
+
+  /// Delete copy constructor (non-copyable).
+  StorableTimesliceBuilder(const StorableTimesliceBuilder&) = delete;
+  /// Delete assignment operator (non-copyable).
+  void operator=(const StorableTimesliceBuilder&) = delete;
+
+  /// Reserve buffer space for a total of given number of bytes.
+  void reserve(std::size_t capacity) { buffer_.reserve(capacity); }
+
+  /**
+   * \brief Append a single component to fill using append_microslice.
+   *
+   * \param num_microslices  Number of microslices in the component
+   * \param content_capacity Expected size (in bytes) of the microslice
+   *                         contents of the component
+   * \return index of the new component
+   */
+  uint32_t append_component(uint64_t num_microslices,
+                            uint64_t content_capacity = 0);
+
+  /// Append a single microslice using given descriptor and content.
+  uint64_t append_microslice(uint32_t component,
+                             uint64_t microslice,
+                             MicrosliceDescriptor descriptor,
+                             const uint8_t* content);
+
+  /// Append a single microslice object.
+  uint64_t append_microslice(uint32_t component,
+                             uint64_t microslice,
+                             const Microslice& m) {
+    return append_microslice(component, microslice, m.desc(), m.content());
+  }
+
+  /// Retrieve the number of components.
+  uint32_t num_components() const { return timeslice_descriptor_.num_components; }
+
+  /// Retrieve the total size (in bytes) of all components.
+  uint64_t size() const;
+
+  /**
+   * \brief Create the timeslice.
+   *
+   * The builder is empty afterwards.
+   */
+  StorableTimeslice finalize();
+
+private:
+  /// Location and fill state of a component in the buffer.
+  struct Component {
+    /// Offset (in bytes) of the component in the buffer
+    std::size_t offset;
+    /// Space (in bytes) reserved for the component in the buffer
+    std::size_t capacity;
+    /// Timeslice component descriptor, size is the used space
+    TimesliceComponentDescriptor desc;
+  };
+
+  /// Ensure space for given number of additional bytes in a component.
+  void make_space(Component& c, std::size_t bytes);
+
+  TimesliceDescriptor timeslice_descriptor_ = TimesliceDescriptor();
+
+  /// Offset table
+  std::vector<Component> components_;
+
+  /// Contiguous buffer holding the data of all components
+  std::vector<uint8_t> buffer_;
+};
+
+} // namespace fles
@@ -7,7 +7,9 @@
 #include "MicrosliceView.hpp"
 #include "TimesliceComponentDescriptor.hpp"
 #include "TimesliceDescriptor.hpp"
+#include "TimesliceIndex.hpp"
 #include <fstream>
+#include <memory>
 #include <vector>
 
 #include <boost/serialization/access.hpp>
@@ -40,6 +42,18 @@ public:
     return desc_ptr_[component]->num_microslices;
   }
 
+  /// Check whether a component is absent (partial timeslice). Also true for
+  /// a component delivered without microslices.
+  bool absent(uint64_t component) const {
+    return desc_ptr_[component]->absent();
+  }
+
+  /// Retrieve the size (in bytes) of the data of a component, including the
+  /// microslice descriptors.
+  uint64_t component_size(uint64_t component) const {
+    return desc_ptr_[component]->size;
+  }
+
   /// Retrieve the number of components (contributing input channels).
   uint64_t num_components() const {
     return timeslice_descriptor_.num_components;
@@ -80,10 +94,40 @@ public:
     return MicrosliceView(dd, cc);
   }
 
+  /**
+   * \brief Retrieve the index of the microslices by start time.
+   *
+   * The index is built on first use and kept with the timeslice. This function
+   * must not be called concurrently for the same timeslice object.
+   */
+  const TimesliceIndex& microslice_index() const {
+    if (!index_) {
+      index_.reset(new TimesliceIndex(*this));
+    }
+    return *index_;
+  }
+
 protected:
   Timeslice(){};
 
+  /// Copy constructor (does not copy the microslice index).
+  Timeslice(const Timeslice& other)
+      : timeslice_descriptor_(other.timeslice_descriptor_),
+        data_ptr_(other.data_ptr_), desc_ptr_(other.desc_ptr_) {}
+
+  /// Move constructor (does not move the microslice index).
+  Timeslice(Timeslice&& other) noexcept
+      : timeslice_descriptor_(other.timeslice_descriptor_),
+        data_ptr_(std::move(other.data_ptr_)),
+        desc_ptr_(std::move(other.desc_ptr_)) {}
+
+  /// Discard the microslice index after the timeslice data has changed.
+  void invalidate_index() { index_.reset(); }
+
   friend class StorableTimeslice;
+  friend class TimesliceMultipartView;
+  friend class TimesliceProjection;
+  friend class TimesliceSerializer;
 
   /// The timeslice descriptor.
   TimesliceDescriptor timeslice_descriptor_;
@@ -94,6 +138,10 @@ protected:
   /// \brief A vector of pointers to the microslice descriptors, one per
   /// timeslice component.
   std::vector<TimesliceComponentDescriptor*> desc_ptr_;
+
+private:
+  /// The microslice index, built on first use.
+  mutable std::unique_ptr<TimesliceIndex> index_;
 };
 
 } // namespace fles
@@ -0,0 +1,118 @@
+// Copyright 2026 agent <agent@local>
+/// \file
+/// \brief Defines the structs serializing timeslice component data in the
+/// format of StorableTimeslice.
+#pragma once
+
+#include "TimesliceComponentDescriptor.hpp"
+#include <cstdint>
+#include <vector>
+
+#include <boost/serialization/array_wrapper.hpp>
+#include <boost/serialization/collection_size_type.hpp>
+#include <boost/serialization/item_version_type.hpp>
+#include <boost/serialization/level.hpp>
+#include <boost/serialization/tracking.hpp>
+#include <boost/serialization/vector.hpp>
+#include <boost/serialization/version.hpp>
+
+namespace fles {
+
+/**
+ * \brief The TimesliceComponentData struct serializes the data of a timeslice
+ * component like a std::vector<uint8_t>.
+ */
+struct TimesliceComponentData {
+  const uint8_t* data;
+  uint64_t size;
+
+  template <class Archive>
+  void serialize(Archive& ar, const unsigned int /* version */) {
+    const boost::serialization::collection_size_type count(size);
+    ar << count;
+    if (size > 0) {
+      ar << boost::serialization::make_array<const uint8_t,
+                                             boost::serialization::
+                                                 collection_size_type>(data,
+                                                                       count);
+    }
+  }
+};
+
+/**
+ * \brief The TimesliceComponentDataList struct serializes the data of all
+ * timeslice components like a std::vector<std::vector<uint8_t>>.
+ */
+struct TimesliceComponentDataList {
+  const std::vector<uint8_t*>& data_ptr;
+  const std::vector<TimesliceComponentDescriptor*>& desc_ptr;
+
+  template <class Archive>
+  void serialize(Archive& ar, const unsigned int /* version */) {
+    const boost::serialization::collection_size_type count(data_ptr.size());
+    ar << count;
+    const boost::serialization::item_version_type item_version(
+        boost::serialization::version<std::vector<uint8_t>>::value);
+    ar << item_version;
+    for (std::size_t c = 0; c < data_ptr.size(); ++c) {
+      const TimesliceComponentData data{data_ptr[c], desc_ptr[c]->size};
+      ar << data;
+    }
+  }
+};
+
+/**
+ * \brief The TimesliceComponentDescriptorList struct serializes the
+ * descriptors of all timeslice components like a
+ * std::vector<TimesliceComponentDescriptor>.
+ */
+struct TimesliceComponentDescriptorList {
+  const std::vector<TimesliceComponentDescriptor*>& desc_ptr;
+
+  template <class Archive>
+  void serialize(Archive& ar, const unsigned int /* version */) {
+    const boost::serialization::collection_size_type count(desc_ptr.size());
+    ar << count;
+    const boost::serialization::item_version_type item_version(
+        boost::serialization::version<TimesliceComponentDescriptor>::value);
+    ar << item_version;
+    for (auto desc : desc_ptr) {
+      const TimesliceComponentDescriptor& d = *desc;
+      ar << d;
+    }
+  }
+};
+/// \cond
+using TimesliceComponentDataVector = std::vector<uint8_t>;
+using TimesliceComponentDataListVector = std::vector<std::vector<uint8_t>>;
+using TimesliceComponentDescriptorVector =
+    std::vector<TimesliceComponentDescriptor>;
+/// \endcond
+
+} // namespace fles
+
+// The serialization traits have to match those of the emulated types.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wold-style-cast"
+BOOST_CLASS_IMPLEMENTATION(
+    fles::TimesliceComponentData,
+    boost::serialization::implementation_level<
+        fles::TimesliceComponentDataVector>::value)
+BOOST_CLASS_TRACKING(fles::TimesliceComponentData,
+                     boost::serialization::tracking_level<
+                         fles::TimesliceComponentDataVector>::value)
+BOOST_CLASS_IMPLEMENTATION(
+    fles::TimesliceComponentDataList,
+    boost::serialization::implementation_level<
+        fles::TimesliceComponentDataListVector>::value)
+BOOST_CLASS_TRACKING(fles::TimesliceComponentDataList,
+                     boost::serialization::tracking_level<
+                         fles::TimesliceComponentDataListVector>::value)
+BOOST_CLASS_IMPLEMENTATION(
+    fles::TimesliceComponentDescriptorList,
+    boost::serialization::implementation_level<
+        fles::TimesliceComponentDescriptorVector>::value)
+BOOST_CLASS_TRACKING(fles::TimesliceComponentDescriptorList,
+                     boost::serialization::tracking_level<
+                         fles::TimesliceComponentDescriptorVector>::value)
+#pragma GCC diagnostic pop
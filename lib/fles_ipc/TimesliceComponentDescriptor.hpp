@@ -12,6 +12,12 @@ namespace fles {
 
 /**
  * \brief %Timeslice component descriptor struct.
+ *
+ * A component without microslices is absent, i.e., its input channel did
+ * not deliver it in time and the timeslice is partial. The timeslice
+ * builder emits such a component through an absent marker (see
+ * TimesliceBuffer). A component delivered without any microslices is
+ * reported as absent as well, since it does not contribute data either.
  */
 struct TimesliceComponentDescriptor {
   uint64_t ts_num;          ///< Timeslice index.
@@ -19,6 +25,9 @@ struct TimesliceComponentDescriptor {
   uint64_t size;            ///< Size (in bytes) of corresponding data.
   uint64_t num_microslices; ///< Number of microslices.
 
+  /// Check whether the component is absent, i.e., holds no microslices.
+  bool absent() const { return num_microslices == 0; }
+
   friend class boost::serialization::access;
   /// Provide boost serialization access.
   template <class Archive>
@@ -0,0 +1,35 @@
+// Copyright 2026 agent <agent@local>
+/// \file
+/// \brief Defines the fles::TimesliceComponentEvent struct.
+#pragma once
+
+#include <cstdint>
+
+namespace fles {
+
+#pragma pack(1)
+
+/**
+ * \brief %Timeslice component arrival event struct.
+ *
+ * Announces that a single component of a timeslice has been received,
+ * possibly before the timeslice is complete.
+ */
+struct TimesliceComponentEvent {
+  /// Start offset (in items) of the timeslice
+  uint64_t ts_pos;
+  /// Global index of the timeslice
+  uint64_t ts_num;
+  /// Index of the component (contributing input channel)
+  uint32_t component;
+  /// Number of core microslices
+  uint32_t num_core_microslices;
+  /// Size exponential (in bytes) of each data buffer
+  uint32_t data_buffer_size_exp;
+  /// Size exponential (in bytes) of each descriptor buffer
+  uint32_t desc_buffer_size_exp;
+};
+
+#pragma pack()
+
+} // namespace fles
@@ -0,0 +1,64 @@
+// Copyright 2026 agent <agent@local>
+/// \file
+/// \brief Defines the fles::TimesliceComponentPins class.
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace fles {
+
+/**
+ * \brief Access to the shared state of a timeslice buffer and its component
+ * views.
+ *
+ * The state consists of the acknowledged timeslice position, published by
+ * the timeslice builder, followed by a pin count for each descriptor buffer
+ * slot. A consumer pins the slot of a component before checking that its
+ * timeslice has not yet been acknowledged, and unpins it when the component
+ * view is released. The builder publishes the acknowledged position before
+ * checking the pin counts, and releases the buffer space of a timeslice to
+ * the input nodes only while its slot is not pinned.
+ */
+class TimesliceComponentPins {
+public:
+  /// Retrieve the number of shared entries for a descriptor buffer size.
+  static std::size_t entries(uint32_t desc_buffer_size_exp) {
+    return 1 + (std::size_t(1) << desc_buffer_size_exp);
+  }
+
+  /// Construct from the shared entries.
+  TimesliceComponentPins(std::atomic<uint64_t>* entries,
+                         uint32_t desc_buffer_size_exp)
+      : entries_(entries),
+        mask_((UINT64_C(1) << desc_buffer_size_exp) - 1) {}
+
+  /// Retrieve the acknowledged timeslice position.
+  std::atomic<uint64_t>& acked() { return entries_[0]; }
+
+  /// Retrieve the pin count of the slot of a timeslice position.
+  std::atomic<uint64_t>& count(uint64_t ts_pos) {
+    return entries_[1 + (ts_pos & mask_)];
+  }
+
+  /// Pin the slot of a timeslice position. Fails if the timeslice has
+  /// already been acknowledged.
+  bool pin(uint64_t ts_pos) {
+    count(ts_pos).fetch_add(1);
+    if (acked().load() > ts_pos) {
+      count(ts_pos).fetch_sub(1);
+      return false;
+    }
+    return true;
+  }
+
+private:
+  /// The shared entries.
+  std::atomic<uint64_t>* entries_;
+
+  /// The descriptor buffer slot mask.
+  uint64_t mask_;
+};
+
+} // namespace fles
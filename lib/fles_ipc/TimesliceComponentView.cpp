@@ -0,0 +1,22 @@
+// Copyright 2026 agent <agent@local>
+
+#include "TimesliceComponentView.hpp"
+#include <utility>
+
+namespace fles {
+
+TimesliceComponentView::TimesliceComponentView(
+    const TimesliceComponentEvent& event,
+    uint8_t* data,
+    TimesliceComponentDescriptor* desc,
+    std::shared_ptr<std::atomic<uint64_t>> pin)
+    : component_(event.component), pin_(std::move(pin)) {
+  timeslice_descriptor_ = {event.ts_num, event.ts_pos,
+                           event.num_core_microslices, 1};
+  data_ptr_.push_back(data);
+  desc_ptr_.push_back(desc);
+}
+
+TimesliceComponentView::~TimesliceComponentView() { pin_->fetch_sub(1); }
+
+} // namespace fles
@@ -0,0 +1,50 @@
+// Copyright 2026 agent <agent@local>
+/// \file
+/// \brief Defines the fles::TimesliceComponentView class.
+#pragma once
+
+#include "Timeslice.hpp"
+#include "TimesliceComponentEvent.hpp"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+namespace fles {
+
+/**
+ * \brief The TimesliceComponentView class provides early access to a single
+ * component of a timeslice that may still be incomplete.
+ *
+ * The view is a timeslice with a single component. It pins the buffer
+ * space of the component, which is released to the input nodes only after
+ * both the complete timeslice and all of its component views have been
+ * released (see TimesliceReceiver::try_get_component()).
+ */
+class TimesliceComponentView : public Timeslice {
+public:
+  /// Delete copy constructor (non-copyable).
+  TimesliceComponentView(const TimesliceComponentView&) = delete;
+  /// Delete assignment operator (non-copyable).
+  void operator=(const TimesliceComponentView&) = delete;
+
+  ~TimesliceComponentView() override;
+
+  /// Retrieve the index of the component in the complete timeslice.
+  uint64_t component() const { return component_; }
+
+private:
+  friend class TimesliceReceiver;
+
+  TimesliceComponentView(const TimesliceComponentEvent& event,
+                         uint8_t* data,
+                         TimesliceComponentDescriptor* desc,
+                         std::shared_ptr<std::atomic<uint64_t>> pin);
+
+  /// The index of the component in the complete timeslice.
+  uint64_t component_;
+
+  /// The pin count of the descriptor buffer slot, released on destruction.
+  std::shared_ptr<std::atomic<uint64_t>> pin_;
+};
+
+} // namespace fles
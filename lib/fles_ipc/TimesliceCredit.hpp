@@ -0,0 +1,30 @@
+// Copyright 2026 agent <agent@local>
+/// \file
+/// \brief Defines the fles::TimesliceCredit struct.
+#pragma once
+
+#include <cstdint>
+
+namespace fles {
+
+#pragma pack(1)
+
+/**
+ * \brief %Timeslice distribution credit message struct.
+ *
+ * Sent from a TimesliceWorker to the TimesliceDistributor to request further
+ * timeslices and to acknowledge completely processed ones. Messages skipped
+ * as malformed are acknowledged as well.
+ */
+struct TimesliceCredit {
+  /// Number of additional timeslices the worker is ready to receive
+  uint32_t credits;
+  /// Number of timeslices acknowledged by this message
+  uint32_t acked;
+  /// Index of the most recently completed timeslice
+  uint64_t ts_index;
+};
+
+#pragma pack()
+
+} // namespace fles
@@ -0,0 +1,177 @@
+// Copyright 2026 agent <agent@local>
+
+#include "TimesliceDistributor.hpp"
+#include "TimesliceCredit.hpp"
+#include "TimesliceMultipartView.hpp"
+#include <cerrno>
+#include <utility>
+
+namespace fles {
+
+TimesliceDistributor::TimesliceDistributor(
+    const std::string& address, std::chrono::milliseconds eos_timeout)
+    : eos_timeout_(eos_timeout) {
+  distributor_.setsockopt(ZMQ_ROUTER_MANDATORY, 1);
+  distributor_.bind(address.c_str());
+}
+
+TimesliceDistributor::~TimesliceDistributor() {
+  if (!end_of_stream_) {
+    end_stream();
+  }
+}
+
+void TimesliceDistributor::put(std::shared_ptr<const Timeslice> timeslice) {
+  receive_credits(0);
+
+  while (true) {
+    // select worker with most credits, round-robin among equals
+    auto worker = workers_.end();
+    auto it = workers_.upper_bound(last_worker_);
+    for (std::size_t i = 0; i < workers_.size(); ++i, ++it) {
+      if (it == workers_.end()) {
+        it = workers_.begin();
+      }
+      if (it->second.credits > 0 &&
+          (worker == workers_.end() ||
+           it->second.credits > worker->second.credits)) {
+        worker = it;
+      }
+    }
+
+    if (worker == workers_.end()) {
+      receive_credits(-1);
+      continue;
+    }
+
+    WorkerStatus& status = worker->second;
+    zmq::message_t identity(status.identity.data(), status.identity.size());
+    bool routed = false;
+    try {
+      routed = distributor_.send(identity, ZMQ_SNDMORE);
+    } catch (zmq::error_t& e) {
+      if (e.num() != EHOSTUNREACH) {
+        throw;
+      }
+    }
+    if (!routed) {
+      // keep the statistics to account for the unacknowledged timeslices
+      status.disconnected = true;
+      status.credits = 0;
+      continue;
+    }
+
+    status.bytes += TimesliceMultipartView::send(distributor_, timeslice);
+    --status.credits;
+    ++status.sent;
+    last_worker_ = status.identity;
+    return;
+  }
+}
+
+void TimesliceDistributor::end_stream() {
+  receive_credits(0);
+  for (auto& worker : workers_) {
+    if (!worker.second.disconnected &&
+        !send_end_of_stream(worker.second.identity)) {
+      worker.second.disconnected = true;
+    }
+  }
+  end_of_stream_ = true;
+
+  // collect the final acknowledgements, answering late workers
+  auto deadline = std::chrono::steady_clock::now() + eos_timeout_;
+  while (!all_acked()) {
+    auto now = std::chrono::steady_clock::now();
+    if (now >= deadline) {
+      break;
+    }
+    receive_credits(
+        std::chrono::duration_cast<std::chrono::milliseconds>(deadline - now)
+            .count() +
+        1);
+  }
+}
+
+std::vector<TimesliceDistributor::WorkerStatus>
+TimesliceDistributor::worker_status() const {
+  std::vector<WorkerStatus> status;
+  for (auto& worker : workers_) {
+    status.push_back(worker.second);
+  }
+  return status;
+}
+
+uint64_t TimesliceDistributor::lost() const {
+  uint64_t lost = 0;
+  for (auto& worker : workers_) {
+    if (worker.second.disconnected) {
+      lost += worker.second.unacked();
+    }
+  }
+  return lost;
+}
+
+bool TimesliceDistributor::send_end_of_stream(const std::string& identity) {
+  zmq::message_t identity_frame(identity.data(), identity.size());
+  try {
+    if (distributor_.send(identity_frame, ZMQ_SNDMORE)) {
+      distributor_.send(zmq::message_t());
+      return true;
+    }
+  } catch (zmq::error_t& e) {
+    if (e.num() != EHOSTUNREACH) {
+      throw;
+    }
+  }
+  return false;
+}
+
+bool TimesliceDistributor::all_acked() const {
+  for (auto& worker : workers_) {
+    if (!worker.second.disconnected && worker.second.unacked() > 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void TimesliceDistributor::receive_credits(long timeout_ms) {
+  zmq::pollitem_t item{static_cast<void*>(distributor_), 0, ZMQ_POLLIN, 0};
+  if (zmq::poll(&item, 1, timeout_ms) == 0) {
+    return;
+  }
+
+  zmq::message_t identity;
+  while (distributor_.recv(&identity, ZMQ_DONTWAIT)) {
+    zmq::message_t message;
+    distributor_.recv(&message);
+    while (message.more()) {
+      distributor_.recv(&message);
+    }
+    if (message.size() != sizeof(TimesliceCredit)) {
+      continue;
+    }
+    const auto& credit = *static_cast<const TimesliceCredit*>(message.data());
+
+    auto now = std::chrono::steady_clock::now();
+    std::string id(static_cast<const char*>(identity.data()), identity.size());
+    auto it = workers_.find(id);
+    if (it == workers_.end()) {
+      it = workers_.insert(std::make_pair(id, WorkerStatus())).first;
+      it->second.identity = id;
+      it->second.time_begin = now;
+      if (end_of_stream_) {
+        // late workers would otherwise wait forever
+        send_end_of_stream(id);
+      }
+    }
+    it->second.credits += credit.credits;
+    if (credit.acked > 0) {
+      it->second.acked += credit.acked;
+      it->second.time_last_ack = now;
+    }
+  }
+}
+
+} // namespace fles
@@ -0,0 +1,110 @@
+// Copyright 2026 agent <agent@local>
+/// \file
+/// \brief Defines the fles::TimesliceDistributor class.
+#pragma once
+
+#include "Sink.hpp"
+#include "Timeslice.hpp"
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+#include <zmq.hpp>
+
+namespace fles {
+
+/**
+ * \brief The TimesliceDistributor class distributes timeslice data sets to a
+ * number of connected TimesliceWorker objects via a zeromq socket.
+ *
+ * In contrast to TimeslicePublisher, each timeslice is sent to exactly one
+ * worker. Workers request timeslices using credits and return a credit with
+ * each acknowledged timeslice, so that slower workers receive fewer
+ * timeslices. If no worker has credits left, put() blocks.
+ *
+ * After signaling end-of-stream, the distributor waits up to a given timeout
+ * for the outstanding acknowledgements. Workers connecting during this time
+ * receive the end-of-stream message immediately. Timeslices sent to a worker
+ * that disconnects before acknowledging them are counted as lost.
+ */
+class TimesliceDistributor : public TimesliceSink {
+public:
+  /// Per-worker distribution statistics.
+  struct WorkerStatus {
+    /// Identity of the worker connection
+    std::string identity;
+    /// Number of timeslices sent to the worker
+    uint64_t sent = 0;
+    /// Number of timeslices acknowledged by the worker
+    uint64_t acked = 0;
+    /// Number of data bytes sent to the worker
+    uint64_t bytes = 0;
+    /// Number of timeslices the worker is currently ready to receive
+    uint64_t credits = 0;
+    /// Flag indicating that the worker has disconnected
+    bool disconnected = false;
+    /// Time of the first message from the worker
+    std::chrono::steady_clock::time_point time_begin;
+    /// Time of the most recent acknowledgement from the worker
+    std::chrono::steady_clock::time_point time_last_ack;
+
+    /// Retrieve the number of timeslices sent but not acknowledged.
+    uint64_t unacked() const { return sent > acked ? sent - acked : 0; }
+
+    /// Retrieve the acknowledged timeslice rate in Hz.
+    double rate() const {
+      std::chrono::duration<double> d = time_last_ack - time_begin;
+      return d.count() > 0 ? static_cast<double>(acked) / d.count() : 0.0;
+    }
+  };
+
+  /// Construct timeslice distributor sending at given ZMQ address.
+  explicit TimesliceDistributor(
+      const std::string& address,
+      std::chrono::milliseconds eos_timeout = std::chrono::seconds(1));
+
+  /// Delete copy constructor (non-copyable).
+  TimesliceDistributor(const TimesliceDistributor&) = delete;
+  /// Delete assignment operator (non-copyable).
+  void operator=(const TimesliceDistributor&) = delete;
+
+  ~TimesliceDistributor() override;
+
+  /// Send a timeslice to one of the connected workers.
+  void put(std::shared_ptr<const fles::Timeslice> timeslice) override;
+
+  /// Signal end-of-stream to all known workers.
+  void end_stream() override;
+
+  /// Retrieve the distribution statistics of all known workers.
+  std::vector<WorkerStatus> worker_status() const;
+
+  /// Retrieve the number of timeslices lost on disconnected workers.
+  uint64_t lost() const;
+
+private:
+  /// Process credit messages from workers, blocking up to given timeout.
+  void receive_credits(long timeout_ms);
+
+  /// Send the end-of-stream message to a worker.
+  /** \return false if the worker has disconnected */
+  bool send_end_of_stream(const std::string& identity);
+
+  /// Check if all connected workers have acknowledged their timeslices.
+  bool all_acked() const;
+
+  zmq::context_t context_{1};
+  zmq::socket_t distributor_{context_, ZMQ_ROUTER};
+
+  /// Known workers by connection identity.
+  std::map<std::string, WorkerStatus> workers_;
+  /// Worker that received the most recent timeslice.
+  std::string last_worker_;
+  /// Maximum time to wait for acknowledgements at end-of-stream.
+  std::chrono::milliseconds eos_timeout_;
+
+  bool end_of_stream_ = false;
+};
+
+} // namespace fles
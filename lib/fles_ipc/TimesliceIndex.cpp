@@ -0,0 +1,133 @@
+// Copyright 2026 agent <agent@local>
+
+#include "TimesliceIndex.hpp"
+#include "Timeslice.hpp"
+#include <algorithm>
+#include <numeric>
+
+namespace fles {
+
+namespace {
+/// Hint the processor to fetch data that is accessed soon.
+inline void prefetch(const void* address) {
+#if defined(__GNUC__)
+  __builtin_prefetch(address);
+#else
+  (void)address;
+#endif
+}
+} // namespace
+
+TimesliceIndex::TimesliceIndex(const Timeslice& timeslice) {
+  const uint64_t num_components = timeslice.num_components();
+  offsets_.reserve(num_components + 1);
+  offsets_.push_back(0);
+  for (uint64_t c = 0; c < num_components; ++c) {
+    offsets_.push_back(offsets_.back() + timeslice.num_microslices(c));
+  }
+  const std::size_t total = offsets_.back();
+  idx_.resize(total);
+  microslice_.resize(total);
+  size_.resize(total);
+  content_.resize(total);
+  desc_.resize(total);
+
+  std::vector<uint64_t> order;
+  for (uint64_t c = 0; c < num_components; ++c) {
+    const uint64_t n = timeslice.num_microslices(c);
+    if (n == 0) {
+      continue;
+    }
+    const auto* descs = &timeslice.descriptor(c, 0);
+    const uint8_t* content = timeslice.content(c, 0);
+
+    // microslices are usually stored in time order already
+    order.resize(n);
+    std::iota(order.begin(), order.end(), 0);
+    bool sorted = true;
+    for (uint64_t m = 1; m < n && sorted; ++m) {
+      sorted = descs[m - 1].idx <= descs[m].idx;
+    }
+    if (!sorted) {
+      std::stable_sort(order.begin(), order.end(),
+                       [descs](uint64_t a, uint64_t b) {
+                         return descs[a].idx < descs[b].idx;
+                       });
+    }
+
+    std::size_t pos = offsets_[c];
+    for (uint64_t m : order) {
+      const MicrosliceDescriptor& desc = descs[m];
+      idx_[pos] = desc.idx;
+      microslice_[pos] = m;
+      size_[pos] = desc.size;
+      content_[pos] = content + (desc.offset - descs[0].offset);
+      desc_[pos] = &desc;
+      ++pos;
+    }
+  }
+}
+
+std::pair<uint64_t, uint64_t>
+TimesliceIndex::find(uint64_t component, uint64_t t0, uint64_t t1) const {
+  const uint64_t* begin = idx_.data() + offsets_[component];
+  const uint64_t* end = idx_.data() + offsets_[component + 1];
+  const uint64_t* first = std::lower_bound(begin, end, t0);
+  const uint64_t* last = t1 > t0 ? std::lower_bound(first, end, t1) : first;
+  return {static_cast<uint64_t>(first - begin),
+          static_cast<uint64_t>(last - begin)};
+}
+
+TimesliceIndex::MergedRange TimesliceIndex::window(uint64_t t0,
+                                                   uint64_t t1) const {
+  std::vector<MergedIterator::Cursor> cursors;
+  cursors.reserve(num_components());
+  for (uint64_t c = 0; c < num_components(); ++c) {
+    auto range = find(c, t0, t1);
+    if (range.first != range.second) {
+      cursors.push_back(
+          {c, offsets_[c] + range.first, offsets_[c] + range.second});
+    }
+  }
+  return MergedRange(MergedIterator(this, std::move(cursors)));
+}
+
+namespace {
+/// Heap order of merge cursors: earliest start time (then component) first.
+struct CursorGreater {
+  const std::vector<uint64_t>& idx;
+  template <class Cursor>
+  bool operator()(const Cursor& a, const Cursor& b) const {
+    return idx[a.pos] != idx[b.pos] ? idx[a.pos] > idx[b.pos]
+                                    : a.component > b.component;
+  }
+};
+} // namespace
+
+TimesliceIndex::MergedIterator::MergedIterator(const TimesliceIndex* index,
+                                               std::vector<Cursor> cursors)
+    : index_(index), cursors_(std::move(cursors)) {
+  std::make_heap(cursors_.begin(), cursors_.end(), CursorGreater{index_->idx_});
+  advance();
+}
+
+void TimesliceIndex::MergedIterator::advance() {
+  if (cursors_.empty()) {
+    index_ = nullptr;
+    return;
+  }
+  const CursorGreater greater{index_->idx_};
+  std::pop_heap(cursors_.begin(), cursors_.end(), greater);
+  Cursor& cursor = cursors_.back();
+  current_ = index_->entry_at(cursor.component, cursor.pos);
+  if (++cursor.pos < cursor.end) {
+    // the next microslice of this component is visited soon
+    prefetch(index_->desc_[cursor.pos]);
+    prefetch(index_->content_[cursor.pos]);
+    std::push_heap(cursors_.begin(), cursors_.end(), greater);
+  } else {
+    cursors_.pop_back();
+  }
+}
+
+} // namespace fles
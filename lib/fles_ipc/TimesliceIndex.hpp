@@ -0,0 +1,166 @@
+// Copyright 2026 agent <agent@local>
+/// \file
+/// \brief Defines the fles::TimesliceIndex class.
+#pragma once
+
+#include "MicrosliceDescriptor.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace fles {
+
+class Timeslice;
+
+/**
+ * \brief The TimesliceIndex class provides fast access to the microslices of
+ * a timeslice by start time.
+ *
+ * The microslice start time (idx), size, content pointer, and descriptor
+ * pointer of all components are stored in separate contiguous arrays, ordered
+ * by start time within each component. Queries for a time window use binary
+ * search, and the microslices of all components can be iterated merged in
+ * time order.
+ *
+ * The index refers to the memory of the timeslice and is only valid as long as
+ * the timeslice data exists and is not modified. It is usually obtained using
+ * Timeslice::microslice_index().
+ */
+class TimesliceIndex {
+public:
+  /// Reference to a single indexed microslice.
+  struct Entry {
+    uint64_t component;  ///< Index of the timeslice component
+    uint64_t microslice; ///< Index of the microslice in the component
+    uint64_t idx;        ///< Microslice start time
+    uint32_t size;       ///< Content size (bytes)
+    const uint8_t* content;           ///< Pointer to the content
+    const MicrosliceDescriptor* desc; ///< Pointer to the descriptor
+  };
+
+  /// Iterator over the microslices of all components in time order.
+  class MergedIterator {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Entry;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const Entry*;
+    using reference = const Entry&;
+
+    MergedIterator() = default;
+
+    reference operator*() const { return current_; }
+    pointer operator->() const { return &current_; }
+
+    MergedIterator& operator++() {
+      advance();
+      return *this;
+    }
+
+    MergedIterator operator++(int) {
+      MergedIterator it = *this;
+      advance();
+      return it;
+    }
+
+    bool operator==(const MergedIterator& other) const {
+      return at_end() == other.at_end() &&
+             (at_end() || (current_.component == other.current_.component &&
+                           current_.microslice == other.current_.microslice));
+    }
+
+    bool operator!=(const MergedIterator& other) const {
+      return !(*this == other);
+    }
+
+  private:
+    friend class TimesliceIndex;
+
+    /// Current and end position in the index arrays of a component.
+    struct Cursor {
+      uint64_t component;
+      std::size_t pos;
+      std::size_t end;
+    };
+
+    MergedIterator(const TimesliceIndex* index, std::vector<Cursor> cursors);
+
+    bool at_end() const { return index_ == nullptr; }
+    void advance();
+
+    const TimesliceIndex* index_ = nullptr;
+    /// Heap of cursors into non-exhausted components, by start time.
+    std::vector<Cursor> cursors_;
+    Entry current_ = Entry();
+  };
+
+  /// Range of microslices of all components in time order.
+  class MergedRange {
+  public:
+    MergedIterator begin() const { return begin_; }
+    MergedIterator end() const { return MergedIterator(); }
+
+  private:
+    friend class TimesliceIndex;
+    explicit MergedRange(MergedIterator begin) : begin_(std::move(begin)) {}
+    MergedIterator begin_;
+  };
+
+  /// Build the index of a timeslice.
+  explicit TimesliceIndex(const Timeslice& timeslice);
+
+  /// Retrieve the number of components.
+  uint64_t num_components() const { return offsets_.size() - 1; }
+
+  /// Retrieve the number of microslices in a component.
+  uint64_t num_microslices(uint64_t component) const {
+    return offsets_[component + 1] - offsets_[component];
+  }
+
+  /// Retrieve the total number of microslices.
+  uint64_t size() const { return idx_.size(); }
+
+  /// Retrieve the start times of a component, in increasing order.
+  const uint64_t* idx(uint64_t component) const {
+    return idx_.data() + offsets_[component];
+  }
+
+  /// Retrieve the microslice at the given position of a component.
+  Entry entry(uint64_t component, uint64_t position) const {
+    return entry_at(component, offsets_[component] + position);
+  }
+
+  /**
+   * \brief Find the microslices of a component with a start time in the
+   * window [t0, t1).
+   *
+   * \return range of positions [first, last) in the component
+   */
+  std::pair<uint64_t, uint64_t>
+  find(uint64_t component, uint64_t t0, uint64_t t1) const;
+
+  /// Retrieve the microslices of all components with a start time in the
+  /// window [t0, t1), merged in time order.
+  MergedRange window(uint64_t t0, uint64_t t1) const;
+
+  /// Retrieve the microslices of all components merged in time order.
+  MergedRange merged() const { return window(0, UINT64_MAX); }
+
+private:
+  Entry entry_at(uint64_t component, std::size_t pos) const {
+    return {component, microslice_[pos], idx_[pos],
+            size_[pos], content_[pos],   desc_[pos]};
+  }
+
+  /// Start position of each component in the arrays, plus total size.
+  std::vector<std::size_t> offsets_;
+  std::vector<uint64_t> idx_;
+  std::vector<uint64_t> microslice_;
+  std::vector<uint32_t> size_;
+  std::vector<const uint8_t*> content_;
+  std::vector<const MicrosliceDescriptor*> desc_;
+};
+
+} // namespace fles
@@ -6,6 +6,8 @@
 #include "ArchiveDescriptor.hpp"
 #include "InputArchive.hpp"
 #include "InputArchiveLoop.hpp"
+#include "InputArchivePrefetch.hpp"
+#include "InputArchiveSequence.hpp"
 
 namespace fles {
 
@@ -24,4 +26,14 @@ using TimesliceInputArchiveLoop =
                      StorableTimeslice,
                      ArchiveType::TimesliceArchive>;
 
+using TimesliceInputArchivePrefetch =
+    InputArchivePrefetch<Timeslice,
+                         StorableTimeslice,
+                         ArchiveType::TimesliceArchive>;
+
+using TimesliceInputArchiveSequence =
+    InputArchiveSequence<Timeslice,
+                         StorableTimeslice,
+                         ArchiveType::TimesliceArchive>;
+
 } // namespace fles
@@ -0,0 +1,33 @@
+// Copyright 2026 agent <agent@local>
+/// \file
+/// \brief Defines the fles::TimesliceMultipartHeader struct.
+#pragma once
+
+#include "TimesliceDescriptor.hpp"
+#include <cstdint>
+
+namespace fles {
+
+#pragma pack(1)
+
+/**
+ * \brief %Timeslice multipart message header struct.
+ *
+ * A timeslice is published as a multipart message consisting of this header
+ * followed by a TimesliceComponentDescriptor frame and a data frame for each
+ * component. The data frame contains the microslice descriptors followed by
+ * the microslice contents, as in the timeslice buffer.
+ */
+struct TimesliceMultipartHeader {
+  /// Identifies the multipart message format
+  uint64_t magic;
+  /// The timeslice descriptor
+  TimesliceDescriptor ts_desc;
+
+  /// Value of the magic field.
+  static constexpr uint64_t magic_value = UINT64_C(0x3154534d534c4643);
+};
+
+#pragma pack()
+
+} // namespace fles
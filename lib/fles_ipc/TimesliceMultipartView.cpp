@@ -0,0 +1,89 @@
+// Copyright 2026 agent <agent@local>
+
+#include "TimesliceMultipartView.hpp"
+#include "TimesliceMultipartHeader.hpp"
+#include <stdexcept>
+#include <utility>
+
+namespace fles {
+
+namespace {
+/// Release the timeslice reference held by a zero-copy message frame.
+void release_timeslice(void* /* data */, void* hint) {
+  delete static_cast<std::shared_ptr<const Timeslice>*>(hint);
+}
+} // namespace
+
+uint64_t
+TimesliceMultipartView::send(zmq::socket_t& socket,
+                             std::shared_ptr<const Timeslice> timeslice) {
+  TimesliceMultipartHeader header = TimesliceMultipartHeader();
+  header.magic = TimesliceMultipartHeader::magic_value;
+  header.ts_desc = timeslice->timeslice_descriptor_;
+  uint64_t num_components = header.ts_desc.num_components;
+  zmq::message_t header_frame(&header, sizeof(header));
+  socket.send(header_frame, num_components > 0 ? ZMQ_SNDMORE : 0);
+
+  uint64_t bytes = 0;
+  for (uint64_t c = 0; c < num_components; ++c) {
+    const TimesliceComponentDescriptor& desc = *timeslice->desc_ptr_[c];
+    zmq::message_t desc_frame(&desc, sizeof(desc));
+    socket.send(desc_frame, ZMQ_SNDMORE);
+
+    // each frame holds a reference to keep the timeslice data alive
+    std::unique_ptr<std::shared_ptr<const Timeslice>> hint(
+        new std::shared_ptr<const Timeslice>(timeslice));
+    zmq::message_t data_frame(timeslice->data_ptr_[c], desc.size,
+                              release_timeslice, hint.get());
+    hint.release();
+    socket.send(data_frame, c + 1 < num_components ? ZMQ_SNDMORE : 0);
+    bytes += desc.size;
+  }
+  return bytes;
+}
+
+bool TimesliceMultipartView::is_header(const zmq::message_t& frame) {
+  // a serialized timeslice never fits into a multipart header frame
+  return frame.size() == sizeof(TimesliceMultipartHeader) &&
+         static_cast<const TimesliceMultipartHeader*>(frame.data())->magic ==
+             TimesliceMultipartHeader::magic_value;
+}
+
+TimesliceMultipartView::TimesliceMultipartView(zmq::message_t header_frame,
+                                               zmq::socket_t& socket) {
+  frames_.push_back(std::move(header_frame));
+  while (frames_.back().more()) {
+    frames_.emplace_back();
+    socket.recv(&frames_.back());
+  }
+
+  if (!is_header(frames_[0])) {
+    throw std::runtime_error("invalid timeslice message header");
+  }
+  const auto& header =
+      *static_cast<const TimesliceMultipartHeader*>(frames_[0].data());
+  if (frames_.size() != 1 + 2 * header.ts_desc.num_components) {
+    throw std::runtime_error("invalid timeslice message format");
+  }
+  timeslice_descriptor_ = header.ts_desc;
+
+  // initialize access pointer vectors
+  data_ptr_.resize(num_components());
+  desc_ptr_.resize(num_components());
+  for (size_t c = 0; c < num_components(); ++c) {
+    zmq::message_t& desc_frame = frames_[1 + 2 * c];
+    zmq::message_t& data_frame = frames_[2 + 2 * c];
+    if (desc_frame.size() != sizeof(TimesliceComponentDescriptor)) {
+      throw std::runtime_error("invalid timeslice component descriptor");
+    }
+    desc_ptr_[c] = static_cast<TimesliceComponentDescriptor*>(desc_frame.data());
+    if (data_frame.size() != desc_ptr_[c]->size ||
+        data_frame.size() <
+            desc_ptr_[c]->num_microslices * sizeof(MicrosliceDescriptor)) {
+      throw std::runtime_error("invalid timeslice component data size");
+    }
+    data_ptr_[c] = static_cast<uint8_t*>(data_frame.data());
+  }
+}
+
+} // namespace fles
@@ -0,0 +1,60 @@
+// Copyright 2026 agent <agent@local>
+/// \file
+/// \brief Defines the fles::TimesliceMultipartView class.
+#pragma once
+
+#include "Timeslice.hpp"
+#include <memory>
+#include <vector>
+#include <zmq.hpp>
+
+namespace fles {
+
+/**
+ * \brief The TimesliceMultipartView class provides access to the data of a
+ * single timeslice received as a zeromq multipart message.
+ *
+ * The timeslice data is accessed in place in the received message frames,
+ * which are owned by this object.
+ */
+class TimesliceMultipartView : public Timeslice {
+public:
+  /// Delete copy constructor (non-copyable).
+  TimesliceMultipartView(const TimesliceMultipartView&) = delete;
+  /// Delete assignment operator (non-copyable).
+  void operator=(const TimesliceMultipartView&) = delete;
+
+  ~TimesliceMultipartView() override = default;
+
+  /**
+   * \brief Send a timeslice as a multipart message without copying its data.
+   *
+   * The data frames hold a reference to the timeslice until zeromq has
+   * finished sending them.
+   *
+   * \return number of component data bytes sent
+   */
+  static uint64_t send(zmq::socket_t& socket,
+                   std::shared_ptr<const Timeslice> timeslice);
+
+  /// Check if a message frame is the header of a multipart timeslice.
+  static bool is_header(const zmq::message_t& frame);
+
+private:
+  friend class TimesliceSubscriber;
+  friend class TimesliceWorker;
+
+  /**
+   * \brief Construct a timeslice view from a received header frame and the
+   * remaining frames of the multipart message, which are received from the
+   * given socket.
+   *
+   * Throws std::runtime_error if the frames do not form a valid timeslice.
+   */
+  TimesliceMultipartView(zmq::message_t header_frame, zmq::socket_t& socket);
+
+  /// The received message frames.
+  std::vector<zmq::message_t> frames_;
+};
+
+} // namespace fles
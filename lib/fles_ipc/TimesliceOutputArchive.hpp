@@ -5,20 +5,23 @@
 
 #include "OutputArchive.hpp"
 #include "OutputArchiveSequence.hpp"
-#include "StorableTimeslice.hpp"
+#include "TimesliceSerializer.hpp"
 
 namespace fles {
 
 /**
  * \brief The TimesliceOutputArchive class serializes timeslice data sets to
  * an output file.
+ *
+ * Timeslices are serialized directly via TimesliceSerializer, without an
+ * intermediate StorableTimeslice copy. The archive format is unchanged.
  */
 using TimesliceOutputArchive =
-    OutputArchive<Timeslice, StorableTimeslice, ArchiveType::TimesliceArchive>;
+    OutputArchive<Timeslice, TimesliceSerializer, ArchiveType::TimesliceArchive>;
 
 using TimesliceOutputArchiveSequence =
     OutputArchiveSequence<Timeslice,
-                          StorableTimeslice,
+                          TimesliceSerializer,
                           ArchiveType::TimesliceArchive>;
 
 } // namespace fles
@@ -0,0 +1,33 @@
+// Copyright 2026 agent <agent@local>
+
+#include "TimesliceProjection.hpp"
+#include <stdexcept>
+#include <utility>
+
+namespace fles {
+
+TimesliceProjection::TimesliceProjection(
+    std::shared_ptr<const Timeslice> timeslice,
+    const ComponentPredicate& predicate)
+    : TimesliceProjection(timeslice, select_components(*timeslice, predicate)) {
+}
+
+TimesliceProjection::TimesliceProjection(
+    std::shared_ptr<const Timeslice> timeslice,
+    std::vector<uint64_t> components)
+    : timeslice_(std::move(timeslice)), components_(std::move(components)) {
+  timeslice_descriptor_ = timeslice_->timeslice_descriptor_;
+  timeslice_descriptor_.num_components = components_.size();
+
+  data_ptr_.reserve(components_.size());
+  desc_ptr_.reserve(components_.size());
+  for (uint64_t c : components_) {
+    if (c >= timeslice_->num_components()) {
+      throw std::out_of_range("timeslice component index out of range");
+    }
+    data_ptr_.push_back(timeslice_->data_ptr_[c]);
+    desc_ptr_.push_back(timeslice_->desc_ptr_[c]);
+  }
+}
+
+} // namespace fles
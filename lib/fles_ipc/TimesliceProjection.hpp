@@ -0,0 +1,51 @@
+// Copyright 2026 agent <agent@local>
+/// \file
+/// \brief Defines the fles::TimesliceProjection class.
+#pragma once
+
+#include "ComponentSelection.hpp"
+#include "Timeslice.hpp"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace fles {
+
+/**
+ * \brief The TimesliceProjection class provides access to a subset of the
+ * components of another timeslice.
+ *
+ * The data is not copied. The underlying timeslice is kept alive as long as
+ * the projection exists.
+ */
+class TimesliceProjection : public Timeslice {
+public:
+  /// Construct a projection to the components selected by a predicate.
+  TimesliceProjection(std::shared_ptr<const Timeslice> timeslice,
+                      const ComponentPredicate& predicate);
+
+  /// Construct a projection to the given components.
+  TimesliceProjection(std::shared_ptr<const Timeslice> timeslice,
+                      std::vector<uint64_t> components);
+
+  /// Delete copy constructor (non-copyable).
+  TimesliceProjection(const TimesliceProjection&) = delete;
+  /// Delete assignment operator (non-copyable).
+  void operator=(const TimesliceProjection&) = delete;
+
+  ~TimesliceProjection() override = default;
+
+  /// Retrieve the index of a component in the underlying timeslice.
+  uint64_t source_component(uint64_t component) const {
+    return components_[component];
+  }
+
+private:
+  /// The underlying timeslice.
+  std::shared_ptr<const Timeslice> timeslice_;
+
+  /// The indices of the selected components in the underlying timeslice.
+  std::vector<uint64_t> components_;
+};
+
+} // namespace fles
@@ -1,33 +1,132 @@
 // Copyright 2014 Jan de Cuveland <cmail@cuveland.de>
 
 #include "TimeslicePublisher.hpp"
-#include <algorithm>
+#include "TimesliceMultipartView.hpp"
+#include "TimesliceProjection.hpp"
+#include "TimesliceSerializer.hpp"
 #include <boost/archive/binary_oarchive.hpp>
 #include <boost/iostreams/device/back_inserter.hpp>
 #include <boost/iostreams/stream.hpp>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <utility>
 
 namespace fles {
 
+namespace {
+/// The first byte of a selection topic cannot start a serialized timeslice
+/// (archive signature length) or a multipart message (header magic), so
+/// complete timeslices are sent without a topic frame.
+const char selection_topic_prefix[] = "\xff"
+                                      "fles-ts-select:";
+const std::size_t selection_topic_prefix_size =
+    sizeof(selection_topic_prefix) - 1;
+
+bool has_selection_prefix(const void* data, std::size_t size) {
+  return size > selection_topic_prefix_size &&
+         std::memcmp(data, selection_topic_prefix,
+                     selection_topic_prefix_size) == 0;
+}
+} // namespace
+
 TimeslicePublisher::TimeslicePublisher(const std::string& address,
-                                       uint32_t hwm) {
+                                       uint32_t hwm,
+                                       bool multipart)
+    : multipart_(multipart) {
   publisher_.setsockopt(ZMQ_SNDHWM, hwm);
   publisher_.bind(address.c_str());
 }
 
-void TimeslicePublisher::do_put(const StorableTimeslice& timeslice) {
+void TimeslicePublisher::put(std::shared_ptr<const Timeslice> timeslice) {
+  update_subscriptions();
+  for (const auto& selection : selections_) {
+    zmq::message_t topic_frame(selection.first.data(), selection.first.size());
+    publisher_.send(topic_frame, ZMQ_SNDMORE);
+    send(std::make_shared<TimesliceProjection>(timeslice,
+                                               selection.second.predicate()));
+  }
+  send(std::move(timeslice));
+}
+
+std::string
+TimeslicePublisher::selection_topic(const ComponentSelection& selection) {
+  if (selection.all()) {
+    return std::string();
+  }
+  // the terminator keeps topics from matching as prefixes of each other
+  return selection_topic_prefix + selection.to_string() + "\n";
+}
+
+bool TimeslicePublisher::is_selection_topic(const zmq::message_t& frame) {
+  return has_selection_prefix(frame.data(), frame.size());
+}
+
+void TimeslicePublisher::update_subscriptions() {
+  zmq::message_t message;
+  while (publisher_.recv(&message, ZMQ_DONTWAIT)) {
+    // first byte: 1 = subscribe, 0 = unsubscribe; followed by the topic
+    if (message.size() < 2) {
+      continue;
+    }
+    const char* data = static_cast<const char*>(message.data());
+    std::string topic(data + 1, message.size() - 1);
+    if (!has_selection_prefix(topic.data(), topic.size()) ||
+        topic.back() != '\n') {
+      continue;
+    }
+    if (data[0] == 0) {
+      selections_.erase(topic);
+      continue;
+    }
+    try {
+      ComponentSelection selection(
+          topic.substr(selection_topic_prefix_size,
+                       topic.size() - selection_topic_prefix_size - 1));
+      if (!selection.all()) {
+        selections_.emplace(topic, selection);
+      }
+    } catch (std::invalid_argument&) {
+      // ignore malformed selection requests
+    }
+  }
+}
+
+void TimeslicePublisher::send(std::shared_ptr<const Timeslice> timeslice) {
+  if (multipart_) {
+    do_put_multipart(std::move(timeslice));
+  } else {
+    do_put(*timeslice);
+  }
+}
+
+void TimeslicePublisher::do_put(const Timeslice& timeslice) {
   // serialize timeslice to string
-  serial_str_.clear();
-  boost::iostreams::back_insert_device<std::string> inserter(serial_str_);
-  boost::iostreams::stream<boost::iostreams::back_insert_device<std::string>> s(
-      inserter);
-  boost::archive::binary_oarchive oa(s);
-  oa << timeslice;
-  s.flush();
-
-  zmq::message_t message(serial_str_.size());
-  std::copy_n(static_cast<const char*>(serial_str_.data()), message.size(),
-              static_cast<char*>(message.data()));
+  std::unique_ptr<std::string> serial_str(new std::string);
+  serial_str->reserve(serial_size_);
+  {
+    boost::iostreams::back_insert_device<std::string> inserter(*serial_str);
+    boost::iostreams::stream<boost::iostreams::back_insert_device<std::string>>
+        s(inserter);
+    boost::archive::binary_oarchive oa(s);
+    const TimesliceSerializer serializer(timeslice);
+    oa << serializer;
+    s.flush();
+  }
+  serial_size_ = serial_str->size();
+
+  // hand the string over to zeromq, which frees it after sending
+  zmq::message_t message(
+      const_cast<char*>(serial_str->data()), serial_str->size(),
+      [](void*, void* hint) { delete static_cast<std::string*>(hint); },
+      serial_str.get());
+  serial_str.release();
   publisher_.send(message);
 }
 
+void TimeslicePublisher::do_put_multipart(
+    std::shared_ptr<const Timeslice> timeslice) {
+  TimesliceMultipartView::send(publisher_, std::move(timeslice));
+}
+
 } // namespace fles
@@ -3,8 +3,10 @@
 /// \brief Defines the fles::TimeslicePublisher class.
 #pragma once
 
+#include "ComponentSelection.hpp"
 #include "Sink.hpp"
-#include "StorableTimeslice.hpp"
+#include "Timeslice.hpp"
+#include <map>
 #include <string>
 #include <zmq.hpp>
 
@@ -13,11 +15,27 @@ namespace fles {
 /**
  * \brief The TimeslicePublisher class publishes serialized timeslice data sets
  * to a zeromq socket.
+ *
+ * In multipart mode, the timeslice is not serialized. Instead, the header, the
+ * component descriptors, and the component data are sent as separate frames
+ * of a multipart message (see TimesliceMultipartHeader). The data frames refer
+ * to the memory of the original timeslice object, which is kept alive until
+ * zeromq has finished sending.
+ *
+ * Complete timeslices are sent without a topic frame, in the same format as
+ * without selections. Subscribers may request a component selection (see
+ * TimesliceSubscriber). For each selection requested by any connected
+ * subscriber, a projection of the timeslice to the selected components is
+ * published in addition, preceded by a topic frame identifying the
+ * selection. Selective subscribers only receive the messages of their topic,
+ * so the unselected component data is never sent to them.
  */
 class TimeslicePublisher : public TimesliceSink {
 public:
   /// Construct timeslice publisher sending at given ZMQ address.
-  TimeslicePublisher(const std::string& address, uint32_t hwm = 1);
+  TimeslicePublisher(const std::string& address,
+                     uint32_t hwm = 1,
+                     bool multipart = false);
 
   /// Delete copy constructor (non-copyable).
   TimeslicePublisher(const TimeslicePublisher&) = delete;
@@ -25,16 +43,30 @@ public:
   void operator=(const TimeslicePublisher&) = delete;
 
   /// Send a timeslice to all connected subscribers.
-  void put(std::shared_ptr<const fles::Timeslice> timeslice) override {
-    do_put(*timeslice);
-  };
+  void put(std::shared_ptr<const fles::Timeslice> timeslice) override;
+
+  /// Retrieve the message topic of a component selection (empty, i.e.,
+  /// matching all messages, if all components are selected).
+  static std::string selection_topic(const ComponentSelection& selection);
+
+  /// Check whether a frame is the topic frame of a selection message.
+  static bool is_selection_topic(const zmq::message_t& frame);
 
 private:
   zmq::context_t context_{1};
-  zmq::socket_t publisher_{context_, ZMQ_PUB};
-  std::string serial_str_;
+  zmq::socket_t publisher_{context_, ZMQ_XPUB};
+  /// The component selections requested by subscribers, by topic.
+  std::map<std::string, ComponentSelection> selections_;
+  /// Size of the previous serialized timeslice (allocation hint).
+  std::size_t serial_size_ = 0;
+  bool multipart_;
+
+  /// Process pending subscription messages.
+  void update_subscriptions();
 
-  void do_put(const fles::StorableTimeslice& timeslice);
+  void send(std::shared_ptr<const fles::Timeslice> timeslice);
+  void do_put(const fles::Timeslice& timeslice);
+  void do_put_multipart(std::shared_ptr<const fles::Timeslice> timeslice);
 };
 
 } // namespace fles
@@ -1,12 +1,18 @@
 // Copyright 2013 Jan de Cuveland <cmail@cuveland.de>
 
 #include "TimesliceReceiver.hpp"
-#include <boost/version.hpp>
+#include "TimesliceComponentPins.hpp"
+#include <algorithm>
+#include <boost/interprocess/exceptions.hpp>
+#include <array>
+#include <utility>
 
 namespace fles {
 
-TimesliceReceiver::TimesliceReceiver(const std::string shared_memory_identifier)
-    : shared_memory_identifier_(shared_memory_identifier) {
+TimesliceReceiver::TimesliceReceiver(const std::string shared_memory_identifier,
+                                     ComponentPredicate predicate)
+    : shared_memory_identifier_(shared_memory_identifier),
+      predicate_(std::move(predicate)) {
   data_shm_ = std::unique_ptr<boost::interprocess::shared_memory_object>(
       new boost::interprocess::shared_memory_object(
           boost::interprocess::open_only,
@@ -27,51 +33,82 @@ TimesliceReceiver::TimesliceReceiver(const std::string shared_memory_identifier)
       new boost::interprocess::mapped_region(*desc_shm_,
                                              boost::interprocess::read_only));
 
-  work_items_mq_ = std::unique_ptr<boost::interprocess::message_queue>(
-      new boost::interprocess::message_queue(
+  work_items_ = std::unique_ptr<SharedMemoryQueue<TimesliceWorkItem>>(
+      new SharedMemoryQueue<TimesliceWorkItem>(
           boost::interprocess::open_only,
-          (shared_memory_identifier + "work_items_").c_str()));
+          shared_memory_identifier + "work_items_"));
 
-  completions_mq_ = std::shared_ptr<boost::interprocess::message_queue>(
-      new boost::interprocess::message_queue(
-          boost::interprocess::open_only,
-          (shared_memory_identifier + "completions_").c_str()));
+  completions_ = std::make_shared<SharedMemoryQueue<TimesliceCompletion>>(
+      boost::interprocess::open_only,
+      shared_memory_identifier + "completions_");
+
+  // optional, see TimesliceBuffer
+  try {
+    component_events_ =
+        std::unique_ptr<SharedMemoryQueue<TimesliceComponentEvent>>(
+            new SharedMemoryQueue<TimesliceComponentEvent>(
+                boost::interprocess::open_only,
+                shared_memory_identifier + "component_events_"));
+    pins_shm_ = std::unique_ptr<boost::interprocess::shared_memory_object>(
+        new boost::interprocess::shared_memory_object(
+            boost::interprocess::open_only,
+            (shared_memory_identifier + "component_pins_").c_str(),
+            boost::interprocess::read_write));
+    pins_region_ = std::make_shared<boost::interprocess::mapped_region>(
+        *pins_shm_, boost::interprocess::read_write);
+  } catch (boost::interprocess::interprocess_exception const&) {
+    component_events_ = nullptr;
+  }
 }
 
-#if BOOST_VERSION < 105600
-/**
- * \brief Workaround for bug in old Boost version
- *
- * This workaround is required for Boost versions 1.52.0 to 1.55.0, as there is
- * a serious synchronization bug in boost::interprocess in these versions.
- *
- * For reference, see: https://svn.boost.org/trac/boost/ticket/9221
- * ("message_queue deadlock on linux")
- *
- * This code should no longer be required when using Boost version 1.56.0 or
- * newer.
- *
- * 2014-03-12, Jan de Cuveland <cuveland@fias.uni-frankfurt.de>
- */
-void mq_receive_workaround(boost::interprocess::message_queue& mq,
-                           void* buffer,
-                           size_t buffer_size,
-                           size_t& recvd_size,
-                           unsigned int& priority);
-void mq_receive_workaround(boost::interprocess::message_queue& mq,
-                           void* buffer,
-                           size_t buffer_size,
-                           size_t& recvd_size,
-                           unsigned int& priority) {
-  boost::posix_time::ptime abs_time;
-  do {
-    abs_time = boost::posix_time::ptime(
-                   boost::posix_time::microsec_clock::universal_time()) +
-               boost::posix_time::milliseconds(10);
-  } while (
-      !mq.timed_receive(buffer, buffer_size, recvd_size, priority, abs_time));
+std::unique_ptr<TimesliceComponentView>
+TimesliceReceiver::try_get_component() {
+  if (!component_events_) {
+    return nullptr;
+  }
+
+  uint8_t* data = reinterpret_cast<uint8_t*>(data_region_->get_address());
+  TimesliceComponentDescriptor* desc =
+      reinterpret_cast<TimesliceComponentDescriptor*>(
+          desc_region_->get_address());
+
+  auto* entries =
+      static_cast<std::atomic<uint64_t>*>(pins_region_->get_address());
+
+  TimesliceComponentEvent event;
+  while (component_events_->try_pop(event)) {
+    // pin before looking at the buffer, the builder holds back the release
+    // of pinned timeslices that are not yet acknowledged
+    TimesliceComponentPins pins(entries, event.desc_buffer_size_exp);
+    if (!pins.pin(event.ts_pos)) {
+      // released already
+      continue;
+    }
+    std::shared_ptr<std::atomic<uint64_t>> pin(pins_region_,
+                                               &pins.count(event.ts_pos));
+    TimesliceComponentDescriptor* desc_c =
+        desc + (static_cast<uint64_t>(event.component)
+                << event.desc_buffer_size_exp) +
+        (event.ts_pos & ((UINT64_C(1) << event.desc_buffer_size_exp) - 1));
+    if (desc_c->ts_num != event.ts_num || desc_c->absent()) {
+      // overwritten after the timeslice has been released
+      pin->fetch_sub(1);
+      continue;
+    }
+    uint8_t* data_c =
+        data + (static_cast<uint64_t>(event.component)
+                << event.data_buffer_size_exp) +
+        (desc_c->offset & ((UINT64_C(1) << event.data_buffer_size_exp) - 1));
+    if (predicate_ &&
+        !predicate_(*reinterpret_cast<const MicrosliceDescriptor*>(data_c))) {
+      pin->fetch_sub(1);
+      continue;
+    }
+    return std::unique_ptr<TimesliceComponentView>(
+        new TimesliceComponentView(event, data_c, desc_c, std::move(pin)));
+  }
+  return nullptr;
 }
-#endif
 
 TimesliceView* TimesliceReceiver::do_get() {
   if (eos_) {
@@ -79,27 +116,74 @@ TimesliceView* TimesliceReceiver::do_get() {
   }
 
   TimesliceWorkItem wi;
-  std::size_t recvd_size;
-  unsigned int priority;
-
-#if BOOST_VERSION >= 105600
-  work_items_mq_->receive(&wi, sizeof(wi), recvd_size, priority);
-#else
-  mq_receive_workaround(*work_items_mq_, &wi, sizeof(wi), recvd_size, priority);
-#endif
-  if (recvd_size == 0) {
+  if (!work_items_->pop(wi)) {
     eos_ = true;
-    // put end work item back for other consumers
-    work_items_mq_->send(nullptr, 0, 0);
     return nullptr;
   }
-  assert(recvd_size == sizeof(wi));
 
+  return create_view(wi);
+}
+
+TimesliceView* TimesliceReceiver::do_try_get() {
+  if (eos_) {
+    return nullptr;
+  }
+
+  TimesliceWorkItem wi;
+  if (work_items_->try_pop(wi)) {
+    return create_view(wi);
+  }
+  if (work_items_->is_closed()) {
+    // items sent before the end of stream are visible now
+    if (work_items_->try_pop(wi)) {
+      return create_view(wi);
+    }
+    eos_ = true;
+  }
+  return nullptr;
+}
+
+TimesliceView* TimesliceReceiver::do_get_for(std::chrono::nanoseconds timeout) {
+  if (eos_) {
+    return nullptr;
+  }
+
+  TimesliceWorkItem wi;
+  if (work_items_->pop_for(wi, timeout)) {
+    return create_view(wi);
+  }
+  return do_try_get();
+}
+
+void TimesliceReceiver::do_get_batch(
+    std::vector<std::unique_ptr<Timeslice>>& items, std::size_t max_items) {
+  std::unique_ptr<TimesliceView> first(do_get());
+  if (!first) {
+    return;
+  }
+  items.push_back(std::move(first));
+
+  std::array<TimesliceWorkItem, 64> wi;
+  while (items.size() < max_items) {
+    std::size_t count = work_items_->try_pop_batch(
+        wi.data(), std::min(wi.size(), max_items - items.size()));
+    if (count == 0) {
+      break;
+    }
+    for (std::size_t i = 0; i < count; ++i) {
+      items.emplace_back(create_view(wi[i]));
+    }
+  }
+}
+
+TimesliceView*
+TimesliceReceiver::create_view(const TimesliceWorkItem& work_item) {
   return new TimesliceView(
-      wi, reinterpret_cast<uint8_t*>(data_region_->get_address()),
+      work_item, reinterpret_cast<uint8_t*>(data_region_->get_address()),
       reinterpret_cast<TimesliceComponentDescriptor*>(
           desc_region_->get_address()),
-      completions_mq_);
+      desc_region_->get_size() > work_item.desc_buffers_size(), completions_,
+      predicate_);
 }
 
 } // namespace fles
@@ -3,13 +3,19 @@
 /// \brief Defines the fles::TimesliceReceiver class.
 #pragma once
 
+#include "ComponentSelection.hpp"
+#include "SharedMemoryQueue.hpp"
+#include "TimesliceComponentEvent.hpp"
+#include "TimesliceComponentView.hpp"
 #include "TimesliceSource.hpp"
 #include "TimesliceView.hpp"
-#include <boost/interprocess/ipc/message_queue.hpp>
 #include <boost/interprocess/mapped_region.hpp>
 #include <boost/interprocess/shared_memory_object.hpp>
+#include <chrono>
+#include <cstddef>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace fles {
 
@@ -19,8 +25,15 @@ namespace fles {
  */
 class TimesliceReceiver : public TimesliceSource {
 public:
-  /// Construct timeslice receiver connected to a given shared memory.
-  explicit TimesliceReceiver(const std::string shared_memory_identifier);
+  /**
+   * \brief Construct timeslice receiver connected to a given shared memory.
+   *
+   * \param shared_memory_identifier Identifier of the timeslice buffer
+   * \param predicate Selects the timeslice components to provide (all if empty)
+   */
+  explicit TimesliceReceiver(
+      const std::string shared_memory_identifier,
+      ComponentPredicate predicate = ComponentPredicate());
 
   /// Delete copy constructor (non-copyable).
   TimesliceReceiver(const TimesliceReceiver&) = delete;
@@ -40,12 +53,35 @@ public:
     return std::unique_ptr<TimesliceView>(do_get());
   };
 
+  /**
+   * \brief Retrieve the next component that has arrived, possibly before
+   * its timeslice is complete.
+   *
+   * This function does not block. Component events are only available if
+   * the producer publishes them, and may be lost if they are not retrieved
+   * in time. The complete timeslice is delivered by get() as usual. Its
+   * buffer space is held back until the complete timeslice and all of its
+   * component views have been released. Components of a timeslice that has
+   * already been released are skipped.
+   *
+   * \return pointer to the component, or nullptr if none is available
+   */
+  std::unique_ptr<TimesliceComponentView> try_get_component();
+
   bool eos() const override { return eos_; }
 
 private:
   TimesliceView* do_get() override;
+  TimesliceView* do_try_get() override;
+  TimesliceView* do_get_for(std::chrono::nanoseconds timeout) override;
+  void do_get_batch(std::vector<std::unique_ptr<Timeslice>>& items,
+                    std::size_t max_items) override;
+
+  /// Create a view of the timeslice described by a work item.
+  TimesliceView* create_view(const TimesliceWorkItem& work_item);
 
   const std::string shared_memory_identifier_;
+  const ComponentPredicate predicate_;
 
   std::unique_ptr<boost::interprocess::shared_memory_object> data_shm_;
   std::unique_ptr<boost::interprocess::shared_memory_object> desc_shm_;
@@ -53,8 +89,16 @@ private:
   std::unique_ptr<boost::interprocess::mapped_region> data_region_;
   std::unique_ptr<boost::interprocess::mapped_region> desc_region_;
 
-  std::unique_ptr<boost::interprocess::message_queue> work_items_mq_;
-  std::shared_ptr<boost::interprocess::message_queue> completions_mq_;
+  std::unique_ptr<SharedMemoryQueue<TimesliceWorkItem>> work_items_;
+  std::shared_ptr<SharedMemoryQueue<TimesliceCompletion>> completions_;
+
+  /// The component arrival events (nullptr if not published).
+  std::unique_ptr<SharedMemoryQueue<TimesliceComponentEvent>>
+      component_events_;
+
+  /// The pin counts of the component views, see TimesliceComponentPins.
+  std::unique_ptr<boost::interprocess::shared_memory_object> pins_shm_;
+  std::shared_ptr<boost::interprocess::mapped_region> pins_region_;
 
   /// The end-of-stream flag.
   bool eos_ = false;
@@ -0,0 +1,222 @@
+// Copyright 2026 agent <agent@local>
+
+#include "TimesliceSelectiveInputArchive.hpp"
+#include <algorithm>
+#include <array>
+#include <boost/serialization/array_wrapper.hpp>
+#include <boost/serialization/collection_size_type.hpp>
+#include <boost/serialization/item_version_type.hpp>
+#include <boost/serialization/level.hpp>
+#include <boost/serialization/library_version_type.hpp>
+#include <boost/serialization/tracking.hpp>
+#include <boost/serialization/vector.hpp>
+#include <boost/serialization/version.hpp>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace fles {
+
+/**
+ * \brief The SelectiveTimesliceLoader struct deserializes a timeslice in the
+ * format of StorableTimeslice, skipping the data of unselected components.
+ */
+struct SelectiveTimesliceLoader {
+  SelectiveTimesliceLoader(const ComponentPredicate& predicate,
+                           std::streambuf& streambuf)
+      : predicate(predicate), streambuf(streambuf) {}
+
+  const ComponentPredicate& predicate;
+  /// The stream buffer underlying the archive, used to skip data.
+  std::streambuf& streambuf;
+
+  TimesliceDescriptor ts_desc = TimesliceDescriptor();
+  std::vector<std::vector<uint8_t>> data;
+  std::vector<TimesliceComponentDescriptor> desc;
+  std::vector<bool> selected;
+  uint64_t bytes_skipped = 0;
+
+  template <class Archive>
+  void serialize(Archive& ar, const unsigned int /* version */);
+
+  /// Skip bytes in the archive.
+  template <class Archive> void skip(Archive& ar, uint64_t size) {
+    auto off = static_cast<std::streamoff>(size);
+    if (streambuf.pubseekoff(off, std::ios_base::cur, std::ios_base::in) ==
+        std::streampos(std::streamoff(-1))) {
+      // not seekable, read and discard
+      std::array<uint8_t, 4096> buffer;
+      while (size > 0) {
+        std::size_t n = std::min<uint64_t>(size, buffer.size());
+        ar.load_binary(buffer.data(), n);
+        size -= n;
+      }
+    }
+    bytes_skipped += static_cast<uint64_t>(off);
+  }
+};
+
+/**
+ * \brief The SelectiveComponentDataLoader struct deserializes the selected
+ * component data stored like a std::vector<std::vector<uint8_t>>.
+ */
+struct SelectiveComponentDataLoader {
+  SelectiveTimesliceLoader& ts;
+
+  template <class Archive>
+  void serialize(Archive& ar, const unsigned int /* version */) {
+    const boost::archive::library_version_type library_version(
+        ar.get_library_version());
+    boost::serialization::collection_size_type count;
+    ar >> count;
+    if (boost::archive::library_version_type(3) < library_version) {
+      boost::serialization::item_version_type item_version(0);
+      ar >> item_version;
+    }
+    ts.selected.assign(count, false);
+    for (std::size_t c = 0; c < count; ++c) {
+      boost::serialization::collection_size_type size;
+      ar >> size;
+      if (BOOST_SERIALIZATION_VECTOR_VERSIONED(library_version)) {
+        unsigned int item_version = 0;
+        ar >> item_version;
+      }
+      std::size_t head = 0;
+      MicrosliceDescriptor first_desc = MicrosliceDescriptor();
+      if (ts.predicate) {
+        if (size < sizeof(MicrosliceDescriptor)) {
+          ts.skip(ar, size);
+          continue;
+        }
+        head = sizeof(MicrosliceDescriptor);
+        ar.load_binary(&first_desc, head);
+        if (!ts.predicate(first_desc)) {
+          ts.skip(ar, size - head);
+          continue;
+        }
+      }
+      ts.selected[c] = true;
+      ts.data.emplace_back(size);
+      std::vector<uint8_t>& data = ts.data.back();
+      std::memcpy(data.data(), &first_desc, head);
+      if (size > head) {
+        ar.load_binary(data.data() + head, size - head);
+      }
+    }
+  }
+};
+
+/**
+ * \brief The SelectiveComponentDescriptorLoader struct deserializes the
+ * selected component descriptors stored like a
+ * std::vector<TimesliceComponentDescriptor>.
+ */
+struct SelectiveComponentDescriptorLoader {
+  SelectiveTimesliceLoader& ts;
+
+  template <class Archive>
+  void serialize(Archive& ar, const unsigned int /* version */) {
+    boost::serialization::collection_size_type count;
+    ar >> count;
+    if (boost::archive::library_version_type(3) < ar.get_library_version()) {
+      boost::serialization::item_version_type item_version(0);
+      ar >> item_version;
+    }
+    if (count != ts.selected.size()) {
+      throw std::runtime_error("inconsistent number of timeslice components");
+    }
+    for (std::size_t c = 0; c < count; ++c) {
+      TimesliceComponentDescriptor desc;
+      ar >> desc;
+      if (ts.selected[c]) {
+        ts.desc.push_back(desc);
+      }
+    }
+  }
+};
+
+template <class Archive>
+void SelectiveTimesliceLoader::serialize(Archive& ar,
+                                         const unsigned int /* version */) {
+  ar >> ts_desc;
+  SelectiveComponentDataLoader data_loader{*this};
+  ar >> data_loader;
+  SelectiveComponentDescriptorLoader desc_loader{*this};
+  ar >> desc_loader;
+  ts_desc.num_components = data.size();
+}
+
+using SelectiveComponentDataVector = std::vector<std::vector<uint8_t>>;
+using SelectiveComponentDescriptorVector =
+    std::vector<TimesliceComponentDescriptor>;
+
+} // namespace fles
+
+// The serialization traits have to match those of the emulated types.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wold-style-cast"
+BOOST_CLASS_IMPLEMENTATION(
+    fles::SelectiveTimesliceLoader,
+    boost::serialization::implementation_level<fles::StorableTimeslice>::value)
+BOOST_CLASS_TRACKING(
+    fles::SelectiveTimesliceLoader,
+    boost::serialization::tracking_level<fles::StorableTimeslice>::value)
+BOOST_CLASS_VERSION(fles::SelectiveTimesliceLoader,
+                    boost::serialization::version<fles::StorableTimeslice>::value)
+BOOST_CLASS_IMPLEMENTATION(
+    fles::SelectiveComponentDataLoader,
+    boost::serialization::implementation_level<
+        fles::SelectiveComponentDataVector>::value)
+BOOST_CLASS_TRACKING(fles::SelectiveComponentDataLoader,
+                     boost::serialization::tracking_level<
+                         fles::SelectiveComponentDataVector>::value)
+BOOST_CLASS_IMPLEMENTATION(
+    fles::SelectiveComponentDescriptorLoader,
+    boost::serialization::implementation_level<
+        fles::SelectiveComponentDescriptorVector>::value)
+BOOST_CLASS_TRACKING(fles::SelectiveComponentDescriptorLoader,
+                     boost::serialization::tracking_level<
+                         fles::SelectiveComponentDescriptorVector>::value)
+#pragma GCC diagnostic pop
+
+namespace fles {
+
+TimesliceSelectiveInputArchive::TimesliceSelectiveInputArchive(
+    const std::string& filename, ComponentPredicate predicate)
+    : predicate_(std::move(predicate)) {
+  ifstream_ = std::unique_ptr<std::ifstream>(
+      new std::ifstream(filename.c_str(), std::ios::binary));
+  if (!*ifstream_) {
+    throw std::ios_base::failure("error opening file \"" + filename + "\"");
+  }
+  iarchive_ = std::unique_ptr<boost::archive::binary_iarchive>(
+      new boost::archive::binary_iarchive(*ifstream_));
+  *iarchive_ >> descriptor_;
+  if (descriptor_.archive_type() != ArchiveType::TimesliceArchive) {
+    throw std::runtime_error("File \"" + filename +
+                             "\" is not of correct archive type");
+  }
+}
+
+StorableTimeslice* TimesliceSelectiveInputArchive::do_get() {
+  if (eos_) {
+    return nullptr;
+  }
+
+  SelectiveTimesliceLoader loader(predicate_, *ifstream_->rdbuf());
+  try {
+    *iarchive_ >> loader;
+  } catch (boost::archive::archive_exception& e) {
+    if (e.code == boost::archive::archive_exception::input_stream_error) {
+      eos_ = true;
+      return nullptr;
+    }
+    throw;
+  }
+  bytes_skipped_ += loader.bytes_skipped;
+  return new StorableTimeslice(loader.ts_desc, std::move(loader.data),
+                               std::move(loader.desc));
+}
+
+} // namespace fles
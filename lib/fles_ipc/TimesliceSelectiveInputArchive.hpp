@@ -0,0 +1,79 @@
+// Copyright 2026 agent <agent@local>
+/// \file
+/// \brief Defines the fles::TimesliceSelectiveInputArchive class.
+#pragma once
+
+#include "ArchiveDescriptor.hpp"
+#include "ComponentSelection.hpp"
+#include "StorableTimeslice.hpp"
+#include "TimesliceSource.hpp"
+#include <boost/archive/binary_iarchive.hpp>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+
+namespace fles {
+
+/**
+ * \brief The TimesliceSelectiveInputArchive class deserializes the selected
+ * components of timeslice data sets from an input file.
+ *
+ * The data of unselected components is skipped on disk instead of being read
+ * and deserialized. Only the first microslice descriptor of each component is
+ * read to evaluate the selection predicate.
+ */
+class TimesliceSelectiveInputArchive : public TimesliceSource {
+public:
+  /**
+   * \brief Construct an input archive object, open the given archive file for
+   * reading, and read the archive descriptor.
+   *
+   * \param filename  File name of the archive file
+   * \param predicate Selects the timeslice components to read (all if empty)
+   */
+  TimesliceSelectiveInputArchive(const std::string& filename,
+                                 ComponentPredicate predicate);
+
+  /// Delete copy constructor (non-copyable).
+  TimesliceSelectiveInputArchive(const TimesliceSelectiveInputArchive&) =
+      delete;
+  /// Delete assignment operator (non-copyable).
+  void operator=(const TimesliceSelectiveInputArchive&) = delete;
+
+  ~TimesliceSelectiveInputArchive() override = default;
+
+  /// Read the next data set.
+  std::unique_ptr<StorableTimeslice> get() {
+    return std::unique_ptr<StorableTimeslice>(do_get());
+  };
+
+  /// Retrieve the archive descriptor.
+  const ArchiveDescriptor& descriptor() const { return descriptor_; };
+
+  /// Retrieve the number of component data bytes skipped so far.
+  uint64_t bytes_skipped() const { return bytes_skipped_; }
+
+  bool eos() const override { return eos_; }
+
+private:
+  StorableTimeslice* do_get() override;
+
+  // reading from a file never waits for external input
+  StorableTimeslice* do_try_get() override { return do_get(); }
+
+  StorableTimeslice*
+  do_get_for(std::chrono::nanoseconds /* timeout */) override {
+    return do_get();
+  }
+
+  std::unique_ptr<std::ifstream> ifstream_;
+  std::unique_ptr<boost::archive::binary_iarchive> iarchive_;
+  ArchiveDescriptor descriptor_;
+  ComponentPredicate predicate_;
+  uint64_t bytes_skipped_ = 0;
+  bool eos_ = false;
+};
+
+} // namespace fles
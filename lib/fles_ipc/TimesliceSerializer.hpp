@@ -0,0 +1,62 @@
+// Copyright 2026 agent <agent@local>
+/// \file
+/// \brief Defines the fles::TimesliceSerializer class.
+#pragma once
+
+#include "StorableTimeslice.hpp"
+#include "Timeslice.hpp"
+#include "TimesliceComponentData.hpp"
+
+#include <boost/serialization/access.hpp>
+#include <boost/serialization/level.hpp>
+#include <boost/serialization/split_member.hpp>
+#include <boost/serialization/tracking.hpp>
+#include <boost/serialization/version.hpp>
+
+namespace fles {
+
+/**
+ * \brief The TimesliceSerializer class serializes any Timeslice object in the
+ * format of StorableTimeslice.
+ *
+ * The timeslice data is written directly from the component buffers, so no
+ * intermediate StorableTimeslice copy is needed. The serialized bytes are
+ * identical to those of a StorableTimeslice with the same contents, provided
+ * that no StorableTimeslice is written to the same archive. Use with output
+ * archives only.
+ */
+class TimesliceSerializer {
+public:
+  /// Construct serializer for the given timeslice.
+  TimesliceSerializer(const Timeslice& ts) : ts_(ts) {}
+
+private:
+  friend class boost::serialization::access;
+
+  template <class Archive>
+  void save(Archive& ar, const unsigned int /* version */) const {
+    ar << ts_.timeslice_descriptor_;
+    const TimesliceComponentDataList data{ts_.data_ptr_, ts_.desc_ptr_};
+    ar << data;
+    const TimesliceComponentDescriptorList desc{ts_.desc_ptr_};
+    ar << desc;
+  }
+
+  BOOST_SERIALIZATION_SPLIT_MEMBER()
+
+  const Timeslice& ts_;
+};
+
+} // namespace fles
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wold-style-cast"
+BOOST_CLASS_IMPLEMENTATION(
+    fles::TimesliceSerializer,
+    boost::serialization::implementation_level<fles::StorableTimeslice>::value)
+BOOST_CLASS_TRACKING(
+    fles::TimesliceSerializer,
+    boost::serialization::tracking_level<fles::StorableTimeslice>::value)
+BOOST_CLASS_VERSION(fles::TimesliceSerializer,
+                    boost::serialization::version<fles::StorableTimeslice>::value)
+#pragma GCC diagnostic pop
@@ -1,40 +1,141 @@
 // Copyright 2014 Jan de Cuveland <cmail@cuveland.de>
 
 #include "TimesliceSubscriber.hpp"
+#include "TimeslicePublisher.hpp"
+#include <cstring>
+#include <new>
+#include <stdexcept>
 
 namespace fles {
 
 TimesliceSubscriber::TimesliceSubscriber(const std::string& address,
-                                         uint32_t hwm) {
+                                         uint32_t hwm)
+    : TimesliceSubscriber(address, ComponentSelection(), hwm) {}
+
+TimesliceSubscriber::TimesliceSubscriber(const std::string& address,
+                                         const ComponentSelection& selection,
+                                         uint32_t hwm)
+    : topic_(TimeslicePublisher::selection_topic(selection)) {
   subscriber_.setsockopt(ZMQ_RCVHWM, hwm);
   subscriber_.connect(address.c_str());
-  subscriber_.setsockopt(ZMQ_SUBSCRIBE, nullptr, 0);
+  subscriber_.setsockopt(ZMQ_SUBSCRIBE, topic_.data(), topic_.size());
+}
+
+fles::Timeslice* TimesliceSubscriber::do_get() { return receive(0); }
+
+fles::Timeslice* TimesliceSubscriber::do_try_get() {
+  return receive(ZMQ_DONTWAIT);
 }
 
-fles::StorableTimeslice* TimesliceSubscriber::do_get() {
+fles::Timeslice*
+TimesliceSubscriber::do_get_for(std::chrono::nanoseconds timeout) {
   if (eos_flag) {
     return nullptr;
   }
 
-  zmq::message_t message;
-  subscriber_.recv(&message);
+  // zeromq polls with millisecond resolution, round up
+  auto timeout_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+      timeout + std::chrono::milliseconds(1) - std::chrono::nanoseconds(1));
+  zmq::pollitem_t item{static_cast<void*>(subscriber_), 0, ZMQ_POLLIN, 0};
+  zmq::poll(&item, 1, static_cast<long>(timeout_ms.count()));
+  return receive(ZMQ_DONTWAIT);
+}
+
+void TimesliceSubscriber::do_get_batch(
+    std::vector<std::unique_ptr<Timeslice>>& items, std::size_t max_items) {
+  Timeslice* item = receive(0);
+  while (item != nullptr) {
+    items.emplace_back(item);
+    if (items.size() == max_items) {
+      break;
+    }
+    item = receive(ZMQ_DONTWAIT);
+  }
+}
+
+fles::Timeslice* TimesliceSubscriber::receive(int flags) {
+  while (!eos_flag) {
+    zmq::message_t message;
+    if (!receive_frame(message, flags)) {
+      return nullptr;
+    }
+
+    if (message.size() == 0 && !message.more()) {
+      // an empty message signals end-of-stream
+      eos_flag = true;
+      return nullptr;
+    }
+
+    Timeslice* ts = decode(std::move(message));
+    if (ts != nullptr) {
+      return ts;
+    }
+    ++malformed_messages_;
+  }
+  return nullptr;
+}
+
+fles::Timeslice* TimesliceSubscriber::decode(zmq::message_t message) {
+  if (TimesliceMultipartView::is_header(message)) {
+    try {
+      return new fles::TimesliceMultipartView(std::move(message), subscriber_);
+    } catch (std::runtime_error& e) {
+      return nullptr;
+    }
+  }
+
+  if (message.more()) {
+    // a serialized timeslice is a single frame, discard the whole message
+    zmq::message_t frame;
+    do {
+      subscriber_.recv(&frame);
+    } while (frame.more());
+    return nullptr;
+  }
 
   boost::iostreams::basic_array_source<char> device(
       static_cast<char*>(message.data()), message.size());
   boost::iostreams::stream<boost::iostreams::basic_array_source<char>> s(
       device);
-  boost::archive::binary_iarchive ia(s);
 
-  fles::StorableTimeslice* sts = nullptr;
+  std::unique_ptr<fles::StorableTimeslice> sts(new fles::StorableTimeslice());
   try {
-    sts = new fles::StorableTimeslice();
+    boost::archive::binary_iarchive ia(s);
     ia >> *sts;
   } catch (boost::archive::archive_exception& e) {
-    delete sts;
-    eos_flag = true;
     return nullptr;
+  } catch (std::length_error& e) {
+    // corrupt size fields
+    return nullptr;
+  } catch (std::bad_alloc& e) {
+    return nullptr;
+  }
+  return sts.release();
+}
+
+bool TimesliceSubscriber::receive_frame(zmq::message_t& message, int flags) {
+  while (subscriber_.recv(&message, flags)) {
+    if (!TimeslicePublisher::is_selection_topic(message)) {
+      // complete timeslices are sent without a topic frame
+      return true;
+    }
+    bool subscribed =
+        message.size() == topic_.size() &&
+        std::memcmp(message.data(), topic_.data(), topic_.size()) == 0;
+    // the remaining frames of a multipart message are available at once
+    if (subscribed && message.more()) {
+      subscriber_.recv(&message);
+      return true;
+    }
+    if (subscribed) {
+      ++malformed_messages_;
+    }
+    // plain subscribers receive and skip the selection messages of others
+    while (message.more()) {
+      subscriber_.recv(&message);
+    }
   }
-  return sts;
+  return false;
 }
 
 } // namespace fles
@@ -3,24 +3,51 @@
 /// \brief Defines the fles::TimesliceSubscriber class.
 #pragma once
 
+#include "ComponentSelection.hpp"
 #include "StorableTimeslice.hpp"
+#include "TimesliceMultipartView.hpp"
 #include "TimesliceSource.hpp"
 #include <boost/archive/binary_iarchive.hpp>
 #include <boost/iostreams/device/array.hpp>
 #include <boost/iostreams/stream.hpp>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
 #include <string>
+#include <vector>
 #include <zmq.hpp>
 
 namespace fles {
 /**
  * \brief The TimesliceSubscriber class receives serialized timeslice data sets
  * from a zeromq socket.
+ *
+ * Both the serialized and the multipart message format of TimeslicePublisher
+ * are accepted. Timeslices received in multipart format are accessed in place
+ * as TimesliceMultipartView objects.
+ *
+ * If a component selection is given, the subscriber requests the projection
+ * of each timeslice to the selected components from the publisher, so that
+ * unselected component data is not transferred. Otherwise, it receives the
+ * complete timeslices, which are sent without a topic frame, and skips the
+ * projections published for other subscribers.
+ *
+ * An empty message signals end-of-stream (for selective subscribers, an empty
+ * message following the topic frame). Malformed messages are skipped and
+ * counted.
  */
 class TimesliceSubscriber : public TimesliceSource {
 public:
   /// Construct timeslice subscriber receiving from given ZMQ address.
   explicit TimesliceSubscriber(const std::string& address, uint32_t hwm = 1);
 
+  /// Construct timeslice subscriber receiving the selected components from
+  /// given ZMQ address.
+  TimesliceSubscriber(const std::string& address,
+                      const ComponentSelection& selection,
+                      uint32_t hwm = 1);
+
   /// Delete copy constructor (non-copyable).
   TimesliceSubscriber(const TimesliceSubscriber&) = delete;
   /// Delete assignment operator (non-copyable).
@@ -28,25 +55,41 @@ public:
 
   ~TimesliceSubscriber() override = default;
 
-  /**
-   * \brief Retrieve the next item.
-   *
-   * This function blocks if the next item is not yet available.
-   *
-   * \return pointer to the item, or nullptr if end-of-file
-   */
-  std::unique_ptr<StorableTimeslice> get() {
-    return std::unique_ptr<StorableTimeslice>(do_get());
-  };
-
   bool eos() const override { return eos_flag; }
 
+  /// Retrieve the number of malformed messages skipped.
+  uint64_t malformed_messages() const { return malformed_messages_; }
+
 private:
-  StorableTimeslice* do_get() override;
+  Timeslice* do_get() override;
+  Timeslice* do_try_get() override;
+  Timeslice* do_get_for(std::chrono::nanoseconds timeout) override;
+  void do_get_batch(std::vector<std::unique_ptr<Timeslice>>& items,
+                    std::size_t max_items) override;
+
+  /// Receive and deserialize a timeslice using the given zeromq flags.
+  /** \return pointer to the timeslice, or nullptr if none is available */
+  Timeslice* receive(int flags);
+
+  /// Decode a timeslice from a received message, whose remaining frames are
+  /// received from the socket.
+  /** \return pointer to the timeslice, or nullptr if the message is
+   * malformed */
+  Timeslice* decode(zmq::message_t message);
+
+  /// Receive the first frame of the next message (following the topic frame
+  /// of a selection message).
+  bool receive_frame(zmq::message_t& message, int flags);
 
   zmq::context_t context_{1};
   zmq::socket_t subscriber_{context_, ZMQ_SUB};
 
+  /// The message topic subscribed to.
+  std::string topic_;
+
+  /// Number of malformed messages skipped.
+  uint64_t malformed_messages_ = 0;
+
   bool eos_flag = false;
 };
 
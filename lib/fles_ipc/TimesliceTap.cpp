@@ -0,0 +1,157 @@
+// Copyright 2026 agent <agent@local>
+
+#include "TimesliceTap.hpp"
+#include <atomic>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+namespace fles {
+
+TimesliceTap::TimesliceTap(const std::string& shared_memory_identifier) {
+  data_shm_ = std::unique_ptr<boost::interprocess::shared_memory_object>(
+      new boost::interprocess::shared_memory_object(
+          boost::interprocess::open_only,
+          (shared_memory_identifier + "data_").c_str(),
+          boost::interprocess::read_only));
+
+  desc_shm_ = std::unique_ptr<boost::interprocess::shared_memory_object>(
+      new boost::interprocess::shared_memory_object(
+          boost::interprocess::open_only,
+          (shared_memory_identifier + "desc_").c_str(),
+          boost::interprocess::read_only));
+
+  status_shm_ = std::unique_ptr<boost::interprocess::shared_memory_object>(
+      new boost::interprocess::shared_memory_object(
+          boost::interprocess::open_only,
+          (shared_memory_identifier + "tap_").c_str(),
+          boost::interprocess::read_only));
+
+  data_region_ = std::unique_ptr<boost::interprocess::mapped_region>(
+      new boost::interprocess::mapped_region(*data_shm_,
+                                             boost::interprocess::read_only));
+
+  desc_region_ = std::unique_ptr<boost::interprocess::mapped_region>(
+      new boost::interprocess::mapped_region(*desc_shm_,
+                                             boost::interprocess::read_only));
+
+  status_region_ = std::unique_ptr<boost::interprocess::mapped_region>(
+      new boost::interprocess::mapped_region(*status_shm_,
+                                             boost::interprocess::read_only));
+
+  status_ = reinterpret_cast<const TimesliceTapStatus*>(
+      status_region_->get_address());
+
+  items_ = std::unique_ptr<SharedMemoryQueue<TimesliceWorkItem>>(
+      new SharedMemoryQueue<TimesliceWorkItem>(
+          boost::interprocess::open_only,
+          shared_memory_identifier + "tap_items_"));
+}
+
+StorableTimeslice* TimesliceTap::do_get() {
+  TimesliceWorkItem wi;
+  while (!eos_) {
+    if (!items_->pop(wi)) {
+      eos_ = true;
+    } else if (StorableTimeslice* ts = copy(wi)) {
+      return ts;
+    }
+  }
+  return nullptr;
+}
+
+StorableTimeslice* TimesliceTap::do_try_get() {
+  TimesliceWorkItem wi;
+  while (!eos_) {
+    if (items_->try_pop(wi)) {
+      if (StorableTimeslice* ts = copy(wi)) {
+        return ts;
+      }
+    } else if (items_->is_closed()) {
+      // items sent before the end of stream are visible now
+      if (!items_->try_pop(wi)) {
+        eos_ = true;
+      } else if (StorableTimeslice* ts = copy(wi)) {
+        return ts;
+      }
+    } else {
+      break;
+    }
+  }
+  return nullptr;
+}
+
+StorableTimeslice* TimesliceTap::do_get_for(std::chrono::nanoseconds timeout) {
+  auto deadline = std::chrono::steady_clock::now() + timeout;
+  TimesliceWorkItem wi;
+  while (!eos_) {
+    auto now = std::chrono::steady_clock::now();
+    if (items_->pop_for(wi, std::max(deadline - now,
+                                     std::chrono::steady_clock::duration(0)))) {
+      if (StorableTimeslice* ts = copy(wi)) {
+        return ts;
+      }
+    } else {
+      return do_try_get();
+    }
+  }
+  return nullptr;
+}
+
+StorableTimeslice* TimesliceTap::copy(const TimesliceWorkItem& work_item) {
+  const TimesliceDescriptor& ts_desc = work_item.ts_desc;
+  const uint8_t* data =
+      reinterpret_cast<const uint8_t*>(data_region_->get_address());
+  const TimesliceComponentDescriptor* desc =
+      reinterpret_cast<const TimesliceComponentDescriptor*>(
+          desc_region_->get_address());
+  uint64_t data_buffer_size = UINT64_C(1) << work_item.data_buffer_size_exp;
+  uint64_t descriptor_offset =
+      ts_desc.ts_pos & ((UINT64_C(1) << work_item.desc_buffer_size_exp) - 1);
+
+  bool absent_markers =
+      desc_region_->get_size() > work_item.desc_buffers_size();
+
+  std::vector<TimesliceComponentDescriptor> desc_copy(ts_desc.num_components);
+  std::vector<std::vector<uint8_t>> data_copy(ts_desc.num_components);
+  bool valid = !released(work_item);
+  for (uint64_t c = 0; valid && c < ts_desc.num_components; ++c) {
+    desc_copy[c] =
+        desc[(c << work_item.desc_buffer_size_exp) + descriptor_offset];
+    if (absent_markers) {
+      // absent markers follow the descriptor buffers (see TimesliceBuffer)
+      const TimesliceComponentDescriptor& marker =
+          desc[((ts_desc.num_components + c)
+                << work_item.desc_buffer_size_exp) +
+               descriptor_offset];
+      if (marker.offset == ts_desc.ts_pos) {
+        desc_copy[c] = marker;
+      }
+    }
+    uint64_t offset = desc_copy[c].offset & (data_buffer_size - 1);
+    // stale descriptor, the position has already been reused
+    if (desc_copy[c].ts_num != ts_desc.index ||
+        desc_copy[c].size > data_buffer_size - offset) {
+      valid = false;
+      break;
+    }
+    const uint8_t* data_c =
+        data + (c << work_item.data_buffer_size_exp) + offset;
+    data_copy[c].resize(desc_copy[c].size);
+    std::memcpy(data_copy[c].data(), data_c, desc_copy[c].size);
+  }
+
+  // the copy is consistent if the buffer space has not been released
+  // in the meantime
+  std::atomic_thread_fence(std::memory_order_acquire);
+  if (!valid || released(work_item)) {
+    ++overwritten_;
+    return nullptr;
+  }
+
+  ++received_;
+  return new StorableTimeslice(ts_desc, std::move(data_copy),
+                               std::move(desc_copy));
+}
+
+} // namespace fles
@@ -0,0 +1,105 @@
+// Copyright 2026 agent <agent@local>
+/// \file
+/// \brief Defines the fles::TimesliceTap class.
+#pragma once
+
+#include "SharedMemoryQueue.hpp"
+#include "StorableTimeslice.hpp"
+#include "TimesliceSource.hpp"
+#include "TimesliceTapStatus.hpp"
+#include "TimesliceWorkItem.hpp"
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/interprocess/shared_memory_object.hpp>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace fles {
+
+/**
+ * \brief The TimesliceTap class receives copies of a sampled subset of the
+ * timeslices in a timeslice buffer for monitoring purposes.
+ *
+ * In contrast to a TimesliceReceiver, a tap never holds on to buffer space
+ * and never sends completions, so it has no effect on the timeslice
+ * processors. The timeslices offered to the taps are copied optimistically
+ * and validated against the acknowledged position of the buffer afterwards.
+ * Copies of timeslices that may have been overwritten in the meantime are
+ * discarded. Timeslices are also lost if the taps do not keep up.
+ *
+ * The producer has to enable the tap (see TimesliceBuffer).
+ */
+class TimesliceTap : public TimesliceSource {
+public:
+  /// Construct timeslice tap connected to a given shared memory.
+  explicit TimesliceTap(const std::string& shared_memory_identifier);
+
+  /// Delete copy constructor (non-copyable).
+  TimesliceTap(const TimesliceTap&) = delete;
+  /// Delete assignment operator (non-copyable).
+  void operator=(const TimesliceTap&) = delete;
+
+  ~TimesliceTap() override = default;
+
+  bool eos() const override { return eos_; }
+
+  /// Retrieve the sampling interval (every n-th timeslice index).
+  uint32_t sampling() const { return status_->sampling; }
+
+  /// Retrieve the number of timeslices offered to the taps.
+  uint64_t sampled() const {
+    return status_->sampled.load(std::memory_order_relaxed);
+  }
+
+  /// Retrieve the number of sampled timeslices not queued for the taps.
+  uint64_t lost() const {
+    return status_->lost.load(std::memory_order_relaxed);
+  }
+
+  /// Retrieve the number of copies discarded by this tap.
+  uint64_t overwritten() const { return overwritten_; }
+
+  /// Retrieve the number of timeslices received by this tap.
+  uint64_t received() const { return received_; }
+
+private:
+  StorableTimeslice* do_get() override;
+  StorableTimeslice* do_try_get() override;
+  StorableTimeslice* do_get_for(std::chrono::nanoseconds timeout) override;
+
+  /// Copy a timeslice from the buffer.
+  /** \return pointer to the copy, or nullptr if it may have been
+      overwritten */
+  StorableTimeslice* copy(const TimesliceWorkItem& work_item);
+
+  /// Check whether a timeslice may have been overwritten.
+  bool released(const TimesliceWorkItem& work_item) const {
+    return status_->acked.load(std::memory_order_acquire) >
+           work_item.ts_desc.ts_pos;
+  }
+
+  std::unique_ptr<boost::interprocess::shared_memory_object> data_shm_;
+  std::unique_ptr<boost::interprocess::shared_memory_object> desc_shm_;
+  std::unique_ptr<boost::interprocess::shared_memory_object> status_shm_;
+
+  std::unique_ptr<boost::interprocess::mapped_region> data_region_;
+  std::unique_ptr<boost::interprocess::mapped_region> desc_region_;
+  std::unique_ptr<boost::interprocess::mapped_region> status_region_;
+
+  /// The shared state of the buffer and its taps.
+  const TimesliceTapStatus* status_;
+
+  std::unique_ptr<SharedMemoryQueue<TimesliceWorkItem>> items_;
+
+  /// Number of copies discarded by this tap.
+  uint64_t overwritten_ = 0;
+
+  /// Number of timeslices received by this tap.
+  uint64_t received_ = 0;
+
+  /// The end-of-stream flag.
+  bool eos_ = false;
+};
+
+} // namespace fles
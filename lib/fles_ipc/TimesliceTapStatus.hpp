@@ -0,0 +1,30 @@
+// Copyright 2026 agent <agent@local>
+/// \file
+/// \brief Defines the fles::TimesliceTapStatus struct.
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace fles {
+
+/**
+ * \brief Shared state of a timeslice buffer and its monitoring taps.
+ *
+ * The timeslice builder publishes the acknowledged position of the
+ * timeslice buffer. Timeslices before this position have been completed and
+ * their buffer space may already be reused, so a tap discards any copy of
+ * such a timeslice.
+ */
+struct TimesliceTapStatus {
+  /// Acknowledged timeslice position
+  std::atomic<uint64_t> acked{0};
+  /// Number of timeslices offered to the taps
+  std::atomic<uint64_t> sampled{0};
+  /// Number of sampled timeslices discarded because the tap queue was full
+  std::atomic<uint64_t> lost{0};
+  /// Sampling interval (every n-th timeslice index is offered)
+  uint32_t sampling = 0;
+};
+
+} // namespace fles
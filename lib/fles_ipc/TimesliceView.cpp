@@ -2,35 +2,104 @@
 
 #include "TimesliceView.hpp"
 #include <iostream>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
 
 namespace fles {
 
+namespace {
+
+/// Recycled storage of destroyed TimesliceView objects.
+struct TimesliceViewPool {
+  /// Maximum number of recycled objects kept in the pool.
+  static constexpr std::size_t capacity = 1024;
+
+  TimesliceViewPool() {
+    // recycling must not allocate
+    blocks.reserve(capacity);
+    data_ptrs.reserve(capacity);
+    desc_ptrs.reserve(capacity);
+  }
+
+  std::mutex mutex;
+  std::vector<void*> blocks;
+  std::vector<std::vector<uint8_t*>> data_ptrs;
+  std::vector<std::vector<TimesliceComponentDescriptor*>> desc_ptrs;
+};
+
+TimesliceViewPool& pool() {
+  // never destroyed, as views may outlive static destruction
+  static TimesliceViewPool* pool = new TimesliceViewPool;
+  return *pool;
+}
+
+} // namespace
+
 TimesliceView::TimesliceView(
     TimesliceWorkItem work_item,
     uint8_t* data,
     TimesliceComponentDescriptor* desc,
-    std::shared_ptr<boost::interprocess::message_queue> completions_mq)
-    : completions_mq_(std::move(completions_mq)) {
+    bool absent_markers,
+    std::shared_ptr<SharedMemoryQueue<TimesliceCompletion>> completions,
+    const ComponentPredicate& predicate)
+    : completions_(std::move(completions)) {
   timeslice_descriptor_ = work_item.ts_desc;
   completion_ = {timeslice_descriptor_.ts_pos};
 
+  // reuse access pointer vectors of a previous object
+  {
+    TimesliceViewPool& p = pool();
+    std::lock_guard<std::mutex> lock(p.mutex);
+    if (!p.data_ptrs.empty()) {
+      data_ptr_ = std::move(p.data_ptrs.back());
+      p.data_ptrs.pop_back();
+      desc_ptr_ = std::move(p.desc_ptrs.back());
+      p.desc_ptrs.pop_back();
+    }
+  }
+
   // initialize access pointer vectors
-  data_ptr_.resize(num_components());
-  desc_ptr_.resize(num_components());
+  uint64_t num_all_components = timeslice_descriptor_.num_components;
+  data_ptr_.resize(num_all_components);
+  desc_ptr_.resize(num_all_components);
   uint64_t descriptor_offset =
       timeslice_descriptor_.ts_pos &
       ((UINT64_C(1) << work_item.desc_buffer_size_exp) - 1);
   uint64_t data_offset_mask =
       (UINT64_C(1) << work_item.data_buffer_size_exp) - 1;
-  for (size_t c = 0; c < num_components(); ++c) {
-    desc_ptr_[c] =
+  uint64_t selected = 0;
+  for (size_t c = 0; c < num_all_components; ++c) {
+    TimesliceComponentDescriptor* desc_c =
         desc + (c << work_item.desc_buffer_size_exp) + descriptor_offset;
-    data_ptr_[c] = data + (c << work_item.data_buffer_size_exp) +
-                   (desc_ptr_[c]->offset & data_offset_mask);
+    if (absent_markers) {
+      // absent markers follow the descriptor buffers (see TimesliceBuffer)
+      TimesliceComponentDescriptor* marker_c =
+          desc +
+          ((num_all_components + c) << work_item.desc_buffer_size_exp) +
+          descriptor_offset;
+      if (marker_c->offset == timeslice_descriptor_.ts_pos) {
+        desc_c = marker_c;
+      }
+    }
+    uint8_t* data_c = data + (c << work_item.data_buffer_size_exp) +
+                      (desc_c->offset & data_offset_mask);
+    if (predicate &&
+        (desc_c->num_microslices == 0 ||
+         !predicate(*reinterpret_cast<const MicrosliceDescriptor*>(data_c)))) {
+      continue;
+    }
+    desc_ptr_[selected] = desc_c;
+    data_ptr_[selected] = data_c;
+    ++selected;
   }
+  data_ptr_.resize(selected);
+  desc_ptr_.resize(selected);
+  timeslice_descriptor_.num_components = selected;
 
   // consistency check
-  for (size_t c = 1; c < num_components(); ++c) {
+  for (size_t c = 0; c < num_components(); ++c) {
     if (timeslice_descriptor_.index != desc_ptr_[c]->ts_num) {
       std::cerr << "error: index=" << timeslice_descriptor_.index << ", ts_num["
                 << c << "]=" << desc_ptr_[c]->ts_num << std::endl;
@@ -39,12 +108,44 @@ TimesliceView::TimesliceView(
 }
 
 TimesliceView::~TimesliceView() {
-  try {
-    completions_mq_->send(&completion_, sizeof(completion_), 0);
-  } catch (boost::interprocess::interprocess_exception& e) {
-    std::cerr << "exception in destructor ~TimesliceView(): " << e.what();
-    // FIXME: this may not be sufficient in case of error
+  completions_->push(completion_);
+
+  data_ptr_.clear();
+  desc_ptr_.clear();
+  TimesliceViewPool& p = pool();
+  std::lock_guard<std::mutex> lock(p.mutex);
+  if (p.data_ptrs.size() < TimesliceViewPool::capacity) {
+    p.data_ptrs.push_back(std::move(data_ptr_));
+    p.desc_ptrs.push_back(std::move(desc_ptr_));
+  }
+}
+
+void* TimesliceView::operator new(std::size_t size) {
+  if (size == sizeof(TimesliceView)) {
+    TimesliceViewPool& p = pool();
+    std::lock_guard<std::mutex> lock(p.mutex);
+    if (!p.blocks.empty()) {
+      void* ptr = p.blocks.back();
+      p.blocks.pop_back();
+      return ptr;
+    }
+  }
+  return ::operator new(size);
+}
+
+void TimesliceView::operator delete(void* ptr, std::size_t size) {
+  if (ptr == nullptr) {
+    return;
+  }
+  if (size == sizeof(TimesliceView)) {
+    TimesliceViewPool& p = pool();
+    std::lock_guard<std::mutex> lock(p.mutex);
+    if (p.blocks.size() < TimesliceViewPool::capacity) {
+      p.blocks.push_back(ptr);
+      return;
+    }
   }
+  ::operator delete(ptr);
 }
 
 } // namespace fles
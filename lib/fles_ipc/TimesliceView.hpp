@@ -3,10 +3,12 @@
 /// \brief Defines the fles::TimesliceView class.
 #pragma once
 
+#include "ComponentSelection.hpp"
+#include "SharedMemoryQueue.hpp"
 #include "Timeslice.hpp"
 #include "TimesliceCompletion.hpp"
 #include "TimesliceWorkItem.hpp"
-#include <boost/interprocess/ipc/message_queue.hpp>
+#include <cstddef>
 #include <cstdint>
 #include <memory>
 
@@ -15,6 +17,13 @@ namespace fles {
 /**
  * \brief The TimesliceView class provides access to the data of a single
  * timeslice in memory.
+ *
+ * The memory of destroyed TimesliceView objects, including their pointer
+ * tables, is recycled for subsequent objects to avoid heap allocations at high
+ * timeslice rates.
+ *
+ * If a component predicate is given, the view only contains the selected
+ * components. The data of the other components is not accessed.
  */
 class TimesliceView : public Timeslice {
 public:
@@ -25,19 +34,26 @@ public:
 
   ~TimesliceView() override;
 
+  /// Allocate storage from the pool of recycled objects.
+  static void* operator new(std::size_t size);
+  /// Return storage to the pool of recycled objects.
+  static void operator delete(void* ptr, std::size_t size);
+
 private:
   friend class TimesliceReceiver;
   friend class StorableTimeslice;
 
-  TimesliceView(
-      TimesliceWorkItem work_item,
-      uint8_t* data,
-      TimesliceComponentDescriptor* desc,
-      std::shared_ptr<boost::interprocess::message_queue> completions_mq);
+  TimesliceView(TimesliceWorkItem work_item,
+                uint8_t* data,
+                TimesliceComponentDescriptor* desc,
+                bool absent_markers,
+                std::shared_ptr<SharedMemoryQueue<TimesliceCompletion>>
+                    completions,
+                const ComponentPredicate& predicate = ComponentPredicate());
 
   TimesliceCompletion completion_ = TimesliceCompletion();
 
-  std::shared_ptr<boost::interprocess::message_queue> completions_mq_;
+  std::shared_ptr<SharedMemoryQueue<TimesliceCompletion>> completions_;
 };
 
 } // namespace fles
@@ -3,6 +3,7 @@
 /// \brief Defines the fles::TimesliceWorkItem serializable struct.
 #pragma once
 
+#include "TimesliceComponentDescriptor.hpp"
 #include "TimesliceDescriptor.hpp"
 #include <boost/serialization/access.hpp>
 #include <cstdint>
@@ -22,6 +23,14 @@ struct TimesliceWorkItem {
   /// Size exponential (in bytes) of each descriptor buffer
   uint32_t desc_buffer_size_exp;
 
+  /// Retrieve the size (in bytes) of the descriptor buffers of all
+  /// components. If the descriptor memory is larger, the absent markers
+  /// follow (see TimesliceBuffer).
+  uint64_t desc_buffers_size() const {
+    return (ts_desc.num_components << desc_buffer_size_exp) *
+           sizeof(TimesliceComponentDescriptor);
+  }
+
   friend class boost::serialization::access;
   /// Provide boost serialization access.
   template <class Archive>
@@ -0,0 +1,105 @@
+// Copyright 2026 agent <agent@local>
+
+#include "TimesliceWorker.hpp"
+#include "TimesliceCredit.hpp"
+
+namespace fles {
+
+TimesliceWorker::TimesliceWorker(const std::string& address,
+                                 uint32_t credits) {
+  worker_.setsockopt(ZMQ_LINGER, 0);
+  worker_.connect(address.c_str());
+  send_credit(credits > 0 ? credits : 1, 0);
+}
+
+TimesliceWorker::~TimesliceWorker() {
+  if (pending_ack_) {
+    // allow the final acknowledgement to be delivered
+    worker_.setsockopt(ZMQ_LINGER, 100);
+    send_pending_ack();
+  }
+}
+
+void TimesliceWorker::send_credit(uint32_t credits, uint32_t acked) {
+  TimesliceCredit credit = TimesliceCredit();
+  credit.credits = credits;
+  credit.acked = acked;
+  credit.ts_index = ts_index_;
+  zmq::message_t message(&credit, sizeof(credit));
+  worker_.send(message);
+}
+
+void TimesliceWorker::send_pending_ack() {
+  if (pending_ack_) {
+    send_credit(1, 1);
+    pending_ack_ = false;
+  }
+}
+
+fles::Timeslice* TimesliceWorker::do_get() { return receive(0); }
+
+fles::Timeslice* TimesliceWorker::do_try_get() {
+  return receive(ZMQ_DONTWAIT);
+}
+
+fles::Timeslice*
+TimesliceWorker::do_get_for(std::chrono::nanoseconds timeout) {
+  if (eos_flag) {
+    return nullptr;
+  }
+
+  // acknowledge before waiting, the distributor may be waiting for it
+  send_pending_ack();
+
+  // zeromq polls with millisecond resolution, round up
+  auto timeout_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+      timeout + std::chrono::milliseconds(1) - std::chrono::nanoseconds(1));
+  zmq::pollitem_t item{static_cast<void*>(worker_), 0, ZMQ_POLLIN, 0};
+  zmq::poll(&item, 1, static_cast<long>(timeout_ms.count()));
+  return receive(ZMQ_DONTWAIT);
+}
+
+fles::Timeslice* TimesliceWorker::receive(int flags) {
+  if (eos_flag) {
+    return nullptr;
+  }
+
+  // the previous timeslice is completed when the next one is requested
+  send_pending_ack();
+
+  while (true) {
+    zmq::message_t message;
+    if (!worker_.recv(&message, flags)) {
+      return nullptr;
+    }
+
+    if (message.size() == 0 && !message.more()) {
+      // an empty message signals end-of-stream
+      eos_flag = true;
+      return nullptr;
+    }
+
+    if (TimesliceMultipartView::is_header(message)) {
+      try {
+        auto ts =
+            new fles::TimesliceMultipartView(std::move(message), worker_);
+        ts_index_ = ts->index();
+        pending_ack_ = true;
+        return ts;
+      } catch (std::runtime_error& e) {
+        // all frames of the message have been received, skip it below
+      }
+    } else {
+      while (message.more()) {
+        worker_.recv(&message);
+      }
+    }
+
+    // skip the malformed message, but acknowledge it to the distributor,
+    // which would otherwise wait for it at end-of-stream
+    ++malformed_messages_;
+    send_credit(1, 1);
+  }
+}
+
+} // namespace fles
@@ -0,0 +1,68 @@
+// Copyright 2026 agent <agent@local>
+/// \file
+/// \brief Defines the fles::TimesliceWorker class.
+#pragma once
+
+#include "TimesliceMultipartView.hpp"
+#include "TimesliceSource.hpp"
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <zmq.hpp>
+
+namespace fles {
+/**
+ * \brief The TimesliceWorker class receives timeslice data sets from a
+ * TimesliceDistributor.
+ *
+ * The worker requests up to a given number of timeslices in advance. Each
+ * call to get() acknowledges the previously retrieved timeslice as completed
+ * and requests a further one. The final timeslice is acknowledged on the
+ * call to get() that returns end-of-stream, or on destruction. Malformed
+ * messages are skipped, counted, and acknowledged at once.
+ */
+class TimesliceWorker : public TimesliceSource {
+public:
+  /// Construct timeslice worker receiving from given ZMQ address.
+  explicit TimesliceWorker(const std::string& address, uint32_t credits = 1);
+
+  /// Delete copy constructor (non-copyable).
+  TimesliceWorker(const TimesliceWorker&) = delete;
+  /// Delete assignment operator (non-copyable).
+  void operator=(const TimesliceWorker&) = delete;
+
+  ~TimesliceWorker() override;
+
+  bool eos() const override { return eos_flag; }
+
+  /// Retrieve the number of malformed messages skipped.
+  uint64_t malformed_messages() const { return malformed_messages_; }
+
+private:
+  Timeslice* do_get() override;
+  Timeslice* do_try_get() override;
+  Timeslice* do_get_for(std::chrono::nanoseconds timeout) override;
+
+  /// Receive a timeslice using the given zeromq flags.
+  /** \return pointer to the timeslice, or nullptr if none is available */
+  Timeslice* receive(int flags);
+
+  /// Send a credit message to the distributor.
+  void send_credit(uint32_t credits, uint32_t acked);
+
+  /// Acknowledge the previously retrieved timeslice, if any.
+  void send_pending_ack();
+
+  zmq::context_t context_{1};
+  zmq::socket_t worker_{context_, ZMQ_DEALER};
+
+  /// Index of the most recently retrieved timeslice.
+  uint64_t ts_index_ = UINT64_MAX;
+  bool pending_ack_ = false;
+  /// Number of malformed messages skipped.
+  uint64_t malformed_messages_ = 0;
+
+  bool eos_flag = false;
+};
+
+} // namespace fles
@@ -5,6 +5,7 @@
 #include "ComputeNodeInfo.hpp"
 #include "LibfabricException.hpp"
 #include "Provider.hpp"
+#include "RemoteCqData.hpp"
 #include "RequestIdentifier.hpp"
 #include <cassert>
 #include <log.hpp>
@@ -20,18 +21,32 @@ ComputeNodeConnection::ComputeNodeConnection(
     uint8_t* data_ptr,
     uint32_t data_buffer_size_exp,
     fles::TimesliceComponentDescriptor* desc_ptr,
-    uint32_t desc_buffer_size_exp)
+    uint32_t desc_buffer_size_exp,
+    bool cq_data)
     : Connection(eq, connection_index, remote_connection_index),
       remote_info_(std::move(remote_info)), data_ptr_(data_ptr),
       data_buffer_size_exp_(data_buffer_size_exp), desc_ptr_(desc_ptr),
-      desc_buffer_size_exp_(desc_buffer_size_exp) {
+      desc_buffer_size_exp_(desc_buffer_size_exp), cq_data_(cq_data) {
   // send and receive only single StatusMessage struct
   max_send_wr_ = 2; // one additional wr to avoid race (recv before
   // send completion)
   max_send_sge_ = 1;
-  max_recv_wr_ = 1;
   max_recv_sge_ = 1;
 
+  if (cq_data_) {
+    if (Provider::getInst()->get_info()->domain_attr->cq_data_size < 4) {
+      throw LibfabricException("provider does not support remote CQ data");
+    }
+    if (desc_buffer_size_exp_ >= cq_data_desc_bits) {
+      throw LibfabricException("descriptor buffer too large for CQ data");
+    }
+    rx_cq_data_ =
+        (Provider::getInst()->get_info()->rx_attr->mode & FI_RX_CQ_DATA) != 0;
+  }
+  // additional receive buffers for writes with remote CQ data
+  recv_buffers_.resize(rx_cq_data_ ? 2 * cq_data_max_pending_writes + 1 : 1);
+  max_recv_wr_ = static_cast<uint32_t>(recv_buffers_.size());
+
   if (Provider::getInst()->is_connection_oriented()) {
     connection_oriented_ = true;
   } else {
@@ -49,18 +64,33 @@ ComputeNodeConnection::ComputeNodeConnection(
     /*InputNodeInfo remote_info, */ uint8_t* data_ptr,
     uint32_t data_buffer_size_exp,
     fles::TimesliceComponentDescriptor* desc_ptr,
-    uint32_t desc_buffer_size_exp)
+    uint32_t desc_buffer_size_exp,
+    bool cq_data)
     : Connection(eq, connection_index, remote_connection_index),
       data_ptr_(data_ptr), data_buffer_size_exp_(data_buffer_size_exp),
-      desc_ptr_(desc_ptr), desc_buffer_size_exp_(desc_buffer_size_exp) {
+      desc_ptr_(desc_ptr), desc_buffer_size_exp_(desc_buffer_size_exp),
+      cq_data_(cq_data) {
 
   // send and receive only single StatusMessage struct
   max_send_wr_ = 2; // one additional wr to avoid race (recv before
   // send completion)
   max_send_sge_ = 1;
-  max_recv_wr_ = 1;
   max_recv_sge_ = 1;
 
+  if (cq_data_) {
+    if (Provider::getInst()->get_info()->domain_attr->cq_data_size < 4) {
+      throw LibfabricException("provider does not support remote CQ data");
+    }
+    if (desc_buffer_size_exp_ >= cq_data_desc_bits) {
+      throw LibfabricException("descriptor buffer too large for CQ data");
+    }
+    rx_cq_data_ =
+        (Provider::getInst()->get_info()->rx_attr->mode & FI_RX_CQ_DATA) != 0;
+  }
+  // additional receive buffers for writes with remote CQ data
+  recv_buffers_.resize(rx_cq_data_ ? 2 * cq_data_max_pending_writes + 1 : 1);
+  max_recv_wr_ = static_cast<uint32_t>(recv_buffers_.size());
+
   if (Provider::getInst()->is_connection_oriented()) {
     connection_oriented_ = true;
   } else {
@@ -71,12 +101,17 @@ ComputeNodeConnection::ComputeNodeConnection(
   make_endpoint(Provider::getInst()->get_info(), "", "", pd, cq, av);
 }
 
-void ComputeNodeConnection::post_recv_status_message() {
+void ComputeNodeConnection::post_recv_status_message(size_t slot) {
   if (false) {
     L_(trace) << "[c" << remote_index_ << "] "
               << "[" << index_ << "] "
               << "POST RECEIVE status message";
   }
+  recv_sge.iov_base = &recv_buffers_[slot];
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wold-style-cast"
+  recv_wr.context = (void*)(ID_RECEIVE_STATUS | (index_ << 8) | (slot << 24));
+#pragma GCC diagnostic pop
   post_recv_msg(&recv_wr);
 }
 
@@ -92,6 +127,7 @@ void ComputeNodeConnection::post_send_status_message() {
     throw LibfabricException("Max number of pending send requests exceeded");
   }
   ++pending_send_requests_;
+  ++status_messages_sent_;
   post_send_msg(&send_wr);
 }
 
@@ -132,7 +168,8 @@ void ComputeNodeConnection::setup_mr(struct fid_domain* pd) {
               << fi_strerror(-res);
     throw LibfabricException("fi_mr_reg failed for send");
   }
-  res = fi_mr_reg(pd, &recv_status_message_, sizeof(InputChannelStatusMessage),
+  res = fi_mr_reg(pd, recv_buffers_.data(),
+                  recv_buffers_.size() * sizeof(InputChannelStatusMessage),
                   FI_RECV, 0, Provider::requested_key++, 0, &mr_recv_, nullptr);
   if (res) {
     L_(fatal) << "fi_mr_reg failed for recv: " << res << "="
@@ -156,7 +193,6 @@ void ComputeNodeConnection::setup_mr(struct fid_domain* pd) {
 
 void ComputeNodeConnection::setup() {
   // setup send and receive buffers
-  recv_sge.iov_base = &recv_status_message_;
   recv_sge.iov_len = sizeof(InputChannelStatusMessage);
 
   recv_wr_descs[0] = fi_mr_desc(mr_recv_);
@@ -164,10 +200,6 @@ void ComputeNodeConnection::setup() {
   recv_wr.msg_iov = &recv_sge;
   recv_wr.desc = recv_wr_descs;
   recv_wr.iov_count = 1;
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wold-style-cast"
-  recv_wr.context = (void*)(ID_RECEIVE_STATUS | (index_ << 8));
-#pragma GCC diagnostic pop
 
   send_sge.iov_base = &send_status_message_;
   send_sge.iov_len = sizeof(ComputeNodeStatusMessage);
@@ -182,8 +214,10 @@ void ComputeNodeConnection::setup() {
   send_wr.context = (void*)(ID_SEND_STATUS | (index_ << 8));
 #pragma GCC diagnostic pop
 
-  // post initial receive request
-  post_recv_status_message();
+  // post initial receive requests
+  for (size_t slot = 0; slot < recv_buffers_.size(); ++slot) {
+    post_recv_status_message(slot);
+  }
 }
 
 void ComputeNodeConnection::on_established(struct fi_eq_cm_entry* event) {
@@ -231,12 +265,31 @@ void ComputeNodeConnection::inc_ack_pointers(uint64_t ack_pos) {
       desc_ptr_[(ack_pos - 1) & ((UINT64_C(1) << desc_buffer_size_exp_) - 1)];
 
   cn_ack_.data = acked_ts.offset + acked_ts.size;
+
+  if (cq_data_) {
+    try_send_status_message();
+  }
 }
 
-void ComputeNodeConnection::on_complete_recv() {
+void ComputeNodeConnection::request_abort() {
+  send_status_message_.request_abort = true;
+  if (cq_data_) {
+    try_send_status_message();
+  }
+}
+
+void ComputeNodeConnection::on_complete_recv(size_t slot) {
+  ++status_messages_received_;
+  recv_status_message_ = recv_buffers_[slot];
+  if (recv_status_message_.final && cq_data_) {
+    // send FINAL status message when no other send is pending
+    try_send_status_message();
+    return;
+  }
   if (recv_status_message_.final) {
     // send FINAL status message
     send_status_message_.final = true;
+    send_status_message_.schedule_weight = 0;
     post_send_final_status_message();
     return;
   }
@@ -246,13 +299,102 @@ void ComputeNodeConnection::on_complete_recv() {
               << "COMPLETE RECEIVE status message"
               << " (wp.desc=" << recv_status_message_.wp.desc << ")";
   }
+  post_recv_status_message(slot);
+  if (cq_data_) {
+    // write pointers are signalled by remote CQ data, the message confirms
+    // the reception of earlier status messages
+    try_send_status_message();
+    return;
+  }
   cn_wp_ = recv_status_message_.wp;
-  post_recv_status_message();
   send_status_message_.ack = cn_ack_;
+  add_announcement();
   post_send_status_message();
 }
 
-void ComputeNodeConnection::on_complete_send() { pending_send_requests_--; }
+void ComputeNodeConnection::on_announcement() {
+  if (cq_data_) {
+    try_send_status_message();
+  }
+}
+
+void ComputeNodeConnection::add_announcement() {
+  if (announcement_pending()) {
+    send_status_message_.schedule_epoch = announced_;
+    send_status_message_.schedule_weight = announcements_->weight(announced_);
+    ++announced_;
+  } else {
+    send_status_message_.schedule_weight = 0;
+  }
+}
+
+void ComputeNodeConnection::on_remote_cq_data(uint64_t wr_id,
+                                              uint64_t data) {
+  if (rx_cq_data_) {
+    // a receive buffer has been consumed, repost it
+    post_recv_status_message(wr_id >> 24);
+  }
+
+  uint64_t desc = cq_data_desc(data, cn_wp_.desc);
+  if (desc - cn_wp_.desc > (UINT64_C(1) << desc_buffer_size_exp_)) {
+    L_(error) << "[c" << remote_index_ << "] "
+              << "[" << index_ << "] "
+              << "ignoring outdated remote CQ data";
+    return;
+  }
+  if (desc == cn_wp_.desc) {
+    return;
+  }
+  const fles::TimesliceComponentDescriptor& written_ts =
+      desc_ptr_[(desc - 1) & ((UINT64_C(1) << desc_buffer_size_exp_) - 1)];
+  cn_wp_.desc = desc;
+  cn_wp_.data = written_ts.offset + written_ts.size;
+}
+
+void ComputeNodeConnection::try_send_status_message() {
+  // the send buffer must not change while a send is pending
+  if (pending_send_requests_ != 0 || send_status_message_.final) {
+    return;
+  }
+  if (recv_status_message_.final) {
+    send_status_message_.final = true;
+    send_status_message_.schedule_weight = 0;
+    post_send_final_status_message();
+    return;
+  }
+
+  // the input channel has to confirm the reception of earlier status
+  // messages to provide receive buffers
+  if (status_messages_sent_ - recv_status_message_.status_received >=
+      cq_data_status_buffers) {
+    return;
+  }
+
+  bool abort = send_status_message_.request_abort && !abort_sent_;
+  bool announce = announcement_pending();
+  if (!abort && !announce && cn_ack_ == send_status_message_.ack) {
+    return;
+  }
+  // acknowledge in batches of an eighth of the buffer, or as soon as
+  // everything written has been processed
+  uint64_t desc_step = (UINT64_C(1) << desc_buffer_size_exp_) >> 3;
+  uint64_t data_step = (UINT64_C(1) << data_buffer_size_exp_) >> 3;
+  if (abort || announce || cn_ack_ == cn_wp_ ||
+      cn_ack_.desc >= send_status_message_.ack.desc + desc_step ||
+      cn_ack_.data >= send_status_message_.ack.data + data_step) {
+    send_status_message_.ack = cn_ack_;
+    abort_sent_ = send_status_message_.request_abort;
+    add_announcement();
+    post_send_status_message();
+  }
+}
+
+void ComputeNodeConnection::on_complete_send() {
+  pending_send_requests_--;
+  if (cq_data_) {
+    try_send_status_message();
+  }
+}
 
 void ComputeNodeConnection::on_complete_send_finalize() { done_ = true; }
 
@@ -292,6 +434,7 @@ void ComputeNodeConnection::send_ep_addr() {
   assert(res == 0);
   send_wr.addr = partner_addr_;
   ++pending_send_requests_;
+  ++status_messages_sent_;
   post_send_msg(&send_wr);
 }
 
@@ -8,6 +8,7 @@
 #include "InputChannelStatusMessage.hpp"
 #include "InputNodeInfo.hpp"
 #include "TimesliceComponentDescriptor.hpp"
+#include "WeightAnnouncements.hpp"
 #include <boost/format.hpp>
 #include <chrono>
 
@@ -29,7 +30,8 @@ public:
                         uint8_t* data_ptr,
                         uint32_t data_buffer_size_exp,
                         fles::TimesliceComponentDescriptor* desc_ptr,
-                        uint32_t desc_buffer_size_exp);
+                        uint32_t desc_buffer_size_exp,
+                        bool cq_data);
 
   ComputeNodeConnection(struct fid_eq* eq,
                         struct fid_domain* pd,
@@ -40,22 +42,35 @@ public:
                         /*InputNodeInfo remote_info, */ uint8_t* data_ptr,
                         uint32_t data_buffer_size_exp,
                         fles::TimesliceComponentDescriptor* desc_ptr,
-                        uint32_t desc_buffer_size_exp);
+                        uint32_t desc_buffer_size_exp,
+                        bool cq_data);
 
   ComputeNodeConnection(const ComputeNodeConnection&) = delete;
   void operator=(const ComputeNodeConnection&) = delete;
 
-  /// Post a receive work request (WR) to the receive queue
-  void post_recv_status_message();
+  /// Post a receive work request (WR) for a receive buffer to the receive
+  /// queue
+  void post_recv_status_message(size_t slot);
 
   void post_send_status_message();
 
   void post_send_final_status_message();
 
-  void request_abort() { send_status_message_.request_abort = true; }
+  void request_abort();
 
   bool abort_flag() { return recv_status_message_.abort; }
 
+  /// Pass on the compute node's weights with the status messages, starting
+  /// at the given epoch.
+  void set_announcements(const WeightAnnouncements* announcements,
+                         uint64_t first_epoch) {
+    announcements_ = announcements;
+    announced_ = first_epoch;
+  }
+
+  /// Handle new weights announced by the compute node.
+  void on_announcement();
+
   virtual void setup() override;
 
   virtual void setup_mr(struct fid_domain* pd) override;
@@ -70,7 +85,10 @@ public:
 
   void inc_ack_pointers(uint64_t ack_pos);
 
-  void on_complete_recv();
+  void on_complete_recv(size_t slot);
+
+  /// Handle arrival of timeslice components signalled by remote CQ data.
+  void on_remote_cq_data(uint64_t wr_id, uint64_t data);
 
   void on_complete_send();
 
@@ -78,6 +96,14 @@ public:
 
   const ComputeNodeBufferPosition& cn_wp() const { return cn_wp_; }
 
+  /// Retrieve the number of status messages sent to the input channel.
+  uint64_t status_messages_sent() const { return status_messages_sent_; }
+
+  /// Retrieve the number of status messages received from the input channel.
+  uint64_t status_messages_received() const {
+    return status_messages_received_;
+  }
+
   virtual std::unique_ptr<std::vector<uint8_t>> get_private_data() override;
 
   struct BufferStatus {
@@ -139,10 +165,26 @@ public:
   bool is_connection_finalized();
 
 private:
+  /// Send a status message if no other is pending and enough progress has
+  /// been made (cq-data protocol mode).
+  void try_send_status_message();
+
+  /// Check if a weight is waiting to be announced to the input channel.
+  bool announcement_pending() const {
+    return announcements_ != nullptr && announced_ < announcements_->end();
+  }
+
+  /// Add the next announced weight (if any) to the status message.
+  void add_announcement();
+
   ComputeNodeStatusMessage send_status_message_ = ComputeNodeStatusMessage();
   ComputeNodeBufferPosition cn_ack_ = ComputeNodeBufferPosition();
 
   InputChannelStatusMessage recv_status_message_ = InputChannelStatusMessage();
+
+  /// Receive buffers for status messages. In cq-data protocol mode, each
+  /// write with remote CQ data may consume a receive buffer.
+  std::vector<InputChannelStatusMessage> recv_buffers_;
   ComputeNodeBufferPosition cn_wp_ = ComputeNodeBufferPosition();
 
   struct fid_mr* mr_data_ = nullptr;
@@ -175,6 +217,27 @@ private:
 
   uint32_t pending_send_requests_{0};
 
+  /// Number of status messages sent to the input channel.
+  uint64_t status_messages_sent_ = 0;
+
+  /// Number of status messages received from the input channel.
+  uint64_t status_messages_received_ = 0;
+
+  /// Flag, true if write progress is signalled by remote CQ data.
+  bool cq_data_ = false;
+
+  /// Flag, true if remote CQ data consumes a receive buffer.
+  bool rx_cq_data_ = false;
+
+  /// Flag, true if the abort request has been sent.
+  bool abort_sent_ = false;
+
+  /// Weights announced by the compute node (if any).
+  const WeightAnnouncements* announcements_ = nullptr;
+
+  /// Next epoch to announce to the input channel.
+  uint64_t announced_ = 0;
+
   fi_addr_t partner_addr_;
 };
 } // namespace tl_libfabric
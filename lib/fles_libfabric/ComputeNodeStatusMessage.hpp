@@ -10,11 +10,15 @@
 
 namespace tl_libfabric {
 /// Structure representing a status update message sent from compute buffer to
-/// input channel.
+/// input channel. It also carries the compute node's weight for the
+/// assignment of a future timeslice epoch (see TimesliceSchedule), one epoch
+/// per message and in ascending order.
 struct ComputeNodeStatusMessage {
   ComputeNodeBufferPosition ack;
   bool request_abort;
   bool final;
+  uint64_t schedule_epoch;  ///< Epoch of the announced weight.
+  uint32_t schedule_weight; ///< Announced weight (zero if none).
   //
   bool connect;
   ComputeNodeInfo info;
@@ -80,6 +80,13 @@ void Connection::connect(const std::string& hostname,
 
   fi_freeinfo(hints);
 
+  // use the queue depth and limits granted by the provider
+  if (info2->tx_attr->size > 0) {
+    max_send_wr_ = static_cast<uint32_t>(info2->tx_attr->size);
+  }
+  max_send_sge_ = static_cast<uint32_t>(info2->tx_attr->iov_limit);
+  max_inline_data_ = static_cast<uint32_t>(info2->tx_attr->inject_size);
+
   err = fi_endpoint(domain, info2, &ep_, this);
   if (err) {
     L_(fatal) << "fi_endpoint failed: " << err << "=" << fi_strerror(-err);
@@ -126,7 +126,7 @@ public:
   int poll_completion() {
     const int ne_max = 10;
 
-    struct fi_cq_entry wc[ne_max];
+    struct fi_cq_data_entry wc[ne_max];
     int ne;
     int ne_total = 0;
 
@@ -155,7 +155,11 @@ public:
 #pragma GCC diagnostic ignored "-Wold-style-cast"
         // L_(trace) << "on_completion(wr_id=" <<
         // (uintptr_t)wc[i].op_context << ")";
-        on_completion((uintptr_t)wc[i].op_context);
+        if (wc[i].flags & FI_REMOTE_CQ_DATA) {
+          on_remote_cq_data((uintptr_t)wc[i].op_context, wc[i].data);
+        } else {
+          on_completion((uintptr_t)wc[i].op_context);
+        }
 #pragma GCC diagnostic pop
       }
     }
@@ -246,7 +250,7 @@ protected:
     memset(&cq_attr, 0, sizeof(cq_attr));
     cq_attr.size = num_cqe_;
     cq_attr.flags = 0;
-    cq_attr.format = FI_CQ_FORMAT_CONTEXT;
+    cq_attr.format = FI_CQ_FORMAT_DATA;
     cq_attr.wait_obj = FI_WAIT_NONE;
     cq_attr.signaling_vector = Provider::vector++; // ??
     cq_attr.wait_cond = FI_CQ_COND_NONE;
@@ -341,6 +345,11 @@ private:
   /// Completion notification event dispatcher. Called by the event loop.
   virtual void on_completion(uint64_t wc) = 0;
 
+  /// Remote CQ data event dispatcher. Called by the event loop.
+  virtual void on_remote_cq_data(uint64_t /* wc */, uint64_t /* data */) {
+    throw LibfabricException("unexpected remote CQ data");
+  }
+
   /// Total number of bytes transmitted.
   uint64_t aggregate_bytes_sent_ = 0;
 
@@ -6,8 +6,10 @@
 #include "LibfabricException.hpp"
 #include "MicrosliceDescriptor.hpp"
 #include "Provider.hpp"
+#include "RemoteCqData.hpp"
 #include "RequestIdentifier.hpp"
 #include "TimesliceComponentDescriptor.hpp"
+#include <algorithm>
 #include <cassert>
 #include <cstring>
 #include <log.hpp>
@@ -16,24 +18,36 @@
 
 namespace tl_libfabric {
 
+constexpr size_t InputChannelConnection::max_data_write_iov;
+
 InputChannelConnection::InputChannelConnection(
     struct fid_eq* eq,
     uint_fast16_t connection_index,
     uint_fast16_t remote_connection_index,
     unsigned int max_send_wr,
-    unsigned int max_pending_write_requests)
+    unsigned int max_pending_write_requests,
+    unsigned int max_timeslices_per_write,
+    bool cq_data)
     : Connection(eq, connection_index, remote_connection_index),
-      max_pending_write_requests_(max_pending_write_requests) {
+      max_pending_write_requests_(max_pending_write_requests),
+      max_timeslices_per_write_(max_timeslices_per_write), cq_data_(cq_data) {
   assert(max_pending_write_requests_ > 0);
+  assert(max_timeslices_per_write_ > 0 && max_timeslices_per_write_ <= 0xFF);
 
   max_send_wr_ = max_send_wr; // typical hca maximum: 16k
   max_send_sge_ = 4;          // max. two chunks each for descriptors and data
 
-  max_recv_wr_ = 1; // receive only single ComputeNodeStatusMessage struct
+  // receive single ComputeNodeStatusMessage structs, several of them
+  // unanswered in cq-data protocol mode
+  recv_buffers_.resize(cq_data_ ? cq_data_status_buffers + 1 : 1);
+  max_recv_wr_ = static_cast<uint32_t>(recv_buffers_.size());
   max_recv_sge_ = 1;
 
   max_inline_data_ = sizeof(fles::TimesliceComponentDescriptor);
 
+  desc_staging_.alloc_with_size(max_pending_write_requests_ *
+                                max_timeslices_per_write_);
+
   send_status_message_.info.index = remote_index_;
 
   if (Provider::getInst()->is_connection_oriented()) {
@@ -79,136 +93,49 @@ void InputChannelConnection::send_data(struct iovec* sge,
                                        uint64_t desc_length,
                                        uint64_t data_length,
                                        uint64_t skip) {
-  int num_sge2 = 0;
-  struct iovec sge2[4];
-  void* desc2[4];
-
   uint64_t cn_wp_data = cn_wp_.data;
   cn_wp_data += skip;
 
   uint64_t cn_data_buffer_mask =
       (UINT64_C(1) << remote_info_.data_buffer_size_exp) - 1;
-  uint64_t cn_desc_buffer_mask =
-      (UINT64_C(1) << remote_info_.desc_buffer_size_exp) - 1;
   uint64_t target_bytes_left =
       (UINT64_C(1) << remote_info_.data_buffer_size_exp) -
       (cn_wp_data & cn_data_buffer_mask);
 
-  // split sge list if necessary
-  int num_sge_cut = 0;
-  if (data_length + desc_length * sizeof(fles::MicrosliceDescriptor) >
-      target_bytes_left) {
-    for (int i = 0; i < num_sge; ++i) {
-      if (sge[i].iov_len <= target_bytes_left) {
-        target_bytes_left -= sge[i].iov_len;
-      } else {
-        if (target_bytes_left) {
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wold-style-cast"
-          sge2[num_sge2].iov_base =
-              (uint8_t*)sge[i].iov_base + target_bytes_left;
-#pragma GCC diagnostic pop
-          sge2[num_sge2].iov_len = sge[i].iov_len - target_bytes_left;
-          desc2[num_sge2++] = desc[i];
-          sge[i].iov_len = target_bytes_left;
-          target_bytes_left = 0;
-        } else {
-          sge2[num_sge2] = sge[i];
-          desc2[num_sge2++] = desc[i];
-          ++num_sge_cut;
-        }
-      }
-    }
-  }
-  num_sge -= num_sge_cut;
-
-  struct fi_msg_rma send_wr_ts;
-  struct fi_msg_rma send_wr_tswrap;
-  struct fi_msg_rma send_wr_tscdesc;
-  struct fi_rma_iov rma_iov[1];
-
+  // append to data write request, split sge list if necessary
   uint64_t remote_addr =
       remote_info_.data.addr + (cn_wp_data & cn_data_buffer_mask);
-  for (int i = 0; i < num_sge; i++) {
-
-    memset(rma_iov, 0, sizeof(rma_iov));
-    rma_iov[0].addr = remote_addr;
-    rma_iov[0].len = sge[i].iov_len;
-    rma_iov[0].key = remote_info_.data.rkey;
-
-    remote_addr += sge[i].iov_len;
-
-    memset(&send_wr_ts, 0, sizeof(send_wr_ts));
-    send_wr_ts.msg_iov = &sge[i];
-    send_wr_ts.desc = &desc[i];
-    send_wr_ts.iov_count = 1;
-    // addr
-    send_wr_ts.rma_iov = rma_iov;
-    send_wr_ts.rma_iov_count = 1;
-    send_wr_ts.addr = partner_addr_;
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wold-style-cast"
-    send_wr_ts.context = (void*)ID_WRITE_DATA;
-#pragma GCC diagnostic pop
-    post_send_rdma(&send_wr_ts, FI_MORE);
-  }
-
-  if (num_sge2) {
-    uint64_t remote_addr = remote_info_.data.addr;
-    for (int i = 0; i < num_sge2; i++) {
-
-      rma_iov[0].addr = remote_addr;
-      rma_iov[0].len = sge2[i].iov_len;
-      rma_iov[0].key = remote_info_.data.rkey;
-
-      remote_addr += +sge2[i].iov_len;
-
-      memset(&send_wr_tswrap, 0, sizeof(send_wr_tswrap));
-      send_wr_tswrap.msg_iov = &sge2[i];
-      send_wr_tswrap.desc = &desc2[i];
-      send_wr_tswrap.iov_count = 1;
-      // addr
-      send_wr_tswrap.rma_iov = rma_iov;
-      send_wr_tswrap.rma_iov_count = 1;
-      send_wr_tswrap.addr = partner_addr_;
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wold-style-cast"
-      send_wr_tswrap.context = (void*)ID_WRITE_DATA_WRAP;
-#pragma GCC diagnostic pop
-      post_send_rdma(&send_wr_tswrap, FI_MORE);
+  for (int i = 0; i < num_sge; ++i) {
+    struct iovec chunk = sge[i];
+    if (chunk.iov_len > target_bytes_left) {
+      if (target_bytes_left) {
+        struct iovec head = chunk;
+        head.iov_len = target_bytes_left;
+        append_data_write(head, desc[i], remote_addr);
+        chunk.iov_base = static_cast<uint8_t*>(chunk.iov_base) + head.iov_len;
+        chunk.iov_len -= head.iov_len;
+      }
+      remote_addr = remote_info_.data.addr;
+      target_bytes_left = UINT64_MAX;
     }
+    append_data_write(chunk, desc[i], remote_addr);
+    remote_addr += chunk.iov_len;
+    target_bytes_left -= chunk.iov_len;
   }
 
-  // timeslice component descriptor
-  fles::TimesliceComponentDescriptor tscdesc;
+  // stage timeslice component descriptor
+  if (staged_desc_count_ == 0) {
+    assert(pending_write_requests_ < max_pending_write_requests_);
+    ++pending_write_requests_;
+    staged_desc_begin_ = cn_wp_.desc;
+  }
+  assert(staged_desc_begin_ + staged_desc_count_ == cn_wp_.desc);
+  fles::TimesliceComponentDescriptor& tscdesc = desc_staging_.at(cn_wp_.desc);
   tscdesc.ts_num = timeslice;
   tscdesc.offset = cn_wp_data;
   tscdesc.size = data_length + desc_length * sizeof(fles::MicrosliceDescriptor);
   tscdesc.num_microslices = desc_length;
-  struct iovec sge3;
-  sge3.iov_base = &tscdesc;
-  sge3.iov_len = sizeof(tscdesc);
-  // sge3.lkey = 0;
-
-  rma_iov[0].addr =
-      remote_info_.desc.addr + (cn_wp_.desc & cn_desc_buffer_mask) *
-                                   sizeof(fles::TimesliceComponentDescriptor);
-  rma_iov[0].len = sizeof(tscdesc);
-  rma_iov[0].key = remote_info_.desc.rkey;
-
-  memset(&send_wr_tscdesc, 0, sizeof(send_wr_tscdesc));
-  send_wr_tscdesc.msg_iov = &sge3;
-  send_wr_tscdesc.desc = NULL;
-  send_wr_tscdesc.iov_count = 1;
-  // addr
-  send_wr_tscdesc.rma_iov = rma_iov;
-  send_wr_tscdesc.rma_iov_count = 1;
-  send_wr_tscdesc.addr = partner_addr_;
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wold-style-cast"
-  send_wr_tscdesc.context =
-      (void*)(ID_WRITE_DESC | (timeslice << 24) | (index_ << 8));
-#pragma GCC diagnostic pop
+  ++staged_desc_count_;
 
   if (false) {
     L_(info) << "[i" << remote_index_ << "] "
@@ -216,14 +143,89 @@ void InputChannelConnection::send_data(struct iovec* sge,
              << "POST SEND data (timeslice " << timeslice << ")";
   }
 
-  // send everything
-  assert(pending_write_requests_ < max_pending_write_requests_);
-  ++pending_write_requests_;
-  post_send_rdma(&send_wr_tscdesc, FI_FENCE | FI_COMPLETION | FI_INJECT);
+  uint64_t max_desc_count =
+      std::min(static_cast<uint64_t>(max_timeslices_per_write_),
+               UINT64_C(1) << remote_info_.desc_buffer_size_exp);
+  if (staged_desc_count_ >= max_desc_count) {
+    flush();
+  }
+}
+
+void InputChannelConnection::flush() {
+  if (staged_desc_count_ == 0) {
+    return;
+  }
+
+  post_data_write();
+
+  uint64_t cn_desc_buffer_size = UINT64_C(1)
+                                 << remote_info_.desc_buffer_size_exp;
+  uint64_t begin = staged_desc_begin_;
+  uint64_t end = staged_desc_begin_ + staged_desc_count_;
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wold-style-cast"
+  void* context = (void*)(ID_WRITE_DESC | (index_ << 8) |
+                          (uint64_t(staged_desc_count_) << 24) |
+                          (staged_desc_begin_ << 32));
+#pragma GCC diagnostic pop
+
+  // one write request per contiguous range of both remote and staging buffer
+  while (begin < end) {
+    uint64_t count = std::min(
+        {end - begin,
+         cn_desc_buffer_size - (begin & (cn_desc_buffer_size - 1)),
+         desc_staging_.size() - (begin & desc_staging_.size_mask())});
+
+    struct iovec sge;
+    sge.iov_base = &desc_staging_.at(begin);
+    sge.iov_len = count * sizeof(fles::TimesliceComponentDescriptor);
+    void* desc = fi_mr_desc(mr_desc_staging_);
+
+    struct fi_rma_iov rma_iov;
+    rma_iov.addr = remote_info_.desc.addr +
+                   (begin & (cn_desc_buffer_size - 1)) *
+                       sizeof(fles::TimesliceComponentDescriptor);
+    rma_iov.len = sge.iov_len;
+    rma_iov.key = remote_info_.desc.rkey;
+
+    struct fi_msg_rma send_wr_tscdesc;
+    memset(&send_wr_tscdesc, 0, sizeof(send_wr_tscdesc));
+    send_wr_tscdesc.msg_iov = &sge;
+    send_wr_tscdesc.desc = &desc;
+    send_wr_tscdesc.iov_count = 1;
+    send_wr_tscdesc.rma_iov = &rma_iov;
+    send_wr_tscdesc.rma_iov_count = 1;
+    send_wr_tscdesc.addr = partner_addr_;
+    send_wr_tscdesc.context = context;
+
+    begin += count;
+    uint64_t flags = FI_FENCE;
+    if (sge.iov_len <= max_inline_data_) {
+      flags |= FI_INJECT;
+    }
+    if (begin < end) {
+      flags |= FI_MORE;
+    } else {
+      flags |= FI_COMPLETION;
+      if (cq_data_) {
+        // signal new write position to compute node
+        flags |= FI_REMOTE_CQ_DATA;
+        send_wr_tscdesc.data = cq_data_encode(remote_index_, end);
+      }
+    }
+    post_send_rdma(&send_wr_tscdesc, flags);
+  }
+
+  staged_desc_count_ = 0;
 }
 
 bool InputChannelConnection::write_request_available() {
-  return (pending_write_requests_ < max_pending_write_requests_);
+  // do not overwrite staged descriptors of pending write requests
+  if (cn_wp_.desc - staged_desc_acked_ >= desc_staging_.size()) {
+    return false;
+  }
+  return staged_desc_count_ > 0 ||
+         pending_write_requests_ < max_pending_write_requests_;
 }
 
 void InputChannelConnection::inc_write_pointers(uint64_t data_size,
@@ -232,9 +234,15 @@ void InputChannelConnection::inc_write_pointers(uint64_t data_size,
   cn_wp_.desc += desc_size;
 }
 
-bool InputChannelConnection::try_sync_buffer_positions() {
-  if (our_turn_) {
+bool InputChannelConnection::try_sync_buffer_positions(
+    std::chrono::system_clock::time_point now) {
+  // in cq-data protocol mode, write pointers are signalled by remote CQ data
+  if (cq_data_) {
+    return false;
+  }
+  if (our_turn_ && status_message_due(now)) {
     our_turn_ = false;
+    flush();
     send_status_message_.wp = cn_wp_;
     post_send_status_message();
     return true;
@@ -243,6 +251,38 @@ bool InputChannelConnection::try_sync_buffer_positions() {
   }
 }
 
+bool InputChannelConnection::status_message_due(
+    std::chrono::system_clock::time_point now) const {
+  constexpr auto max_delay = std::chrono::microseconds(500);
+
+  uint64_t data_size = UINT64_C(1) << remote_info_.data_buffer_size_exp;
+  uint64_t desc_size = UINT64_C(1) << remote_info_.desc_buffer_size_exp;
+  const ComputeNodeBufferPosition& wp = send_status_message_.wp;
+  bool news = (cn_wp_ != wp);
+
+  // less than a quarter of the compute node buffer left, the input channel
+  // is about to block and needs acknowledgements
+  bool blocking = (cn_wp_.data - cn_ack_.data > data_size - data_size / 4 ||
+                   cn_wp_.desc - cn_ack_.desc > desc_size - desc_size / 4);
+
+  // enough progress to be worth a message
+  bool progress =
+      (cn_wp_.data - wp.data >= data_size / 8 ||
+       cn_wp_.desc - wp.desc >= std::max<uint64_t>(desc_size / 8, 1));
+
+  if (news && (finalize_ || blocking || progress)) {
+    return true;
+  }
+
+  // the compute node announces its weights only in its replies
+  bool scheduling = (schedule_received_ < schedule_wanted_);
+
+  // otherwise, send pending updates and acknowledgement requests at a
+  // limited rate
+  return (news || blocking || scheduling) &&
+         now - status_message_time_ >= max_delay;
+}
+
 uint64_t InputChannelConnection::skip_required(uint64_t data_size) {
   uint64_t databuf_size = UINT64_C(1) << remote_info_.data_buffer_size_exp;
   uint64_t databuf_wp = cn_wp_.data & (databuf_size - 1);
@@ -255,6 +295,17 @@ uint64_t InputChannelConnection::skip_required(uint64_t data_size) {
 void InputChannelConnection::finalize(bool abort) {
   finalize_ = true;
   abort_ = abort;
+  flush();
+  if (cq_data_) {
+    // send only the final status message when everything is acknowledged
+    if (our_turn_ && !send_pending_ && (cn_wp_ == cn_ack_ || abort_)) {
+      our_turn_ = false;
+      send_status_message_.final = true;
+      send_status_message_.abort = abort_;
+      post_send_status_message();
+    }
+    return;
+  }
   if (our_turn_) {
     our_turn_ = false;
     if (cn_wp_ == cn_ack_ || abort_) {
@@ -267,9 +318,38 @@ void InputChannelConnection::finalize(bool abort) {
   }
 }
 
-void InputChannelConnection::on_complete_write() { pending_write_requests_--; }
+void InputChannelConnection::on_complete_write(
+    uint64_t wr_id, std::vector<uint64_t>& timeslices) {
+  uint64_t count = (wr_id >> 24) & 0xFF;
+  uint64_t begin =
+      staged_desc_acked_ + static_cast<uint32_t>(static_cast<uint32_t>(
+                               wr_id >> 32) -
+                           static_cast<uint32_t>(staged_desc_acked_));
+  for (uint64_t pos = begin; pos < begin + count; ++pos) {
+    timeslices.push_back(desc_staging_.at(pos).ts_num);
+  }
+  pending_write_requests_--;
+
+  if (begin != staged_desc_acked_) {
+    // completion has been reordered, store for later
+    staged_desc_completed_.emplace_back(begin, begin + count);
+    return;
+  }
+  staged_desc_acked_ = begin + count;
+  auto it = staged_desc_completed_.begin();
+  while (it != staged_desc_completed_.end()) {
+    if (it->first == staged_desc_acked_) {
+      staged_desc_acked_ = it->second;
+      staged_desc_completed_.erase(it);
+      it = staged_desc_completed_.begin();
+    } else {
+      ++it;
+    }
+  }
+}
 
-void InputChannelConnection::on_complete_recv() {
+void InputChannelConnection::on_complete_recv(size_t slot) {
+  recv_status_message_ = recv_buffers_[slot];
   if (recv_status_message_.final) {
     done_ = true;
     return;
@@ -281,10 +361,23 @@ void InputChannelConnection::on_complete_recv() {
               << "receive completion, new cn_ack_.data="
               << recv_status_message_.ack.data;
   }
+  ++status_messages_received_;
   cn_ack_ = recv_status_message_.ack;
-  post_recv_status_message();
+  schedule_epoch_ = recv_status_message_.schedule_epoch;
+  schedule_weight_ = recv_status_message_.schedule_weight;
+  if (schedule_weight_ != 0) {
+    schedule_received_ = schedule_epoch_ + 1;
+  }
+  post_recv_status_message(slot);
 
   if (get_partner_addr() || connection_oriented_) {
+    if (cq_data_) {
+      try_confirm_status_messages();
+      if (finalize_) {
+        finalize(abort_);
+      }
+      return;
+    }
     // L_(info)<< "recv message with abort_ = "<<abort_ << " and cn_wp_ ==
     // send_status_message_.wp = "<< (cn_wp_ == send_status_message_.wp) <<
     // " and cn_wp_ == cn_ack_ = "<<(cn_wp_ == cn_ack_) << " and the
@@ -303,12 +396,34 @@ void InputChannelConnection::on_complete_recv() {
   }
 }
 
+void InputChannelConnection::on_complete_send() {
+  send_pending_ = false;
+  if (cq_data_) {
+    try_confirm_status_messages();
+    if (finalize_) {
+      finalize(abort_);
+    }
+  }
+}
+
+void InputChannelConnection::try_confirm_status_messages() {
+  // the send buffer must not change while a send is pending
+  if (send_pending_ || send_status_message_.final) {
+    return;
+  }
+  if (status_messages_received_ - send_status_message_.status_received >=
+      cq_data_status_buffers / 2) {
+    post_send_status_message();
+  }
+}
+
 void InputChannelConnection::setup_mr(struct fid_domain* pd) {
 
   // register memory regions
-  int err =
-      fi_mr_reg(pd, &recv_status_message_, sizeof(ComputeNodeStatusMessage),
-                FI_WRITE, 0, Provider::requested_key++, 0, &mr_recv_, nullptr);
+  int err = fi_mr_reg(pd, recv_buffers_.data(),
+                      recv_buffers_.size() * sizeof(ComputeNodeStatusMessage),
+                      FI_WRITE, 0, Provider::requested_key++, 0, &mr_recv_,
+                      nullptr);
   if (err) {
     L_(fatal) << "fi_mr_reg failed for recv msg: " << err << "="
               << fi_strerror(-err);
@@ -331,6 +446,18 @@ void InputChannelConnection::setup_mr(struct fid_domain* pd) {
   if (!mr_send_)
     throw LibfabricException(
         "registration of memory region failed in InputChannelConnection2");
+
+  err = fi_mr_reg(pd, desc_staging_.ptr(), desc_staging_.bytes(), FI_WRITE, 0,
+                  Provider::requested_key++, 0, &mr_desc_staging_, nullptr);
+  if (err) {
+    L_(fatal) << "fi_mr_reg failed for desc staging buffer: " << err << "="
+              << fi_strerror(-err);
+    throw LibfabricException("fi_mr_reg failed for desc staging buffer");
+  }
+
+  if (!mr_desc_staging_)
+    throw LibfabricException(
+        "registration of memory region failed in InputChannelConnection3");
 }
 
 void InputChannelConnection::setup() {
@@ -340,17 +467,12 @@ void InputChannelConnection::setup() {
 
   // setup send and receive buffers
   memset(&recv_wr_iovec, 0, sizeof(struct iovec));
-  recv_wr_iovec.iov_base = &recv_status_message_;
   recv_wr_iovec.iov_len = sizeof(ComputeNodeStatusMessage);
 
   memset(&recv_wr, 0, sizeof(struct fi_msg));
   recv_wr.msg_iov = &recv_wr_iovec;
   recv_wr.desc = recv_descs;
   recv_wr.iov_count = 1;
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wold-style-cast"
-  recv_wr.context = (void*)(ID_RECEIVE_STATUS | (index_ << 8));
-#pragma GCC diagnostic pop
 
   memset(&send_wr_iovec, 0, sizeof(struct iovec));
   send_wr_iovec.iov_base = &send_status_message_;
@@ -365,8 +487,10 @@ void InputChannelConnection::setup() {
   send_wr.context = (void*)(ID_SEND_STATUS | (index_ << 8));
 #pragma GCC diagnostic pop
 
-  // post initial receive request
-  post_recv_status_message();
+  // post initial receive requests
+  for (size_t slot = 0; slot < recv_buffers_.size(); ++slot) {
+    post_recv_status_message(slot);
+  }
 }
 
 /// Connection handler function, called on successful connection.
@@ -392,6 +516,11 @@ void InputChannelConnection::dereg_mr() {
     fi_close((struct fid*)mr_send_);
     mr_send_ = nullptr;
   }
+
+  if (mr_desc_staging_) {
+    fi_close((struct fid*)mr_desc_staging_);
+    mr_desc_staging_ = nullptr;
+  }
 #pragma GCC diagnostic pop
 }
 
@@ -418,12 +547,17 @@ InputChannelConnection::get_private_data() {
   return private_data;
 }
 
-void InputChannelConnection::post_recv_status_message() {
+void InputChannelConnection::post_recv_status_message(size_t slot) {
   if (false) {
     L_(trace) << "[i" << remote_index_ << "] "
               << "[" << index_ << "] "
               << "POST RECEIVE status message";
   }
+  recv_wr_iovec.iov_base = &recv_buffers_[slot];
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wold-style-cast"
+  recv_wr.context = (void*)(ID_RECEIVE_STATUS | (index_ << 8) | (slot << 24));
+#pragma GCC diagnostic pop
   post_recv_msg(&recv_wr);
 }
 
@@ -435,9 +569,59 @@ void InputChannelConnection::post_send_status_message() {
               << send_status_message_.wp.data
               << " wp.desc=" << send_status_message_.wp.desc << ")";
   }
+  ++status_messages_sent_;
+  status_message_time_ = std::chrono::system_clock::now();
+  send_status_message_.status_received = status_messages_received_;
+  send_pending_ = true;
   post_send_msg(&send_wr);
 }
 
+void InputChannelConnection::append_data_write(const struct iovec& sge,
+                                               void* desc,
+                                               uint64_t remote_addr) {
+  size_t iov_limit = std::min<size_t>(max_send_sge_, max_data_write_iov);
+  if (data_write_iov_count_ > 0 &&
+      (data_write_addr_ + data_write_len_ != remote_addr ||
+       data_write_iov_count_ >= iov_limit)) {
+    post_data_write();
+  }
+  if (data_write_iov_count_ == 0) {
+    data_write_addr_ = remote_addr;
+    data_write_len_ = 0;
+  }
+  data_write_iov_[data_write_iov_count_] = sge;
+  data_write_desc_[data_write_iov_count_] = desc;
+  ++data_write_iov_count_;
+  data_write_len_ += sge.iov_len;
+}
+
+void InputChannelConnection::post_data_write() {
+  if (data_write_iov_count_ == 0) {
+    return;
+  }
+
+  struct fi_rma_iov rma_iov;
+  rma_iov.addr = data_write_addr_;
+  rma_iov.len = data_write_len_;
+  rma_iov.key = remote_info_.data.rkey;
+
+  struct fi_msg_rma send_wr_ts;
+  memset(&send_wr_ts, 0, sizeof(send_wr_ts));
+  send_wr_ts.msg_iov = data_write_iov_;
+  send_wr_ts.desc = data_write_desc_;
+  send_wr_ts.iov_count = data_write_iov_count_;
+  send_wr_ts.rma_iov = &rma_iov;
+  send_wr_ts.rma_iov_count = 1;
+  send_wr_ts.addr = partner_addr_;
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wold-style-cast"
+  send_wr_ts.context = (void*)ID_WRITE_DATA;
+#pragma GCC diagnostic pop
+  post_send_rdma(&send_wr_ts, FI_MORE);
+
+  data_write_iov_count_ = 0;
+}
+
 void InputChannelConnection::connect(const std::string& hostname,
                                      const std::string& service,
                                      struct fid_domain* domain,
@@ -7,8 +7,13 @@
 #include "ComputeNodeStatusMessage.hpp"
 #include "Connection.hpp"
 #include "InputChannelStatusMessage.hpp"
+#include "RingBuffer.hpp"
+#include "TimesliceComponentDescriptor.hpp"
 
+#include <algorithm>
+#include <chrono>
 #include <sys/uio.h>
+#include <vector>
 
 namespace tl_libfabric {
 /// Input node connection class.
@@ -23,7 +28,9 @@ public:
                          uint_fast16_t connection_index,
                          uint_fast16_t remote_connection_index,
                          unsigned int max_send_wr,
-                         unsigned int max_pending_write_requests);
+                         unsigned int max_pending_write_requests,
+                         unsigned int max_timeslices_per_write,
+                         bool cq_data);
 
   InputChannelConnection(const InputChannelConnection&) = delete;
   void operator=(const InputChannelConnection&) = delete;
@@ -31,7 +38,9 @@ public:
   /// Wait until enough space is available at target compute node.
   bool check_for_buffer_space(uint64_t data_size, uint64_t desc_size);
 
-  /// Send data and descriptors to compute node.
+  /// Send data and descriptors to compute node. The timeslice component
+  /// descriptor is staged and written together with those of the following
+  /// timeslices on flush().
   void send_data(struct iovec* sge,
                  void** desc,
                  int num_sge,
@@ -40,6 +49,9 @@ public:
                  uint64_t data_length,
                  uint64_t skip);
 
+  /// Post the write request for the staged timeslice component descriptors.
+  void flush();
+
   bool write_request_available();
 
   /// Increment target write pointers after data has been sent.
@@ -48,16 +60,44 @@ public:
   // Get number of bytes to skip in advance (to avoid buffer wrap)
   uint64_t skip_required(uint64_t data_size);
 
-  bool try_sync_buffer_positions();
+  /// Send a write pointer update to the compute node if one is due.
+  bool try_sync_buffer_positions(std::chrono::system_clock::time_point now);
 
   void finalize(bool abort);
 
   bool request_abort_flag() { return recv_status_message_.request_abort; }
 
-  void on_complete_write();
+  /// Retrieve the epoch of the weight announced in the most recent status
+  /// message.
+  uint64_t schedule_epoch() const { return schedule_epoch_; }
+
+  /// Retrieve the weight announced in the most recent status message (zero
+  /// if none).
+  uint32_t schedule_weight() const { return schedule_weight_; }
+
+  /// Keep exchanging status messages until the compute node has announced
+  /// its weight for the given epoch.
+  void request_schedule(uint64_t epoch) {
+    schedule_wanted_ = std::max(schedule_wanted_, epoch + 1);
+  }
+
+  /// Retrieve the number of status messages sent to the compute node.
+  uint64_t status_messages_sent() const { return status_messages_sent_; }
+
+  /// Retrieve the number of status messages received from the compute node.
+  uint64_t status_messages_received() const {
+    return status_messages_received_;
+  }
+
+  /// Handle completion of a descriptor write request, append the numbers of
+  /// the completed timeslices to the given vector.
+  void on_complete_write(uint64_t wr_id, std::vector<uint64_t>& timeslices);
 
   /// Handle Libfabric receive completion notification.
-  void on_complete_recv();
+  void on_complete_recv(size_t slot);
+
+  /// Handle Libfabric send completion notification.
+  void on_complete_send();
 
   virtual void setup_mr(struct fid_domain* pd) override;
   virtual void setup() override;
@@ -93,28 +133,75 @@ public:
 
 private:
   /// Post a receive work request (WR) to the receive queue
-  void post_recv_status_message();
+  void post_recv_status_message(size_t slot);
 
   /// Post a send work request (WR) to the send queue
   void post_send_status_message();
 
+  /// Check if a write pointer update should be sent (coalescing of status
+  /// messages).
+  bool status_message_due(std::chrono::system_clock::time_point now) const;
+
+  /// Confirm the reception of status messages to the compute node if its
+  /// allowance is running low (cq-data protocol mode).
+  void try_confirm_status_messages();
+
+  /// Add a data transfer to the pending data write request, posting the
+  /// latter if the transfer cannot be appended.
+  void append_data_write(const struct iovec& sge,
+                         void* desc,
+                         uint64_t remote_addr);
+
+  /// Post the pending data write request.
+  void post_data_write();
+
+  /// Maximum number of local buffers in a data write request.
+  static constexpr size_t max_data_write_iov = 8;
+
   /// Flag, true if it is the input nodes's turn to send a pointer update.
   bool our_turn_ = true;
 
+  /// Time of the most recent status message sent to the compute node.
+  std::chrono::system_clock::time_point status_message_time_;
+
+  /// Number of status messages sent to the compute node.
+  uint64_t status_messages_sent_ = 0;
+
+  /// Number of status messages received from the compute node.
+  uint64_t status_messages_received_ = 0;
+
+  /// Flag, true if a status message send is pending.
+  bool send_pending_ = false;
+
   bool finalize_ = false;
   bool abort_ = false;
 
+  /// Epochs before this one have been requested from the compute node.
+  uint64_t schedule_wanted_ = 0;
+
+  /// Epochs before this one have been announced by the compute node.
+  uint64_t schedule_received_ = 0;
+
+  /// Epoch of the most recently announced weight.
+  uint64_t schedule_epoch_ = 0;
+
+  /// Most recently announced weight (zero if none).
+  uint32_t schedule_weight_ = 0;
+
   /// Access information for memory regions on remote end.
   ComputeNodeInfo remote_info_ = ComputeNodeInfo();
 
   /// Local copy of acknowledged-by-CN pointers
   ComputeNodeBufferPosition cn_ack_ = ComputeNodeBufferPosition();
 
-  /// Receive buffer for CN status (including acknowledged-by-CN pointers)
+  /// Most recent CN status (including acknowledged-by-CN pointers)
   ComputeNodeStatusMessage recv_status_message_ = ComputeNodeStatusMessage();
 
-  /// Libfabric memory region descriptor for CN status (including
-  /// acknowledged-by-CN pointers)
+  /// Receive buffers for CN status. In cq-data protocol mode, the compute
+  /// node may send several status messages unanswered.
+  std::vector<ComputeNodeStatusMessage> recv_buffers_;
+
+  /// Libfabric memory region descriptor for the CN status receive buffers
   fid_mr* mr_recv_ = nullptr;
 
   /// Local version of CN write pointers
@@ -141,6 +228,40 @@ private:
 
   unsigned int max_pending_write_requests_{0};
 
+  /// Maximum number of timeslices per descriptor write request.
+  unsigned int max_timeslices_per_write_{1};
+
+  /// Staging buffer for timeslice component descriptors, indexed like the
+  /// compute node descriptor buffer.
+  RingBuffer<fles::TimesliceComponentDescriptor> desc_staging_;
+
+  /// Libfabric memory region descriptor for descriptor staging buffer.
+  struct fid_mr* mr_desc_staging_ = nullptr;
+
+  /// Position of the first staged descriptor not yet written.
+  uint64_t staged_desc_begin_ = 0;
+
+  /// Number of staged descriptors not yet written.
+  unsigned int staged_desc_count_ = 0;
+
+  /// Position up to which staged descriptors have been written completely.
+  uint64_t staged_desc_acked_ = 0;
+
+  /// Descriptor write requests completed out of order (begin, end).
+  std::vector<std::pair<uint64_t, uint64_t>> staged_desc_completed_;
+
+  /// Local buffers of the pending data write request.
+  struct iovec data_write_iov_[max_data_write_iov];
+  void* data_write_desc_[max_data_write_iov];
+  size_t data_write_iov_count_ = 0;
+
+  /// Remote address and length of the pending data write request.
+  uint64_t data_write_addr_ = 0;
+  uint64_t data_write_len_ = 0;
+
   fi_addr_t partner_addr_ = 0;
+
+  /// Flag, true if write progress is signalled by remote CQ data.
+  bool cq_data_ = false;
 };
 } // namespace tl_libfabric
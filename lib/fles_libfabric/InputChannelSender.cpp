@@ -3,8 +3,10 @@
 
 #include "InputChannelSender.hpp"
 #include "MicrosliceDescriptor.hpp"
+#include "RemoteCqData.hpp"
 #include "RequestIdentifier.hpp"
 #include "Utility.hpp"
+#include <algorithm>
 #include <cassert>
 #include <chrono>
 #include <log.hpp>
@@ -19,11 +21,22 @@ InputChannelSender::InputChannelSender(
     uint32_t timeslice_size,
     uint32_t overlap_size,
     uint32_t max_timeslice_number,
+    bool cq_data,
+    uint32_t stagger_window,
+    uint64_t pacing_rate,
     std::string input_node_name)
     : ConnectionGroup(input_node_name), input_index_(input_index),
       data_source_(data_source), compute_hostnames_(compute_hostnames),
       compute_services_(compute_services), timeslice_size_(timeslice_size),
       overlap_size_(overlap_size), max_timeslice_number_(max_timeslice_number),
+      cq_data_(cq_data),
+      // timeslices of a block should target different compute nodes
+      order_(input_index,
+             std::min(stagger_window,
+                      static_cast<uint32_t>(compute_hostnames.size())),
+             max_timeslice_number),
+      schedule_(static_cast<uint32_t>(compute_hostnames.size())),
+      pacing_rate_(pacing_rate), pacing_next_(compute_hostnames.size()),
       min_acked_desc_(data_source.desc_buffer().size() / 4),
       min_acked_data_(data_source.data_buffer().size() / 4) {
 
@@ -123,11 +136,11 @@ void InputChannelSender::report_status() {
 }
 
 void InputChannelSender::sync_buffer_positions() {
+  auto now = std::chrono::system_clock::now();
   for (auto& c : conn_) {
-    c->try_sync_buffer_positions();
+    c->try_sync_buffer_positions(now);
   }
 
-  auto now = std::chrono::system_clock::now();
   scheduler_.add(std::bind(&InputChannelSender::sync_buffer_positions, this),
                  now + std::chrono::milliseconds(0));
 }
@@ -198,13 +211,15 @@ void InputChannelSender::operator()() {
     data_source_.proceed();
     time_begin_ = std::chrono::high_resolution_clock::now();
 
+    // position of the first timeslice not yet sent, in the (possibly
+    // staggered) sending order
     uint64_t timeslice = 0;
     sync_buffer_positions();
     sync_data_source(true);
     report_status();
     while (timeslice < max_timeslice_number_ && !abort_) {
-      if (try_send_timeslice(timeslice)) {
-        timeslice++;
+      if (!try_send_pending(timeslice)) {
+        flush();
       }
       poll_completion();
       data_source_.proceed();
@@ -212,7 +227,8 @@ void InputChannelSender::operator()() {
     }
 
     // wait for pending send completions
-    while (acked_desc_ < timeslice_size_ * timeslice + start_index_desc_) {
+    flush();
+    while (acked_timeslices_ < timeslice) {
       poll_completion();
       scheduler_.timer();
     }
@@ -241,6 +257,20 @@ void InputChannelSender::operator()() {
     }
 
     summary();
+
+    // control traffic per timeslice
+    uint64_t messages_sent = 0;
+    uint64_t messages_received = 0;
+    for (auto& c : conn_) {
+      messages_sent += c->status_messages_sent();
+      messages_received += c->status_messages_received();
+    }
+    L_(info) << "[i" << input_index_ << "] summary: " << messages_sent
+             << " status messages sent, " << messages_received
+             << " received ("
+             << static_cast<double>(messages_sent + messages_received) /
+                    static_cast<double>(std::max<uint64_t>(timeslice, 1))
+             << " per timeslice)";
   } catch (std::exception& e) {
     L_(fatal) << "exception in InputChannelSender: " << e.what();
   }
@@ -280,6 +310,13 @@ bool InputChannelSender::try_send_timeslice(uint64_t timeslice) {
     if (!conn_[cn]->write_request_available())
       return false;
 
+    std::chrono::steady_clock::time_point now;
+    if (pacing_rate_ != 0) {
+      now = std::chrono::steady_clock::now();
+      if (now < pacing_next_[cn])
+        return false;
+    }
+
     // number of bytes to skip in advance (to avoid buffer wrap)
     uint64_t skip = conn_[cn]->skip_required(total_length);
     total_length += skip;
@@ -291,8 +328,18 @@ bool InputChannelSender::try_send_timeslice(uint64_t timeslice) {
 
       conn_[cn]->inc_write_pointers(total_length, 1);
 
-      sent_desc_ = desc_offset + desc_length;
-      sent_data_ = data_end;
+      if (pacing_rate_ != 0) {
+        pacing_next_[cn] =
+            std::max(pacing_next_[cn], now) +
+            std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                std::chrono::duration<double>(
+                    static_cast<double>(total_length) /
+                    static_cast<double>(pacing_rate_)));
+      }
+
+      // timeslices may be sent out of order if staggered
+      sent_desc_ = std::max(sent_desc_, desc_offset + desc_length);
+      sent_data_ = std::max(sent_data_, data_end);
 
       return true;
     }
@@ -301,21 +348,42 @@ bool InputChannelSender::try_send_timeslice(uint64_t timeslice) {
   return false;
 }
 
+void InputChannelSender::flush() {
+  for (auto& c : conn_) {
+    c->flush();
+  }
+}
+
 std::unique_ptr<InputChannelConnection>
 InputChannelSender::create_input_node_connection(uint_fast16_t index) {
-  // @todo
-  // unsigned int max_send_wr = 8000; ???  IB hca
-  // unsigned int max_send_wr = 495; // ??? libfabric for verbs
-  unsigned int max_send_wr = 256; // ??? libfabric for sockets
+  // send queue depth offered by the provider (e.g., 256 for sockets)
+  unsigned int max_send_wr = static_cast<unsigned int>(
+      Provider::getInst()->get_info()->tx_attr->size);
+  if (max_send_wr == 0) {
+    max_send_wr = 256;
+  }
+
+  // a write request for n timeslices takes up to 4n data write and two
+  // descriptor write work requests
+  unsigned int max_timeslices_per_write =
+      std::max(1u, std::min(16u, (max_send_wr - 1) / 32));
 
   // limit pending write requests so that send queue and completion queue
   // do not overflow
-  unsigned int max_pending_write_requests = std::min(
-      static_cast<unsigned int>((max_send_wr - 1) / 3),
-      static_cast<unsigned int>((num_cqe_ - 1) / compute_hostnames_.size()));
+  unsigned int max_pending_write_requests = std::max(
+      1u, std::min(static_cast<unsigned int>((max_send_wr - 1) /
+                                             (4 * max_timeslices_per_write + 2)),
+                   static_cast<unsigned int>((num_cqe_ - 1) /
+                                             compute_hostnames_.size())));
+  if (cq_data_) {
+    // each write with remote CQ data may consume a receive buffer
+    max_pending_write_requests =
+        std::min(max_pending_write_requests, cq_data_max_pending_writes);
+  }
 
   std::unique_ptr<InputChannelConnection> connection(new InputChannelConnection(
-      eq_, index, input_index_, max_send_wr, max_pending_write_requests));
+      eq_, index, input_index_, max_send_wr, max_pending_write_requests,
+      max_timeslices_per_write, cq_data_));
   return connection;
 }
 
@@ -334,7 +402,80 @@ void InputChannelSender::connect() {
 }
 
 int InputChannelSender::target_cn_index(uint64_t timeslice) {
-  return timeslice % conn_.size();
+  return static_cast<int>(block_cn_.at(timeslice - block_begin_));
+}
+
+uint64_t InputChannelSender::sending_order(uint64_t position) {
+  uint64_t begin = position - position % order_.window();
+  uint64_t end = std::min<uint64_t>(begin + order_.window(),
+                                    max_timeslice_number_);
+  if (begin != block_begin_) {
+    block_begin_ = begin;
+    block_cn_.clear();
+    block_order_.clear();
+    block_sent_.clear();
+  }
+
+  // the schedule has to be queried in ascending order
+  while (begin + block_cn_.size() < end) {
+    uint64_t timeslice = begin + block_cn_.size();
+    if (!schedule_.ready(timeslice)) {
+      for (auto& c : conn_) {
+        c->request_schedule(schedule_.epoch(timeslice));
+      }
+      return UINT64_MAX;
+    }
+    block_cn_.push_back(schedule_.compute_node(timeslice));
+  }
+
+  // keep the staggered sequence of compute nodes, but send the timeslices
+  // of each compute node in ascending order, as the compute node expects
+  // them in the same order from all input channels
+  if (block_order_.empty()) {
+    std::vector<uint64_t> next(conn_.size(), 0);
+    for (uint64_t p = begin; p < end; ++p) {
+      uint32_t cn = block_cn_[order_.timeslice(p) - begin];
+      while (block_cn_[next[cn]] != cn) {
+        ++next[cn];
+      }
+      block_order_.push_back(begin + next[cn]++);
+    }
+    block_sent_.assign(block_order_.size(), false);
+  }
+
+  return block_order_.at(position - begin);
+}
+
+bool InputChannelSender::try_send_pending(uint64_t& position) {
+  if (sending_order(position) == UINT64_MAX) {
+    return false;
+  }
+
+  // look ahead within the block only, and pass a timeslice only by those
+  // targeting other compute nodes to keep the order per compute node
+  cn_blocked_.assign(conn_.size(), false);
+  bool sent = false;
+  for (uint64_t p = position - block_begin_; p < block_order_.size(); ++p) {
+    if (block_sent_[p]) {
+      continue;
+    }
+    int cn = target_cn_index(block_order_[p]);
+    if (cn_blocked_[cn]) {
+      continue;
+    }
+    if (try_send_timeslice(block_order_[p])) {
+      block_sent_[p] = true;
+      sent = true;
+    } else {
+      cn_blocked_[cn] = true;
+    }
+  }
+
+  while (position - block_begin_ < block_order_.size() &&
+         block_sent_[position - block_begin_]) {
+    ++position;
+  }
+  return sent;
 }
 
 void InputChannelSender::on_connected(struct fid_domain* pd) {
@@ -479,42 +620,49 @@ void InputChannelSender::post_send_data(uint64_t timeslice,
 void InputChannelSender::on_completion(uint64_t wr_id) {
   switch (wr_id & 0xFF) {
   case ID_WRITE_DESC: {
-    uint64_t ts = wr_id >> 24;
-
     int cn = (wr_id >> 8) & 0xFFFF;
-    conn_[cn]->on_complete_write();
-
-    uint64_t acked_ts = (acked_desc_ - start_index_desc_) / timeslice_size_;
-    if (ts != acked_ts) {
-      // transmission has been reordered, store completion information
-      ack_.at(ts) = ts;
-    } else {
-      // completion is for earliest pending timeslice, update indices
-      do {
-        ++acked_ts;
-      } while (ack_.at(acked_ts) > ts);
-
-      acked_desc_ = acked_ts * timeslice_size_ + start_index_desc_;
-      acked_data_ = data_source_.desc_buffer().at(acked_desc_ - 1).offset +
-                    data_source_.desc_buffer().at(acked_desc_ - 1).size;
-      if (acked_data_ >= cached_acked_data_ + min_acked_data_ ||
-          acked_desc_ >= cached_acked_desc_ + min_acked_desc_) {
-        cached_acked_data_ = acked_data_;
-        cached_acked_desc_ = acked_desc_;
-        data_source_.set_read_index({cached_acked_desc_, cached_acked_data_});
+    completed_timeslices_.clear();
+    conn_[cn]->on_complete_write(wr_id, completed_timeslices_);
+
+    acked_timeslices_ += completed_timeslices_.size();
+    for (uint64_t ts : completed_timeslices_) {
+      uint64_t acked_ts = (acked_desc_ - start_index_desc_) / timeslice_size_;
+      if (ts != acked_ts) {
+        // transmission has been reordered, store completion information
+        ack_.at(ts) = ts;
+      } else {
+        // completion is for earliest pending timeslice, update indices
+        do {
+          ++acked_ts;
+        } while (ack_.at(acked_ts) > ts);
+
+        acked_desc_ = acked_ts * timeslice_size_ + start_index_desc_;
+        acked_data_ = data_source_.desc_buffer().at(acked_desc_ - 1).offset +
+                      data_source_.desc_buffer().at(acked_desc_ - 1).size;
+        if (acked_data_ >= cached_acked_data_ + min_acked_data_ ||
+            acked_desc_ >= cached_acked_desc_ + min_acked_desc_) {
+          cached_acked_data_ = acked_data_;
+          cached_acked_desc_ = acked_desc_;
+          data_source_.set_read_index(
+              {cached_acked_desc_, cached_acked_data_});
+        }
+      }
+      if (false) {
+        L_(trace) << "[i" << input_index_ << "] "
+                  << "write timeslice " << ts
+                  << " complete, now: acked_data_=" << acked_data_
+                  << " acked_desc_=" << acked_desc_;
       }
-    }
-    if (false) {
-      L_(trace) << "[i" << input_index_ << "] "
-                << "write timeslice " << ts
-                << " complete, now: acked_data_=" << acked_data_
-                << " acked_desc_=" << acked_desc_;
     }
   } break;
 
   case ID_RECEIVE_STATUS: {
-    int cn = wr_id >> 8;
-    conn_[cn]->on_complete_recv();
+    int cn = (wr_id >> 8) & 0xFFFF;
+    conn_[cn]->on_complete_recv(wr_id >> 24);
+    if (conn_[cn]->schedule_weight() != 0 && !conn_[cn]->done()) {
+      schedule_.set_weight(cn, conn_[cn]->schedule_epoch(),
+                           conn_[cn]->schedule_weight());
+    }
     if (!connection_oriented_ && !conn_[cn]->get_partner_addr()) {
       conn_[cn]->set_partner_addr(av_);
       conn_[cn]->set_remote_info();
@@ -538,6 +686,8 @@ void InputChannelSender::on_completion(uint64_t wr_id) {
   } break;
 
   case ID_SEND_STATUS: {
+    int cn = (wr_id >> 8) & 0xFFFF;
+    conn_[cn]->on_complete_send();
   } break;
 
   default:
@@ -7,8 +7,11 @@
 #include "DualRingBuffer.hpp"
 #include "InputChannelConnection.hpp"
 #include "RingBuffer.hpp"
+#include "StaggeredOrder.hpp"
+#include "TimesliceSchedule.hpp"
 #include <boost/format.hpp>
 #include <cassert>
+#include <chrono>
 
 #include <rdma/fi_domain.h>
 #include <set>
@@ -19,7 +22,9 @@ namespace tl_libfabric {
 /// Input buffer and compute node connection container class.
 /** An InputChannelSender object represents an input buffer (filled by a
     FLIB) and a group of timeslice building connections to compute
-    nodes. */
+    nodes. Timeslices are assigned to compute nodes according to the
+    weights the compute nodes announce in their status messages (see
+    TimesliceSchedule). */
 
 class InputChannelSender : public ConnectionGroup<InputChannelConnection> {
 public:
@@ -31,6 +36,9 @@ public:
                      uint32_t timeslice_size,
                      uint32_t overlap_size,
                      uint32_t max_timeslice_number,
+                     bool cq_data,
+                     uint32_t stagger_window,
+                     uint64_t pacing_rate,
                      std::string input_node_name);
 
   InputChannelSender(const InputChannelSender&) = delete;
@@ -49,6 +57,9 @@ public:
   /// The central function for distributing timeslice data.
   bool try_send_timeslice(uint64_t timeslice);
 
+  /// Post the pending write requests of all connections.
+  void flush();
+
   std::unique_ptr<InputChannelConnection>
   create_input_node_connection(uint_fast16_t index);
 
@@ -58,9 +69,20 @@ public:
   virtual void on_connected(struct fid_domain* pd) override;
 
 private:
-  /// Return target computation node for given timeslice.
+  /// Return target computation node for given timeslice (requires
+  /// sending_order() to have returned it).
   int target_cn_index(uint64_t timeslice);
 
+  /// Retrieve the timeslice sent at a given position in the sending order,
+  /// or UINT64_MAX if the assignment of its block is not yet known.
+  uint64_t sending_order(uint64_t position);
+
+  /// Try to send the pending timeslices of the current block, starting at
+  /// the given position in the sending order. A timeslice that cannot be
+  /// sent yet (e.g., due to pacing) is passed by those targeting other
+  /// compute nodes. Advances the position past the timeslices sent.
+  bool try_send_pending(uint64_t& position);
+
   /// Handle RDMA_CM_REJECTED event.
   virtual void on_rejected(struct fi_eq_err_entry* event) override;
 
@@ -96,6 +118,9 @@ private:
   /// Buffer to store acknowledged status of timeslices.
   RingBuffer<uint64_t, true> ack_;
 
+  /// Timeslices of a completed write request (reused to avoid allocation).
+  std::vector<uint64_t> completed_timeslices_;
+
   /// Number of acknowledged microslices. Written to FLIB.
   uint64_t acked_desc_ = 0;
 
@@ -118,6 +143,41 @@ private:
   const uint32_t overlap_size_;
   const uint32_t max_timeslice_number_;
 
+  /// Flag, true if write progress is signalled by remote CQ data.
+  const bool cq_data_;
+
+  /// The order in which the timeslices are sent.
+  const StaggeredOrder order_;
+
+  /// Assignment of timeslices to compute nodes.
+  TimesliceSchedule schedule_;
+
+  /// First timeslice of the current block of the sending order.
+  uint64_t block_begin_ = UINT64_MAX;
+
+  /// Compute nodes of the timeslices of the current block, as far as known.
+  std::vector<uint32_t> block_cn_;
+
+  /// Timeslices of the current block in sending order (empty if not yet
+  /// known).
+  std::vector<uint64_t> block_order_;
+
+  /// Flags, true if the timeslice at the position in block_order_ is sent.
+  std::vector<bool> block_sent_;
+
+  /// Flags, true if a compute node has a pending timeslice that could not
+  /// be sent (reused to avoid allocation).
+  std::vector<bool> cn_blocked_;
+
+  /// Maximum data rate per compute node in bytes/s (zero if unlimited).
+  const uint64_t pacing_rate_;
+
+  /// Earliest time of the next write to each compute node (if paced).
+  std::vector<std::chrono::steady_clock::time_point> pacing_next_;
+
+  /// Number of acknowledged timeslices.
+  uint64_t acked_timeslices_ = 0;
+
   const uint64_t min_acked_desc_;
   const uint64_t min_acked_data_;
 
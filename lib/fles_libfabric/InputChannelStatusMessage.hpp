@@ -13,6 +13,8 @@ namespace tl_libfabric {
 /// compute buffer.
 struct InputChannelStatusMessage {
   ComputeNodeBufferPosition wp;
+  /// Number of status messages received (cq-data protocol mode).
+  uint64_t status_received;
   bool abort;
   bool final;
   // "private data" on connect
@@ -0,0 +1,42 @@
+// Copyright 2026 agent <agent@local>
+
+#pragma once
+
+#include <cstdint>
+
+namespace tl_libfabric {
+/// Remote CQ data of a descriptor write request (cq-data protocol mode).
+/** In this mode, the final descriptor write request of a batch carries the
+    index of the input channel and the low bits of the new write position in
+    the compute node's descriptor buffer. The compute node learns about the
+    arrival of timeslice components from its completion queue instead of
+    from InputChannelStatusMessage updates. Only 32 bits of CQ data are
+    assumed to be available. */
+
+/// Number of bits used for the descriptor buffer position.
+constexpr unsigned int cq_data_desc_bits = 20;
+
+/// Maximum number of pending descriptor write requests per connection.
+constexpr unsigned int cq_data_max_pending_writes = 32;
+
+/// Maximum number of status messages a compute node sends before the input
+/// channel has confirmed their reception. In this mode, the compute node
+/// sends status messages without being asked, so the input channel keeps a
+/// receive buffer for each of them (plus one for the final message).
+constexpr unsigned int cq_data_status_buffers = 8;
+
+inline uint64_t cq_data_encode(uint64_t input_index, uint64_t desc) {
+  return (input_index << cq_data_desc_bits) |
+         (desc & ((UINT64_C(1) << cq_data_desc_bits) - 1));
+}
+
+inline uint64_t cq_data_input_index(uint64_t data) {
+  return (data & UINT32_MAX) >> cq_data_desc_bits;
+}
+
+/// Reconstruct the descriptor buffer position from its low bits.
+inline uint64_t cq_data_desc(uint64_t data, uint64_t previous_desc) {
+  uint64_t mask = (UINT64_C(1) << cq_data_desc_bits) - 1;
+  return previous_desc + ((data - previous_desc) & mask);
+}
+} // namespace tl_libfabric
@@ -4,9 +4,12 @@
 #include "TimesliceBuilder.hpp"
 #include "ChildProcessManager.hpp"
 //#include "InputNodeInfo.hpp"
+#include "RemoteCqData.hpp"
 #include "RequestIdentifier.hpp"
 #include "TimesliceCompletion.hpp"
 #include "TimesliceWorkItem.hpp"
+#include <algorithm>
+#include <array>
 #include <boost/algorithm/string.hpp>
 //#include <boost/lexical_cast.hpp>
 //#include <log.hpp>
@@ -20,16 +23,24 @@ TimesliceBuilder::TimesliceBuilder(uint64_t compute_index,
                                    TimesliceBuffer& timeslice_buffer,
                                    unsigned short service,
                                    uint32_t num_input_nodes,
+                                   uint32_t num_compute_nodes,
                                    uint32_t timeslice_size,
                                    volatile sig_atomic_t* signal_status,
                                    bool drop,
-                                   std::string local_node_name)
+                                   bool cq_data,
+                                   std::string local_node_name,
+                                   double shed_threshold)
     : ConnectionGroup(local_node_name), compute_index_(compute_index),
       timeslice_buffer_(timeslice_buffer), service_(service),
       num_input_nodes_(num_input_nodes), timeslice_size_(timeslice_size),
+      red_lantern_(num_input_nodes),
       ack_(timeslice_buffer_.get_desc_size_exp()),
       signal_status_(signal_status), local_node_name_(local_node_name),
-      drop_(drop) {
+      drop_(drop), cq_data_(cq_data),
+      shedding_(ack_.size(), shed_threshold, shed_threshold * 3 / 4),
+      schedule_(num_compute_nodes),
+      announcements_(timeslice_buffer_.get_desc_size_exp() + 1,
+                     schedule_.lookahead()) {
   assert(timeslice_buffer_.get_num_input_nodes() == num_input_nodes);
   assert(not local_node_name_.empty());
   if (Provider::getInst()->is_connection_oriented()) {
@@ -216,7 +227,8 @@ void TimesliceBuilder::bootstrap_wo_connections() {
     std::unique_ptr<ComputeNodeConnection> conn(new ComputeNodeConnection(
         eq_, pd_, cq_, av_, index, compute_index_, data_ptr,
         timeslice_buffer_.get_data_size_exp(), desc_ptr,
-        timeslice_buffer_.get_desc_size_exp()));
+        timeslice_buffer_.get_desc_size_exp(), cq_data_));
+    conn->set_announcements(&announcements_, schedule_.lookahead());
     conn->setup_mr(pd_);
     conn->setup();
     conn_.at(index) = std::move(conn);
@@ -341,6 +353,31 @@ void TimesliceBuilder::operator()() {
     timeslice_buffer_.send_end_completion();
 
     summary();
+    if (shedding_.enabled()) {
+      L_(info) << "[c" << compute_index_ << "] summary: " << timeslices_shed_
+               << " timeslices shed";
+    }
+    if (timeslice_buffer_.get_num_component_events_lost() != 0) {
+      L_(info) << "[c" << compute_index_ << "] summary: "
+               << timeslice_buffer_.get_num_component_events_lost()
+               << " component events discarded";
+    }
+
+    // control traffic per timeslice
+    uint64_t messages_sent = 0;
+    uint64_t messages_received = 0;
+    uint64_t components = 0;
+    for (auto& c : conn_) {
+      messages_sent += c->status_messages_sent();
+      messages_received += c->status_messages_received();
+      components += c->cn_wp().desc;
+    }
+    uint64_t timeslices = components / std::max<size_t>(conn_.size(), 1);
+    L_(info) << "[c" << compute_index_ << "] summary: " << messages_received
+             << " status messages received, " << messages_sent << " sent ("
+             << static_cast<double>(messages_received + messages_sent) /
+                    static_cast<double>(std::max<uint64_t>(timeslices, 1))
+             << " per timeslice)";
   } catch (std::exception& e) {
     L_(error) << "exception in TimesliceBuilder: " << e.what();
   }
@@ -365,7 +402,9 @@ void TimesliceBuilder::on_connect_request(struct fi_eq_cm_entry* event,
                                 timeslice_buffer_.get_data_ptr(index),
                                 timeslice_buffer_.get_data_size_exp(),
                                 timeslice_buffer_.get_desc_ptr(index),
-                                timeslice_buffer_.get_desc_size_exp()));
+                                timeslice_buffer_.get_desc_size_exp(),
+                                cq_data_));
+  conn->set_announcements(&announcements_, schedule_.lookahead());
   conn_.at(index) = std::move(conn);
 
   conn_.at(index)->on_connect_request(event, pd_, cq_);
@@ -373,7 +412,7 @@ void TimesliceBuilder::on_connect_request(struct fi_eq_cm_entry* event,
 
 /// Completion notification event dispatcher. Called by the event loop.
 void TimesliceBuilder::on_completion(uint64_t wr_id) {
-  size_t in = wr_id >> 8;
+  size_t in = (wr_id >> 8) & 0xFFFF;
   assert(in < conn_.size());
   switch (wr_id & 0xFF) {
   case ID_SEND_STATUS:
@@ -403,55 +442,137 @@ void TimesliceBuilder::on_completion(uint64_t wr_id) {
     break;
 
   case ID_RECEIVE_STATUS:
-    conn_[in]->on_complete_recv();
-    if (connected_ == conn_.size() && in == red_lantern_) {
-      auto new_red_lantern = std::min_element(
-          std::begin(conn_), std::end(conn_),
-          [](const std::unique_ptr<ComputeNodeConnection>& v1,
-             const std::unique_ptr<ComputeNodeConnection>& v2) {
-            return v1->cn_wp().desc < v2->cn_wp().desc;
-          });
-
-      uint64_t new_completely_written = (*new_red_lantern)->cn_wp().desc;
-      red_lantern_ = std::distance(std::begin(conn_), new_red_lantern);
-
-      for (uint64_t tpos = completely_written_; tpos < new_completely_written;
-           ++tpos) {
-        if (!drop_) {
-          uint64_t ts_index = UINT64_MAX;
-          if (conn_.size() > 0) {
-            ts_index = timeslice_buffer_.get_desc(0, tpos).ts_num;
-          }
-          timeslice_buffer_.send_work_item(
-              {{ts_index, tpos, timeslice_size_,
-                static_cast<uint32_t>(conn_.size())},
-               timeslice_buffer_.get_data_size_exp(),
-               timeslice_buffer_.get_desc_size_exp()});
-        } else {
+    conn_[in]->on_complete_recv(wr_id >> 24);
+    on_write_pointer_update(in);
+    break;
+
+  default:
+    throw LibfabricException("wc for unknown wr_id");
+  }
+}
+
+void TimesliceBuilder::on_remote_cq_data(uint64_t wr_id, uint64_t data) {
+  size_t in = cq_data_input_index(data);
+  assert(in < conn_.size());
+  conn_[in]->on_remote_cq_data(wr_id, data);
+  on_write_pointer_update(in);
+}
+
+void TimesliceBuilder::on_write_pointer_update(size_t in) {
+  uint64_t written = conn_[in]->cn_wp().desc;
+  if (timeslice_buffer_.has_component_events() && !drop_) {
+    send_component_events(in, red_lantern_.value(in), written);
+  }
+  red_lantern_.update(in, written);
+  uint64_t new_completely_written = red_lantern_.min_value();
+  if (connected_ == conn_.size() &&
+      new_completely_written > completely_written_) {
+    for (uint64_t tpos = completely_written_; tpos < new_completely_written;
+         ++tpos) {
+      uint64_t ts_index = UINT64_MAX;
+      if (conn_.size() > 0) {
+        ts_index = timeslice_buffer_.get_desc(0, tpos).ts_num;
+      }
+      announce(tpos, ts_index);
+      if (!drop_) {
+        update_load_shedding(tpos, ts_index);
+        if (shedding_.shed(ts_index)) {
+          L_(trace) << "[c" << compute_index_ << "] shed timeslice "
+                    << ts_index;
+          ++timeslices_shed_;
           timeslice_buffer_.send_completion({tpos});
+          continue;
         }
+        timeslice_buffer_.send_work_item(
+            {{ts_index, tpos, timeslice_size_,
+              static_cast<uint32_t>(conn_.size())},
+             timeslice_buffer_.get_data_size_exp(),
+             timeslice_buffer_.get_desc_size_exp()});
+      } else {
+        timeslice_buffer_.send_completion({tpos});
       }
-
-      completely_written_ = new_completely_written;
     }
-    break;
 
-  default:
-    throw LibfabricException("wc for unknown wr_id");
+    completely_written_ = new_completely_written;
   }
 }
 
+void TimesliceBuilder::send_component_events(std::size_t in,
+                                             uint64_t begin,
+                                             uint64_t end) {
+  for (uint64_t tpos = begin; tpos < end; ++tpos) {
+    timeslice_buffer_.send_component_event(
+        {tpos, timeslice_buffer_.get_desc(in, tpos).ts_num,
+         static_cast<uint32_t>(in), timeslice_size_,
+         timeslice_buffer_.get_data_size_exp(),
+         timeslice_buffer_.get_desc_size_exp()});
+  }
+}
+
+void TimesliceBuilder::update_load_shedding(uint64_t tpos,
+                                            uint64_t ts_index) {
+  if (shedding_.update(tpos, tpos - acked_,
+                       timeslice_buffer_.get_num_work_items())) {
+    L_(info) << "[c" << compute_index_ << "] load shedding level "
+             << shedding_.level() << "/" << LoadShedding::steps
+             << " from timeslice " << ts_index << ": shedding "
+             << shedding_.share() * 100 << "% of timeslices (hash bucket < "
+             << shedding_.level() << ")";
+  }
+}
+
+void TimesliceBuilder::announce(uint64_t tpos, uint64_t ts_index) {
+  if (ts_index == UINT64_MAX) {
+    return;
+  }
+  uint64_t epoch = schedule_.epoch(ts_index) + schedule_.lookahead();
+  if (epoch < announcements_.end()) {
+    return;
+  }
+  announcements_.announce(epoch,
+                          schedule_.weight(free_fraction(), tpos + 1 - acked_));
+  for (auto& connection : conn_) {
+    connection->on_announcement();
+  }
+}
+
+double TimesliceBuilder::free_fraction() const {
+  double free_fraction = 1.0;
+  for (auto& c : conn_) {
+    for (const auto& status :
+         {c->buffer_status_data(), c->buffer_status_desc()}) {
+      double free = static_cast<double>(status.size - status.used()) /
+                    static_cast<double>(status.size);
+      free_fraction = std::min(free_fraction, free);
+    }
+  }
+  return free_fraction;
+}
+
 void TimesliceBuilder::poll_ts_completion() {
-  fles::TimesliceCompletion c;
-  if (!timeslice_buffer_.try_receive_completion(c))
+  std::array<fles::TimesliceCompletion, 64> completions;
+  std::size_t count = timeslice_buffer_.try_receive_completions(
+      completions.data(), completions.size());
+  if (count == 0 && released_ == acked_)
     return;
-  if (c.ts_pos == acked_) {
-    do
-      ++acked_;
-    while (ack_.at(acked_) > c.ts_pos);
+  uint64_t acked = acked_;
+  for (std::size_t i = 0; i < count; ++i) {
+    const fles::TimesliceCompletion& c = completions[i];
+    if (c.ts_pos == acked_) {
+      do
+        ++acked_;
+      while (ack_.at(acked_) > c.ts_pos);
+    } else
+      ack_.at(c.ts_pos) = c.ts_pos;
+  }
+  if (acked_ != acked) {
+    timeslice_buffer_.set_acked(acked_);
+  }
+  uint64_t released = timeslice_buffer_.get_releasable(acked_);
+  if (released != released_) {
+    released_ = released;
     for (auto& connection : conn_)
-      connection->inc_ack_pointers(acked_);
-  } else
-    ack_.at(c.ts_pos) = c.ts_pos;
+      connection->inc_ack_pointers(released_);
+  }
 }
 } // namespace tl_libfabric
@@ -4,10 +4,13 @@
 
 #include "ComputeNodeConnection.hpp"
 #include "ConnectionGroup.hpp"
+#include "LoadShedding.hpp"
 #include "RingBuffer.hpp"
 #include "TimesliceComponentDescriptor.hpp"
+#include "TimesliceSchedule.hpp"
+#include "TournamentTree.hpp"
+#include "WeightAnnouncements.hpp"
 
-#include <boost/interprocess/ipc/message_queue.hpp>
 #include <boost/interprocess/mapped_region.hpp>
 #include <boost/interprocess/shared_memory_object.hpp>
 
@@ -25,7 +28,10 @@ namespace tl_libfabric {
 /// Compute buffer and input node connection container class.
 /** A ComputeBuffer object represents a timeslice buffer (filled by
  the input nodes) and a group of timeslice building connections to
- input nodes. */
+ input nodes. The share of future timeslices assigned to this compute node
+ is adapted to its free buffer space and consumer backlog by announcing
+ weights to the input nodes with the status messages (see
+ TimesliceSchedule). */
 
 class TimesliceBuilder : public ConnectionGroup<ComputeNodeConnection> {
 public:
@@ -34,10 +40,13 @@ public:
                    TimesliceBuffer& timeslice_buffer,
                    unsigned short service,
                    uint32_t num_input_nodes,
+                   uint32_t num_compute_nodes,
                    uint32_t timeslice_size,
                    volatile sig_atomic_t* signal_status,
                    bool drop,
-                   std::string local_node_name);
+                   bool cq_data,
+                   std::string local_node_name,
+                   double shed_threshold);
 
   TimesliceBuilder(const TimesliceBuilder&) = delete;
   void operator=(const TimesliceBuilder&) = delete;
@@ -58,6 +67,9 @@ public:
   /// Completion notification event dispatcher. Called by the event loop.
   virtual void on_completion(uint64_t wc_id) override;
 
+  /// Remote CQ data event dispatcher. Called by the event loop.
+  virtual void on_remote_cq_data(uint64_t wc_id, uint64_t data) override;
+
   void poll_ts_completion();
 
 private:
@@ -67,6 +79,22 @@ private:
   /// setup connections between nodes
   void bootstrap_wo_connections();
 
+  /// Check for completely written timeslices after a write pointer update.
+  void on_write_pointer_update(size_t in);
+
+  /// Publish the arrival of the components of an input at the given
+  /// timeslice positions.
+  void send_component_events(std::size_t in, uint64_t begin, uint64_t end);
+
+  /// Adapt the load shedding level before building a timeslice.
+  void update_load_shedding(uint64_t tpos, uint64_t ts_index);
+
+  /// Announce weights up to the lookahead of the given timeslice's epoch.
+  void announce(uint64_t tpos, uint64_t ts_index);
+
+  /// Retrieve the free fraction of the most occupied buffer.
+  double free_fraction() const;
+
   void make_endpoint_named(struct fi_info* info,
                            const std::string& hostname,
                            const std::string& service,
@@ -89,10 +117,16 @@ private:
 
   uint32_t timeslice_size_;
 
-  size_t red_lantern_ = 0;
+  /// The input connection with the smallest write pointer (red lantern).
+  TournamentTree red_lantern_;
+
   uint64_t completely_written_ = 0;
   uint64_t acked_ = 0;
 
+  /// Position up to which the buffer space has been released to the input
+  /// nodes, held back by component views still in use.
+  uint64_t released_ = 0;
+
   /// Buffer to store acknowledged status of timeslices.
   RingBuffer<uint64_t, true> ack_;
 
@@ -101,5 +135,20 @@ private:
   std::string local_node_name_;
 
   bool drop_;
+
+  /// Flag, true if write progress is signalled by remote CQ data.
+  bool cq_data_;
+
+  /// The policy for completing timeslices without processing them.
+  LoadShedding shedding_;
+
+  /// Number of timeslices completed without processing.
+  uint64_t timeslices_shed_ = 0;
+
+  /// Assignment of timeslices to compute nodes.
+  TimesliceSchedule schedule_;
+
+  /// Weights announced to the input nodes.
+  WeightAnnouncements announcements_;
 };
 } // namespace tl_libfabric
@@ -0,0 +1,181 @@
+// Copyright 2026 agent <agent@local>
+
+#include "ComponentSenderLocal.hpp"
+#include "MicrosliceDescriptor.hpp"
+#include "Utility.hpp"
+#include "log.hpp"
+#include <algorithm>
+#include <thread>
+
+ComponentSenderLocal::ComponentSenderLocal(
+    uint64_t input_index,
+    InputBufferReadInterface& data_source,
+    uint32_t num_compute_nodes,
+    uint32_t timeslice_size,
+    uint32_t overlap_size,
+    uint32_t max_timeslice_number,
+    volatile sig_atomic_t* signal_status)
+    : input_index_(input_index), data_source_(data_source),
+      desc_buffer_(data_source.desc_buffer()),
+      data_buffer_(data_source.data_buffer()),
+      num_compute_nodes_(num_compute_nodes), timeslice_size_(timeslice_size),
+      overlap_size_(overlap_size), max_timeslice_number_(max_timeslice_number),
+      signal_status_(signal_status),
+      released_(new std::atomic<uint64_t>[num_compute_nodes]),
+      min_acked_({data_source.desc_buffer().size() / 4,
+                  data_source.data_buffer().size() / 4}) {
+  assert(num_compute_nodes_ > 0);
+  start_index_ = acked_ = cached_acked_ = data_source.get_read_index();
+  write_index_desc_.store(start_index_.desc);
+  for (uint32_t i = 0; i < num_compute_nodes_; ++i) {
+    released_[i].store(0);
+  }
+}
+
+ComponentSenderLocal::~ComponentSenderLocal() {}
+
+void ComponentSenderLocal::operator()() {
+  data_source_.proceed();
+  time_begin_ = std::chrono::high_resolution_clock::now();
+  report_status();
+
+  while (acked_ts_ < max_timeslice_number_ && *signal_status_ == 0) {
+    data_source_.proceed();
+    uint64_t write_index_desc = data_source_.get_write_index().desc;
+    bool idle = write_index_desc == write_index_desc_.load();
+    write_index_desc_.store(write_index_desc, std::memory_order_release);
+
+    if (!ack_timeslices() && idle) {
+      std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+    scheduler_.timer();
+  }
+
+  sync_data_source();
+  time_end_ = std::chrono::high_resolution_clock::now();
+}
+
+bool ComponentSenderLocal::component_available(uint64_t timeslice) const {
+  return write_index_desc_.load(std::memory_order_acquire) >=
+         desc_offset(timeslice) + component_num_microslices();
+}
+
+uint64_t ComponentSenderLocal::component_size(uint64_t timeslice) const {
+  assert(data_end(timeslice) >= data_offset(timeslice));
+  return component_num_microslices() * sizeof(fles::MicrosliceDescriptor) +
+         data_end(timeslice) - data_offset(timeslice);
+}
+
+void ComponentSenderLocal::copy_component(
+    uint64_t timeslice, ManagedRingBuffer<uint8_t>& target) const {
+  // part 1: descriptors, in up to two chunks
+  uint64_t desc_begin = desc_offset(timeslice);
+  uint64_t desc_length = component_num_microslices();
+  uint64_t desc_chunk = std::min<uint64_t>(
+      desc_length, desc_buffer_.size() - (desc_begin & desc_buffer_.size_mask()));
+  target.append(reinterpret_cast<const uint8_t*>(&desc_buffer_.at(desc_begin)),
+                desc_chunk * sizeof(fles::MicrosliceDescriptor));
+  if (desc_chunk < desc_length) {
+    target.append(reinterpret_cast<const uint8_t*>(desc_buffer_.ptr()),
+                  (desc_length - desc_chunk) *
+                      sizeof(fles::MicrosliceDescriptor));
+  }
+
+  // part 2: data, in up to two chunks
+  uint64_t data_begin = data_offset(timeslice);
+  uint64_t data_length = data_end(timeslice) - data_begin;
+  uint64_t data_chunk = std::min<uint64_t>(
+      data_length, data_buffer_.size() - (data_begin & data_buffer_.size_mask()));
+  target.append(&data_buffer_.at(data_begin), data_chunk);
+  if (data_chunk < data_length) {
+    target.append(data_buffer_.ptr(), data_length - data_chunk);
+  }
+}
+
+void ComponentSenderLocal::release_component(uint64_t timeslice) {
+  auto& released = released_[timeslice % num_compute_nodes_];
+  assert(released.load() == timeslice / num_compute_nodes_);
+  released.store(timeslice / num_compute_nodes_ + 1,
+                 std::memory_order_release);
+}
+
+bool ComponentSenderLocal::ack_timeslices() {
+  // timeslice index of the earliest component not released, compute nodes
+  // are assigned round robin
+  uint64_t acked_ts = UINT64_MAX;
+  for (uint32_t i = 0; i < num_compute_nodes_; ++i) {
+    acked_ts = std::min<uint64_t>(
+        acked_ts,
+        released_[i].load(std::memory_order_acquire) * num_compute_nodes_ + i);
+  }
+  if (acked_ts == acked_ts_) {
+    return false;
+  }
+
+  assert(acked_ts > acked_ts_);
+  acked_ts_ = acked_ts;
+  acked_.desc = desc_offset(acked_ts_);
+  acked_.data = desc_buffer_.at(acked_.desc - 1).offset +
+                desc_buffer_.at(acked_.desc - 1).size;
+  if (acked_.data >= cached_acked_.data + min_acked_.data ||
+      acked_.desc >= cached_acked_.desc + min_acked_.desc) {
+    cached_acked_ = acked_;
+    data_source_.set_read_index(cached_acked_);
+  }
+  return true;
+}
+
+void ComponentSenderLocal::sync_data_source() {
+  if (acked_.data > cached_acked_.data || acked_.desc > cached_acked_.desc) {
+    cached_acked_ = acked_;
+    data_source_.set_read_index(cached_acked_);
+  }
+}
+
+void ComponentSenderLocal::report_status() {
+  constexpr auto interval = std::chrono::seconds(1);
+
+  std::chrono::system_clock::time_point now = std::chrono::system_clock::now();
+
+  DualIndex written = data_source_.get_write_index();
+
+  SendBufferStatus status_desc{now, desc_buffer_.size(), cached_acked_.desc,
+                               acked_.desc, written.desc};
+  SendBufferStatus status_data{now, data_buffer_.size(), cached_acked_.data,
+                               acked_.data, written.data};
+
+  double delta_t =
+      std::chrono::duration<double, std::chrono::seconds::period>(
+          status_desc.time - previous_send_buffer_status_desc_.time)
+          .count();
+  double rate_desc =
+      static_cast<double>(status_desc.acked -
+                          previous_send_buffer_status_desc_.acked) /
+      delta_t;
+  double rate_data =
+      static_cast<double>(status_data.acked -
+                          previous_send_buffer_status_data_.acked) /
+      delta_t;
+
+  L_(debug) << "[i" << input_index_ << "] desc " << status_desc.percentages()
+            << " (used..free) | "
+            << human_readable_count(status_desc.acked, true, "") << " ("
+            << human_readable_count(rate_desc, true, "Hz") << ")";
+
+  L_(debug) << "[i" << input_index_ << "] data " << status_data.percentages()
+            << " (used..free) | "
+            << human_readable_count(status_data.acked, true) << " ("
+            << human_readable_count(rate_data, true, "B/s") << ")";
+
+  L_(info) << "[i" << input_index_ << "] |"
+           << bar_graph(status_data.vector(), "#._", 20) << "|"
+           << bar_graph(status_desc.vector(), "#._", 10) << "| "
+           << human_readable_count(rate_data, true, "B/s") << " ("
+           << human_readable_count(rate_desc, true, "Hz") << ")";
+
+  previous_send_buffer_status_desc_ = status_desc;
+  previous_send_buffer_status_data_ = status_data;
+
+  scheduler_.add(std::bind(&ComponentSenderLocal::report_status, this),
+                 now + interval);
+}
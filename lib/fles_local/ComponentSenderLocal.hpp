@@ -0,0 +1,202 @@
+// Copyright 2026 agent <agent@local>
+#pragma once
+
+#include "DualRingBuffer.hpp"
+#include "ManagedRingBuffer.hpp"
+#include "Scheduler.hpp"
+#include <atomic>
+#include <boost/format.hpp>
+#include <cassert>
+#include <chrono>
+#include <csignal>
+#include <memory>
+#include <string>
+#include <vector>
+
+/// Input buffer container class for timeslice building on the same host.
+/** A ComponentSenderLocal object represents an input buffer (filled by a
+    FLIB) whose timeslice components are read by timeslice builders in the
+    same process.
+
+    The builders copy the components directly from the input buffer to
+    their timeslice buffers. The write index of the input buffer and the
+    progress of each builder are exchanged using atomic variables, the
+    sender thread only advances the read index of the data source. */
+
+class ComponentSenderLocal {
+public:
+  /// The ComponentSenderLocal constructor.
+  ComponentSenderLocal(uint64_t input_index,
+                       InputBufferReadInterface& data_source,
+                       uint32_t num_compute_nodes,
+                       uint32_t timeslice_size,
+                       uint32_t overlap_size,
+                       uint32_t max_timeslice_number,
+                       volatile sig_atomic_t* signal_status);
+
+  ComponentSenderLocal(const ComponentSenderLocal&) = delete;
+  void operator=(const ComponentSenderLocal&) = delete;
+
+  /// The ComponentSenderLocal destructor.
+  ~ComponentSenderLocal();
+
+  /// The thread main function.
+  void operator()();
+
+  /// Retrieve this component's index in the list of input components.
+  uint64_t input_index() const { return input_index_; }
+
+  /// Check if a timeslice component is completely available (thread-safe).
+  bool component_available(uint64_t timeslice) const;
+
+  /// Retrieve the number of microslices in a timeslice component.
+  uint64_t component_num_microslices() const {
+    return timeslice_size_ + overlap_size_;
+  }
+
+  /// Retrieve the size of an available timeslice component (in bytes,
+  /// including the microslice descriptors).
+  uint64_t component_size(uint64_t timeslice) const;
+
+  /// Copy an available timeslice component (microslice descriptors
+  /// followed by contents) to a ring buffer.
+  void copy_component(uint64_t timeslice,
+                      ManagedRingBuffer<uint8_t>& target) const;
+
+  /// Release a copied timeslice component (thread-safe). Each compute node
+  /// has to release its timeslices in order.
+  void release_component(uint64_t timeslice);
+
+private:
+  /// This component's index in the list of input components.
+  uint64_t input_index_;
+
+  /// Data source (e.g., FLIB via shared memory).
+  InputBufferReadInterface& data_source_;
+
+  /// Microslice descriptor buffer of the data source.
+  const RingBufferView<fles::MicrosliceDescriptor>& desc_buffer_;
+
+  /// Microslice data buffer of the data source.
+  const RingBufferView<uint8_t>& data_buffer_;
+
+  /// Number of compute nodes.
+  const uint32_t num_compute_nodes_;
+
+  /// Constant size (in microslices) of a timeslice component.
+  const uint32_t timeslice_size_;
+
+  /// Constant overlap size (in microslices) of a timeslice component.
+  const uint32_t overlap_size_;
+
+  /// Number of timeslices after which this run shall end.
+  const uint32_t max_timeslice_number_;
+
+  /// Pointer to global signal status variable.
+  volatile sig_atomic_t* signal_status_;
+
+  /// Write index received from data source, published to the builders.
+  std::atomic<uint64_t> write_index_desc_;
+
+  /// Number of timeslices released by each compute node.
+  std::unique_ptr<std::atomic<uint64_t>[]> released_;
+
+  /// Number of acknowledged timeslices.
+  uint64_t acked_ts_ = 0;
+
+  /// Indexes of acknowledged microslices (i.e., read indexes).
+  DualIndex acked_;
+
+  /// Hysteresis for writing read indexes to data source.
+  const DualIndex min_acked_;
+
+  /// Read indexes last written to data source.
+  DualIndex cached_acked_;
+
+  /// Read indexes at start of operation.
+  DualIndex start_index_;
+
+  /// Begin of operation (for performance statistics).
+  std::chrono::high_resolution_clock::time_point time_begin_;
+
+  /// End of operation (for performance statistics).
+  std::chrono::high_resolution_clock::time_point time_end_;
+
+  struct SendBufferStatus {
+    std::chrono::system_clock::time_point time;
+    uint64_t size;
+
+    uint64_t cached_acked;
+    uint64_t acked;
+    uint64_t written;
+
+    int64_t used() const {
+      assert(acked <= written);
+      return written - acked;
+    }
+    int64_t freeing() const {
+      assert(cached_acked <= acked);
+      return acked - cached_acked;
+    }
+    int64_t unused() const {
+      assert(written <= cached_acked + size);
+      return cached_acked + size - written;
+    }
+
+    float percentage(int64_t value) const {
+      return static_cast<float>(value) / static_cast<float>(size);
+    }
+
+    std::string caption() const { return std::string("used/freeing/free"); }
+
+    std::string percentage_str(int64_t value) const {
+      boost::format percent_fmt("%4.1f%%");
+      percent_fmt % (percentage(value) * 100);
+      std::string s = percent_fmt.str();
+      s.resize(4);
+      return s;
+    }
+
+    std::string percentages() const {
+      return percentage_str(used()) + " " + percentage_str(freeing()) + " " +
+             percentage_str(unused());
+    }
+
+    std::vector<int64_t> vector() const {
+      return std::vector<int64_t>{used(), freeing(), unused()};
+    }
+  };
+
+  SendBufferStatus previous_send_buffer_status_desc_ = SendBufferStatus();
+  SendBufferStatus previous_send_buffer_status_data_ = SendBufferStatus();
+
+  /// Scheduler for periodic events.
+  Scheduler scheduler_;
+
+  /// Retrieve the microslice descriptor offset of a timeslice component.
+  uint64_t desc_offset(uint64_t timeslice) const {
+    return timeslice * timeslice_size_ + start_index_.desc;
+  }
+
+  /// Retrieve the data offset of a timeslice component.
+  uint64_t data_offset(uint64_t timeslice) const {
+    return desc_buffer_.at(desc_offset(timeslice)).offset;
+  }
+
+  /// Retrieve the data end offset of a timeslice component.
+  uint64_t data_end(uint64_t timeslice) const {
+    const auto& last = desc_buffer_.at(desc_offset(timeslice) +
+                                       component_num_microslices() - 1);
+    return last.offset + last.size;
+  }
+
+  /// Update read indexes after timeslices have been released.
+  /** \return true if new timeslices have been acknowledged */
+  bool ack_timeslices();
+
+  /// Force writing read indexes to data source.
+  void sync_data_source();
+
+  /// Print a (periodic) buffer status report.
+  void report_status();
+};
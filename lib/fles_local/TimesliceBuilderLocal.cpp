@@ -0,0 +1,173 @@
+// Copyright 2026 agent <agent@local>
+
+#include "TimesliceBuilderLocal.hpp"
+#include "TimesliceCompletion.hpp"
+#include "TimesliceWorkItem.hpp"
+#include "Utility.hpp"
+#include "log.hpp"
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <thread>
+
+TimesliceBuilderLocal::TimesliceBuilderLocal(
+    uint64_t compute_index,
+    TimesliceBuffer& timeslice_buffer,
+    const std::vector<ComponentSenderLocal*> senders,
+    uint32_t num_compute_nodes,
+    uint32_t timeslice_size,
+    uint32_t max_timeslice_number,
+    volatile sig_atomic_t* signal_status)
+    : compute_index_(compute_index), timeslice_buffer_(timeslice_buffer),
+      num_compute_nodes_(num_compute_nodes), timeslice_size_(timeslice_size),
+      max_timeslice_number_(max_timeslice_number),
+      signal_status_(signal_status), ts_index_(compute_index_),
+      ack_(timeslice_buffer_.get_desc_size_exp()) {
+  for (size_t i = 0; i < senders.size(); ++i) {
+    assert(senders[i]->input_index() == i);
+    connections_.push_back(std::unique_ptr<Connection>(
+        new Connection{timeslice_buffer_, i, *senders[i]}));
+  }
+}
+
+TimesliceBuilderLocal::~TimesliceBuilderLocal() {}
+
+void TimesliceBuilderLocal::operator()() {
+  assert(connections_.size() > 0);
+  time_begin_ = std::chrono::high_resolution_clock::now();
+  report_status();
+
+  while (ts_index_ < max_timeslice_number_ && *signal_status_ == 0) {
+    bool active = handle_timeslice_completions();
+    for (auto& c : connections_) {
+      active |= store_components(*c);
+    }
+    complete_timeslices();
+    if (!active) {
+      std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+    scheduler_.timer();
+  }
+
+  time_end_ = std::chrono::high_resolution_clock::now();
+
+  // wait until all pending timeslices have been acknowledged
+  while (acked_ < tpos_) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    handle_timeslice_completions();
+  }
+  assert(timeslice_buffer_.get_num_work_items() == 0);
+  assert(timeslice_buffer_.get_num_completions() == 0);
+  timeslice_buffer_.send_end_work_item();
+  timeslice_buffer_.send_end_completion();
+}
+
+bool TimesliceBuilderLocal::store_components(Connection& c) {
+  bool stored = false;
+  uint64_t timeslice;
+  while ((timeslice = timeslice_index(c.desc.write_index())) <
+             max_timeslice_number_ &&
+         c.sender.component_available(timeslice)) {
+    uint64_t size_required = c.sender.component_size(timeslice);
+
+    if (c.data.size_available_contiguous() < size_required ||
+        c.desc.size_available() < 1) {
+      // retry after timeslice completions
+      break;
+    }
+
+    // skip remaining bytes in data buffer to avoid fractured entry
+    c.data.skip_buffer_wrap(size_required);
+
+    // generate timeslice component descriptor
+    c.desc.append({timeslice, c.data.write_index(), size_required,
+                   c.sender.component_num_microslices()});
+
+    // copy from the input buffer and release it
+    c.sender.copy_component(timeslice, c.data);
+    c.sender.release_component(timeslice);
+    stored = true;
+  }
+  return stored;
+}
+
+void TimesliceBuilderLocal::complete_timeslices() {
+  uint64_t stored = UINT64_MAX;
+  for (auto& c : connections_) {
+    stored = std::min<uint64_t>(stored, c->desc.write_index());
+  }
+
+  while (tpos_ < stored) {
+    timeslice_buffer_.send_work_item(
+        {{ts_index_, tpos_, timeslice_size_,
+          static_cast<uint32_t>(connections_.size())},
+         timeslice_buffer_.get_data_size_exp(),
+         timeslice_buffer_.get_desc_size_exp()});
+    ++tpos_;
+    // next timeslice: round robin (see TimesliceSchedule)
+    ts_index_ += num_compute_nodes_;
+  }
+}
+
+bool TimesliceBuilderLocal::handle_timeslice_completions() {
+  std::array<fles::TimesliceCompletion, 64> completions;
+  uint64_t acked = acked_;
+  std::size_t count;
+  while ((count = timeslice_buffer_.try_receive_completions(
+              completions.data(), completions.size())) > 0) {
+    for (std::size_t i = 0; i < count; ++i) {
+      const fles::TimesliceCompletion& c = completions[i];
+      if (c.ts_pos == acked_) {
+        do
+          ++acked_;
+        while (ack_.at(acked_) > c.ts_pos);
+      } else
+        ack_.at(c.ts_pos) = c.ts_pos;
+    }
+  }
+  if (acked_ == acked) {
+    return false;
+  }
+  timeslice_buffer_.set_acked(acked_);
+  for (auto& conn : connections_) {
+    conn->desc.set_read_index(acked_);
+    conn->data.set_read_index(conn->desc.at(acked_ - 1).offset +
+                              conn->desc.at(acked_ - 1).size);
+  }
+  return true;
+}
+
+void TimesliceBuilderLocal::report_status() {
+  constexpr auto interval = std::chrono::seconds(1);
+
+  std::chrono::system_clock::time_point now = std::chrono::system_clock::now();
+
+  uint64_t received_data = UINT64_MAX;
+  uint64_t acked_data = UINT64_MAX;
+  for (auto& c : connections_) {
+    received_data =
+        std::min<uint64_t>(received_data, c->data.write_index());
+    acked_data = std::min<uint64_t>(acked_data, c->data.read_index());
+  }
+
+  auto& c = connections_.at(0);
+  BufferStatus status_desc{now, c->desc.size(), acked_, acked_, tpos_};
+  BufferStatus status_data{now, c->data.size(), acked_data, acked_data,
+                           received_data};
+
+  L_(debug) << "[c" << compute_index_ << "] desc " << status_desc.percentages()
+            << " (used..free) | "
+            << human_readable_count(status_desc.acked, true, "")
+            << " timeslices";
+
+  L_(debug) << "[c" << compute_index_ << "] data " << status_data.percentages()
+            << " (used..free) | "
+            << human_readable_count(status_data.acked, true);
+
+  L_(info) << "[c" << compute_index_ << "] |"
+           << bar_graph(status_data.vector(), "#._", 20) << "|"
+           << bar_graph(status_desc.vector(), "#._", 10) << "| ";
+
+  scheduler_.add(std::bind(&TimesliceBuilderLocal::report_status, this),
+                 now + interval);
+}
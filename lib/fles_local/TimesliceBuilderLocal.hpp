@@ -0,0 +1,157 @@
+// Copyright 2026 agent <agent@local>
+#pragma once
+
+#include "ComponentSenderLocal.hpp"
+#include "ManagedRingBuffer.hpp"
+#include "RingBuffer.hpp"
+#include "Scheduler.hpp"
+#include "TimesliceBuffer.hpp"
+#include <boost/format.hpp>
+#include <chrono>
+#include <csignal>
+#include <memory>
+#include <string>
+#include <vector>
+
+/// Timeslice builder class for input buffers on the same host.
+/** A TimesliceBuilderLocal object builds timeslices from the input
+    buffers of ComponentSenderLocal objects in the same process.
+
+    Each timeslice component is copied directly from the input buffer to
+    the timeslice buffer and released to its sender immediately. */
+
+class TimesliceBuilderLocal {
+public:
+  /// The TimesliceBuilderLocal constructor.
+  TimesliceBuilderLocal(uint64_t compute_index,
+                        TimesliceBuffer& timeslice_buffer,
+                        const std::vector<ComponentSenderLocal*> senders,
+                        uint32_t num_compute_nodes,
+                        uint32_t timeslice_size,
+                        uint32_t max_timeslice_number,
+                        volatile sig_atomic_t* signal_status);
+
+  TimesliceBuilderLocal(const TimesliceBuilderLocal&) = delete;
+  void operator=(const TimesliceBuilderLocal&) = delete;
+
+  /// The TimesliceBuilderLocal destructor.
+  ~TimesliceBuilderLocal();
+
+  /// The thread main function.
+  void operator()();
+
+private:
+  /// Connection struct, handles data for one input buffer.
+  struct Connection {
+    Connection(TimesliceBuffer& timeslice_buffer,
+               size_t i,
+               ComponentSenderLocal& component_sender)
+        : desc(timeslice_buffer.get_desc_ptr(i),
+               timeslice_buffer.get_desc_size_exp()),
+          data(timeslice_buffer.get_data_ptr(i),
+               timeslice_buffer.get_data_size_exp()),
+          sender(component_sender) {}
+
+    ManagedRingBuffer<fles::TimesliceComponentDescriptor> desc;
+    ManagedRingBuffer<uint8_t> data;
+
+    ComponentSenderLocal& sender;
+  };
+
+  /// This builder's index in the list of compute nodes.
+  const uint64_t compute_index_;
+
+  /// Shared memory buffer to store received timeslices.
+  TimesliceBuffer& timeslice_buffer_;
+
+  /// Number of compute nodes.
+  const uint32_t num_compute_nodes_;
+
+  /// Constant size (in microslices) of a timeslice component.
+  const uint32_t timeslice_size_;
+
+  /// Number of timeslices after which this run shall end.
+  const uint32_t max_timeslice_number_;
+
+  /// Pointer to global signal status variable.
+  volatile sig_atomic_t* signal_status_;
+
+  /// Index of acknowledged timeslices (local index).
+  uint64_t acked_ = 0;
+
+  /// The global index of the timeslice currently being built.
+  uint64_t ts_index_;
+
+  /// The local buffer position of the timeslice currently being built.
+  uint64_t tpos_ = 0;
+
+  /// Buffer to store acknowledged status of timeslices.
+  RingBuffer<uint64_t, true> ack_;
+
+  /// The vector of connections, one per input buffer.
+  std::vector<std::unique_ptr<Connection>> connections_;
+
+  /// Begin of operation (for performance statistics).
+  std::chrono::high_resolution_clock::time_point time_begin_;
+
+  /// End of operation (for performance statistics).
+  std::chrono::high_resolution_clock::time_point time_end_;
+
+  struct BufferStatus {
+    std::chrono::system_clock::time_point time;
+    uint64_t size;
+
+    uint64_t cached_acked;
+    uint64_t acked;
+    uint64_t received;
+
+    int64_t used() const { return received - acked; }
+    int64_t freeing() const { return acked - cached_acked; }
+    int64_t unused() const { return cached_acked + size - received; }
+
+    float percentage(int64_t value) const {
+      return static_cast<float>(value) / static_cast<float>(size);
+    }
+
+    std::string caption() const { return std::string("used/freeing/free"); }
+
+    std::string percentage_str(int64_t value) const {
+      boost::format percent_fmt("%4.1f%%");
+      percent_fmt % (percentage(value) * 100);
+      std::string s = percent_fmt.str();
+      s.resize(4);
+      return s;
+    }
+
+    std::string percentages() const {
+      return percentage_str(used()) + " " + percentage_str(freeing()) + " " +
+             percentage_str(unused());
+    }
+
+    std::vector<int64_t> vector() const {
+      return std::vector<int64_t>{used(), freeing(), unused()};
+    }
+  };
+
+  /// Scheduler for periodic events.
+  Scheduler scheduler_;
+
+  /// Retrieve the global index of the timeslice at a local buffer position.
+  uint64_t timeslice_index(uint64_t tpos) const {
+    return compute_index_ + tpos * num_compute_nodes_;
+  }
+
+  /// Copy available components from an input buffer in timeslice order.
+  /** \return true if a component has been copied */
+  bool store_components(Connection& c);
+
+  /// Hand over timeslices copied from all input buffers.
+  void complete_timeslices();
+
+  /// Handle pending timeslice completions and advance read indexes.
+  /** \return true if timeslices have been acknowledged */
+  bool handle_timeslice_completions();
+
+  /// Print a (periodic) buffer status report.
+  void report_status();
+};
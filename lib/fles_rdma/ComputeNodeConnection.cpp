@@ -15,11 +15,12 @@ ComputeNodeConnection::ComputeNodeConnection(
     uint8_t* data_ptr,
     uint32_t data_buffer_size_exp,
     fles::TimesliceComponentDescriptor* desc_ptr,
+    const fles::TimesliceComponentDescriptor* absent_ptr,
     uint32_t desc_buffer_size_exp)
     : IBConnection(ec, connection_index, remote_connection_index, id),
       remote_info_(std::move(remote_info)), data_ptr_(data_ptr),
       data_buffer_size_exp_(data_buffer_size_exp), desc_ptr_(desc_ptr),
-      desc_buffer_size_exp_(desc_buffer_size_exp) {
+      desc_buffer_size_exp_(desc_buffer_size_exp), absent_ptr_(absent_ptr) {
   // send and receive only single StatusMessage struct
   qp_cap_.max_send_wr = 2; // one additional wr to avoid race (recv before
   // send completion)
@@ -48,6 +49,8 @@ void ComputeNodeConnection::post_send_status_message() {
     throw InfinibandException("Max number of pending send requests exceeded");
   }
   ++pending_send_requests_;
+  ++status_messages_sent_;
+  ++status_messages_sent_;
   post_send(&send_wr);
 }
 
@@ -137,19 +140,31 @@ void ComputeNodeConnection::on_disconnected(struct rdma_cm_event* event) {
 void ComputeNodeConnection::inc_ack_pointers(uint64_t ack_pos) {
   cn_ack_.desc = ack_pos;
 
-  const fles::TimesliceComponentDescriptor& acked_ts =
-      desc_ptr_[(ack_pos - 1) & ((UINT64_C(1) << desc_buffer_size_exp_) - 1)];
+  // after a straggler timeout, the acknowledged position may be ahead of the
+  // input channel
+  if (ack_pos >= cn_wp_.desc) {
+    cn_ack_.data = cn_wp_.data;
+    return;
+  }
 
-  cn_ack_.data = acked_ts.offset + acked_ts.size;
+  uint64_t slot = (ack_pos - 1) & ((UINT64_C(1) << desc_buffer_size_exp_) - 1);
+
+  // absent components do not occupy the data buffer
+  if (absent_ptr_ == nullptr || absent_ptr_[slot].offset != ack_pos - 1) {
+    const fles::TimesliceComponentDescriptor& acked_ts = desc_ptr_[slot];
+    cn_ack_.data = acked_ts.offset + acked_ts.size;
+  }
 }
 
 void ComputeNodeConnection::on_complete_recv() {
+  ++status_messages_received_;
   if (recv_status_message_.final) {
     L_(debug) << "[c" << remote_index_ << "] "
               << "[" << index_ << "] "
               << "received FINAL status message";
     // send FINAL status message
     send_status_message_.final = true;
+    send_status_message_.schedule_weight = 0;
     post_send_final_status_message();
     return;
   }
@@ -160,11 +175,26 @@ void ComputeNodeConnection::on_complete_recv() {
               << " (wp.desc=" << recv_status_message_.wp.desc << ")";
   }
   cn_wp_ = recv_status_message_.wp;
+  if (cn_ack_.desc >= cn_wp_.desc) {
+    // late components have been received or dropped
+    cn_ack_.data = cn_wp_.data;
+  }
   post_recv_status_message();
   send_status_message_.ack = cn_ack_;
+  add_announcement();
   post_send_status_message();
 }
 
+void ComputeNodeConnection::add_announcement() {
+  if (announcements_ != nullptr && announced_ < announcements_->end()) {
+    send_status_message_.schedule_epoch = announced_;
+    send_status_message_.schedule_weight = announcements_->weight(announced_);
+    ++announced_;
+  } else {
+    send_status_message_.schedule_weight = 0;
+  }
+}
+
 void ComputeNodeConnection::on_complete_send() { pending_send_requests_--; }
 
 void ComputeNodeConnection::on_complete_send_finalize() { done_ = true; }
@@ -6,6 +6,7 @@
 #include "InputChannelStatusMessage.hpp"
 #include "InputNodeInfo.hpp"
 #include "TimesliceComponentDescriptor.hpp"
+#include "WeightAnnouncements.hpp"
 #include <boost/format.hpp>
 #include <chrono>
 
@@ -24,6 +25,7 @@ public:
                         uint8_t* data_ptr,
                         uint32_t data_buffer_size_exp,
                         fles::TimesliceComponentDescriptor* desc_ptr,
+                        const fles::TimesliceComponentDescriptor* absent_ptr,
                         uint32_t desc_buffer_size_exp);
 
   ComputeNodeConnection(const ComputeNodeConnection&) = delete;
@@ -40,6 +42,14 @@ public:
 
   bool abort_flag() { return recv_status_message_.abort; }
 
+  /// Pass on the compute node's weights with the status messages, starting
+  /// at the given epoch.
+  void set_announcements(const WeightAnnouncements* announcements,
+                         uint64_t first_epoch) {
+    announcements_ = announcements;
+    announced_ = first_epoch;
+  }
+
   virtual void setup(struct ibv_pd* pd) override;
 
   /// Connection handler function, called on successful connection.
@@ -60,6 +70,14 @@ public:
 
   const ComputeNodeBufferPosition& cn_wp() const { return cn_wp_; }
 
+  /// Retrieve the number of status messages sent to the input channel.
+  uint64_t status_messages_sent() const { return status_messages_sent_; }
+
+  /// Retrieve the number of status messages received from the input channel.
+  uint64_t status_messages_received() const {
+    return status_messages_received_;
+  }
+
   virtual std::unique_ptr<std::vector<uint8_t>> get_private_data() override;
 
   struct BufferStatus {
@@ -113,6 +131,9 @@ public:
   }
 
 private:
+  /// Add the next announced weight (if any) to the status message.
+  void add_announcement();
+
   ComputeNodeStatusMessage send_status_message_ = ComputeNodeStatusMessage();
   ComputeNodeBufferPosition cn_ack_ = ComputeNodeBufferPosition();
 
@@ -133,6 +154,10 @@ private:
   fles::TimesliceComponentDescriptor* desc_ptr_ = nullptr;
   std::size_t desc_buffer_size_exp_ = 0;
 
+  /// Absent markers of the components (see TimesliceBuffer), nullptr
+  /// without a straggler timeout.
+  const fles::TimesliceComponentDescriptor* absent_ptr_ = nullptr;
+
   /// InfiniBand receive work request
   ibv_recv_wr recv_wr = ibv_recv_wr();
 
@@ -146,4 +171,16 @@ private:
   ibv_sge send_sge = ibv_sge();
 
   uint32_t pending_send_requests_{0};
+
+  /// Weights announced by the compute node (if any).
+  const WeightAnnouncements* announcements_ = nullptr;
+
+  /// Next epoch to announce to the input channel.
+  uint64_t announced_ = 0;
+
+  /// Number of status messages sent to the input channel.
+  uint64_t status_messages_sent_ = 0;
+
+  /// Number of status messages received from the input channel.
+  uint64_t status_messages_received_ = 0;
 };
@@ -2,7 +2,9 @@
 #pragma once
 
 #include "ConnectionGroupWorker.hpp"
+#include "IBSharedContext.hpp"
 #include "InfinibandException.hpp"
+#include <cassert>
 #include <chrono>
 #include <cstring>
 #include <fcntl.h>
@@ -42,7 +44,7 @@ public:
       listen_id_ = nullptr;
     }
 
-    if (cq_) {
+    if (cq_ && !shared_context_) {
       int err = ibv_destroy_cq(cq_);
       if (err) {
         L_(error) << "ibv_destroy_cq() failed";
@@ -50,7 +52,7 @@ public:
       cq_ = nullptr;
     }
 
-    if (pd_) {
+    if (pd_ && !shared_context_) {
       int err = ibv_dealloc_pd(pd_);
       if (err) {
         L_(error) << "ibv_dealloc_pd() failed";
@@ -61,6 +63,14 @@ public:
     rdma_destroy_event_channel(ec_);
   }
 
+  /// Use a protection domain and completion queue shared with other
+  /// connection groups. Must be called before connecting.
+  void set_shared_context(IBSharedContext* context) {
+    assert(!pd_);
+    shared_context_ = context;
+    shared_context_->add_user();
+  }
+
   void accept(unsigned short port, unsigned int count) {
     conn_.resize(count);
 
@@ -142,14 +152,18 @@ public:
   }
 
   /// The InfiniBand completion notification handler.
-  int poll_completion() {
+  int poll_completion() { return poll_completion(cq_); }
+
+  /// The InfiniBand completion notification handler for a given completion
+  /// queue.
+  int poll_completion(struct ibv_cq* cq) {
     const int ne_max = 10;
 
     struct ibv_wc wc[ne_max];
     int ne;
     int ne_total = 0;
 
-    while (ne_total < 1000 && (ne = ibv_poll_cq(cq_, ne_max, wc))) {
+    while (ne_total < 1000 && (ne = ibv_poll_cq(cq, ne_max, wc))) {
       if (ne < 0)
         throw InfinibandException("ibv_poll_cq failed");
 
@@ -260,6 +274,13 @@ protected:
   void init_context(struct ibv_context* context) {
     context_ = context;
 
+    if (shared_context_) {
+      shared_context_->init(context);
+      pd_ = shared_context_->protection_domain();
+      cq_ = shared_context_->completion_queue();
+      return;
+    }
+
     L_(debug) << "create verbs objects";
 
     pd_ = ibv_alloc_pd(context);
@@ -276,6 +297,17 @@ protected:
 
   const uint32_t num_cqe_ = 1000000;
 
+  /// Retrieve the number of completion queue entries available to this
+  /// group.
+  uint32_t available_cqe() const {
+    return shared_context_
+               ? shared_context_->num_cqe() / shared_context_->users()
+               : num_cqe_;
+  }
+
+  /// Protection domain and completion queue shared with other groups.
+  IBSharedContext* shared_context_ = nullptr;
+
   /// InfiniBand protection domain.
   struct ibv_pd* pd_ = nullptr;
 
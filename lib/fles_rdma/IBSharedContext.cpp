@@ -0,0 +1,45 @@
+// Copyright 2026 agent <agent@local>
+
+#include "IBSharedContext.hpp"
+#include "InfinibandException.hpp"
+#include "log.hpp"
+
+IBSharedContext::~IBSharedContext() {
+  if (cq_) {
+    int err = ibv_destroy_cq(cq_);
+    if (err) {
+      L_(error) << "ibv_destroy_cq() failed";
+    }
+    cq_ = nullptr;
+  }
+
+  if (pd_) {
+    int err = ibv_dealloc_pd(pd_);
+    if (err) {
+      L_(error) << "ibv_dealloc_pd() failed";
+    }
+    pd_ = nullptr;
+  }
+}
+
+void IBSharedContext::init(struct ibv_context* context) {
+  if (context_) {
+    if (context != context_)
+      throw InfinibandException("shared context used with different devices");
+    return;
+  }
+  context_ = context;
+
+  L_(debug) << "create shared verbs objects";
+
+  pd_ = ibv_alloc_pd(context);
+  if (!pd_)
+    throw InfinibandException("ibv_alloc_pd failed");
+
+  cq_ = ibv_create_cq(context, num_cqe_, nullptr, nullptr, 0);
+  if (!cq_)
+    throw InfinibandException("ibv_create_cq failed");
+
+  if (ibv_req_notify_cq(cq_, 0))
+    throw InfinibandException("ibv_req_notify_cq failed");
+}
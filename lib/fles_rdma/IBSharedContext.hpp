@@ -0,0 +1,58 @@
+// Copyright 2026 agent <agent@local>
+#pragma once
+
+#include <cstdint>
+#include <infiniband/verbs.h>
+
+/// InfiniBand verbs objects shared by several connection groups.
+/** An IBSharedContext object holds a protection domain and a completion
+    queue that are used by the connections of several connection groups.
+    The verbs objects are created for the device of the first connection.
+    Completions of all groups arrive at the shared completion queue and have
+    to be dispatched by its user, e.g. by QP number. */
+
+class IBSharedContext {
+public:
+  /// The IBSharedContext constructor.
+  explicit IBSharedContext(uint32_t num_cqe) : num_cqe_(num_cqe) {}
+
+  IBSharedContext(const IBSharedContext&) = delete;
+  IBSharedContext& operator=(const IBSharedContext&) = delete;
+
+  /// The IBSharedContext destructor.
+  ~IBSharedContext();
+
+  /// Register a connection group using this context.
+  void add_user() { ++users_; }
+
+  /// Retrieve the number of connection groups using this context.
+  unsigned int users() const { return users_; }
+
+  /// Initialize the verbs objects, if not done before.
+  void init(struct ibv_context* context);
+
+  /// Retrieve the InfiniBand protection domain.
+  struct ibv_pd* protection_domain() const { return pd_; }
+
+  /// Retrieve the InfiniBand completion queue.
+  struct ibv_cq* completion_queue() const { return cq_; }
+
+  /// Retrieve the number of completion queue entries.
+  uint32_t num_cqe() const { return num_cqe_; }
+
+private:
+  /// Number of completion queue entries.
+  const uint32_t num_cqe_;
+
+  /// Number of connection groups using this context.
+  unsigned int users_ = 0;
+
+  /// InfiniBand verbs context
+  struct ibv_context* context_ = nullptr;
+
+  /// InfiniBand protection domain.
+  struct ibv_pd* pd_ = nullptr;
+
+  /// InfiniBand completion queue
+  struct ibv_cq* cq_ = nullptr;
+};
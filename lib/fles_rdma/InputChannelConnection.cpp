@@ -6,6 +6,7 @@
 #include "RequestIdentifier.hpp"
 #include "TimesliceComponentDescriptor.hpp"
 #include "log.hpp"
+#include <algorithm>
 #include <cassert>
 #include <cstring>
 
@@ -171,8 +172,9 @@ void InputChannelConnection::inc_write_pointers(uint64_t data_size,
   cn_wp_.desc += desc_size;
 }
 
-bool InputChannelConnection::try_sync_buffer_positions() {
-  if (our_turn_) {
+bool InputChannelConnection::try_sync_buffer_positions(
+    std::chrono::system_clock::time_point now) {
+  if (our_turn_ && status_message_due(now)) {
     our_turn_ = false;
     send_status_message_.wp = cn_wp_;
     post_send_status_message();
@@ -182,6 +184,40 @@ bool InputChannelConnection::try_sync_buffer_positions() {
   }
 }
 
+bool InputChannelConnection::status_message_due(
+    std::chrono::system_clock::time_point now) const {
+  constexpr auto max_delay = std::chrono::microseconds(500);
+
+  uint64_t data_size = UINT64_C(1) << remote_info_.data_buffer_size_exp;
+  uint64_t desc_size = UINT64_C(1) << remote_info_.desc_buffer_size_exp;
+  const ComputeNodeBufferPosition& wp = send_status_message_.wp;
+  bool news = (cn_wp_ != wp);
+
+  // less than a quarter of the compute node buffer left, the input channel
+  // is about to block and needs acknowledgements
+  bool blocking =
+      !drop_requested() &&
+      (cn_wp_.data - cn_ack_.data > data_size - data_size / 4 ||
+       cn_wp_.desc - cn_ack_.desc > desc_size - desc_size / 4);
+
+  // enough progress to be worth a message
+  bool progress =
+      (cn_wp_.data - wp.data >= data_size / 8 ||
+       cn_wp_.desc - wp.desc >= std::max<uint64_t>(desc_size / 8, 1));
+
+  if (news && (finalize_ || blocking || progress)) {
+    return true;
+  }
+
+  // the compute node announces its weights only in its replies
+  bool scheduling = (schedule_received_ < schedule_wanted_);
+
+  // otherwise, send pending updates and acknowledgement requests at a
+  // limited rate
+  return (news || blocking || scheduling) &&
+         now - status_message_time_ >= max_delay;
+}
+
 uint64_t InputChannelConnection::skip_required(uint64_t data_size) {
   uint64_t databuf_size = UINT64_C(1) << remote_info_.data_buffer_size_exp;
   uint64_t databuf_wp = cn_wp_.data & (databuf_size - 1);
@@ -219,7 +255,11 @@ void InputChannelConnection::on_complete_recv() {
               << "receive completion, new cn_ack_.data="
               << recv_status_message_.ack.data;
   }
+  ++status_messages_received_;
   cn_ack_ = recv_status_message_.ack;
+  if (recv_status_message_.schedule_weight != 0) {
+    schedule_received_ = recv_status_message_.schedule_epoch + 1;
+  }
   post_recv_status_message();
 
   if (cn_wp_ == send_status_message_.wp && finalize_) {
@@ -332,5 +372,7 @@ void InputChannelConnection::post_send_status_message() {
               << send_status_message_.wp.data
               << " wp.desc=" << send_status_message_.wp.desc << ")";
   }
+  ++status_messages_sent_;
+  status_message_time_ = std::chrono::system_clock::now();
   post_send(&send_wr);
 }
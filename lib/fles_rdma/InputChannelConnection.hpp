@@ -5,6 +5,8 @@
 #include "ComputeNodeStatusMessage.hpp"
 #include "IBConnection.hpp"
 #include "InputChannelStatusMessage.hpp"
+#include <algorithm>
+#include <chrono>
 
 /// Input node connection class.
 /** An InputChannelConnection object represents the endpoint of a single
@@ -43,12 +45,44 @@ public:
   // Get number of bytes to skip in advance (to avoid buffer wrap)
   uint64_t skip_required(uint64_t data_size);
 
-  bool try_sync_buffer_positions();
+  /// Check if the compute node has acknowledged the next timeslice position
+  /// without having received it (straggler timeout). The input channel
+  /// should then drop its component instead of sending it.
+  bool drop_requested() const { return cn_ack_.desc > cn_wp_.desc; }
+
+  /// Send a write pointer update to the compute node if one is due.
+  bool try_sync_buffer_positions(std::chrono::system_clock::time_point now);
 
   void finalize(bool abort);
 
   bool request_abort_flag() { return recv_status_message_.request_abort; }
 
+  /// Retrieve the epoch of the weight announced in the most recent status
+  /// message.
+  uint64_t schedule_epoch() const {
+    return recv_status_message_.schedule_epoch;
+  }
+
+  /// Retrieve the weight announced in the most recent status message (zero
+  /// if none).
+  uint32_t schedule_weight() const {
+    return recv_status_message_.schedule_weight;
+  }
+
+  /// Keep exchanging status messages until the compute node has announced
+  /// its weight for the given epoch.
+  void request_schedule(uint64_t epoch) {
+    schedule_wanted_ = std::max(schedule_wanted_, epoch + 1);
+  }
+
+  /// Retrieve the number of status messages sent to the compute node.
+  uint64_t status_messages_sent() const { return status_messages_sent_; }
+
+  /// Retrieve the number of status messages received from the compute node.
+  uint64_t status_messages_received() const {
+    return status_messages_received_;
+  }
+
   void on_complete_write();
 
   /// Handle Infiniband receive completion notification.
@@ -77,12 +111,31 @@ private:
   /// Post a send work request (WR) to the send queue
   void post_send_status_message();
 
+  /// Check if a write pointer update should be sent (coalescing of status
+  /// messages).
+  bool status_message_due(std::chrono::system_clock::time_point now) const;
+
   /// Flag, true if it is the input nodes's turn to send a pointer update.
   bool our_turn_ = true;
 
+  /// Time of the most recent status message sent to the compute node.
+  std::chrono::system_clock::time_point status_message_time_;
+
+  /// Number of status messages sent to the compute node.
+  uint64_t status_messages_sent_ = 0;
+
+  /// Number of status messages received from the compute node.
+  uint64_t status_messages_received_ = 0;
+
   bool finalize_ = false;
   bool abort_ = false;
 
+  /// Epochs before this one have been requested from the compute node.
+  uint64_t schedule_wanted_ = 0;
+
+  /// Epochs before this one have been announced by the compute node.
+  uint64_t schedule_received_ = 0;
+
   /// Access information for memory regions on remote end.
   ComputeNodeInfo remote_info_ = ComputeNodeInfo();
 
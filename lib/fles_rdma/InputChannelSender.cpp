@@ -5,6 +5,7 @@
 #include "RequestIdentifier.hpp"
 #include "Utility.hpp"
 #include "log.hpp"
+#include <algorithm>
 #include <cassert>
 #include <chrono>
 #include <thread>
@@ -21,6 +22,7 @@ InputChannelSender::InputChannelSender(
       compute_hostnames_(compute_hostnames),
       compute_services_(compute_services), timeslice_size_(timeslice_size),
       overlap_size_(overlap_size), max_timeslice_number_(max_timeslice_number),
+      schedule_(static_cast<uint32_t>(compute_hostnames.size())),
       min_acked_desc_(data_source.desc_buffer().size() / 4),
       min_acked_data_(data_source.data_buffer().size() / 4) {
   start_index_desc_ = sent_desc_ = acked_desc_ = cached_acked_desc_ =
@@ -118,11 +120,11 @@ void InputChannelSender::report_status() {
 }
 
 void InputChannelSender::sync_buffer_positions() {
+  auto now = std::chrono::system_clock::now();
   for (auto& c : conn_) {
-    c->try_sync_buffer_positions();
+    c->try_sync_buffer_positions(now);
   }
 
-  auto now = std::chrono::system_clock::now();
   scheduler_.add(std::bind(&InputChannelSender::sync_buffer_positions, this),
                  now + std::chrono::milliseconds(0));
 }
@@ -146,36 +148,61 @@ void InputChannelSender::operator()() {
   try {
 
     connect();
-    while (connected_ != compute_hostnames_.size()) {
+    while (!connected()) {
       poll_cm_events();
     }
-    L_(info) << "[i" << input_index_ << "] "
-             << "connection to compute nodes established";
-
-    data_source_.proceed();
-    time_begin_ = std::chrono::high_resolution_clock::now();
-
-    uint64_t timeslice = 0;
-    sync_buffer_positions();
-    sync_data_source(true);
-    report_status();
-    while (timeslice < max_timeslice_number_ && !abort_) {
-      if (try_send_timeslice(timeslice)) {
-        timeslice++;
-        if (timeslice == 1) {
+
+    begin();
+    while (step()) {
+      poll_completion();
+    }
+
+    // this should not be neccessary
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    disconnect();
+    while (!disconnected()) {
+      poll_cm_events();
+    }
+
+    report_summary();
+  } catch (std::exception& e) {
+    L_(error) << "exception in InputChannelSender: " << e.what();
+  }
+}
+
+void InputChannelSender::begin() {
+  L_(info) << "[i" << input_index_ << "] "
+           << "connection to compute nodes established";
+
+  data_source_.proceed();
+  time_begin_ = std::chrono::high_resolution_clock::now();
+
+  sync_buffer_positions();
+  sync_data_source(true);
+  report_status();
+}
+
+bool InputChannelSender::step() {
+  switch (state_) {
+  case State::Sending:
+    if (timeslice_ < max_timeslice_number_ && !abort_) {
+      if (try_send_timeslice(timeslice_)) {
+        timeslice_++;
+        if (timeslice_ == 1) {
           L_(info) << "[i" << input_index_ << "] "
                    << "first timeslice processed";
         }
       }
-      poll_completion();
       data_source_.proceed();
-      scheduler_.timer();
+      break;
     }
-
+    state_ = State::Draining;
+  // fall through
+  case State::Draining:
     // wait for pending send completions
-    while (acked_desc_ < timeslice_size_ * timeslice + start_index_desc_) {
-      poll_completion();
-      scheduler_.timer();
+    if (acked_desc_ < timeslice_size_ * timeslice_ + start_index_desc_) {
+      break;
     }
     sync_data_source(false);
 
@@ -185,25 +212,42 @@ void InputChannelSender::operator()() {
 
     L_(debug) << "[i" << input_index_ << "] "
               << "SENDER loop done";
-
-    while (!all_done_) {
-      poll_completion();
-      scheduler_.timer();
+    state_ = State::Finalizing;
+  // fall through
+  case State::Finalizing:
+    if (!all_done_) {
+      break;
     }
-
     time_end_ = std::chrono::high_resolution_clock::now();
+    state_ = State::Done;
+  // fall through
+  case State::Done:
+    return false;
+  }
 
-    // this should not be neccessary
-    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  scheduler_.timer();
+  return true;
+}
 
-    disconnect();
-    while (connected_ != 0 || timewait_ != 0) {
-      poll_cm_events();
-    }
+void InputChannelSender::report_summary() {
+  summary();
 
-    summary();
-  } catch (std::exception& e) {
-    L_(error) << "exception in InputChannelSender: " << e.what();
+  // control traffic per timeslice
+  uint64_t messages_sent = 0;
+  uint64_t messages_received = 0;
+  for (auto& c : conn_) {
+    messages_sent += c->status_messages_sent();
+    messages_received += c->status_messages_received();
+  }
+  L_(info) << "[i" << input_index_ << "] summary: " << messages_sent
+           << " status messages sent, " << messages_received << " received ("
+           << static_cast<double>(messages_sent + messages_received) /
+                  static_cast<double>(std::max<uint64_t>(timeslice_, 1))
+           << " per timeslice)";
+  if (dropped_timeslices_ != 0) {
+    L_(warning) << "[i" << input_index_ << "] summary: "
+                << dropped_timeslices_
+                << " late timeslice components dropped";
   }
 }
 
@@ -236,8 +280,26 @@ bool InputChannelSender::try_send_timeslice(uint64_t timeslice) {
       L_(trace) << get_state_string();
     }
 
+    // wait until all compute nodes have announced their weights
+    if (!schedule_.ready(timeslice)) {
+      for (auto& c : conn_) {
+        c->request_schedule(schedule_.epoch(timeslice));
+      }
+      return false;
+    }
+
     int cn = target_cn_index(timeslice);
 
+    if (conn_[cn]->drop_requested()) {
+      // the compute node has given up waiting for this component
+      conn_[cn]->inc_write_pointers(0, 1);
+      ++dropped_timeslices_;
+      sent_desc_ = desc_offset + desc_length;
+      sent_data_ = data_end;
+      on_timeslice_acked(timeslice);
+      return true;
+    }
+
     if (!conn_[cn]->write_request_available())
       return false;
 
@@ -270,7 +332,8 @@ InputChannelSender::create_input_node_connection(uint_fast16_t index) {
   // do not overflow
   unsigned int max_pending_write_requests = std::min(
       static_cast<unsigned int>((max_send_wr - 1) / 3),
-      static_cast<unsigned int>((num_cqe_ - 1) / compute_hostnames_.size()));
+      static_cast<unsigned int>((available_cqe() - 1) /
+                                compute_hostnames_.size()));
 
   std::unique_ptr<InputChannelConnection> connection(new InputChannelConnection(
       ec_, index, input_index_, max_send_wr, max_pending_write_requests));
@@ -287,7 +350,7 @@ void InputChannelSender::connect() {
 }
 
 int InputChannelSender::target_cn_index(uint64_t timeslice) {
-  return timeslice % conn_.size();
+  return static_cast<int>(schedule_.compute_node(timeslice));
 }
 
 void InputChannelSender::dump_mr(struct ibv_mr* mr) {
@@ -437,37 +500,16 @@ void InputChannelSender::on_completion(const struct ibv_wc& wc) {
 
     int cn = (wc.wr_id >> 8) & 0xFFFF;
     conn_[cn]->on_complete_write();
-
-    uint64_t acked_ts = (acked_desc_ - start_index_desc_) / timeslice_size_;
-    if (ts != acked_ts) {
-      // transmission has been reordered, store completion information
-      ack_.at(ts) = ts;
-    } else {
-      // completion is for earliest pending timeslice, update indices
-      do {
-        ++acked_ts;
-      } while (ack_.at(acked_ts) > ts);
-      acked_desc_ = acked_ts * timeslice_size_ + start_index_desc_;
-      acked_data_ = data_source_.desc_buffer().at(acked_desc_ - 1).offset +
-                    data_source_.desc_buffer().at(acked_desc_ - 1).size;
-      if (acked_data_ >= cached_acked_data_ + min_acked_data_ ||
-          acked_desc_ >= cached_acked_desc_ + min_acked_desc_) {
-        cached_acked_data_ = acked_data_;
-        cached_acked_desc_ = acked_desc_;
-        data_source_.set_read_index({cached_acked_desc_, cached_acked_data_});
-      }
-    }
-    if (false) {
-      L_(trace) << "[i" << input_index_ << "] "
-                << "write timeslice " << ts
-                << " complete, now: acked_data_=" << acked_data_
-                << " acked_desc_=" << acked_desc_;
-    }
+    on_timeslice_acked(ts);
   } break;
 
   case ID_RECEIVE_STATUS: {
     int cn = wc.wr_id >> 8;
     conn_[cn]->on_complete_recv();
+    if (conn_[cn]->schedule_weight() != 0 && !conn_[cn]->done()) {
+      schedule_.set_weight(cn, conn_[cn]->schedule_epoch(),
+                           conn_[cn]->schedule_weight());
+    }
     if (conn_[cn]->request_abort_flag()) {
       abort_ = true;
     }
@@ -489,3 +531,31 @@ void InputChannelSender::on_completion(const struct ibv_wc& wc) {
     throw InfinibandException("wc for unknown wr_id");
   }
 }
+
+void InputChannelSender::on_timeslice_acked(uint64_t ts) {
+  uint64_t acked_ts = (acked_desc_ - start_index_desc_) / timeslice_size_;
+  if (ts != acked_ts) {
+    // transmission has been reordered, store completion information
+    ack_.at(ts) = ts;
+  } else {
+    // completion is for earliest pending timeslice, update indices
+    do {
+      ++acked_ts;
+    } while (ack_.at(acked_ts) > ts);
+    acked_desc_ = acked_ts * timeslice_size_ + start_index_desc_;
+    acked_data_ = data_source_.desc_buffer().at(acked_desc_ - 1).offset +
+                  data_source_.desc_buffer().at(acked_desc_ - 1).size;
+    if (acked_data_ >= cached_acked_data_ + min_acked_data_ ||
+        acked_desc_ >= cached_acked_desc_ + min_acked_desc_) {
+      cached_acked_data_ = acked_data_;
+      cached_acked_desc_ = acked_desc_;
+      data_source_.set_read_index({cached_acked_desc_, cached_acked_data_});
+    }
+  }
+  if (false) {
+    L_(trace) << "[i" << input_index_ << "] "
+              << "write timeslice " << ts
+              << " complete, now: acked_data_=" << acked_data_
+              << " acked_desc_=" << acked_desc_;
+  }
+}
@@ -5,13 +5,15 @@
 #include "IBConnectionGroup.hpp"
 #include "InputChannelConnection.hpp"
 #include "RingBuffer.hpp"
+#include "TimesliceSchedule.hpp"
 #include <boost/format.hpp>
 #include <cassert>
 
 /// Input buffer and compute node connection container class.
 /** An InputChannelSender object represents an input buffer (filled by a
     FLIB) and a group of timeslice building connections to compute
-    nodes. */
+    nodes. Timeslices are assigned to compute nodes according to the
+    weights announced by the compute nodes in their status messages. */
 
 class InputChannelSender : public IBConnectionGroup<InputChannelConnection> {
 public:
@@ -37,6 +39,25 @@ public:
 
   virtual void operator()() override;
 
+  /// Check if the connections to all compute nodes are established.
+  bool connected() const { return connected_ == compute_hostnames_.size(); }
+
+  /// Check if the connections to all compute nodes are shut down.
+  bool disconnected() const { return connected_ == 0 && timewait_ == 0; }
+
+  /// Start sending after the connections have been established.
+  void begin();
+
+  /// Perform a single iteration of the sender's event loop, excluding the
+  /// polling of the completion queue. Return false when done.
+  bool step();
+
+  /// Log summary information after disconnecting.
+  void report_summary();
+
+  /// Retrieve the index of the input channel.
+  uint64_t input_index() const { return input_index_; }
+
   /// The central function for distributing timeslice data.
   bool try_send_timeslice(uint64_t timeslice);
 
@@ -47,6 +68,11 @@ public:
   void connect();
 
 private:
+  friend class InputChannelSenderGroup;
+
+  /// States of the sender's event loop.
+  enum class State { Sending, Draining, Finalizing, Done };
+
   /// Return target computation node for given timeslice.
   int target_cn_index(uint64_t timeslice);
 
@@ -72,6 +98,10 @@ private:
   /// Completion notification event dispatcher. Called by the event loop.
   virtual void on_completion(const struct ibv_wc& wc) override;
 
+  /// Update the acknowledged positions after a timeslice has been sent or
+  /// dropped.
+  void on_timeslice_acked(uint64_t ts);
+
   uint64_t input_index_;
 
   /// InfiniBand memory region descriptor for input data buffer.
@@ -105,6 +135,9 @@ private:
   const uint32_t overlap_size_;
   const uint32_t max_timeslice_number_;
 
+  /// Assignment of timeslices to compute nodes.
+  TimesliceSchedule schedule_;
+
   const uint64_t min_acked_desc_;
   const uint64_t min_acked_data_;
 
@@ -116,8 +149,17 @@ private:
 
   uint64_t write_index_desc_ = 0;
 
+  /// Number of timeslice components dropped on request of a compute node.
+  uint64_t dropped_timeslices_ = 0;
+
   bool abort_ = false;
 
+  /// Current state of the sender's event loop.
+  State state_ = State::Sending;
+
+  /// Index of the next timeslice to send.
+  uint64_t timeslice_ = 0;
+
   struct SendBufferStatus {
     std::chrono::system_clock::time_point time;
     uint64_t size;
@@ -0,0 +1,108 @@
+// Copyright 2026 agent <agent@local>
+
+#include "InputChannelSenderGroup.hpp"
+#include "log.hpp"
+#include <algorithm>
+#include <sstream>
+#include <thread>
+
+InputChannelSenderGroup::InputChannelSenderGroup() : context_(1000000) {}
+
+void InputChannelSenderGroup::add(std::unique_ptr<InputChannelSender> sender) {
+  sender->set_shared_context(&context_);
+  senders_.push_back(std::move(sender));
+}
+
+/// The thread main function.
+void InputChannelSenderGroup::operator()() {
+  try {
+    for (auto& s : senders_) {
+      s->connect();
+    }
+    while (!std::all_of(senders_.begin(), senders_.end(),
+                        [](const std::unique_ptr<InputChannelSender>& s) {
+                          return s->connected();
+                        })) {
+      for (auto& s : senders_) {
+        s->poll_cm_events();
+      }
+    }
+
+    for (auto& s : senders_) {
+      for (auto& c : s->conn_) {
+        qp_senders_[c->qp()->qp_num] = s.get();
+      }
+      s->begin();
+    }
+
+    // round robin, starting with a different sender in each round
+    std::vector<bool> active(senders_.size(), true);
+    std::size_t remaining = senders_.size();
+    std::size_t first = 0;
+    while (remaining > 0) {
+      for (std::size_t i = 0; i < senders_.size(); ++i) {
+        std::size_t s = (first + i) % senders_.size();
+        if (active[s] && !senders_[s]->step()) {
+          active[s] = false;
+          --remaining;
+        }
+      }
+      first = (first + 1) % senders_.size();
+      poll_completion();
+    }
+
+    // this should not be neccessary
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    for (auto& s : senders_) {
+      s->disconnect();
+    }
+    while (!std::all_of(senders_.begin(), senders_.end(),
+                        [](const std::unique_ptr<InputChannelSender>& s) {
+                          return s->disconnected();
+                        })) {
+      for (auto& s : senders_) {
+        s->poll_cm_events();
+      }
+    }
+
+    for (auto& s : senders_) {
+      s->report_summary();
+    }
+  } catch (std::exception& e) {
+    L_(error) << "exception in InputChannelSenderGroup: " << e.what();
+  }
+}
+
+int InputChannelSenderGroup::poll_completion() {
+  const int ne_max = 10;
+
+  struct ibv_wc wc[ne_max];
+  int ne;
+  int ne_total = 0;
+
+  while (ne_total < 1000 &&
+         (ne = ibv_poll_cq(context_.completion_queue(), ne_max, wc))) {
+    if (ne < 0)
+      throw InfinibandException("ibv_poll_cq failed");
+
+    ne_total += ne;
+    for (int i = 0; i < ne; ++i) {
+      if (wc[i].status != IBV_WC_SUCCESS) {
+        std::ostringstream s;
+        s << ibv_wc_status_str(wc[i].status) << " for wr_id "
+          << static_cast<int>(wc[i].wr_id);
+        L_(error) << s.str();
+
+        continue;
+      }
+
+      auto it = qp_senders_.find(wc[i].qp_num);
+      if (it == qp_senders_.end())
+        throw InfinibandException("wc for unknown qp_num");
+      it->second->on_completion(wc[i]);
+    }
+  }
+
+  return ne_total;
+}
@@ -0,0 +1,48 @@
+// Copyright 2026 agent <agent@local>
+#pragma once
+
+#include "ConnectionGroupWorker.hpp"
+#include "IBSharedContext.hpp"
+#include "InputChannelSender.hpp"
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+/// Container class for several input channels driven by a single thread.
+/** An InputChannelSenderGroup object runs the event loops of several
+    InputChannelSender objects in one thread. The senders take turns in
+    round-robin order, each sending at most one timeslice per turn. Their
+    connections share a protection domain and a completion queue, the
+    completions are dispatched to the senders by QP number. */
+
+class InputChannelSenderGroup : public ConnectionGroupWorker {
+public:
+  /// The InputChannelSenderGroup constructor.
+  InputChannelSenderGroup();
+
+  InputChannelSenderGroup(const InputChannelSenderGroup&) = delete;
+  void operator=(const InputChannelSenderGroup&) = delete;
+
+  /// Add an input channel. Must be called before running the group.
+  void add(std::unique_ptr<InputChannelSender> sender);
+
+  /// Retrieve the number of input channels.
+  std::size_t size() const { return senders_.size(); }
+
+  /// The thread main function.
+  virtual void operator()() override;
+
+private:
+  /// Poll the shared completion queue and dispatch the completions.
+  int poll_completion();
+
+  /// Protection domain and completion queue shared by the senders.
+  /** Declared before the senders, which have to be destroyed first. */
+  IBSharedContext context_;
+
+  /// The input channels driven by this group.
+  std::vector<std::unique_ptr<InputChannelSender>> senders_;
+
+  /// The sender owning each QP, indexed by QP number.
+  std::unordered_map<uint32_t, InputChannelSender*> qp_senders_;
+};
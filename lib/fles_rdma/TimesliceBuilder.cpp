@@ -6,23 +6,63 @@
 #include "TimesliceCompletion.hpp"
 #include "TimesliceWorkItem.hpp"
 #include "log.hpp"
+#include <algorithm>
+#include <array>
 
 TimesliceBuilder::TimesliceBuilder(uint64_t compute_index,
                                    TimesliceBuffer& timeslice_buffer,
                                    unsigned short service,
                                    uint32_t num_input_nodes,
+                                   uint32_t num_compute_nodes,
                                    uint32_t timeslice_size,
                                    volatile sig_atomic_t* signal_status,
-                                   bool drop)
+                                   bool drop,
+                                   uint32_t num_shards,
+                                   std::chrono::milliseconds straggler_timeout,
+                                   double shed_threshold)
     : compute_index_(compute_index), timeslice_buffer_(timeslice_buffer),
       service_(service), num_input_nodes_(num_input_nodes),
       timeslice_size_(timeslice_size),
       ack_(timeslice_buffer_.get_desc_size_exp()),
-      signal_status_(signal_status), drop_(drop) {
+      straggler_timeout_(straggler_timeout), written_(num_input_nodes),
+      progress_(num_input_nodes),
+      shedding_(ack_.size(), shed_threshold, shed_threshold * 3 / 4),
+      schedule_(num_compute_nodes),
+      // keep weights for as many epochs as a lagging input may fall behind
+      announcements_(timeslice_buffer_.get_desc_size_exp() + 1,
+                     schedule_.lookahead()),
+      acked_data_(num_input_nodes),
+      signal_status_(signal_status), drop_(drop),
+      deferred_cm_events_(
+          std::max<uint32_t>(std::min(num_shards, num_input_nodes), 1)) {
   assert(timeslice_buffer_.get_num_input_nodes() == num_input_nodes);
+  assert(straggler_timeout_.count() == 0 ||
+         timeslice_buffer_.has_absent_markers());
+  assert(num_input_nodes_ > 0);
+  num_shards = std::max<uint32_t>(std::min(num_shards, num_input_nodes_), 1);
+  for (uint32_t s = 0; s < num_shards; ++s) {
+    std::size_t size = (num_input_nodes_ - s + num_shards - 1) / num_shards;
+    shards_.push_back(std::unique_ptr<Shard>(new Shard(size)));
+  }
 }
 
-TimesliceBuilder::~TimesliceBuilder() {}
+TimesliceBuilder::~TimesliceBuilder() {
+  stop_shards();
+
+  // destroy the connections before their completion queues
+  for (auto& c : conn_) {
+    c = nullptr;
+  }
+  for (auto& shard : shards_) {
+    if (shard->cq && shard->cq != cq_) {
+      int err = ibv_destroy_cq(shard->cq);
+      if (err) {
+        L_(error) << "ibv_destroy_cq() failed";
+      }
+    }
+    shard->cq = nullptr;
+  }
+}
 
 void TimesliceBuilder::report_status() {
   constexpr auto interval = std::chrono::seconds(1);
@@ -30,7 +70,19 @@ void TimesliceBuilder::report_status() {
   std::chrono::system_clock::time_point now = std::chrono::system_clock::now();
 
   L_(debug) << "[c" << compute_index_ << "] " << completely_written_
-            << " completely written, " << acked_ << " acked";
+            << " completely written, " << acked_ << " acked, "
+            << shards_.size() << " shard(s)";
+
+  if (shards_.size() > 1) {
+    // connections are owned by the shard threads, report shard minimum only
+    for (std::size_t s = 0; s < shards_.size(); ++s) {
+      L_(debug) << "[c" << compute_index_ << "] shard " << s << ": "
+                << shards_[s]->completely_written << " completely written";
+    }
+    scheduler_.add(std::bind(&TimesliceBuilder::report_status, this),
+                   now + interval);
+    return;
+  }
 
   for (auto& c : conn_) {
     auto status_desc = c->buffer_status_desc();
@@ -55,9 +107,7 @@ void TimesliceBuilder::request_abort() {
   L_(info) << "[c" << compute_index_ << "] "
            << "request abort";
 
-  for (auto& connection : conn_) {
-    connection->request_abort();
-  }
+  abort_requested_ = true;
 }
 
 /// The thread main function.
@@ -74,12 +124,28 @@ void TimesliceBuilder::operator()() {
 
     time_begin_ = std::chrono::high_resolution_clock::now();
 
+    for (std::size_t s = 1; s < shards_.size(); ++s) {
+      deferred_cm_events_.hold(s);
+      shards_[s]->thread = std::thread(&TimesliceBuilder::run_shard, this, s);
+    }
+
     report_status();
     while (!all_done_ || connected_ != 0 || timewait_ != 0) {
       if (!all_done_) {
-        poll_completion();
+        poll_shard(0);
+        on_write_pointer_update();
         poll_ts_completion();
+
+        std::size_t connections_done = 0;
+        for (auto& shard : shards_) {
+          if (shard->failed) {
+            std::rethrow_exception(shard->exception);
+          }
+          connections_done += shard->connections_done;
+        }
+        all_done_ = (connections_done == conn_.size());
       }
+      join_finished_shards();
       if (connected_ != 0 || timewait_ != 0) {
         poll_cm_events();
       }
@@ -91,19 +157,73 @@ void TimesliceBuilder::operator()() {
     }
 
     time_end_ = std::chrono::high_resolution_clock::now();
+    stop_shards();
+
+    bool aborted = std::any_of(
+        conn_.begin(), conn_.end(),
+        [](const std::unique_ptr<ComputeNodeConnection>& c) {
+          return c->abort_flag();
+        });
+    if (!aborted) {
+      assert(timeslice_buffer_.get_num_work_items() == 0);
+      assert(timeslice_buffer_.get_num_completions() == 0);
+    }
 
     timeslice_buffer_.send_end_work_item();
     timeslice_buffer_.send_end_completion();
 
     summary();
+    if (shedding_.enabled()) {
+      L_(info) << "[c" << compute_index_ << "] summary: " << timeslices_shed_
+               << " timeslices shed";
+    }
+    if (timeslice_buffer_.get_num_component_events_lost() != 0) {
+      L_(info) << "[c" << compute_index_ << "] summary: "
+               << timeslice_buffer_.get_num_component_events_lost()
+               << " component events discarded";
+    }
+
+    // control traffic per timeslice
+    uint64_t messages_sent = 0;
+    uint64_t messages_received = 0;
+    uint64_t components = 0;
+    for (auto& c : conn_) {
+      messages_sent += c->status_messages_sent();
+      messages_received += c->status_messages_received();
+      components += c->cn_wp().desc;
+    }
+    uint64_t timeslices = components / std::max<size_t>(conn_.size(), 1);
+    L_(info) << "[c" << compute_index_ << "] summary: " << messages_received
+             << " status messages received, " << messages_sent << " sent ("
+             << static_cast<double>(messages_received + messages_sent) /
+                    static_cast<double>(std::max<uint64_t>(timeslices, 1))
+             << " per timeslice)";
+    for (std::size_t i = 0; i < progress_.size(); ++i) {
+      if (progress_[i].missing != 0) {
+        L_(warning) << "[c" << compute_index_ << "] summary: input " << i
+                    << ": " << progress_[i].missing
+                    << " components missing, " << progress_[i].late
+                    << " of them late";
+      }
+    }
   } catch (std::exception& e) {
+    stop_shards();
     L_(error) << "exception in TimesliceBuilder: " << e.what();
   }
 }
 
 void TimesliceBuilder::on_connect_request(struct rdma_cm_event* event) {
-  if (!pd_)
+  if (!pd_) {
     init_context(event->id->verbs);
+    shards_[0]->cq = cq_;
+    for (std::size_t s = 1; s < shards_.size(); ++s) {
+      shards_[s]->cq = ibv_create_cq(event->id->verbs,
+                                     num_cqe_ / shards_.size(), nullptr,
+                                     nullptr, 0);
+      if (!shards_[s]->cq)
+        throw InfinibandException("ibv_create_cq failed");
+    }
+  }
 
   assert(event->param.conn.private_data_len >= sizeof(InputNodeInfo));
   InputNodeInfo remote_info =
@@ -117,10 +237,275 @@ void TimesliceBuilder::on_connect_request(struct rdma_cm_event* event) {
       timeslice_buffer_.get_data_ptr(index),
       timeslice_buffer_.get_data_size_exp(),
       timeslice_buffer_.get_desc_ptr(index),
+      timeslice_buffer_.get_absent_ptr(index),
       timeslice_buffer_.get_desc_size_exp()));
+  conn->set_announcements(&announcements_, schedule_.lookahead());
   conn_.at(index) = std::move(conn);
 
-  conn_.at(index)->on_connect_request(event, pd_, cq_);
+  conn_.at(index)->on_connect_request(event, pd_, shard(index).cq);
+}
+
+void TimesliceBuilder::on_disconnected(struct rdma_cm_event* event) {
+  if (!defer_cm_event(event)) {
+    IBConnectionGroup<ComputeNodeConnection>::on_disconnected(event);
+  }
+}
+
+void TimesliceBuilder::on_timewait_exit(struct rdma_cm_event* event) {
+  if (!defer_cm_event(event)) {
+    IBConnectionGroup<ComputeNodeConnection>::on_timewait_exit(event);
+  }
+}
+
+bool TimesliceBuilder::defer_cm_event(struct rdma_cm_event* event) {
+  auto* conn = static_cast<ComputeNodeConnection*>(event->id->context);
+  struct rdma_cm_event event_copy = *event;
+  // the private data is released after the event has been handled
+  event_copy.param.conn.private_data = nullptr;
+  event_copy.param.conn.private_data_len = 0;
+  return deferred_cm_events_.defer(conn->index() % shards_.size(),
+                                   event_copy);
+}
+
+void TimesliceBuilder::join_finished_shards() {
+  for (std::size_t s = 1; s < shards_.size(); ++s) {
+    Shard& sh = *shards_[s];
+    if (!sh.thread.joinable() || !sh.finished) {
+      continue;
+    }
+    sh.thread.join();
+    for (auto& event : deferred_cm_events_.release(s)) {
+      if (event.event == RDMA_CM_EVENT_DISCONNECTED) {
+        IBConnectionGroup<ComputeNodeConnection>::on_disconnected(&event);
+      } else {
+        IBConnectionGroup<ComputeNodeConnection>::on_timewait_exit(&event);
+      }
+    }
+  }
+}
+
+void TimesliceBuilder::poll_shard(std::size_t s) {
+  Shard& sh = *shards_[s];
+  poll_completion(sh.cq);
+
+  uint64_t acked = shared_acked_.load(std::memory_order_acquire);
+  bool abort = abort_requested_ && !sh.abort_requested;
+  if (acked != sh.acked || abort) {
+    for (std::size_t i = s; i < conn_.size(); i += shards_.size()) {
+      if (acked != sh.acked) {
+        conn_[i]->inc_ack_pointers(acked);
+      }
+      if (abort) {
+        conn_[i]->request_abort();
+      }
+    }
+    sh.acked = acked;
+    sh.abort_requested |= abort;
+  }
+}
+
+void TimesliceBuilder::run_shard(std::size_t s) {
+  Shard& sh = *shards_[s];
+  try {
+    while (sh.connections_done != sh.red_lantern.size() && !stop_shards_) {
+      poll_shard(s);
+    }
+  } catch (...) {
+    sh.exception = std::current_exception();
+    sh.failed = true;
+  }
+  sh.finished = true;
+}
+
+void TimesliceBuilder::stop_shards() {
+  stop_shards_ = true;
+  for (auto& shard : shards_) {
+    if (shard->thread.joinable()) {
+      shard->thread.join();
+    }
+  }
+}
+
+void TimesliceBuilder::on_write_pointer_update() {
+  if (connected_ != conn_.size()) {
+    return;
+  }
+
+  // lock-free minimum of the shards' write pointers
+  uint64_t new_completely_written = UINT64_MAX;
+  uint64_t max_written = 0;
+  for (auto& shard : shards_) {
+    new_completely_written =
+        std::min<uint64_t>(new_completely_written, shard->completely_written);
+    max_written = std::max<uint64_t>(max_written, shard->max_written);
+  }
+
+  if (straggler_timeout_.count() != 0) {
+    new_completely_written =
+        check_stragglers(new_completely_written, max_written);
+  }
+
+  for (uint64_t tpos = completely_written_; tpos < new_completely_written;
+       ++tpos) {
+    uint64_t ts_index = UINT64_MAX;
+    if (num_lagging_ > 0 && !drop_) {
+      ts_index = mark_absent_components(tpos);
+    } else if (conn_.size() > 0) {
+      ts_index = timeslice_buffer_.get_desc(0, tpos).ts_num;
+    }
+    announce(tpos, ts_index);
+    if (!drop_) {
+      update_load_shedding(tpos, ts_index);
+      if (shedding_.shed(ts_index)) {
+        L_(trace) << "[c" << compute_index_ << "] shed timeslice " << ts_index;
+        ++timeslices_shed_;
+        timeslice_buffer_.send_completion({tpos});
+        continue;
+      }
+      timeslice_buffer_.send_work_item(
+          {{ts_index, tpos, timeslice_size_,
+            static_cast<uint32_t>(conn_.size())},
+           timeslice_buffer_.get_data_size_exp(),
+           timeslice_buffer_.get_desc_size_exp()});
+    } else {
+      timeslice_buffer_.send_completion({tpos});
+    }
+  }
+
+  completely_written_ = std::max(completely_written_, new_completely_written);
+}
+
+void TimesliceBuilder::update_load_shedding(uint64_t tpos,
+                                            uint64_t ts_index) {
+  if (shedding_.update(tpos, tpos - acked_,
+                       timeslice_buffer_.get_num_work_items())) {
+    L_(info) << "[c" << compute_index_ << "] load shedding level "
+             << shedding_.level() << "/" << LoadShedding::steps
+             << " from timeslice " << ts_index << ": shedding "
+             << shedding_.share() * 100 << "% of timeslices (hash bucket < "
+             << shedding_.level() << ")";
+  }
+}
+
+void TimesliceBuilder::announce(uint64_t tpos, uint64_t ts_index) {
+  if (ts_index == UINT64_MAX) {
+    return;
+  }
+  uint64_t epoch = schedule_.epoch(ts_index) + schedule_.lookahead();
+  if (epoch < announcements_.end()) {
+    return;
+  }
+  announcements_.announce(
+      epoch, schedule_.weight(free_fraction(tpos + 1), tpos + 1 - acked_));
+}
+
+double TimesliceBuilder::free_fraction(uint64_t tpos) {
+  uint64_t desc_size = UINT64_C(1) << timeslice_buffer_.get_desc_size_exp();
+  uint64_t data_size = UINT64_C(1) << timeslice_buffer_.get_data_size_exp();
+  double free_fraction = static_cast<double>(released_ + desc_size - tpos) /
+                         static_cast<double>(desc_size);
+  if (tpos <= released_) {
+    return free_fraction;
+  }
+  for (std::size_t i = 0; i < conn_.size(); ++i) {
+    if (timeslice_buffer_.is_absent(i, tpos - 1)) {
+      continue;
+    }
+    const auto& last = timeslice_buffer_.get_desc(i, tpos - 1);
+    uint64_t used = last.offset + last.size - acked_data_[i];
+    free_fraction = std::min(free_fraction,
+                             static_cast<double>(data_size - used) /
+                                 static_cast<double>(data_size));
+  }
+  return free_fraction;
+}
+
+uint64_t TimesliceBuilder::check_stragglers(uint64_t completely_written,
+                                            uint64_t max_written) {
+  auto now = std::chrono::steady_clock::now();
+  uint64_t desc_buffer_size = UINT64_C(1)
+                              << timeslice_buffer_.get_desc_size_exp();
+
+  if (num_lagging_ > 0) {
+    // minimum over the inputs that are not lagging (linear, but only while
+    // there are lagging inputs)
+    completely_written = UINT64_MAX;
+    for (std::size_t i = 0; i < conn_.size(); ++i) {
+      uint64_t written = written_[i].load(std::memory_order_acquire);
+      InputProgress& p = progress_[i];
+      if (p.lagging) {
+        if (written > p.written) {
+          p.late += std::min(written, completely_written_) - p.written;
+          p.written = written;
+        }
+        if (written < completely_written_) {
+          // do not overtake the input by a full buffer
+          completely_written =
+              std::min(completely_written, p.written + desc_buffer_size);
+          continue;
+        }
+        p.lagging = false;
+        --num_lagging_;
+        L_(info) << "[c" << compute_index_ << "] input " << i
+                 << " has caught up";
+      }
+      completely_written = std::min(completely_written, written);
+    }
+  }
+
+  if (completely_written > completely_written_ ||
+      max_written <= completely_written_) {
+    // progress, or no input is waiting for another one
+    waiting_since_ = now;
+    return completely_written;
+  }
+  if (now - waiting_since_ < straggler_timeout_) {
+    return completely_written;
+  }
+
+  // leave behind the inputs that have not yet delivered the next timeslice
+  completely_written = UINT64_MAX;
+  for (std::size_t i = 0; i < conn_.size(); ++i) {
+    uint64_t written = written_[i].load(std::memory_order_acquire);
+    InputProgress& p = progress_[i];
+    if (!p.lagging && written <= completely_written_) {
+      p.lagging = true;
+      p.written = written;
+      ++num_lagging_;
+      L_(warning) << "[c" << compute_index_ << "] input " << i
+                  << " timed out at timeslice position " << written;
+    }
+    if (p.lagging) {
+      completely_written =
+          std::min(completely_written, p.written + desc_buffer_size);
+    } else {
+      completely_written = std::min(completely_written, written);
+    }
+  }
+  waiting_since_ = now;
+  return completely_written;
+}
+
+uint64_t TimesliceBuilder::mark_absent_components(uint64_t tpos) {
+  // take the timeslice index from a component that is present
+  uint64_t ts_index = UINT64_MAX;
+  for (std::size_t i = 0; i < conn_.size(); ++i) {
+    if (!progress_[i].lagging || progress_[i].written > tpos) {
+      ts_index = timeslice_buffer_.get_desc(i, tpos).ts_num;
+      break;
+    }
+  }
+
+  for (std::size_t i = 0; i < conn_.size(); ++i) {
+    InputProgress& p = progress_[i];
+    if (p.lagging && p.written <= tpos) {
+      // a late write may still hit the descriptor, so it is left untouched
+      timeslice_buffer_.mark_absent(i, tpos, ts_index);
+      ++p.missing;
+    }
+  }
+
+  return ts_index;
 }
 
 /// Completion notification event dispatcher. Called by the event loop.
@@ -139,50 +524,29 @@ void TimesliceBuilder::on_completion(const struct ibv_wc& wc) {
     break;
 
   case ID_SEND_FINALIZE: {
-    if (!conn_[in]->abort_flag()) {
-      assert(timeslice_buffer_.get_num_work_items() == 0);
-      assert(timeslice_buffer_.get_num_completions() == 0);
-    }
     conn_[in]->on_complete_send();
     conn_[in]->on_complete_send_finalize();
-    ++connections_done_;
-    all_done_ = (connections_done_ == conn_.size());
+    ++shard(in).connections_done;
     L_(debug) << "[c" << compute_index_ << "] "
-              << "SEND FINALIZE complete for id " << in
-              << " all_done=" << all_done_;
+              << "SEND FINALIZE complete for id " << in;
   } break;
 
   case ID_RECEIVE_STATUS: {
     conn_[in]->on_complete_recv();
-    if (connected_ == conn_.size() && in == red_lantern_) {
-      auto new_red_lantern = std::min_element(
-          std::begin(conn_), std::end(conn_),
-          [](const std::unique_ptr<ComputeNodeConnection>& v1,
-             const std::unique_ptr<ComputeNodeConnection>& v2) {
-            return v1->cn_wp().desc < v2->cn_wp().desc;
-          });
-
-      uint64_t new_completely_written = (*new_red_lantern)->cn_wp().desc;
-      red_lantern_ = std::distance(std::begin(conn_), new_red_lantern);
-
-      for (uint64_t tpos = completely_written_; tpos < new_completely_written;
-           ++tpos) {
-        if (!drop_) {
-          uint64_t ts_index = UINT64_MAX;
-          if (conn_.size() > 0) {
-            ts_index = timeslice_buffer_.get_desc(0, tpos).ts_num;
-          }
-          timeslice_buffer_.send_work_item(
-              {{ts_index, tpos, timeslice_size_,
-                static_cast<uint32_t>(conn_.size())},
-               timeslice_buffer_.get_data_size_exp(),
-               timeslice_buffer_.get_desc_size_exp()});
-        } else {
-          timeslice_buffer_.send_completion({tpos});
-        }
+    Shard& sh = shard(in);
+    uint64_t written = conn_[in]->cn_wp().desc;
+    if (timeslice_buffer_.has_component_events() && !drop_) {
+      send_component_events(in, sh.red_lantern.value(in / shards_.size()),
+                            written);
+    }
+    sh.red_lantern.update(in / shards_.size(), written);
+    sh.completely_written.store(sh.red_lantern.min_value(),
+                                std::memory_order_release);
+    if (straggler_timeout_.count() != 0) {
+      written_[in].store(written, std::memory_order_release);
+      if (written > sh.max_written.load(std::memory_order_relaxed)) {
+        sh.max_written.store(written, std::memory_order_release);
       }
-
-      completely_written_ = new_completely_written;
     }
   } break;
 
@@ -191,16 +555,47 @@ void TimesliceBuilder::on_completion(const struct ibv_wc& wc) {
   }
 }
 
+void TimesliceBuilder::send_component_events(std::size_t in,
+                                             uint64_t begin,
+                                             uint64_t end) {
+  for (uint64_t tpos = begin; tpos < end; ++tpos) {
+    timeslice_buffer_.send_component_event(
+        {tpos, timeslice_buffer_.get_desc(in, tpos).ts_num,
+         static_cast<uint32_t>(in), timeslice_size_,
+         timeslice_buffer_.get_data_size_exp(),
+         timeslice_buffer_.get_desc_size_exp()});
+  }
+}
+
 void TimesliceBuilder::poll_ts_completion() {
-  fles::TimesliceCompletion c;
-  if (!timeslice_buffer_.try_receive_completion(c))
+  std::array<fles::TimesliceCompletion, 64> completions;
+  std::size_t count = timeslice_buffer_.try_receive_completions(
+      completions.data(), completions.size());
+  if (count == 0 && released_ == acked_)
     return;
-  if (c.ts_pos == acked_) {
-    do
-      ++acked_;
-    while (ack_.at(acked_) > c.ts_pos);
-    for (auto& connection : conn_)
-      connection->inc_ack_pointers(acked_);
-  } else
-    ack_.at(c.ts_pos) = c.ts_pos;
+  uint64_t acked = acked_;
+  for (std::size_t i = 0; i < count; ++i) {
+    const fles::TimesliceCompletion& c = completions[i];
+    if (c.ts_pos == acked_) {
+      do
+        ++acked_;
+      while (ack_.at(acked_) > c.ts_pos);
+    } else
+      ack_.at(c.ts_pos) = c.ts_pos;
+  }
+  if (acked_ != acked) {
+    timeslice_buffer_.set_acked(acked_);
+  }
+  uint64_t released = timeslice_buffer_.get_releasable(acked_);
+  if (released != released_) {
+    released_ = released;
+    // the inputs may reuse the descriptors only after the store below
+    for (std::size_t i = 0; i < conn_.size(); ++i) {
+      if (!timeslice_buffer_.is_absent(i, released_ - 1)) {
+        const auto& desc = timeslice_buffer_.get_desc(i, released_ - 1);
+        acked_data_[i] = desc.offset + desc.size;
+      }
+    }
+    shared_acked_.store(released_, std::memory_order_release);
+  }
 }
@@ -2,14 +2,47 @@
 #pragma once
 
 #include "ComputeNodeConnection.hpp"
+#include "DeferredEvents.hpp"
 #include "IBConnectionGroup.hpp"
+#include "LoadShedding.hpp"
 #include "RingBuffer.hpp"
 #include "TimesliceBuffer.hpp"
+#include "TimesliceSchedule.hpp"
+#include "TournamentTree.hpp"
+#include "WeightAnnouncements.hpp"
+#include <atomic>
+#include <chrono>
 #include <csignal>
+#include <exception>
+#include <thread>
 
 /// Timeslice receiver and input node connection container class.
 /** A TimesliceBuilder object represents a group of timeslice building
- connections to input nodes and receives timeslices to a timeslice buffer. */
+ connections to input nodes and receives timeslices to a timeslice buffer.
+
+ The connections are distributed over a number of shards, each with its own
+ completion queue. Shard 0 is served by the builder thread itself, which
+ also handles connection management events, timeslice completions and the
+ generation of work items. Each further shard is served by a thread of its
+ own. The shards publish the minimum write pointer of their connections,
+ the builder thread publishes the acknowledged position. The disconnection
+ events of the connections of a shard thread are held back until the thread
+ has stopped, so that no connection is torn down while its shard may still
+ poll or post on it.
+
+ With a straggler timeout, an input that keeps the compute node waiting
+ for longer than the timeout is left behind: the following timeslices are
+ emitted without its component, which is marked as absent in a buffer of
+ the TimesliceBuffer that the input does not write to, so that a late
+ write cannot tear the marker. The TimesliceBuffer must then be created
+ with absent markers. The input is told to drop these
+ components by acknowledging them, and rejoins once it has caught up. To
+ keep its late writes from hitting a buffer slot still in use, the compute
+ node stays within one descriptor buffer of a lagging input.
+
+ The share of future timeslices assigned to this compute node is adapted to
+ its free buffer space and consumer backlog by announcing weights to the
+ input nodes with the status messages (see TimesliceSchedule). */
 
 class TimesliceBuilder : public IBConnectionGroup<ComputeNodeConnection> {
 public:
@@ -18,9 +51,13 @@ public:
                    TimesliceBuffer& timeslice_buffer,
                    unsigned short service,
                    uint32_t num_input_nodes,
+                   uint32_t num_compute_nodes,
                    uint32_t timeslice_size,
                    volatile sig_atomic_t* signal_status,
-                   bool drop);
+                   bool drop,
+                   uint32_t num_shards,
+                   std::chrono::milliseconds straggler_timeout,
+                   double shed_threshold);
 
   TimesliceBuilder(const TimesliceBuilder&) = delete;
   void operator=(const TimesliceBuilder&) = delete;
@@ -37,12 +74,113 @@ public:
   /// Handle RDMA_CM_EVENT_CONNECT_REQUEST event.
   virtual void on_connect_request(struct rdma_cm_event* event) override;
 
+  /// Handle RDMA_CM_EVENT_DISCONNECTED event.
+  virtual void on_disconnected(struct rdma_cm_event* event) override;
+
+  /// Handle RDMA_CM_EVENT_TIMEWAIT_EXIT event.
+  virtual void on_timewait_exit(struct rdma_cm_event* event) override;
+
   /// Completion notification event dispatcher. Called by the event loop.
   virtual void on_completion(const struct ibv_wc& wc) override;
 
   void poll_ts_completion();
 
 private:
+  /// A subset of the input connections with its own completion queue.
+  struct Shard {
+    explicit Shard(std::size_t size) : red_lantern(size) {}
+
+    /// The completion queue of the shard's connections.
+    struct ibv_cq* cq = nullptr;
+
+    /// The connection with the smallest write pointer (red lantern).
+    TournamentTree red_lantern;
+
+    /// The smallest write pointer of the shard's connections.
+    std::atomic<uint64_t> completely_written{0};
+
+    /// The largest write pointer of the shard's connections.
+    std::atomic<uint64_t> max_written{0};
+
+    /// The number of finalized connections.
+    std::atomic<std::size_t> connections_done{0};
+
+    /// The acknowledged position last passed to the connections.
+    uint64_t acked = 0;
+
+    /// Flag, true if the abort request has been passed to the connections.
+    bool abort_requested = false;
+
+    /// The exception that ended the shard's thread, if any.
+    std::exception_ptr exception;
+    std::atomic<bool> failed{false};
+
+    /// Flag, true if the shard's thread has finished.
+    std::atomic<bool> finished{false};
+
+    std::thread thread;
+  };
+
+  /// Retrieve the shard of a connection.
+  Shard& shard(std::size_t index) { return *shards_[index % shards_.size()]; }
+
+  /// Poll a shard's completion queue and pass on acknowledgements and abort
+  /// requests to its connections.
+  void poll_shard(std::size_t s);
+
+  /// The main function of a shard thread.
+  void run_shard(std::size_t s);
+
+  /// Stop and join the shard threads.
+  void stop_shards();
+
+  /// Join the finished shard threads and handle the connection management
+  /// events held back for their connections.
+  void join_finished_shards();
+
+  /// Hold back a connection management event while the thread of the
+  /// connection's shard is running. Returns true if the event is deferred.
+  bool defer_cm_event(struct rdma_cm_event* event);
+
+  /// Merge the shards' write pointers and generate new work items.
+  void on_write_pointer_update();
+
+  /// Publish the arrival of the components of an input at the given
+  /// timeslice positions.
+  void send_component_events(std::size_t in, uint64_t begin, uint64_t end);
+
+  /// Adapt the load shedding level before building a timeslice.
+  void update_load_shedding(uint64_t tpos, uint64_t ts_index);
+
+  /// Apply the straggler timeout to the merged write pointer.
+  uint64_t check_stragglers(uint64_t completely_written, uint64_t max_written);
+
+  /// Mark the components of lagging inputs as absent. Returns the timeslice
+  /// index.
+  uint64_t mark_absent_components(uint64_t tpos);
+
+  /// Announce weights up to the lookahead of the given timeslice's epoch.
+  void announce(uint64_t tpos, uint64_t ts_index);
+
+  /// Retrieve the free fraction of the most occupied buffer after the given
+  /// timeslice position.
+  double free_fraction(uint64_t tpos);
+
+  /// Per-input state of the straggler timeout, owned by the builder thread.
+  struct InputProgress {
+    /// Flag, true if the input has been left behind.
+    bool lagging = false;
+
+    /// The input's write pointer as last seen by the builder thread.
+    uint64_t written = 0;
+
+    /// Number of components emitted as absent.
+    uint64_t missing = 0;
+
+    /// Number of absent components received or dropped afterwards.
+    uint64_t late = 0;
+  };
+
   uint64_t compute_index_;
   TimesliceBuffer& timeslice_buffer_;
 
@@ -51,13 +189,61 @@ private:
 
   uint32_t timeslice_size_;
 
-  size_t red_lantern_ = 0;
+  /// The connection shards.
+  std::vector<std::unique_ptr<Shard>> shards_;
+
   uint64_t completely_written_ = 0;
   uint64_t acked_ = 0;
 
+  /// Position up to which the buffer space has been released to the input
+  /// nodes, held back by component views still in use.
+  uint64_t released_ = 0;
+
+  /// Acknowledged position, passed to the connections by their shards.
+  std::atomic<uint64_t> shared_acked_{0};
+
+  /// Flag, true if an abort has been requested.
+  std::atomic<bool> abort_requested_{false};
+
+  /// Flag, true if the shard threads should terminate.
+  std::atomic<bool> stop_shards_{false};
+
   /// Buffer to store acknowledged status of timeslices.
   RingBuffer<uint64_t, true> ack_;
 
+  /// Time to wait for a missing component (zero if unlimited).
+  const std::chrono::milliseconds straggler_timeout_;
+
+  /// Write pointer of each connection, published by its shard.
+  std::vector<std::atomic<uint64_t>> written_;
+
+  /// Straggler timeout state of each input.
+  std::vector<InputProgress> progress_;
+
+  /// Number of lagging inputs.
+  std::size_t num_lagging_ = 0;
+
+  /// Start of the current wait for missing components.
+  std::chrono::steady_clock::time_point waiting_since_;
+
+  /// The policy for completing timeslices without processing them.
+  LoadShedding shedding_;
+
+  /// Number of timeslices completed without processing.
+  uint64_t timeslices_shed_ = 0;
+
+  /// Assignment of timeslices to compute nodes.
+  TimesliceSchedule schedule_;
+
+  /// Weights announced to the input nodes, passed on by their shards.
+  WeightAnnouncements announcements_;
+
+  /// Acknowledged data buffer position of each input.
+  std::vector<uint64_t> acked_data_;
+
   volatile sig_atomic_t* signal_status_;
   bool drop_;
+
+  /// Connection management events held back per shard.
+  DeferredEvents<struct rdma_cm_event> deferred_cm_events_;
 };
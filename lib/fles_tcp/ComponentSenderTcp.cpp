@@ -0,0 +1,583 @@
+// Copyright 2026 agent <agent@local>
+
+#include "ComponentSenderTcp.hpp"
+#include "MicrosliceDescriptor.hpp"
+#include "TcpSocket.hpp"
+#include "Utility.hpp"
+#include "log.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <linux/errqueue.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+
+ComponentSenderTcp::ComponentSenderTcp(
+    uint64_t input_index,
+    InputBufferReadInterface& data_source,
+    const std::vector<std::string> compute_hostnames,
+    const std::vector<std::string> compute_services,
+    uint32_t timeslice_size,
+    uint32_t overlap_size,
+    uint32_t max_timeslice_number,
+    volatile sig_atomic_t* signal_status,
+    bool zerocopy)
+    : input_index_(input_index), data_source_(data_source),
+      compute_hostnames_(compute_hostnames),
+      compute_services_(compute_services), timeslice_size_(timeslice_size),
+      overlap_size_(overlap_size), max_timeslice_number_(max_timeslice_number),
+      signal_status_(signal_status), zerocopy_(zerocopy),
+      schedule_(static_cast<uint32_t>(compute_hostnames.size())),
+      min_acked_({data_source.desc_buffer().size() / 4,
+                  data_source.data_buffer().size() / 4}) {
+  assert(compute_hostnames_.size() == compute_services_.size());
+  start_index_ = sent_ = acked_ = cached_acked_ = data_source.get_read_index();
+
+  size_t min_ack_buffer_size =
+      data_source_.desc_buffer().size() / timeslice_size_ + 1;
+  ack_.alloc_with_size(min_ack_buffer_size);
+}
+
+ComponentSenderTcp::~ComponentSenderTcp() {
+  for (auto& c : conn_) {
+    if (c->fd != -1) {
+      ::close(c->fd);
+    }
+  }
+}
+
+void ComponentSenderTcp::operator()() {
+  if (!connect()) {
+    return;
+  }
+
+  data_source_.proceed();
+  time_begin_ = std::chrono::high_resolution_clock::now();
+  report_status();
+
+  uint64_t timeslice = 0;
+  while (timeslice < max_timeslice_number_ && !abort_) {
+    bool sent = try_send_timeslice(timeslice);
+    if (sent) {
+      ++timeslice;
+    }
+    poll_connections(sent ? 0 : 1);
+    data_source_.proceed();
+    scheduler_.timer();
+    if (*signal_status_ != 0) {
+      abort_ = true;
+    }
+  }
+
+  // wait for pending send completions
+  while (!abort_ &&
+         acked_.desc < timeslice_size_ * timeslice + start_index_.desc) {
+    poll_connections(1);
+    scheduler_.timer();
+    if (*signal_status_ != 0) {
+      abort_ = true;
+    }
+  }
+  sync_data_source();
+
+  L_(debug) << "[i" << input_index_ << "] "
+            << "finalize connections";
+  for (auto& c : conn_) {
+    finalize(*c);
+  }
+  while (connections_done_ < conn_.size()) {
+    poll_connections(1);
+    scheduler_.timer();
+  }
+
+  time_end_ = std::chrono::high_resolution_clock::now();
+  for (auto& c : conn_) {
+    ::close(c->fd);
+    c->fd = -1;
+  }
+}
+
+bool ComponentSenderTcp::connect() {
+  for (size_t i = 0; i < compute_hostnames_.size(); ++i) {
+    std::unique_ptr<Connection> c(new Connection);
+    while ((c->fd = tl_tcp::connect_socket(compute_hostnames_[i],
+                                           compute_services_[i])) == -1) {
+      if (*signal_status_ != 0) {
+        return false;
+      }
+      L_(debug) << "[i" << input_index_ << "] "
+                << "retrying to connect to " << compute_hostnames_[i] << ":"
+                << compute_services_[i];
+      std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    }
+    tl_tcp::set_nodelay(c->fd);
+
+    tl_tcp::InputNodeInfo info{static_cast<uint32_t>(input_index_)};
+    tl_tcp::send_all(c->fd, &info, sizeof(info));
+    tl_tcp::recv_all(c->fd, &c->remote_info, sizeof(c->remote_info));
+
+    tl_tcp::set_nonblocking(c->fd);
+    c->zerocopy = zerocopy_ && tl_tcp::enable_zerocopy(c->fd);
+    L_(debug) << "[i" << input_index_ << "] "
+              << "connected to " << compute_hostnames_[i] << ":"
+              << compute_services_[i]
+              << (c->zerocopy ? " (zero-copy)" : "");
+    conn_.push_back(std::move(c));
+  }
+  return true;
+}
+
+bool ComponentSenderTcp::try_send_timeslice(uint64_t timeslice) {
+  // wait until a complete timeslice is available in the input buffer
+  uint64_t desc_offset = timeslice * timeslice_size_ + start_index_.desc;
+  uint64_t desc_length = timeslice_size_ + overlap_size_;
+
+  if (write_index_desc_ < desc_offset + desc_length) {
+    write_index_desc_ = data_source_.get_write_index().desc;
+  }
+  if (write_index_desc_ < desc_offset + desc_length) {
+    return false;
+  }
+
+  // wait until all compute nodes have announced their weights
+  if (!schedule_.ready(timeslice)) {
+    return false;
+  }
+
+  uint64_t data_offset = data_source_.desc_buffer().at(desc_offset).offset;
+  uint64_t data_end =
+      data_source_.desc_buffer().at(desc_offset + desc_length - 1).offset +
+      data_source_.desc_buffer().at(desc_offset + desc_length - 1).size;
+  assert(data_end >= data_offset);
+
+  uint64_t data_length = data_end - data_offset;
+  uint64_t total_length =
+      data_length + desc_length * sizeof(fles::MicrosliceDescriptor);
+
+  Connection& c = *conn_[target_cn_index(timeslice)];
+
+  // number of bytes to skip in advance (to avoid buffer wrap)
+  uint64_t skip = skip_required(c, total_length);
+  total_length += skip;
+
+  if (!check_for_buffer_space(c, total_length, 1)) {
+    return false;
+  }
+
+  post_send_data(timeslice, c, desc_offset, desc_length, data_offset,
+                 data_length, skip);
+
+  c.cn_wp.data += total_length;
+  c.cn_wp.desc += 1;
+
+  sent_.desc = desc_offset + desc_length;
+  sent_.data = data_end;
+
+  return true;
+}
+
+uint64_t ComponentSenderTcp::skip_required(const Connection& c,
+                                           uint64_t data_size) {
+  uint64_t databuf_size = UINT64_C(1) << c.remote_info.data_buffer_size_exp;
+  uint64_t databuf_wp = c.cn_wp.data & (databuf_size - 1);
+  if (databuf_wp + data_size <= databuf_size) {
+    return 0;
+  }
+  return databuf_size - databuf_wp;
+}
+
+bool ComponentSenderTcp::check_for_buffer_space(const Connection& c,
+                                                uint64_t data_size,
+                                                uint64_t desc_size) {
+  return c.cn_ack.data - c.cn_wp.data +
+                 (UINT64_C(1) << c.remote_info.data_buffer_size_exp) >=
+             data_size &&
+         c.cn_ack.desc - c.cn_wp.desc +
+                 (UINT64_C(1) << c.remote_info.desc_buffer_size_exp) >=
+             desc_size;
+}
+
+void ComponentSenderTcp::post_send_data(uint64_t timeslice,
+                                        Connection& c,
+                                        uint64_t desc_offset,
+                                        uint64_t desc_length,
+                                        uint64_t data_offset,
+                                        uint64_t data_length,
+                                        uint64_t skip) {
+  auto& desc_buffer = data_source_.desc_buffer();
+  auto& data_buffer = data_source_.data_buffer();
+  uint64_t size =
+      data_length + desc_length * sizeof(fles::MicrosliceDescriptor);
+
+  c.sends.emplace_back();
+  Send& s = c.sends.back();
+  s.timeslice = timeslice;
+  s.status.wp = {c.cn_wp.data + skip + size, c.cn_wp.desc + 1};
+  s.status.abort = false;
+  s.status.final = false;
+  s.tscdesc = {timeslice, c.cn_wp.data + skip, size, desc_length};
+  s.iov_first = 0;
+  s.zerocopy_end = c.zerocopy_next;
+
+  int n = 0;
+  s.iov[n++] = {&s.status, sizeof(s.status)};
+  s.iov[n++] = {&s.tscdesc, sizeof(s.tscdesc)};
+
+  // descriptors
+  if ((desc_offset & desc_buffer.size_mask()) <=
+      ((desc_offset + desc_length - 1) & desc_buffer.size_mask())) {
+    // one chunk
+    s.iov[n++] = {&desc_buffer.at(desc_offset),
+                  sizeof(fles::MicrosliceDescriptor) * desc_length};
+  } else {
+    // two chunks
+    uint64_t size1 =
+        desc_buffer.size() - (desc_offset & desc_buffer.size_mask());
+    s.iov[n++] = {&desc_buffer.at(desc_offset),
+                  sizeof(fles::MicrosliceDescriptor) * size1};
+    s.iov[n++] = {desc_buffer.ptr(),
+                  sizeof(fles::MicrosliceDescriptor) * (desc_length - size1)};
+  }
+
+  // data
+  if (data_length == 0) {
+    // zero chunks
+  } else if ((data_offset & data_buffer.size_mask()) <=
+             ((data_offset + data_length - 1) & data_buffer.size_mask())) {
+    // one chunk
+    s.iov[n++] = {&data_buffer.at(data_offset), data_length};
+  } else {
+    // two chunks
+    uint64_t size1 =
+        data_buffer.size() - (data_offset & data_buffer.size_mask());
+    s.iov[n++] = {&data_buffer.at(data_offset), size1};
+    s.iov[n++] = {data_buffer.ptr(), data_length - size1};
+  }
+
+  s.iov_count = n;
+  s.bytes_left = sizeof(s.status) + sizeof(s.tscdesc) + size;
+
+  send_queued(c);
+}
+
+void ComponentSenderTcp::finalize(Connection& c) {
+  c.sends.emplace_back();
+  Send& s = c.sends.back();
+  s.timeslice = UINT64_MAX;
+  s.status.wp = c.cn_wp;
+  s.status.abort = abort_;
+  s.status.final = true;
+  s.iov[0] = {&s.status, sizeof(s.status)};
+  s.iov_first = 0;
+  s.iov_count = 1;
+  s.bytes_left = sizeof(s.status);
+  s.zerocopy_end = c.zerocopy_next;
+
+  send_queued(c);
+}
+
+void ComponentSenderTcp::poll_connections(int timeout_ms) {
+  std::vector<struct pollfd> fds(conn_.size());
+  for (size_t i = 0; i < conn_.size(); ++i) {
+    const Connection& c = *conn_[i];
+    fds[i].fd = c.fd;
+    fds[i].events = 0;
+    if (!c.done) {
+      fds[i].events |= POLLIN;
+    }
+    if (c.unsent < c.sends.size()) {
+      fds[i].events |= POLLOUT;
+    }
+  }
+
+  int rc = ::poll(fds.data(), fds.size(), timeout_ms);
+  if (rc == -1 && errno != EINTR) {
+    tl_tcp::throw_errno("poll failed");
+  }
+
+  for (size_t i = 0; i < conn_.size() && rc > 0; ++i) {
+    Connection& c = *conn_[i];
+    if ((fds[i].revents & POLLERR) != 0) {
+      receive_completions(c);
+    }
+    if ((fds[i].revents & (POLLIN | POLLHUP)) != 0 && !c.done) {
+      receive_status(c);
+    }
+    if ((fds[i].revents & POLLOUT) != 0) {
+      send_queued(c);
+    }
+    complete_sends(c);
+  }
+}
+
+void ComponentSenderTcp::send_queued(Connection& c) {
+  while (c.unsent < c.sends.size()) {
+    Send& s = c.sends[c.unsent];
+
+    struct msghdr msg = msghdr();
+    msg.msg_iov = &s.iov[s.iov_first];
+    msg.msg_iovlen = s.iov_count - s.iov_first;
+    int flags = MSG_DONTWAIT | MSG_NOSIGNAL;
+#ifdef MSG_ZEROCOPY
+    bool zerocopy = c.zerocopy && s.bytes_left >= zerocopy_min_size;
+    if (zerocopy) {
+      flags |= MSG_ZEROCOPY;
+    }
+#else
+    bool zerocopy = false;
+#endif
+
+    ssize_t len = ::sendmsg(c.fd, &msg, flags);
+    if (len == -1) {
+      if (errno == EINTR) {
+        continue;
+      }
+      if (errno == EAGAIN || errno == EWOULDBLOCK) {
+        return;
+      }
+      if (errno == ENOBUFS && zerocopy) {
+        // notification limit (optmem) reached, send by copying
+        zerocopy = false;
+        len = ::sendmsg(c.fd, &msg, MSG_DONTWAIT | MSG_NOSIGNAL);
+        if (len == -1 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+          return;
+        }
+      }
+      if (len == -1) {
+        tl_tcp::throw_errno("sendmsg failed");
+      }
+    }
+    if (zerocopy) {
+      s.zerocopy_end = ++c.zerocopy_next;
+    }
+
+    // advance gather list
+    uint64_t written = static_cast<uint64_t>(len);
+    s.bytes_left -= written;
+    while (written > 0) {
+      struct iovec& iov = s.iov[s.iov_first];
+      if (written < iov.iov_len) {
+        iov.iov_base = static_cast<uint8_t*>(iov.iov_base) + written;
+        iov.iov_len -= written;
+        written = 0;
+      } else {
+        written -= iov.iov_len;
+        ++s.iov_first;
+      }
+    }
+
+    if (s.bytes_left > 0) {
+      // socket buffer is full
+      return;
+    }
+    ++c.unsent;
+  }
+}
+
+void ComponentSenderTcp::receive_status(Connection& c) {
+  const size_t size = sizeof(c.recv_status);
+  while (!c.done) {
+    ssize_t len = ::recv(c.fd, reinterpret_cast<uint8_t*>(&c.recv_status) +
+                                   c.recv_bytes,
+                         size - c.recv_bytes, MSG_DONTWAIT);
+    if (len == -1) {
+      if (errno == EINTR) {
+        continue;
+      }
+      if (errno == EAGAIN || errno == EWOULDBLOCK) {
+        return;
+      }
+      tl_tcp::throw_errno("recv failed");
+    }
+    if (len == 0) {
+      throw tl_tcp::TcpException("connection closed by compute node");
+    }
+    c.recv_bytes += static_cast<size_t>(len);
+    if (c.recv_bytes < size) {
+      continue;
+    }
+    c.recv_bytes = 0;
+
+    if (c.recv_status.final) {
+      c.done = true;
+      ++connections_done_;
+      L_(debug) << "[i" << input_index_ << "] "
+                << "final status from compute node, "
+                << (conn_.size() - connections_done_) << " remaining";
+      return;
+    }
+    c.cn_ack = c.recv_status.ack;
+    if (c.recv_status.schedule_weight != 0) {
+      schedule_.set_weight(c.remote_info.index, c.recv_status.schedule_epoch,
+                           c.recv_status.schedule_weight);
+    }
+    if (c.recv_status.request_abort) {
+      abort_ = true;
+    }
+  }
+}
+
+void ComponentSenderTcp::receive_completions(Connection& c) {
+#ifdef MSG_ZEROCOPY
+  while (true) {
+    uint8_t control[128];
+    struct msghdr msg = msghdr();
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+    if (::recvmsg(c.fd, &msg, MSG_ERRQUEUE) == -1) {
+      if (errno == EINTR) {
+        continue;
+      }
+      if (errno == EAGAIN || errno == EWOULDBLOCK) {
+        return;
+      }
+      tl_tcp::throw_errno("recvmsg(MSG_ERRQUEUE) failed");
+    }
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wold-style-cast"
+    for (struct cmsghdr* cm = CMSG_FIRSTHDR(&msg); cm != nullptr;
+         cm = CMSG_NXTHDR(&msg, cm)) {
+      if (!(cm->cmsg_level == SOL_IP && cm->cmsg_type == IP_RECVERR) &&
+          !(cm->cmsg_level == SOL_IPV6 && cm->cmsg_type == IPV6_RECVERR)) {
+        continue;
+      }
+      struct sock_extended_err err;
+      std::memcpy(&err, CMSG_DATA(cm), sizeof(err));
+#pragma GCC diagnostic pop
+      if (err.ee_errno != 0 || err.ee_origin != SO_EE_ORIGIN_ZEROCOPY) {
+        continue;
+      }
+      if ((err.ee_code & SO_EE_CODE_ZEROCOPY_COPIED) != 0 && c.zerocopy) {
+        // the kernel had to copy anyway (e.g., loopback), avoid overhead
+        L_(debug) << "[i" << input_index_ << "] "
+                  << "zero-copy not effective, disabled for connection";
+        c.zerocopy = false;
+      }
+      complete_zerocopy(c, err.ee_info, err.ee_data);
+    }
+  }
+#else
+  (void)c;
+#endif
+}
+
+void ComponentSenderTcp::complete_zerocopy(Connection& c,
+                                           uint32_t lo,
+                                           uint32_t hi) {
+  if (lo != c.zerocopy_done) {
+    // notification has been reordered, store range
+    c.zerocopy_ranges[lo] = hi;
+    return;
+  }
+  c.zerocopy_done = hi + 1;
+  auto it = c.zerocopy_ranges.find(c.zerocopy_done);
+  while (it != c.zerocopy_ranges.end()) {
+    c.zerocopy_done = it->second + 1;
+    c.zerocopy_ranges.erase(it);
+    it = c.zerocopy_ranges.find(c.zerocopy_done);
+  }
+}
+
+void ComponentSenderTcp::complete_sends(Connection& c) {
+  // sequence numbers may wrap around
+  while (c.unsent > 0 &&
+         static_cast<int32_t>(c.zerocopy_done -
+                              c.sends.front().zerocopy_end) >= 0) {
+    if (!c.sends.front().status.final) {
+      ack_timeslice(c.sends.front().timeslice);
+    }
+    c.sends.pop_front();
+    --c.unsent;
+  }
+}
+
+void ComponentSenderTcp::ack_timeslice(uint64_t ts) {
+  if (ts != acked_ts_) {
+    // transmission has been reordered, store completion information
+    ack_.at(ts) = ts;
+  } else {
+    // completion is for earliest pending timeslice, update indices
+    do {
+      ++acked_ts_;
+    } while (ack_.at(acked_ts_) > ts);
+    acked_.desc = acked_ts_ * timeslice_size_ + start_index_.desc;
+    acked_.data = data_source_.desc_buffer().at(acked_.desc - 1).offset +
+                  data_source_.desc_buffer().at(acked_.desc - 1).size;
+    if (acked_.data >= cached_acked_.data + min_acked_.data ||
+        acked_.desc >= cached_acked_.desc + min_acked_.desc) {
+      cached_acked_ = acked_;
+      data_source_.set_read_index(cached_acked_);
+    }
+  }
+}
+
+void ComponentSenderTcp::sync_data_source() {
+  if (acked_.data > cached_acked_.data || acked_.desc > cached_acked_.desc) {
+    cached_acked_ = acked_;
+    data_source_.set_read_index(cached_acked_);
+  }
+}
+
+void ComponentSenderTcp::report_status() {
+  constexpr auto interval = std::chrono::seconds(1);
+
+  std::chrono::system_clock::time_point now = std::chrono::system_clock::now();
+
+  // if data_source.written pointers are lagging behind due to lazy updates,
+  // use sent value instead
+  DualIndex written = data_source_.get_write_index();
+  written.desc = std::max(written.desc, sent_.desc);
+  written.data = std::max(written.data, sent_.data);
+
+  SendBufferStatus status_desc{now,
+                               data_source_.desc_buffer().size(),
+                               cached_acked_.desc,
+                               acked_.desc,
+                               sent_.desc,
+                               written.desc};
+  SendBufferStatus status_data{now,
+                               data_source_.data_buffer().size(),
+                               cached_acked_.data,
+                               acked_.data,
+                               sent_.data,
+                               written.data};
+
+  double delta_t =
+      std::chrono::duration<double, std::chrono::seconds::period>(
+          status_desc.time - previous_send_buffer_status_desc_.time)
+          .count();
+  double rate_desc =
+      static_cast<double>(status_desc.acked -
+                          previous_send_buffer_status_desc_.acked) /
+      delta_t;
+  double rate_data =
+      static_cast<double>(status_data.acked -
+                          previous_send_buffer_status_data_.acked) /
+      delta_t;
+
+  L_(debug) << "[i" << input_index_ << "] desc " << status_desc.percentages()
+            << " (used..free) | "
+            << human_readable_count(status_desc.acked, true, "") << " ("
+            << human_readable_count(rate_desc, true, "Hz") << ")";
+
+  L_(debug) << "[i" << input_index_ << "] data " << status_data.percentages()
+            << " (used..free) | "
+            << human_readable_count(status_data.acked, true) << " ("
+            << human_readable_count(rate_data, true, "B/s") << ")";
+
+  L_(info) << "[i" << input_index_ << "] |"
+           << bar_graph(status_data.vector(), "#x._", 20) << "|"
+           << bar_graph(status_desc.vector(), "#x._", 10) << "| "
+           << human_readable_count(rate_data, true, "B/s") << " ("
+           << human_readable_count(rate_desc, true, "Hz") << ")";
+
+  previous_send_buffer_status_desc_ = status_desc;
+  previous_send_buffer_status_data_ = status_data;
+
+  scheduler_.add(std::bind(&ComponentSenderTcp::report_status, this),
+                 now + interval);
+}
@@ -0,0 +1,303 @@
+// Copyright 2026 agent <agent@local>
+#pragma once
+
+#include "DualRingBuffer.hpp"
+#include "RingBuffer.hpp"
+#include "Scheduler.hpp"
+#include "TcpProtocol.hpp"
+#include "TimesliceComponentDescriptor.hpp"
+#include "TimesliceSchedule.hpp"
+#include <array>
+#include <boost/format.hpp>
+#include <cassert>
+#include <chrono>
+#include <csignal>
+#include <deque>
+#include <map>
+#include <memory>
+#include <string>
+#include <sys/uio.h>
+#include <vector>
+
+/// Input buffer and compute node connection container class.
+/** A ComponentSenderTcp object represents an input buffer (filled by a
+    FLIB) and a group of timeslice building connections to compute
+    nodes using plain TCP sockets.
+
+    Timeslice components are sent directly from the input buffer using
+    scatter/gather I/O. Where supported, the kernel transmits the data
+    without copying it (MSG_ZEROCOPY), and the input buffer is released only
+    after the kernel has signaled completion. Buffer space at the compute
+    nodes is managed using the credit protocol of the RDMA transport.
+    Timeslices are assigned to compute nodes according to the weights
+    announced by the compute nodes. */
+
+class ComponentSenderTcp {
+public:
+  /// The ComponentSenderTcp constructor.
+  ComponentSenderTcp(uint64_t input_index,
+                     InputBufferReadInterface& data_source,
+                     const std::vector<std::string> compute_hostnames,
+                     const std::vector<std::string> compute_services,
+                     uint32_t timeslice_size,
+                     uint32_t overlap_size,
+                     uint32_t max_timeslice_number,
+                     volatile sig_atomic_t* signal_status,
+                     bool zerocopy = true);
+
+  ComponentSenderTcp(const ComponentSenderTcp&) = delete;
+  void operator=(const ComponentSenderTcp&) = delete;
+
+  /// The ComponentSenderTcp destructor.
+  ~ComponentSenderTcp();
+
+  /// The thread main function.
+  void operator()();
+
+private:
+  /// Minimum size of a send call to use zero-copy transmission.
+  static constexpr uint64_t zerocopy_min_size = 16384;
+
+  /// A timeslice component (or final status message) being sent.
+  struct Send {
+    /// Global index of the timeslice.
+    uint64_t timeslice;
+    /// Status message preceding the component.
+    tl_tcp::InputChannelStatusMessage status;
+    /// Timeslice component descriptor.
+    fles::TimesliceComponentDescriptor tscdesc;
+    /// Gather list: status, descriptor, up to two chunks each of
+    /// microslice descriptors and data.
+    std::array<struct iovec, 6> iov;
+    /// First gather list entry not completely written.
+    int iov_first;
+    /// Number of gather list entries.
+    int iov_count;
+    /// Number of bytes not yet written to the socket.
+    uint64_t bytes_left;
+    /// Zero-copy sequence number following the last send call.
+    uint32_t zerocopy_end;
+  };
+
+  /// Connection struct, handles data for one compute node.
+  struct Connection {
+    int fd = -1;
+
+    /// Buffer sizes of the compute node.
+    tl_tcp::ComputeNodeInfo remote_info = tl_tcp::ComputeNodeInfo();
+
+    /// Local version of compute node write pointers.
+    tl_tcp::ComputeNodeBufferPosition cn_wp =
+        tl_tcp::ComputeNodeBufferPosition();
+
+    /// Local copy of acknowledged-by-compute-node pointers.
+    tl_tcp::ComputeNodeBufferPosition cn_ack =
+        tl_tcp::ComputeNodeBufferPosition();
+
+    /// Receive buffer for compute node status messages.
+    tl_tcp::ComputeNodeStatusMessage recv_status =
+        tl_tcp::ComputeNodeStatusMessage();
+    std::size_t recv_bytes = 0;
+
+    /// Queue of components being sent. The memory of an element must not
+    /// change until the transmission has completed.
+    std::deque<Send> sends;
+    /// Index of the first element in sends not completely written.
+    std::size_t unsent = 0;
+
+    /// Zero-copy transmission enabled.
+    bool zerocopy = false;
+    /// Sequence number of the next zero-copy send call.
+    uint32_t zerocopy_next = 0;
+    /// All zero-copy send calls before this sequence number have completed.
+    uint32_t zerocopy_done = 0;
+    /// Completed ranges of zero-copy send calls received out of order.
+    std::map<uint32_t, uint32_t> zerocopy_ranges;
+
+    /// Final status message received from compute node.
+    bool done = false;
+  };
+
+  /// This component's index in the list of input components.
+  uint64_t input_index_;
+
+  /// Data source (e.g., FLIB via shared memory).
+  InputBufferReadInterface& data_source_;
+
+  const std::vector<std::string> compute_hostnames_;
+  const std::vector<std::string> compute_services_;
+
+  /// Constant size (in microslices) of a timeslice component.
+  const uint32_t timeslice_size_;
+
+  /// Constant overlap size (in microslices) of a timeslice component.
+  const uint32_t overlap_size_;
+
+  /// Number of timeslices after which this run shall end.
+  const uint32_t max_timeslice_number_;
+
+  /// Pointer to global signal status variable.
+  volatile sig_atomic_t* signal_status_;
+
+  /// Use zero-copy transmission if supported.
+  const bool zerocopy_;
+
+  /// The vector of connections, one per compute node.
+  std::vector<std::unique_ptr<Connection>> conn_;
+
+  /// Assignment of timeslices to compute nodes.
+  TimesliceSchedule schedule_;
+
+  /// Number of connections finished by the compute node.
+  std::size_t connections_done_ = 0;
+
+  /// Abort requested by a compute node or signal.
+  bool abort_ = false;
+
+  /// Buffer to store acknowledged status of timeslices.
+  RingBuffer<uint64_t, true> ack_;
+
+  /// Number of acknowledged timeslices.
+  uint64_t acked_ts_ = 0;
+
+  /// Indexes of acknowledged microslices (i.e., read indexes).
+  DualIndex acked_;
+
+  /// Hysteresis for writing read indexes to data source.
+  const DualIndex min_acked_;
+
+  /// Read indexes last written to data source.
+  DualIndex cached_acked_;
+
+  /// Read indexes at start of operation.
+  DualIndex start_index_;
+
+  /// Write index received from data source.
+  uint64_t write_index_desc_ = 0;
+
+  /// Begin of operation (for performance statistics).
+  std::chrono::high_resolution_clock::time_point time_begin_;
+
+  /// End of operation (for performance statistics).
+  std::chrono::high_resolution_clock::time_point time_end_;
+
+  /// Amount of data sent (for performance statistics).
+  DualIndex sent_;
+
+  struct SendBufferStatus {
+    std::chrono::system_clock::time_point time;
+    uint64_t size;
+
+    uint64_t cached_acked;
+    uint64_t acked;
+    uint64_t sent;
+    uint64_t written;
+
+    int64_t used() const {
+      assert(sent <= written);
+      return written - sent;
+    }
+    int64_t sending() const {
+      assert(acked <= sent);
+      return sent - acked;
+    }
+    int64_t freeing() const {
+      assert(cached_acked <= acked);
+      return acked - cached_acked;
+    }
+    int64_t unused() const {
+      assert(written <= cached_acked + size);
+      return cached_acked + size - written;
+    }
+
+    float percentage(int64_t value) const {
+      return static_cast<float>(value) / static_cast<float>(size);
+    }
+
+    std::string caption() const {
+      return std::string("used/sending/freeing/free");
+    }
+
+    std::string percentage_str(int64_t value) const {
+      boost::format percent_fmt("%4.1f%%");
+      percent_fmt % (percentage(value) * 100);
+      std::string s = percent_fmt.str();
+      s.resize(4);
+      return s;
+    }
+
+    std::string percentages() const {
+      return percentage_str(used()) + " " + percentage_str(sending()) + " " +
+             percentage_str(freeing()) + " " + percentage_str(unused());
+    }
+
+    std::vector<int64_t> vector() const {
+      return std::vector<int64_t>{used(), sending(), freeing(), unused()};
+    }
+  };
+
+  SendBufferStatus previous_send_buffer_status_desc_ = SendBufferStatus();
+  SendBufferStatus previous_send_buffer_status_data_ = SendBufferStatus();
+
+  /// Scheduler for periodic events.
+  Scheduler scheduler_;
+
+  /// Connect to all compute nodes.
+  /** \return false if interrupted by a signal */
+  bool connect();
+
+  /// Return target computation node for given timeslice.
+  std::size_t target_cn_index(uint64_t timeslice) const {
+    return schedule_.compute_node(timeslice);
+  }
+
+  /// The central function for distributing timeslice data.
+  bool try_send_timeslice(uint64_t timeslice);
+
+  /// Get number of bytes to skip in advance (to avoid buffer wrap).
+  static uint64_t skip_required(const Connection& c, uint64_t data_size);
+
+  /// Check if enough space is available at target compute node.
+  static bool check_for_buffer_space(const Connection& c,
+                                     uint64_t data_size,
+                                     uint64_t desc_size);
+
+  /// Create gather list for transmission of timeslice.
+  void post_send_data(uint64_t timeslice,
+                      Connection& c,
+                      uint64_t desc_offset,
+                      uint64_t desc_length,
+                      uint64_t data_offset,
+                      uint64_t data_length,
+                      uint64_t skip);
+
+  /// Send the final status message to a compute node.
+  void finalize(Connection& c);
+
+  /// Wait for socket events and handle them.
+  void poll_connections(int timeout_ms);
+
+  /// Write queued data to the socket as far as possible.
+  void send_queued(Connection& c);
+
+  /// Receive queued status messages from the compute node.
+  void receive_status(Connection& c);
+
+  /// Receive zero-copy completion notifications from the error queue.
+  void receive_completions(Connection& c);
+
+  /// Mark a range of zero-copy send calls as completed.
+  static void complete_zerocopy(Connection& c, uint32_t lo, uint32_t hi);
+
+  /// Acknowledge completely transmitted timeslice components.
+  void complete_sends(Connection& c);
+
+  /// Update read indexes after timeslice has been sent.
+  void ack_timeslice(uint64_t timeslice);
+
+  /// Force writing read indexes to data source.
+  void sync_data_source();
+
+  /// Print a (periodic) buffer status report.
+  void report_status();
+};
@@ -0,0 +1,67 @@
+// Copyright 2026 agent <agent@local>
+#pragma once
+
+#include <cstdint>
+
+/// Messages of the TCP timeslice building protocol.
+/** The protocol follows the RDMA and libfabric transports. After connecting,
+    an input channel sends its InputNodeInfo and the compute node replies with
+    its ComputeNodeInfo. Each timeslice component is then sent as an
+    InputChannelStatusMessage carrying the new write pointers, followed by the
+    TimesliceComponentDescriptor and the component contents (microslice
+    descriptors and data). The compute node grants buffer space by sending
+    ComputeNodeStatusMessage updates with its acknowledged pointers. These
+    also carry the compute node's weights for the assignment of future
+    timeslice epochs (see TimesliceSchedule), one epoch per message and in
+    ascending order. Both sides end the connection with a final status
+    message. */
+
+namespace tl_tcp {
+
+#pragma pack(1)
+
+/// Structure representing a set of compute node buffer positions.
+struct ComputeNodeBufferPosition {
+  uint64_t data; ///< The position in the data buffer.
+  uint64_t desc; ///< The position in the description buffer.
+  bool operator==(const ComputeNodeBufferPosition& rhs) const {
+    return desc == rhs.desc && data == rhs.data;
+  }
+  bool operator!=(const ComputeNodeBufferPosition& rhs) const {
+    return desc != rhs.desc || data != rhs.data;
+  }
+};
+
+/// Structure sent by an input channel after connecting to a compute node.
+struct InputNodeInfo {
+  uint32_t index;
+};
+
+/// Structure sent by a compute node in reply to an InputNodeInfo.
+struct ComputeNodeInfo {
+  uint32_t index;
+  uint32_t data_buffer_size_exp;
+  uint32_t desc_buffer_size_exp;
+};
+
+/// Structure representing a status update message sent from compute buffer to
+/// input channel.
+struct ComputeNodeStatusMessage {
+  ComputeNodeBufferPosition ack;
+  bool request_abort;
+  bool final;
+  uint64_t schedule_epoch;  ///< Epoch of the announced weight.
+  uint32_t schedule_weight; ///< Announced weight (zero if none).
+};
+
+/// Structure representing a status update message sent from input channel to
+/// compute buffer.
+struct InputChannelStatusMessage {
+  ComputeNodeBufferPosition wp;
+  bool abort;
+  bool final;
+};
+
+#pragma pack()
+
+} // namespace tl_tcp
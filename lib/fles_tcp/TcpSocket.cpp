@@ -0,0 +1,142 @@
+// Copyright 2026 agent <agent@local>
+
+#include "TcpSocket.hpp"
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace tl_tcp {
+
+void throw_errno(const std::string& what) {
+  throw TcpException(what + ": " + std::strerror(errno));
+}
+
+int listen_socket(unsigned short port, int backlog) {
+  int fd = ::socket(AF_INET6, SOCK_STREAM, 0);
+  int family = AF_INET6;
+  if (fd == -1) {
+    fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    family = AF_INET;
+  }
+  if (fd == -1) {
+    throw_errno("socket failed");
+  }
+
+  int on = 1;
+  ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+
+  int rc;
+  if (family == AF_INET6) {
+    int off = 0;
+    ::setsockopt(fd, IPPROTO_IPV6, IPV6_V6ONLY, &off, sizeof(off));
+    sockaddr_in6 addr = sockaddr_in6();
+    addr.sin6_family = AF_INET6;
+    addr.sin6_addr = in6addr_any;
+    addr.sin6_port = htons(port);
+    rc = ::bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+  } else {
+    sockaddr_in addr = sockaddr_in();
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    addr.sin_port = htons(port);
+    rc = ::bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+  }
+  if (rc == -1 || ::listen(fd, backlog) == -1) {
+    int err = errno;
+    ::close(fd);
+    errno = err;
+    throw_errno("cannot listen on port " + std::to_string(port));
+  }
+  return fd;
+}
+
+int connect_socket(const std::string& hostname, const std::string& service) {
+  addrinfo hints = addrinfo();
+  hints.ai_family = AF_UNSPEC;
+  hints.ai_socktype = SOCK_STREAM;
+  addrinfo* result = nullptr;
+  int err = ::getaddrinfo(hostname.c_str(), service.c_str(), &hints, &result);
+  if (err != 0) {
+    throw TcpException("cannot resolve " + hostname + ":" + service + ": " +
+                       ::gai_strerror(err));
+  }
+
+  int fd = -1;
+  for (addrinfo* ai = result; ai != nullptr && fd == -1; ai = ai->ai_next) {
+    fd = ::socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+    if (fd == -1) {
+      continue;
+    }
+    if (::connect(fd, ai->ai_addr, ai->ai_addrlen) == -1) {
+      ::close(fd);
+      fd = -1;
+    }
+  }
+  ::freeaddrinfo(result);
+  return fd;
+}
+
+void set_nonblocking(int fd) {
+  int flags = ::fcntl(fd, F_GETFL, 0);
+  if (flags == -1 || ::fcntl(fd, F_SETFL, flags | O_NONBLOCK) == -1) {
+    throw_errno("fcntl failed");
+  }
+}
+
+void set_nodelay(int fd) {
+  int on = 1;
+  if (::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on)) == -1) {
+    throw_errno("setsockopt(TCP_NODELAY) failed");
+  }
+}
+
+bool enable_zerocopy(int fd) {
+#if defined(SO_ZEROCOPY) && defined(MSG_ZEROCOPY)
+  int on = 1;
+  return ::setsockopt(fd, SOL_SOCKET, SO_ZEROCOPY, &on, sizeof(on)) == 0;
+#else
+  (void)fd;
+  return false;
+#endif
+}
+
+void send_all(int fd, const void* buf, std::size_t len) {
+  const uint8_t* p = static_cast<const uint8_t*>(buf);
+  while (len > 0) {
+    ssize_t n = ::send(fd, p, len, MSG_NOSIGNAL);
+    if (n == -1) {
+      if (errno == EINTR) {
+        continue;
+      }
+      throw_errno("send failed");
+    }
+    p += n;
+    len -= static_cast<std::size_t>(n);
+  }
+}
+
+void recv_all(int fd, void* buf, std::size_t len) {
+  uint8_t* p = static_cast<uint8_t*>(buf);
+  while (len > 0) {
+    ssize_t n = ::recv(fd, p, len, 0);
+    if (n == -1) {
+      if (errno == EINTR) {
+        continue;
+      }
+      throw_errno("recv failed");
+    }
+    if (n == 0) {
+      throw TcpException("connection closed by remote side");
+    }
+    p += n;
+    len -= static_cast<std::size_t>(n);
+  }
+}
+
+} // namespace tl_tcp
@@ -0,0 +1,47 @@
+// Copyright 2026 agent <agent@local>
+#pragma once
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+
+namespace tl_tcp {
+
+/// TCP exception class.
+/** A TcpException object signals an error that occured in the TCP
+    communication functions. */
+
+class TcpException : public std::runtime_error {
+public:
+  /// The TcpException default constructor.
+  explicit TcpException(const std::string& what_arg = "")
+      : std::runtime_error(what_arg) {}
+};
+
+/// Throw a TcpException describing the current errno value.
+[[noreturn]] void throw_errno(const std::string& what);
+
+/// Create a socket listening on the given port on all interfaces.
+int listen_socket(unsigned short port, int backlog);
+
+/// Connect to a remote service.
+/** \return connected socket, or -1 if the remote side is not (yet) listening */
+int connect_socket(const std::string& hostname, const std::string& service);
+
+/// Put a socket into non-blocking mode.
+void set_nonblocking(int fd);
+
+/// Disable Nagle's algorithm on a socket.
+void set_nodelay(int fd);
+
+/// Enable zero-copy transmission (MSG_ZEROCOPY) on a socket.
+/** \return true if supported by the system */
+bool enable_zerocopy(int fd);
+
+/// Send a complete buffer on a blocking socket.
+void send_all(int fd, const void* buf, std::size_t len);
+
+/// Receive a complete buffer on a blocking socket.
+void recv_all(int fd, void* buf, std::size_t len);
+
+} // namespace tl_tcp
@@ -0,0 +1,430 @@
+// Copyright 2026 agent <agent@local>
+
+#include "TimesliceBuilderTcp.hpp"
+#include "TcpSocket.hpp"
+#include "TimesliceCompletion.hpp"
+#include "TimesliceWorkItem.hpp"
+#include "Utility.hpp"
+#include "log.hpp"
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <thread>
+#include <unistd.h>
+
+TimesliceBuilderTcp::TimesliceBuilderTcp(uint64_t compute_index,
+                                         TimesliceBuffer& timeslice_buffer,
+                                         unsigned short service,
+                                         uint32_t num_input_nodes,
+                                         uint32_t num_compute_nodes,
+                                         uint32_t timeslice_size,
+                                         volatile sig_atomic_t* signal_status)
+    : compute_index_(compute_index), timeslice_buffer_(timeslice_buffer),
+      num_input_nodes_(num_input_nodes), timeslice_size_(timeslice_size),
+      signal_status_(signal_status),
+      ack_(timeslice_buffer_.get_desc_size_exp()),
+      schedule_(num_compute_nodes), announced_(schedule_.lookahead()),
+      weights_epoch_(announced_) {
+  assert(timeslice_buffer_.get_num_input_nodes() == num_input_nodes);
+  listen_fd_ = tl_tcp::listen_socket(service, num_input_nodes_);
+}
+
+TimesliceBuilderTcp::~TimesliceBuilderTcp() {
+  for (auto& c : conn_) {
+    if (c && c->fd != -1) {
+      ::close(c->fd);
+    }
+  }
+  if (listen_fd_ != -1) {
+    ::close(listen_fd_);
+  }
+}
+
+void TimesliceBuilderTcp::operator()() {
+  if (!accept_connections()) {
+    timeslice_buffer_.send_end_work_item();
+    timeslice_buffer_.send_end_completion();
+    return;
+  }
+
+  time_begin_ = std::chrono::high_resolution_clock::now();
+  report_status();
+
+  while (connections_done_ < conn_.size()) {
+    poll_connections(1);
+    handle_timeslice_completions();
+    complete_timeslices();
+    scheduler_.timer();
+    if (*signal_status_ != 0 && !request_abort_) {
+      L_(info) << "[c" << compute_index_ << "] "
+               << "request abort";
+      request_abort_ = true;
+      for (auto& c : conn_) {
+        send_status(*c);
+      }
+    }
+  }
+
+  time_end_ = std::chrono::high_resolution_clock::now();
+
+  // wait until all pending timeslices have been acknowledged
+  while (!abort_ && !request_abort_ && acked_ < completely_written_) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    handle_timeslice_completions();
+  }
+  timeslice_buffer_.send_end_work_item();
+  timeslice_buffer_.send_end_completion();
+
+  for (auto& c : conn_) {
+    ::close(c->fd);
+    c->fd = -1;
+  }
+}
+
+bool TimesliceBuilderTcp::accept_connections() {
+  conn_.resize(num_input_nodes_);
+  std::size_t connected = 0;
+  while (connected < num_input_nodes_) {
+    struct pollfd pfd = {listen_fd_, POLLIN, 0};
+    int rc = ::poll(&pfd, 1, 100);
+    if (*signal_status_ != 0) {
+      return false;
+    }
+    if (rc == -1 && errno != EINTR) {
+      tl_tcp::throw_errno("poll failed");
+    }
+    if (rc <= 0) {
+      continue;
+    }
+
+    int fd = ::accept(listen_fd_, nullptr, nullptr);
+    if (fd == -1) {
+      if (errno == EINTR || errno == EAGAIN || errno == ECONNABORTED) {
+        continue;
+      }
+      tl_tcp::throw_errno("accept failed");
+    }
+    tl_tcp::set_nodelay(fd);
+
+    tl_tcp::InputNodeInfo remote_info;
+    tl_tcp::recv_all(fd, &remote_info, sizeof(remote_info));
+    uint_fast16_t index = remote_info.index;
+    if (index >= conn_.size() || conn_.at(index)) {
+      ::close(fd);
+      throw tl_tcp::TcpException("unexpected connection from input node " +
+                                 std::to_string(index));
+    }
+
+    tl_tcp::ComputeNodeInfo info{static_cast<uint32_t>(compute_index_),
+                                 timeslice_buffer_.get_data_size_exp(),
+                                 timeslice_buffer_.get_desc_size_exp()};
+    tl_tcp::send_all(fd, &info, sizeof(info));
+    tl_tcp::set_nonblocking(fd);
+
+    std::unique_ptr<Connection> c(new Connection);
+    c->fd = fd;
+    c->index = index;
+    c->announced = announced_;
+    conn_.at(index) = std::move(c);
+    ++connected;
+    L_(debug) << "[c" << compute_index_ << "] "
+              << "connection from input node " << index << " accepted";
+  }
+  return true;
+}
+
+void TimesliceBuilderTcp::poll_connections(int timeout_ms) {
+  std::vector<struct pollfd> fds(conn_.size());
+  for (size_t i = 0; i < conn_.size(); ++i) {
+    const Connection& c = *conn_[i];
+    // negative descriptors are ignored by poll
+    fds[i].fd = c.done ? -1 : c.fd;
+    fds[i].events = 0;
+    if (!c.final) {
+      fds[i].events |= POLLIN;
+    }
+    if (c.send_bytes < sizeof(c.send_status)) {
+      fds[i].events |= POLLOUT;
+    }
+  }
+
+  int rc = ::poll(fds.data(), fds.size(), timeout_ms);
+  if (rc == -1 && errno != EINTR) {
+    tl_tcp::throw_errno("poll failed");
+  }
+
+  for (size_t i = 0; i < conn_.size() && rc > 0; ++i) {
+    Connection& c = *conn_[i];
+    if ((fds[i].revents & (POLLIN | POLLHUP | POLLERR)) != 0 && !c.final) {
+      receive(c);
+    }
+    if ((fds[i].revents & POLLOUT) != 0) {
+      send_queued(c);
+    }
+  }
+}
+
+void TimesliceBuilderTcp::receive(Connection& c) {
+  const uint64_t status_size = sizeof(c.recv_status);
+  const uint64_t header_size =
+      status_size + sizeof(fles::TimesliceComponentDescriptor);
+
+  while (!c.final) {
+    // the descriptor of the next component is received into its position
+    fles::TimesliceComponentDescriptor& desc =
+        timeslice_buffer_.get_desc(c.index, c.cn_wp.desc);
+
+    ssize_t len;
+    if (!c.receiving_data) {
+      struct iovec iov[2];
+      int iovcnt = 0;
+      if (c.recv_bytes < status_size) {
+        iov[iovcnt++] = {reinterpret_cast<uint8_t*>(&c.recv_status) +
+                             c.recv_bytes,
+                         status_size - c.recv_bytes};
+        iov[iovcnt++] = {&desc, sizeof(desc)};
+      } else {
+        iov[iovcnt++] = {reinterpret_cast<uint8_t*>(&desc) + c.recv_bytes -
+                             status_size,
+                         header_size - c.recv_bytes};
+      }
+      len = ::readv(c.fd, iov, iovcnt);
+    } else {
+      // contents are received into the data buffer without wrap-around
+      assert((desc.offset & ((UINT64_C(1)
+                              << timeslice_buffer_.get_data_size_exp()) -
+                             1)) +
+                 desc.size <=
+             UINT64_C(1) << timeslice_buffer_.get_data_size_exp());
+      len = ::read(c.fd,
+                   &timeslice_buffer_.get_data(c.index, desc.offset) +
+                       c.recv_bytes,
+                   desc.size - c.recv_bytes);
+    }
+
+    if (len == -1) {
+      if (errno == EINTR) {
+        continue;
+      }
+      if (errno == EAGAIN || errno == EWOULDBLOCK) {
+        return;
+      }
+      tl_tcp::throw_errno("read failed");
+    }
+    if (len == 0) {
+      throw tl_tcp::TcpException("connection closed by input node " +
+                                 std::to_string(c.index));
+    }
+    c.recv_bytes += static_cast<uint64_t>(len);
+
+    if (!c.receiving_data) {
+      if (c.recv_bytes >= status_size && c.recv_status.final) {
+        assert(c.recv_bytes == status_size);
+        c.final = true;
+        if (c.recv_status.abort) {
+          abort_ = true;
+        }
+        L_(debug) << "[c" << compute_index_ << "] "
+                  << "final status from input node " << c.index;
+        send_status(c);
+        return;
+      }
+      if (c.recv_bytes < header_size) {
+        continue;
+      }
+      assert(c.recv_status.wp.desc == c.cn_wp.desc + 1);
+      assert(c.recv_status.wp.data == desc.offset + desc.size);
+      announce(desc.ts_num);
+      c.receiving_data = true;
+      c.recv_bytes = 0;
+    }
+
+    if (c.recv_bytes == desc.size) {
+      c.cn_wp = c.recv_status.wp;
+      c.receiving_data = false;
+      c.recv_bytes = 0;
+    }
+  }
+}
+
+void TimesliceBuilderTcp::announce(uint64_t timeslice) {
+  uint64_t epoch = schedule_.epoch(timeslice) + schedule_.lookahead();
+  if (epoch < announced_) {
+    return;
+  }
+
+  // free buffer fraction of the most occupied connection
+  double free_fraction = 1.0;
+  for (auto& c : conn_) {
+    uint64_t data_size = UINT64_C(1) << timeslice_buffer_.get_data_size_exp();
+    uint64_t desc_size = UINT64_C(1) << timeslice_buffer_.get_desc_size_exp();
+    free_fraction = std::min(
+        {free_fraction,
+         static_cast<double>(c->cn_ack.data + data_size - c->cn_wp.data) /
+             static_cast<double>(data_size),
+         static_cast<double>(c->cn_ack.desc + desc_size - c->cn_wp.desc) /
+             static_cast<double>(desc_size)});
+  }
+  uint32_t weight =
+      schedule_.weight(free_fraction, completely_written_ - acked_);
+
+  while (announced_ <= epoch) {
+    weights_.push_back(weight);
+    ++announced_;
+  }
+
+  // discard weights sent to all input nodes
+  uint64_t sent = announced_;
+  for (auto& c : conn_) {
+    if (!c->final) {
+      sent = std::min(sent, c->announced);
+    }
+  }
+  while (weights_epoch_ < sent) {
+    weights_.pop_front();
+    ++weights_epoch_;
+  }
+
+  for (auto& c : conn_) {
+    if (!c->final) {
+      send_status(*c);
+    }
+  }
+}
+
+void TimesliceBuilderTcp::send_status(Connection& c) {
+  if (c.done) {
+    return;
+  }
+  if (c.send_bytes < sizeof(c.send_status)) {
+    // previous message still in transmission
+    c.send_pending = true;
+    return;
+  }
+  c.send_status.ack = c.cn_ack;
+  c.send_status.request_abort = request_abort_;
+  c.send_status.final = c.final;
+  if (c.announced < announced_ && !c.final) {
+    c.send_status.schedule_epoch = c.announced;
+    c.send_status.schedule_weight = weights_.at(c.announced - weights_epoch_);
+    ++c.announced;
+  } else {
+    c.send_status.schedule_weight = 0;
+  }
+  c.send_bytes = 0;
+  send_queued(c);
+}
+
+void TimesliceBuilderTcp::send_queued(Connection& c) {
+  const std::size_t size = sizeof(c.send_status);
+  while (c.send_bytes < size) {
+    ssize_t len = ::send(c.fd,
+                         reinterpret_cast<uint8_t*>(&c.send_status) +
+                             c.send_bytes,
+                         size - c.send_bytes, MSG_DONTWAIT | MSG_NOSIGNAL);
+    if (len == -1) {
+      if (errno == EINTR) {
+        continue;
+      }
+      if (errno == EAGAIN || errno == EWOULDBLOCK) {
+        return;
+      }
+      tl_tcp::throw_errno("send failed");
+    }
+    c.send_bytes += static_cast<std::size_t>(len);
+    if (c.send_bytes < size) {
+      continue;
+    }
+
+    if (c.send_status.final) {
+      c.done = true;
+      ++connections_done_;
+      return;
+    }
+    if (c.send_pending || (c.announced < announced_ && !c.final)) {
+      c.send_pending = false;
+      send_status(c);
+      return;
+    }
+  }
+}
+
+void TimesliceBuilderTcp::complete_timeslices() {
+  uint64_t written = UINT64_MAX;
+  for (auto& c : conn_) {
+    written = std::min<uint64_t>(written, c->cn_wp.desc);
+  }
+
+  while (completely_written_ < written) {
+    uint64_t ts_index = timeslice_buffer_.get_desc(0, completely_written_).ts_num;
+    timeslice_buffer_.send_work_item(
+        {{ts_index, completely_written_, timeslice_size_,
+          static_cast<uint32_t>(conn_.size())},
+         timeslice_buffer_.get_data_size_exp(),
+         timeslice_buffer_.get_desc_size_exp()});
+    ++completely_written_;
+  }
+}
+
+void TimesliceBuilderTcp::handle_timeslice_completions() {
+  std::array<fles::TimesliceCompletion, 64> completions;
+  uint64_t acked = acked_;
+  std::size_t count;
+  while ((count = timeslice_buffer_.try_receive_completions(
+              completions.data(), completions.size())) > 0) {
+    for (std::size_t i = 0; i < count; ++i) {
+      const fles::TimesliceCompletion& c = completions[i];
+      if (c.ts_pos == acked_) {
+        do
+          ++acked_;
+        while (ack_.at(acked_) > c.ts_pos);
+      } else
+        ack_.at(c.ts_pos) = c.ts_pos;
+    }
+  }
+  if (acked_ != acked) {
+    timeslice_buffer_.set_acked(acked_);
+    for (auto& c : conn_) {
+      const fles::TimesliceComponentDescriptor& desc =
+          timeslice_buffer_.get_desc(c->index, acked_ - 1);
+      c->cn_ack = {desc.offset + desc.size, acked_};
+      if (!c->final) {
+        send_status(*c);
+      }
+    }
+  }
+}
+
+void TimesliceBuilderTcp::report_status() {
+  constexpr auto interval = std::chrono::seconds(1);
+
+  std::chrono::system_clock::time_point now = std::chrono::system_clock::now();
+
+  for (auto& c : conn_) {
+    BufferStatus status_desc{now,
+                             UINT64_C(1)
+                                 << timeslice_buffer_.get_desc_size_exp(),
+                             c->cn_ack.desc, c->cn_ack.desc, c->cn_wp.desc};
+    BufferStatus status_data{now,
+                             UINT64_C(1)
+                                 << timeslice_buffer_.get_data_size_exp(),
+                             c->cn_ack.data, c->cn_ack.data, c->cn_wp.data};
+
+    L_(debug) << "[c" << compute_index_ << "] desc "
+              << status_desc.percentages() << " (used..free) | "
+              << human_readable_count(status_desc.acked, true, "")
+              << " timeslices";
+    L_(debug) << "[c" << compute_index_ << "] data "
+              << status_data.percentages() << " (used..free) | "
+              << human_readable_count(status_data.acked, true);
+    L_(info) << "[c" << compute_index_ << "_" << c->index << "] |"
+             << bar_graph(status_data.vector(), "#._", 20) << "|"
+             << bar_graph(status_desc.vector(), "#._", 10) << "| ";
+  }
+
+  scheduler_.add(std::bind(&TimesliceBuilderTcp::report_status, this),
+                 now + interval);
+}
@@ -0,0 +1,212 @@
+// Copyright 2026 agent <agent@local>
+#pragma once
+
+#include "RingBuffer.hpp"
+#include "Scheduler.hpp"
+#include "TcpProtocol.hpp"
+#include "TimesliceBuffer.hpp"
+#include "TimesliceSchedule.hpp"
+#include <boost/format.hpp>
+#include <chrono>
+#include <csignal>
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
+/// Timeslice builder class.
+/** A TimesliceBuilderTcp object accepts TCP connections from input nodes
+    and receives timeslice components to a timeslice buffer.
+
+    The component descriptors and contents are received directly into their
+    positions in the timeslice buffer, which are determined by the input
+    nodes as in the RDMA transport. Buffer space is granted to the input
+    nodes by acknowledging the timeslices completed by the consumers. The
+    share of future timeslices assigned to this compute node is adapted to
+    its free buffer space and consumer backlog by announcing weights to the
+    input nodes. */
+
+class TimesliceBuilderTcp {
+public:
+  /// The TimesliceBuilderTcp constructor.
+  TimesliceBuilderTcp(uint64_t compute_index,
+                      TimesliceBuffer& timeslice_buffer,
+                      unsigned short service,
+                      uint32_t num_input_nodes,
+                      uint32_t num_compute_nodes,
+                      uint32_t timeslice_size,
+                      volatile sig_atomic_t* signal_status);
+
+  TimesliceBuilderTcp(const TimesliceBuilderTcp&) = delete;
+  void operator=(const TimesliceBuilderTcp&) = delete;
+
+  /// The TimesliceBuilderTcp destructor.
+  ~TimesliceBuilderTcp();
+
+  /// The thread main function.
+  void operator()();
+
+private:
+  /// Connection struct, handles data for one input node.
+  struct Connection {
+    int fd = -1;
+
+    /// Index of the input node (timeslice component).
+    uint_fast16_t index = 0;
+
+    /// Receive buffer for input channel status messages.
+    tl_tcp::InputChannelStatusMessage recv_status =
+        tl_tcp::InputChannelStatusMessage();
+    /// Receiving component contents (otherwise status and descriptor).
+    bool receiving_data = false;
+    /// Number of bytes received in the current step.
+    uint64_t recv_bytes = 0;
+
+    /// Write pointers up to which the component data has been received.
+    tl_tcp::ComputeNodeBufferPosition cn_wp =
+        tl_tcp::ComputeNodeBufferPosition();
+
+    /// Pointers acknowledged to the input node.
+    tl_tcp::ComputeNodeBufferPosition cn_ack =
+        tl_tcp::ComputeNodeBufferPosition();
+
+    /// Send buffer for compute node status messages.
+    tl_tcp::ComputeNodeStatusMessage send_status =
+        tl_tcp::ComputeNodeStatusMessage();
+    std::size_t send_bytes = sizeof(tl_tcp::ComputeNodeStatusMessage);
+    /// A newer status message has to be sent after the current one.
+    bool send_pending = false;
+    /// Next epoch to announce to the input node.
+    uint64_t announced = 0;
+
+    /// Final status message received from input node.
+    bool final = false;
+    /// Final status message sent to input node.
+    bool done = false;
+  };
+
+  /// This builder's index in the list of compute nodes.
+  const uint64_t compute_index_;
+
+  /// Shared memory buffer to store received timeslices.
+  TimesliceBuffer& timeslice_buffer_;
+
+  /// Number of input nodes.
+  const uint32_t num_input_nodes_;
+
+  /// Constant size (in microslices) of a timeslice component.
+  const uint32_t timeslice_size_;
+
+  /// Pointer to global signal status variable.
+  volatile sig_atomic_t* signal_status_;
+
+  /// Listening socket.
+  int listen_fd_ = -1;
+
+  /// The vector of connections, indexed by input node.
+  std::vector<std::unique_ptr<Connection>> conn_;
+
+  /// Number of connections finished.
+  std::size_t connections_done_ = 0;
+
+  /// Abort requested by a signal.
+  bool request_abort_ = false;
+
+  /// Abort signaled by an input node.
+  bool abort_ = false;
+
+  /// Index of acknowledged timeslices (local index).
+  uint64_t acked_ = 0;
+
+  /// Number of timeslices received from all input nodes (local index).
+  uint64_t completely_written_ = 0;
+
+  /// Buffer to store acknowledged status of timeslices.
+  RingBuffer<uint64_t, true> ack_;
+
+  /// Assignment of timeslices to compute nodes.
+  TimesliceSchedule schedule_;
+
+  /// Next epoch to announce a weight for.
+  uint64_t announced_;
+
+  /// Announced weights not yet sent to all input nodes.
+  std::deque<uint32_t> weights_;
+
+  /// Epoch of the first element in weights_.
+  uint64_t weights_epoch_;
+
+  /// Begin of operation (for performance statistics).
+  std::chrono::high_resolution_clock::time_point time_begin_;
+
+  /// End of operation (for performance statistics).
+  std::chrono::high_resolution_clock::time_point time_end_;
+
+  struct BufferStatus {
+    std::chrono::system_clock::time_point time;
+    uint64_t size;
+
+    uint64_t cached_acked;
+    uint64_t acked;
+    uint64_t received;
+
+    int64_t used() const { return received - acked; }
+    int64_t freeing() const { return acked - cached_acked; }
+    int64_t unused() const { return cached_acked + size - received; }
+
+    float percentage(int64_t value) const {
+      return static_cast<float>(value) / static_cast<float>(size);
+    }
+
+    std::string caption() const { return std::string("used/freeing/free"); }
+
+    std::string percentage_str(int64_t value) const {
+      boost::format percent_fmt("%4.1f%%");
+      percent_fmt % (percentage(value) * 100);
+      std::string s = percent_fmt.str();
+      s.resize(4);
+      return s;
+    }
+
+    std::string percentages() const {
+      return percentage_str(used()) + " " + percentage_str(freeing()) + " " +
+             percentage_str(unused());
+    }
+
+    std::vector<int64_t> vector() const {
+      return std::vector<int64_t>{used(), freeing(), unused()};
+    }
+  };
+
+  /// Scheduler for periodic events.
+  Scheduler scheduler_;
+
+  /// Accept connections from all input nodes.
+  /** \return false if interrupted by a signal */
+  bool accept_connections();
+
+  /// Wait for socket events and handle them.
+  void poll_connections(int timeout_ms);
+
+  /// Receive timeslice components and status messages from an input node.
+  void receive(Connection& c);
+
+  /// Announce weights up to the lookahead of the given timeslice's epoch.
+  void announce(uint64_t timeslice);
+
+  /// Send a status message with the current acknowledged pointers, or the
+  /// final status message once the input node has finished.
+  void send_status(Connection& c);
+
+  /// Write the status message to the socket as far as possible.
+  void send_queued(Connection& c);
+
+  /// Hand over timeslices received from all input nodes.
+  void complete_timeslices();
+
+  /// Handle pending timeslice completions and advance read indexes.
+  void handle_timeslice_completions();
+
+  /// Print a (periodic) buffer status report.
+  void report_status();
+};
@@ -3,6 +3,7 @@
 #include "ComponentSenderZeromq.hpp"
 #include "MicrosliceDescriptor.hpp"
 #include "Utility.hpp"
+#include "ZeromqProtocol.hpp"
 #include "log.hpp"
 #include <algorithm>
 
@@ -14,26 +15,25 @@ ComponentSenderZeromq::ComponentSenderZeromq(
     uint32_t overlap_size,
     uint32_t max_timeslice_number,
     volatile sig_atomic_t* signal_status,
-    void* zmq_context)
+    void* zmq_context,
+    std::chrono::milliseconds request_timeout)
     : input_index_(input_index), data_source_(data_source),
       timeslice_size_(timeslice_size), overlap_size_(overlap_size),
       max_timeslice_number_(max_timeslice_number),
-      signal_status_(signal_status),
+      signal_status_(signal_status), request_timeout_(request_timeout),
       min_acked_({data_source.desc_buffer().size() / 4,
                   data_source.data_buffer().size() / 4}) {
   start_index_ = sent_ = acked_ = cached_acked_ = data_source.get_read_index();
 
   size_t min_ack_buffer_size =
-      (data_source_.desc_buffer().size() / timeslice_size_ + 1) * 2;
+      data_source_.desc_buffer().size() / timeslice_size_ + 1;
   ack_.alloc_with_size(min_ack_buffer_size);
 
-  socket_ = zmq_socket(zmq_context, ZMQ_REP);
+  socket_ = zmq_socket(zmq_context, ZMQ_ROUTER);
   assert(socket_);
   int timeout_ms = 500;
   int rc =
-      zmq_setsockopt(socket_, ZMQ_RCVTIMEO, &timeout_ms, sizeof timeout_ms);
-  assert(rc == 0);
-  rc = zmq_setsockopt(socket_, ZMQ_SNDTIMEO, &timeout_ms, sizeof timeout_ms);
+      zmq_setsockopt(socket_, ZMQ_SNDTIMEO, &timeout_ms, sizeof timeout_ms);
   assert(rc == 0);
 
   rc = zmq_bind(socket_, listen_address.c_str());
@@ -49,7 +49,7 @@ ComponentSenderZeromq::~ComponentSenderZeromq() {
 
 void ComponentSenderZeromq::operator()() {
   run_begin();
-  while (acked_ts2_ / 2 < max_timeslice_number_ && *signal_status_ == 0) {
+  while (acked_ts_ < max_timeslice_number_ && *signal_status_ == 0) {
     run_cycle();
     scheduler_.timer();
   }
@@ -63,77 +63,216 @@ void ComponentSenderZeromq::run_begin() {
 }
 
 bool ComponentSenderZeromq::run_cycle() {
-  zmq_msg_t request;
-  int rc = zmq_msg_init(&request);
-  assert(rc == 0);
+  // poll frequently only while requests wait for data, and check for
+  // released messages while timeslices are unacknowledged
+  long timeout_ms = !pending_.empty() ? 1 : sent_timeslices_.empty() ? 500 : 10;
+  zmq_pollitem_t item{socket_, 0, ZMQ_POLLIN, 0};
+  int rc = zmq_poll(&item, 1, timeout_ms);
+  assert(rc != -1 || errno == EINTR);
+
+  handle_released_messages();
+  if (rc > 0) {
+    receive_requests();
+  }
+  serve_requests();
+  data_source_.proceed();
 
-  int len = zmq_msg_recv(&request, socket_, 0);
-  if (len == -1 && errno == EAGAIN) {
-    // timeout reached
-    return true;
+  return true;
+}
+
+void ComponentSenderZeromq::receive_requests() {
+  while (true) {
+    // routing identity frame
+    zmq_msg_t identity;
+    int rc = zmq_msg_init(&identity);
+    assert(rc == 0);
+    if (zmq_msg_recv(&identity, socket_, ZMQ_DONTWAIT) == -1) {
+      zmq_msg_close(&identity);
+      return;
+    }
+    assert(zmq_msg_more(&identity));
+
+    // request frame
+    zmq_msg_t request;
+    rc = zmq_msg_init(&request);
+    assert(rc == 0);
+    int len = zmq_msg_recv(&request, socket_, 0);
+    assert(len == sizeof(tl_zeromq::TimesliceRequest));
+    tl_zeromq::TimesliceRequest req;
+    std::copy_n(static_cast<uint8_t*>(zmq_msg_data(&request)), sizeof(req),
+                reinterpret_cast<uint8_t*>(&req));
+    std::string id(static_cast<char*>(zmq_msg_data(&identity)),
+                   zmq_msg_size(&identity));
+    zmq_msg_close(&request);
+    zmq_msg_close(&identity);
+
+    confirm_timeslices(id, req.received);
+    uint64_t timeslice = req.timeslice;
+    if (timeslice == tl_zeromq::no_timeslice) {
+      continue;
+    }
+
+    if (timeslice < acked_ts_) {
+      ++requests_ignored_;
+      continue;
+    }
+    auto sent = sent_timeslices_.find(timeslice);
+    if (sent != sent_timeslices_.end()) {
+      // a request repeated before the receipt is confirmed means that the
+      // reply has been lost, the data is still in the input buffer
+      if (sent->second.received || sent->second.identity != id) {
+        ++requests_ignored_;
+      } else {
+        ++timeslices_resent_;
+        send_timeslice(id, timeslice);
+      }
+      continue;
+    }
+    auto deadline = std::chrono::steady_clock::now() + request_timeout_;
+    auto range = pending_.equal_range(timeslice);
+    auto it = std::find_if(range.first, range.second,
+                           [&](const std::pair<const uint64_t, Request>& r) {
+                             return r.second.identity == id;
+                           });
+    if (it != range.second) {
+      ++requests_ignored_;
+      it->second.deadline = deadline;
+      continue;
+    }
+    pending_.emplace(timeslice, Request{id, deadline});
   }
-  assert(len != -1);
+}
 
-  assert(len == sizeof(uint64_t));
-  uint64_t timeslice = *static_cast<uint64_t*>(zmq_msg_data(&request));
-  zmq_msg_close(&request);
+void ComponentSenderZeromq::confirm_timeslices(const std::string& identity,
+                                              uint64_t received) {
+  auto end = sent_timeslices_.lower_bound(received);
+  for (auto it = sent_timeslices_.begin(); it != end;) {
+    auto current = it++;
+    if (current->second.identity == identity) {
+      current->second.received = true;
+      try_ack_timeslice(current);
+    }
+  }
+}
 
-  try_send_timeslice(timeslice);
-  data_source_.proceed();
+void ComponentSenderZeromq::handle_released_messages() {
+  std::vector<uint64_t> released;
+  {
+    std::lock_guard<std::mutex> lock(released_mutex_);
+    released.swap(released_messages_);
+  }
+  for (uint64_t ts : released) {
+    auto it = sent_timeslices_.find(ts);
+    assert(it != sent_timeslices_.end() && it->second.messages > 0);
+    --it->second.messages;
+    try_ack_timeslice(it);
+  }
+}
 
-  return true;
+void ComponentSenderZeromq::try_ack_timeslice(
+    std::map<uint64_t, SentTimeslice>::iterator timeslice) {
+  if (timeslice->second.received && timeslice->second.messages == 0) {
+    uint64_t ts = timeslice->first;
+    sent_timeslices_.erase(timeslice);
+    ack_timeslice(ts);
+  }
+}
+
+void ComponentSenderZeromq::serve_requests() {
+  // data becomes available in timeslice order
+  while (!pending_.empty() && *signal_status_ == 0 &&
+         timeslice_available(pending_.begin()->first)) {
+    send_timeslice(pending_.begin()->second.identity, pending_.begin()->first);
+    pending_.erase(pending_.begin());
+  }
+
+  auto now = std::chrono::steady_clock::now();
+  for (auto it = pending_.begin(); it != pending_.end();) {
+    if (it->second.deadline <= now) {
+      // empty reply, the compute node repeats the request
+      send_reply_header(it->second.identity, it->first, false);
+      it = pending_.erase(it);
+    } else {
+      ++it;
+    }
+  }
 }
 
 void ComponentSenderZeromq::run_end() {
   sync_data_source();
   time_end_ = std::chrono::high_resolution_clock::now();
+
+  if (requests_ignored_ > 0 || timeslices_resent_ > 0) {
+    L_(info) << "[i" << input_index_ << "] " << requests_ignored_
+             << " repeated requests ignored, " << timeslices_resent_
+             << " timeslices sent again after lost reply";
+  }
 }
 
 struct Acknowledgment {
   ComponentSenderZeromq* server;
   uint64_t timeslice;
-  bool is_data;
 };
 
 void free_ts(void* /* data */, void* hint) {
   assert(hint);
   auto* ack = static_cast<Acknowledgment*>(hint);
-  ack->server->ack_timeslice(ack->timeslice, ack->is_data);
+  ack->server->release_message(ack->timeslice);
   delete ack;
 }
 
-bool ComponentSenderZeromq::try_send_timeslice(uint64_t ts) {
-  assert(ts >= acked_ts2_ / 2);
-
+bool ComponentSenderZeromq::timeslice_available(uint64_t ts) {
   uint64_t desc_offset = ts * timeslice_size_ + start_index_.desc;
   uint64_t desc_length = timeslice_size_ + overlap_size_;
 
-  // check if complete timeslice is available in the input buffer
   if (write_index_desc_ < desc_offset + desc_length) {
     data_source_.proceed();
     write_index_desc_ = data_source_.get_write_index().desc;
-    if (write_index_desc_ < desc_offset + desc_length) {
-      // send empty message
-      zmq_msg_t msg;
-      zmq_msg_init_size(&msg, 0);
-      int rc;
-      do {
-        rc = zmq_msg_send(&msg, socket_, 0);
-      } while (rc == -1 && errno == EAGAIN && *signal_status_ == 0);
-      return false;
-    }
   }
+  return write_index_desc_ >= desc_offset + desc_length;
+}
+
+void ComponentSenderZeromq::send_frame(zmq_msg_t* msg, int flags) {
+  int rc;
+  do {
+    rc = zmq_msg_send(msg, socket_, flags);
+  } while (rc == -1 && errno == EAGAIN && *signal_status_ == 0);
+}
+
+void ComponentSenderZeromq::send_reply_header(const std::string& identity,
+                                              uint64_t ts,
+                                              bool more) {
+  zmq_msg_t identity_msg;
+  zmq_msg_init_size(&identity_msg, identity.size());
+  std::copy(identity.begin(), identity.end(),
+            static_cast<char*>(zmq_msg_data(&identity_msg)));
+  send_frame(&identity_msg, ZMQ_SNDMORE);
+
+  zmq_msg_t header_msg;
+  zmq_msg_init_size(&header_msg, sizeof(ts));
+  std::copy_n(reinterpret_cast<const uint8_t*>(&ts), sizeof(ts),
+              static_cast<uint8_t*>(zmq_msg_data(&header_msg)));
+  send_frame(&header_msg, more ? ZMQ_SNDMORE : 0);
+}
+
+void ComponentSenderZeromq::send_timeslice(const std::string& identity,
+                                           uint64_t ts) {
+  assert(ts >= acked_ts_);
+
+  uint64_t desc_offset = ts * timeslice_size_ + start_index_.desc;
+  uint64_t desc_length = timeslice_size_ + overlap_size_;
+
+  send_reply_header(identity, ts, true);
+  SentTimeslice& sent = sent_timeslices_[ts];
+  sent.identity = identity;
 
   // part 1: descriptors
   if (desc_offset + desc_length > sent_.desc) {
     sent_.desc = desc_offset + desc_length;
   }
   auto desc_msg = create_message(data_source_.desc_buffer(), desc_offset,
-                                 desc_length, ts, false);
-  int rc;
-  do {
-    rc = zmq_msg_send(&desc_msg, socket_, ZMQ_SNDMORE);
-  } while (rc == -1 && errno == EAGAIN && *signal_status_ == 0);
+                                 desc_length, sent, ts);
+  send_frame(&desc_msg, ZMQ_SNDMORE);
 
   // part 2: data
   uint64_t data_offset = data_source_.desc_buffer().at(desc_offset).offset;
@@ -147,32 +286,28 @@ bool ComponentSenderZeromq::try_send_timeslice(uint64_t ts) {
     sent_.data = data_offset + data_length;
   }
   auto data_msg = create_message(data_source_.data_buffer(), data_offset,
-                                 data_length, ts, true);
-  do {
-    rc = zmq_msg_send(&data_msg, socket_, 0);
-  } while (rc == -1 && errno == EAGAIN && *signal_status_ == 0);
-
-  return true;
+                                 data_length, sent, ts);
+  send_frame(&data_msg, 0);
 }
 
 template <typename T_>
 zmq_msg_t ComponentSenderZeromq::create_message(RingBufferView<T_>& buf,
                                                 uint64_t offset,
                                                 uint64_t length,
-                                                uint64_t ts,
-                                                bool is_data) {
+                                                SentTimeslice& sent,
+                                                uint64_t ts) {
   zmq_msg_t msg;
 
   if (length == 0) {
     // zero chunks
     zmq_msg_init_size(&msg, 0);
-    ack_timeslice(ts, is_data);
   } else if ((offset & buf.size_mask()) <=
              ((offset + length - 1) & buf.size_mask())) {
     // one chunk
     auto* data = &buf.at(offset);
     size_t bytes = sizeof(T_) * length;
-    auto* hint = new Acknowledgment{this, ts, is_data};
+    auto* hint = new Acknowledgment{this, ts};
+    ++sent.messages;
     zmq_msg_init_data(&msg, data, bytes, free_ts, hint);
   } else {
     // two chunks
@@ -184,25 +319,27 @@ zmq_msg_t ComponentSenderZeromq::create_message(RingBufferView<T_>& buf,
     auto msg_buf = static_cast<T_*>(zmq_msg_data(&msg));
     std::copy_n(data1, size1, msg_buf);
     std::copy_n(data2, size2, msg_buf + size1);
-    ack_timeslice(ts, is_data);
   }
 
   return msg;
 }
 
-void ComponentSenderZeromq::ack_timeslice(uint64_t ts, bool is_data) {
-  // use ts2 and acked_ts2_ to handle desc and data sequentially
-  uint64_t ts2 = ts * 2 + (is_data ? 1 : 0);
-  assert(ts2 >= acked_ts2_);
-  if (ts2 != acked_ts2_) {
-    // transmission has been reordered, store completion information
-    ack_.at(ts2) = ts2;
+void ComponentSenderZeromq::release_message(uint64_t ts) {
+  std::lock_guard<std::mutex> lock(released_mutex_);
+  released_messages_.push_back(ts);
+}
+
+void ComponentSenderZeromq::ack_timeslice(uint64_t ts) {
+  assert(ts >= acked_ts_);
+  if (ts != acked_ts_) {
+    // receipt has been reordered, store completion information
+    ack_.at(ts) = ts;
   } else {
     // completion is for earliest pending timeslice, update indices
     do {
-      ++acked_ts2_;
-    } while (ack_.at(acked_ts2_) > ts2);
-    acked_.desc = acked_ts2_ / 2 * timeslice_size_ + start_index_.desc;
+      ++acked_ts_;
+    } while (ack_.at(acked_ts_) > ts);
+    acked_.desc = acked_ts_ * timeslice_size_ + start_index_.desc;
     acked_.data = data_source_.desc_buffer().at(acked_.desc - 1).offset +
                   data_source_.desc_buffer().at(acked_.desc - 1).size;
     if (acked_.data >= cached_acked_.data + min_acked_.data ||
@@ -6,13 +6,29 @@
 #include "Scheduler.hpp"
 #include <boost/format.hpp>
 #include <cassert>
+#include <chrono>
 #include <csignal>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
 #include <zmq.h>
 
 /// Input buffer and compute node connection container class.
 /** An ComponentSenderZeromq object represents an input buffer (filled by a
     FLIB) and a group of timeslice building connections to compute
-    nodes. */
+    nodes.
+
+    Compute nodes connect to a ROUTER socket and may keep several timeslice
+    requests outstanding. A request for data that is not yet available is
+    held until the data arrives or the request times out, in which case an
+    empty reply is sent. Repeated requests for pending timeslices are
+    ignored.
+
+    The data of a sent timeslice is kept in the input buffer until the
+    compute node confirms its receipt (see tl_zeromq::TimesliceRequest). If
+    the compute node repeats the request before, the reply has been lost and
+    the timeslice is sent again. */
 
 class ComponentSenderZeromq {
 public:
@@ -24,7 +40,9 @@ public:
                         uint32_t overlap_size,
                         uint32_t max_timeslice_number,
                         volatile sig_atomic_t* signal_status,
-                        void* zmq_context);
+                        void* zmq_context,
+                        std::chrono::milliseconds request_timeout =
+                            std::chrono::milliseconds(1000));
 
   ComponentSenderZeromq(const ComponentSenderZeromq&) = delete;
   void operator=(const ComponentSenderZeromq&) = delete;
@@ -59,11 +77,51 @@ private:
   /// ZeroMQ socket.
   void* socket_;
 
+  /// Maximum time to hold a request for data that is not yet available.
+  const std::chrono::milliseconds request_timeout_;
+
+  /// A timeslice request received from a compute node.
+  struct Request {
+    /// ZeroMQ routing identity of the requesting compute node.
+    std::string identity;
+    /// Time to send an empty reply if the data is still not available.
+    std::chrono::steady_clock::time_point deadline;
+  };
+
+  /// Pending timeslice requests, ordered by timeslice index.
+  std::multimap<uint64_t, Request> pending_;
+
+  /// A timeslice sent to a compute node, not yet acknowledged.
+  struct SentTimeslice {
+    /// ZeroMQ routing identity of the receiving compute node.
+    std::string identity;
+    /// Number of zero-copy messages referring to the input buffer.
+    uint32_t messages = 0;
+    /// Whether the compute node has confirmed the receipt.
+    bool received = false;
+  };
+
+  /// Timeslices sent but not yet acknowledged, by timeslice index.
+  std::map<uint64_t, SentTimeslice> sent_timeslices_;
+
+  /// Timeslices of zero-copy messages released by ZeroMQ, possibly from
+  /// another thread.
+  std::vector<uint64_t> released_messages_;
+
+  /// Mutex protecting released_messages_.
+  std::mutex released_mutex_;
+
+  /// Number of repeated requests ignored (for statistics).
+  uint64_t requests_ignored_ = 0;
+
+  /// Number of timeslices sent again after a lost reply (for statistics).
+  uint64_t timeslices_resent_ = 0;
+
   /// Buffer to store acknowledged status of timeslices.
   RingBuffer<uint64_t, true> ack_;
 
-  /// Number of acknowledged timeslices (times two - desc and data).
-  uint64_t acked_ts2_ = 0;
+  /// Number of acknowledged timeslices.
+  uint64_t acked_ts_ = 0;
 
   /// Indexes of acknowledged microslices (i.e., read indexes).
   DualIndex acked_;
@@ -156,19 +214,49 @@ private:
   /// Cleanup at end of run.
   void run_end();
 
+  /// Receive all queued timeslice requests.
+  void receive_requests();
+
+  /// Handle the receipt confirmation of a compute node.
+  void confirm_timeslices(const std::string& identity, uint64_t received);
+
+  /// Handle the zero-copy messages released by ZeroMQ.
+  void handle_released_messages();
+
+  /// Acknowledge a sent timeslice once it is received and released.
+  void try_ack_timeslice(
+      std::map<uint64_t, SentTimeslice>::iterator timeslice);
+
+  /// Reply to pending requests for available or timed out timeslices.
+  void serve_requests();
+
+  /// Check if a timeslice is completely available in the input buffer.
+  bool timeslice_available(uint64_t timeslice);
+
   /// The central function for distributing timeslice data.
-  bool try_send_timeslice(uint64_t timeslice);
+  void send_timeslice(const std::string& identity, uint64_t timeslice);
+
+  /// Send a single message frame, retrying while the send buffer is full.
+  void send_frame(zmq_msg_t* msg, int flags);
+
+  /// Send the routing identity and timeslice header frames of a reply.
+  void send_reply_header(const std::string& identity,
+                         uint64_t timeslice,
+                         bool more);
 
   /// Create zeromq message part with requested data.
   template <typename T_>
   zmq_msg_t create_message(RingBufferView<T_>& buf,
                            uint64_t offset,
                            uint64_t length,
-                           uint64_t ts,
-                           bool is_data);
+                           SentTimeslice& sent,
+                           uint64_t ts);
+
+  /// Record the release of a zero-copy message (thread-safe).
+  void release_message(uint64_t ts);
 
-  /// Update read indexes after timeslice has been sent.
-  void ack_timeslice(uint64_t ts, bool is_data);
+  /// Update read indexes after timeslice has been received.
+  void ack_timeslice(uint64_t ts);
 
   /// Force writing read indexes to data source.
   void sync_data_source();
@@ -5,7 +5,10 @@
 #include "TimesliceCompletion.hpp"
 #include "TimesliceWorkItem.hpp"
 #include "Utility.hpp"
+#include "ZeromqProtocol.hpp"
 #include "log.hpp"
+#include <algorithm>
+#include <array>
 #include <chrono>
 #include <thread>
 
@@ -17,31 +20,37 @@ TimesliceBuilderZeromq::TimesliceBuilderZeromq(
     uint32_t timeslice_size,
     uint32_t max_timeslice_number,
     volatile sig_atomic_t* signal_status,
-    void* zmq_context)
+    void* zmq_context,
+    uint32_t request_window,
+    std::chrono::milliseconds request_timeout)
     : compute_index_(compute_index), timeslice_buffer_(timeslice_buffer),
       input_server_addresses_(input_server_addresses),
       num_compute_nodes_(num_compute_nodes), timeslice_size_(timeslice_size),
       max_timeslice_number_(max_timeslice_number),
       signal_status_(signal_status), ts_index_(compute_index_),
+      request_window_(std::max<uint64_t>(
+          std::min<uint64_t>(request_window,
+                             UINT64_C(1)
+                                 << timeslice_buffer_.get_desc_size_exp()),
+          1)),
+      request_timeout_(request_timeout),
       ack_(timeslice_buffer_.get_desc_size_exp()) {
   for (size_t i = 0; i < input_server_addresses_.size(); ++i) {
     auto input_server_address = input_server_addresses_.at(i);
 
     std::unique_ptr<Connection> c(new Connection{timeslice_buffer_, i});
 
-    c->socket = zmq_socket(zmq_context, ZMQ_REQ);
+    c->socket = zmq_socket(zmq_context, ZMQ_DEALER);
     assert(c->socket);
     int timeout_ms = 500;
     int rc =
-        zmq_setsockopt(c->socket, ZMQ_RCVTIMEO, &timeout_ms, sizeof timeout_ms);
-    assert(rc == 0);
-    rc =
         zmq_setsockopt(c->socket, ZMQ_SNDTIMEO, &timeout_ms, sizeof timeout_ms);
     assert(rc == 0);
 
     rc = zmq_connect(c->socket, input_server_address.c_str());
     assert(rc == 0);
 
+    poll_items_.push_back({c->socket, 0, ZMQ_POLLIN, 0});
     connections_.push_back(std::move(c));
   }
 }
@@ -71,83 +80,160 @@ void TimesliceBuilderZeromq::run_begin() {
 }
 
 bool TimesliceBuilderZeromq::run_cycle() {
-  auto& c = connections_.at(conn_);
-
-  std::size_t msg_size;
+  send_requests();
 
-  // send request for timeslice data
-  int rc;
-  do {
-    rc = zmq_send(c->socket, &ts_index_, sizeof(ts_index_), 0);
-  } while (rc == -1 && errno == EAGAIN && *signal_status_ == 0);
-  if (*signal_status_ != 0) {
-    return true;
+  // poll frequently while received components wait for buffer space
+  long timeout_ms = 100;
+  for (auto& c : connections_) {
+    if (!c->received.empty() &&
+        c->received.begin()->first == timeslice_index(c->desc.write_index())) {
+      timeout_ms = 1;
+    }
   }
-
-  // receive desc answer (part 1), do not release
-  rc = zmq_msg_init(&c->desc_msg);
-  assert(rc == 0);
-  do {
-    rc = zmq_msg_recv(&c->desc_msg, c->socket, 0);
-  } while (rc == -1 && errno == EAGAIN && *signal_status_ == 0);
+  int rc = zmq_poll(poll_items_.data(), static_cast<int>(poll_items_.size()),
+                    timeout_ms);
+  assert(rc != -1 || errno == EINTR);
   if (*signal_status_ != 0) {
     return true;
   }
-  assert(rc != -1);
-  msg_size = zmq_msg_size(&c->desc_msg);
-  if (msg_size == 0) {
-    zmq_msg_close(&c->desc_msg);
-    std::this_thread::sleep_for(std::chrono::milliseconds(10));
-  }
 
-  if (msg_size == 0 || *signal_status_ != 0) {
-    return true;
+  handle_timeslice_completions();
+  for (size_t i = 0; i < connections_.size(); ++i) {
+    if (rc > 0 && (poll_items_[i].revents & ZMQ_POLLIN) != 0) {
+      receive_replies(*connections_[i]);
+    }
+    repeat_requests(*connections_[i]);
+    store_components(*connections_[i]);
   }
+  complete_timeslices();
 
-  // receive data answer (part 2), do not release
-  assert(zmq_msg_more(&c->desc_msg));
-  rc = zmq_msg_init(&c->data_msg);
-  assert(rc == 0);
+  return true;
+}
+
+void TimesliceBuilderZeromq::send_request(Connection& c, uint64_t timeslice) {
+  tl_zeromq::TimesliceRequest request{timeslice,
+                                      timeslice_index(c.desc.write_index())};
+  int rc;
   do {
-    rc = zmq_msg_recv(&c->data_msg, c->socket, 0);
+    rc = zmq_send(c.socket, &request, sizeof(request), 0);
   } while (rc == -1 && errno == EAGAIN && *signal_status_ == 0);
-  if (*signal_status_ != 0) {
-    return true;
+  if (timeslice != tl_zeromq::no_timeslice) {
+    c.outstanding[timeslice] =
+        std::chrono::steady_clock::now() + request_timeout_;
   }
-  assert(rc != -1);
+}
 
-  uint64_t size_required =
-      zmq_msg_size(&c->desc_msg) + zmq_msg_size(&c->data_msg);
+void TimesliceBuilderZeromq::send_requests() {
+  while (requested_ < tpos_ + request_window_ &&
+         timeslice_index(requested_) < max_timeslice_number_) {
+    for (auto& c : connections_) {
+      send_request(*c, timeslice_index(requested_));
+    }
+    ++requested_;
+  }
+}
 
-  while (c->data.size_available_contiguous() < size_required ||
-         c->desc.size_available() < 1) {
-    std::this_thread::sleep_for(std::chrono::milliseconds(10));
-    handle_timeslice_completions();
+void TimesliceBuilderZeromq::repeat_requests(Connection& c) {
+  auto now = std::chrono::steady_clock::now();
+  for (auto& request : c.outstanding) {
+    if (request.second <= now) {
+      L_(debug) << "[c" << compute_index_ << "] no reply for timeslice "
+                << request.first << ", repeating request";
+      ++requests_repeated_;
+      send_request(c, request.first);
+    }
   }
+}
 
-  // skip remaining bytes in data buffer to avoid fractured entry
-  c->data.skip_buffer_wrap(size_required);
+void TimesliceBuilderZeromq::receive_replies(Connection& c) {
+  while (true) {
+    // reply header: timeslice index
+    zmq_msg_t header_msg;
+    int rc = zmq_msg_init(&header_msg);
+    assert(rc == 0);
+    if (zmq_msg_recv(&header_msg, c.socket, ZMQ_DONTWAIT) == -1) {
+      zmq_msg_close(&header_msg);
+      return;
+    }
+    assert(zmq_msg_size(&header_msg) == sizeof(uint64_t));
+    uint64_t timeslice;
+    std::copy_n(static_cast<uint8_t*>(zmq_msg_data(&header_msg)),
+                sizeof(timeslice), reinterpret_cast<uint8_t*>(&timeslice));
+    bool more = zmq_msg_more(&header_msg) != 0;
+    zmq_msg_close(&header_msg);
+
+    if (!more) {
+      // request timed out on the input server, repeat it unless a reply to
+      // a repeated request has arrived in the meantime
+      if (c.outstanding.count(timeslice) != 0) {
+        send_request(c, timeslice);
+      }
+      continue;
+    }
 
-  // generate timeslice component descriptor
-  assert(tpos_ == c->desc.write_index());
-  c->desc.append(
-      {ts_index_, c->data.write_index(), size_required,
-       zmq_msg_size(&c->desc_msg) / sizeof(fles::MicrosliceDescriptor)});
+    // receive desc (part 1) and data (part 2), do not release
+    std::unique_ptr<Component> component(new Component);
+    rc = zmq_msg_recv(&component->desc_msg, c.socket, 0);
+    assert(rc != -1);
+    assert(zmq_msg_more(&component->desc_msg));
+    rc = zmq_msg_recv(&component->data_msg, c.socket, 0);
+    assert(rc != -1);
+
+    if (timeslice < timeslice_index(c.desc.write_index()) ||
+        c.received.count(timeslice) != 0) {
+      // reply to a repeated request, the component has already arrived
+      ++replies_discarded_;
+      continue;
+    }
+    c.outstanding.erase(timeslice);
+    c.received[timeslice] = std::move(component);
+  }
+}
 
-  // copy into shared memory and release messages
-  c->data.append(static_cast<uint8_t*>(zmq_msg_data(&c->desc_msg)),
-                 zmq_msg_size(&c->desc_msg));
-  c->data.append(static_cast<uint8_t*>(zmq_msg_data(&c->data_msg)),
-                 zmq_msg_size(&c->data_msg));
-  zmq_msg_close(&c->desc_msg);
-  zmq_msg_close(&c->data_msg);
+void TimesliceBuilderZeromq::store_components(Connection& c) {
+  uint64_t stored = c.desc.write_index();
+  while (!c.received.empty() &&
+         c.received.begin()->first == timeslice_index(c.desc.write_index())) {
+    Component& component = *c.received.begin()->second;
+    uint64_t size_required =
+        zmq_msg_size(&component.desc_msg) + zmq_msg_size(&component.data_msg);
+
+    if (c.data.size_available_contiguous() < size_required ||
+        c.desc.size_available() < 1) {
+      // retry after timeslice completions
+      break;
+    }
 
-  ++conn_;
-  if (conn_ == connections_.size()) {
-    conn_ = 0;
+    // skip remaining bytes in data buffer to avoid fractured entry
+    c.data.skip_buffer_wrap(size_required);
+
+    // generate timeslice component descriptor
+    c.desc.append({c.received.begin()->first, c.data.write_index(),
+                   size_required,
+                   zmq_msg_size(&component.desc_msg) /
+                       sizeof(fles::MicrosliceDescriptor)});
+
+    // copy into shared memory and release messages
+    c.data.append(static_cast<uint8_t*>(zmq_msg_data(&component.desc_msg)),
+                  zmq_msg_size(&component.desc_msg));
+    c.data.append(static_cast<uint8_t*>(zmq_msg_data(&component.data_msg)),
+                  zmq_msg_size(&component.data_msg));
+    c.received.erase(c.received.begin());
+  }
 
-    handle_timeslice_completions();
+  // confirm the receipt, the input server keeps the data until then
+  if (c.desc.write_index() != stored) {
+    send_request(c, tl_zeromq::no_timeslice);
+  }
+}
 
+void TimesliceBuilderZeromq::complete_timeslices() {
+  uint64_t stored = UINT64_MAX;
+  for (auto& c : connections_) {
+    stored = std::min<uint64_t>(stored, c->desc.write_index());
+  }
+
+  while (tpos_ < stored) {
     timeslice_buffer_.send_work_item(
         {{ts_index_, tpos_, timeslice_size_,
           static_cast<uint32_t>(connections_.size())},
@@ -157,13 +243,17 @@ bool TimesliceBuilderZeromq::run_cycle() {
     // next timeslice: round robin
     ts_index_ += num_compute_nodes_;
   }
-
-  return true;
 }
 
 void TimesliceBuilderZeromq::run_end() {
   time_end_ = std::chrono::high_resolution_clock::now();
 
+  if (requests_repeated_ > 0) {
+    L_(info) << "[c" << compute_index_ << "] " << requests_repeated_
+             << " requests repeated after timeout, " << replies_discarded_
+             << " duplicate replies discarded";
+  }
+
   // wait until all pending timeslices have been acknowledged
   while (acked_ < tpos_) {
     std::this_thread::sleep_for(std::chrono::milliseconds(10));
@@ -176,19 +266,28 @@ void TimesliceBuilderZeromq::run_end() {
 }
 
 void TimesliceBuilderZeromq::handle_timeslice_completions() {
-  fles::TimesliceCompletion c;
-  while (timeslice_buffer_.try_receive_completion(c)) {
-    if (c.ts_pos == acked_) {
-      do
-        ++acked_;
-      while (ack_.at(acked_) > c.ts_pos);
-      for (auto& conn : connections_) {
-        conn->desc.set_read_index(acked_);
-        conn->data.set_read_index(conn->desc.at(acked_ - 1).offset +
-                                  conn->desc.at(acked_ - 1).size);
-      }
-    } else
-      ack_.at(c.ts_pos) = c.ts_pos;
+  std::array<fles::TimesliceCompletion, 64> completions;
+  uint64_t acked = acked_;
+  std::size_t count;
+  while ((count = timeslice_buffer_.try_receive_completions(
+              completions.data(), completions.size())) > 0) {
+    for (std::size_t i = 0; i < count; ++i) {
+      const fles::TimesliceCompletion& c = completions[i];
+      if (c.ts_pos == acked_) {
+        do
+          ++acked_;
+        while (ack_.at(acked_) > c.ts_pos);
+      } else
+        ack_.at(c.ts_pos) = c.ts_pos;
+    }
+  }
+  if (acked_ != acked) {
+    timeslice_buffer_.set_acked(acked_);
+    for (auto& conn : connections_) {
+      conn->desc.set_read_index(acked_);
+      conn->data.set_read_index(conn->desc.at(acked_ - 1).offset +
+                                conn->desc.at(acked_ - 1).size);
+    }
   }
 }
 
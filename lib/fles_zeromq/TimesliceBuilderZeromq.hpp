@@ -7,7 +7,10 @@
 #include "TimesliceBuffer.hpp"
 #include <boost/format.hpp>
 #include <cassert>
+#include <chrono>
 #include <csignal>
+#include <map>
+#include <memory>
 #include <vector>
 #include <zmq.h>
 
@@ -15,7 +18,18 @@
 /** A TimesliceBuilderZeromq object initiates connections to input nodes
  * and
  * receives
- * timeslices to a timeslice buffer. */
+ * timeslices to a timeslice buffer.
+ *
+ * Up to a given number of timeslice requests are kept outstanding with all
+ * input nodes, and replies are received from all input nodes concurrently.
+ * Requests that remain unanswered for a given timeout are repeated, so that
+ * lost requests or replies do not stall the run. The receipt of stored
+ * components is confirmed to the input nodes, which keep the data until
+ * then and serve a repeated request again (see tl_zeromq::TimesliceRequest).
+ *
+ * Timeslices are assigned round robin. The compute nodes pull timeslices
+ * by index and have no channel to learn each other's load, so the
+ * load-aware TimesliceSchedule is not used here. */
 
 class TimesliceBuilderZeromq {
 public:
@@ -27,7 +41,10 @@ public:
                          uint32_t timeslice_size,
                          uint32_t max_timeslice_number,
                          volatile sig_atomic_t* signal_status,
-                         void* zmq_context);
+                         void* zmq_context,
+                         uint32_t request_window = 8,
+                         std::chrono::milliseconds request_timeout =
+                             std::chrono::milliseconds(5000));
 
   TimesliceBuilderZeromq(const TimesliceBuilderZeromq&) = delete;
   void operator=(const TimesliceBuilderZeromq&) = delete;
@@ -69,12 +86,41 @@ private:
   /// The local buffer position of the timeslice currently being received.
   uint64_t tpos_ = 0;
 
-  /// The index of the connection to receive from next.
-  uint64_t conn_ = 0;
+  /// Maximum number of outstanding timeslice requests per input.
+  const uint64_t request_window_;
+
+  /// The local buffer position of the next timeslice to request.
+  uint64_t requested_ = 0;
+
+  /// Time after which an unanswered request is repeated.
+  const std::chrono::milliseconds request_timeout_;
+
+  /// Number of requests repeated after a timeout (for statistics).
+  uint64_t requests_repeated_ = 0;
+
+  /// Number of duplicate replies discarded (for statistics).
+  uint64_t replies_discarded_ = 0;
 
   /// Buffer to store acknowledged status of timeslices.
   RingBuffer<uint64_t, true> ack_;
 
+  /// A received timeslice component, not yet stored in the buffer.
+  struct Component {
+    Component() {
+      zmq_msg_init(&desc_msg);
+      zmq_msg_init(&data_msg);
+    }
+    ~Component() {
+      zmq_msg_close(&desc_msg);
+      zmq_msg_close(&data_msg);
+    }
+    Component(const Component&) = delete;
+    void operator=(const Component&) = delete;
+
+    zmq_msg_t desc_msg;
+    zmq_msg_t data_msg;
+  };
+
   /// Connection struct, handles data for one input server.
   struct Connection {
     Connection(TimesliceBuffer& timeslice_buffer, size_t i)
@@ -87,13 +133,20 @@ private:
     ManagedRingBuffer<uint8_t> data;
 
     void* socket;
-    zmq_msg_t desc_msg;
-    zmq_msg_t data_msg;
+
+    /// Deadlines of outstanding requests by global timeslice index.
+    std::map<uint64_t, std::chrono::steady_clock::time_point> outstanding;
+
+    /// Received components by global timeslice index.
+    std::map<uint64_t, std::unique_ptr<Component>> received;
   };
 
   /// The vector of connections, one per input server.
   std::vector<std::unique_ptr<Connection>> connections_;
 
+  /// Poll items for the sockets of all connections.
+  std::vector<zmq_pollitem_t> poll_items_;
+
   /// Begin of operation (for performance statistics).
   std::chrono::high_resolution_clock::time_point time_begin_;
 
@@ -151,6 +204,31 @@ private:
   /// Cleanup at end of run.
   void run_end();
 
+  /// Retrieve the global index of the timeslice at a local buffer position.
+  uint64_t timeslice_index(uint64_t tpos) const {
+    return compute_index_ + tpos * num_compute_nodes_;
+  }
+
+  /// Send a timeslice request to an input server, confirming the receipt of
+  /// the stored components.
+  void send_request(Connection& c, uint64_t timeslice);
+
+  /// Keep the configured number of requests outstanding.
+  void send_requests();
+
+  /// Repeat the requests that have not been answered in time.
+  void repeat_requests(Connection& c);
+
+  /// Receive all queued replies from an input server.
+  void receive_replies(Connection& c);
+
+  /// Copy received components to the buffer in timeslice order and confirm
+  /// their receipt.
+  void store_components(Connection& c);
+
+  /// Hand over timeslices received from all input servers.
+  void complete_timeslices();
+
   /// Handle pending timeslice completions and advance read indexes.
   void handle_timeslice_completions();
 
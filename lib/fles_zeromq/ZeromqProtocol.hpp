@@ -0,0 +1,33 @@
+// Copyright 2026 agent <agent@local>
+#pragma once
+
+#include <cstdint>
+
+/// Messages of the ZeroMQ timeslice building protocol.
+/** A compute node sends TimesliceRequest messages on a DEALER socket to the
+    ROUTER socket of each input. Each request carries the global index of the
+    first timeslice assigned to the compute node that it has not yet stored,
+    which confirms the receipt of all earlier ones. A request for
+    no_timeslice only confirms. An input keeps the data of a sent timeslice
+    until its receipt is confirmed, so that a lost reply can be served again.
+
+    A reply starts with a frame carrying the timeslice index, followed by the
+    microslice descriptors and the microslice data. A reply consisting of the
+    index frame only signals a request that timed out on the input. */
+
+namespace tl_zeromq {
+
+#pragma pack(1)
+
+/// Structure representing a timeslice request sent from compute node to input.
+struct TimesliceRequest {
+  uint64_t timeslice; ///< The requested timeslice (global index).
+  uint64_t received;  ///< The first timeslice not yet stored (global index).
+};
+
+#pragma pack()
+
+/// The requested timeslice of a message that only confirms receipt.
+constexpr uint64_t no_timeslice = UINT64_MAX;
+
+} // namespace tl_zeromq
@@ -0,0 +1,58 @@
+// Copyright 2026 agent <agent@local>
+/// \file
+/// \brief Defines the TimesliceFixture test fixture.
+#pragma once
+
+#include "MicrosliceDescriptor.hpp"
+#include "StorableTimeslice.hpp"
+#include <array>
+#include <cstdint>
+
+/// Test fixture providing a timeslice of two components with three
+/// microslices in total.
+struct TimesliceFixture {
+  TimesliceFixture() {
+    // initialize microslice descriptors (for individual meaning cf.
+    // MicrosliceDescriptor.hpp)
+    fles::MicrosliceDescriptor desc = fles::MicrosliceDescriptor();
+    desc.hdr_id = static_cast<uint8_t>(fles::HeaderFormatIdentifier::Standard);
+    desc.hdr_ver = static_cast<uint8_t>(fles::HeaderFormatVersion::Standard);
+    desc.sys_id = static_cast<uint8_t>(fles::SubsystemIdentifier::FLES);
+    desc.sys_ver =
+        static_cast<uint8_t>(fles::SubsystemFormatFLES::Uninitialized);
+
+    desc_a = desc;
+    desc_a.eq_id = 10;
+    desc_a.idx = 1;
+    desc_a.size = static_cast<uint32_t>(data_a.size());
+
+    desc_b = desc;
+    desc_b.eq_id = 10;
+    desc_b.idx = 2;
+    desc_b.size = static_cast<uint32_t>(data_b.size());
+
+    desc_c = desc;
+    desc_c.eq_id = 11;
+    desc_c.idx = 1;
+    desc_c.size = static_cast<uint32_t>(data_c.size());
+
+    // first component: 2 microslices (a, b)
+    ts0.append_component(2, 1);
+    ts0.append_microslice(0, 0, desc_a, data_a.data());
+    ts0.append_microslice(0, 1, desc_b, data_b.data());
+
+    // second component: 1 microslice (c)
+    ts0.append_component(1, 1);
+    ts0.append_microslice(1, 0, desc_c, data_c.data());
+  }
+
+  std::array<uint8_t, 4> data_a{{7, 13, 12, 8}};
+  std::array<uint8_t, 1> data_b{{11}};
+  std::array<uint8_t, 3> data_c{{3, 4, 5}};
+
+  fles::MicrosliceDescriptor desc_a = fles::MicrosliceDescriptor();
+  fles::MicrosliceDescriptor desc_b = fles::MicrosliceDescriptor();
+  fles::MicrosliceDescriptor desc_c = fles::MicrosliceDescriptor();
+
+  fles::StorableTimeslice ts0{1, 1};
+};
@@ -0,0 +1,27 @@
+// Copyright 2026 agent <agent@local>
+#define BOOST_TEST_MODULE test_ComponentSelection
+#include <boost/test/unit_test.hpp>
+
+#include "ComponentSelection.hpp"
+#include "MicrosliceDescriptor.hpp"
+#include <stdexcept>
+
+BOOST_AUTO_TEST_CASE(component_selection_test) {
+  fles::ComponentSelection selection(" 40:e001, 10 ,10");
+  BOOST_CHECK(!selection.all());
+  BOOST_CHECK_EQUAL(selection.to_string(), "10,40:e001");
+  BOOST_CHECK(fles::ComponentSelection("").all());
+  BOOST_CHECK(!fles::ComponentSelection().predicate());
+  BOOST_CHECK_THROW(fles::ComponentSelection("1g"), std::invalid_argument);
+  BOOST_CHECK_THROW(fles::ComponentSelection("10:10000"),
+                    std::invalid_argument);
+
+  fles::MicrosliceDescriptor desc = fles::MicrosliceDescriptor();
+  desc.sys_id = 0x40;
+  desc.eq_id = 0xe001;
+  BOOST_CHECK(selection(desc));
+  desc.eq_id = 0xe002;
+  BOOST_CHECK(!selection(desc));
+  desc.sys_id = 0x10;
+  BOOST_CHECK(selection(desc));
+}
@@ -0,0 +1,56 @@
+// Copyright 2026 agent <agent@local>
+#define BOOST_TEST_MODULE test_DeferredEvents
+#include <boost/test/unit_test.hpp>
+
+#include "DeferredEvents.hpp"
+#include <vector>
+
+BOOST_AUTO_TEST_CASE(pass_through_test) {
+  DeferredEvents<int> events(2);
+  BOOST_CHECK(!events.held(0));
+  BOOST_CHECK(!events.defer(0, 1));
+  BOOST_CHECK(events.release(0).empty());
+}
+
+BOOST_AUTO_TEST_CASE(hold_release_test) {
+  DeferredEvents<int> events(3);
+  events.hold(1);
+  BOOST_CHECK(events.held(1));
+  BOOST_CHECK(!events.defer(0, 10));
+  BOOST_CHECK(events.defer(1, 11));
+  BOOST_CHECK(events.defer(1, 12));
+  BOOST_CHECK(!events.defer(2, 20));
+
+  // deferred events are returned in order of arrival
+  std::vector<int> released = events.release(1);
+  BOOST_REQUIRE_EQUAL(released.size(), 2);
+  BOOST_CHECK_EQUAL(released[0], 11);
+  BOOST_CHECK_EQUAL(released[1], 12);
+
+  // afterwards, events are handled right away
+  BOOST_CHECK(!events.held(1));
+  BOOST_CHECK(!events.defer(1, 13));
+  BOOST_CHECK(events.release(1).empty());
+}
+
+BOOST_AUTO_TEST_CASE(shard_lifecycle_test) {
+  // the events of a connection are held while the thread of its shard runs
+  constexpr std::size_t num_shards = 2;
+  DeferredEvents<int> events(num_shards);
+  for (std::size_t s = 1; s < num_shards; ++s) {
+    events.hold(s);
+  }
+  std::vector<int> handled;
+  for (int connection = 0; connection < 4; ++connection) {
+    if (!events.defer(connection % num_shards, connection)) {
+      handled.push_back(connection);
+    }
+  }
+  BOOST_CHECK((handled == std::vector<int>{0, 2}));
+
+  // the shard thread has stopped
+  for (int connection : events.release(1)) {
+    handled.push_back(connection);
+  }
+  BOOST_CHECK((handled == std::vector<int>{0, 2, 1, 3}));
+}
@@ -7,6 +7,7 @@
 #include "MicrosliceInputArchive.hpp"
 #include "MicrosliceOutputArchive.hpp"
 #include "Source.hpp"
+#include <chrono>
 #include <cstdint>
 #include <iostream>
 #include <limits>
@@ -38,6 +39,12 @@ private:
     }
     return new T(item);
   }
+
+  T* do_try_get() override { return do_get(); }
+
+  T* do_get_for(std::chrono::nanoseconds /* timeout */) override {
+    return do_get();
+  }
 };
 
 // example sink: item dumper
@@ -0,0 +1,60 @@
+// Copyright 2026 agent <agent@local>
+#define BOOST_TEST_MODULE test_InputArchivePrefetch
+#include <boost/test/unit_test.hpp>
+
+#include "StorableTimeslice.hpp"
+#include "System.hpp"
+#include "TimesliceFixture.hpp"
+#include "TimesliceInputArchive.hpp"
+#include "TimesliceOutputArchive.hpp"
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+BOOST_FIXTURE_TEST_CASE(archive_prefetch_test, TimesliceFixture) {
+  auto ts0_ptr = std::make_shared<const fles::StorableTimeslice>(ts0);
+
+  std::string filename("test_prefetch.tsa");
+  {
+    fles::TimesliceOutputArchive output(filename);
+    for (int i = 0; i < 10; ++i) {
+      output.put(ts0_ptr);
+    }
+  }
+  uint64_t count = 0;
+  fles::TimesliceInputArchivePrefetch source(filename, 3, 2);
+  while (auto timeslice = source.get()) {
+    BOOST_CHECK_EQUAL(timeslice->num_core_microslices(), 1);
+    BOOST_CHECK_EQUAL(*timeslice->content(0, 1), 11);
+    BOOST_CHECK_EQUAL(*timeslice->content(1, 0), 3);
+    ++count;
+  }
+  BOOST_CHECK_EQUAL(count, 30);
+  BOOST_CHECK(source.eos());
+  BOOST_CHECK_EQUAL(source.descriptor().username(),
+                    fles::system::current_username());
+}
+
+BOOST_FIXTURE_TEST_CASE(archive_prefetch_destruction_test, TimesliceFixture) {
+  auto ts0_ptr = std::make_shared<const fles::StorableTimeslice>(ts0);
+
+  std::string filename("test_prefetch.tsa");
+  {
+    fles::TimesliceOutputArchive output(filename);
+    for (int i = 0; i < 10; ++i) {
+      output.put(ts0_ptr);
+    }
+  }
+  // Destroy source while the reader thread is blocked on a full queue
+  fles::TimesliceInputArchivePrefetch source(filename, 1, 1, 1);
+  auto timeslice = source.get();
+  BOOST_CHECK(timeslice);
+}
+
+BOOST_AUTO_TEST_CASE(archive_prefetch_exception_test) {
+  BOOST_CHECK_THROW(fles::TimesliceInputArchivePrefetch source("missing.tsa"),
+                    std::ios_base::failure);
+  BOOST_CHECK_THROW(fles::TimesliceInputArchivePrefetch source("example1.msa"),
+                    std::runtime_error);
+}
@@ -0,0 +1,72 @@
+// Copyright 2026 agent <agent@local>
+#define BOOST_TEST_MODULE test_InputArchiveSequence
+#include <boost/test/unit_test.hpp>
+
+#include "StorableTimeslice.hpp"
+#include "TimesliceFixture.hpp"
+#include "TimesliceInputArchive.hpp"
+#include "TimesliceOutputArchive.hpp"
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+
+BOOST_FIXTURE_TEST_CASE(archive_sequence_test, TimesliceFixture) {
+  // write 10 timeslices with increasing index to 4 files
+  {
+    fles::TimesliceOutputArchiveSequence output("test_sequence_%n.tsa", 3);
+    for (uint64_t i = 0; i < 10; ++i) {
+      auto ts = std::make_shared<fles::StorableTimeslice>(1, i);
+      ts->append_component(1, 1);
+      ts->append_microslice(0, 0, desc_c, data_c.data());
+      output.put(ts);
+    }
+  }
+
+  // ordered merge, looping over the sequence twice
+  {
+    fles::TimesliceInputArchiveSequence source("test_sequence_%n.tsa", 2, 3);
+    BOOST_CHECK_EQUAL(source.filenames().size(), 4);
+    uint64_t count = 0;
+    while (auto timeslice = source.get()) {
+      BOOST_CHECK_EQUAL(timeslice->index(), count % 10);
+      BOOST_CHECK_EQUAL(*timeslice->content(0, 0), 3);
+      ++count;
+    }
+    BOOST_CHECK_EQUAL(count, 20);
+    BOOST_CHECK(source.eos());
+  }
+
+  // unordered, selected by wildcard pattern
+  {
+    fles::TimesliceInputArchiveSequence source("test_sequence_*.tsa", 1, 4,
+                                               false);
+    BOOST_CHECK_EQUAL(source.filenames().at(1), "test_sequence_0001.tsa");
+    uint64_t sum = 0;
+    uint64_t count = 0;
+    while (auto timeslice = source.get()) {
+      sum += timeslice->index();
+      ++count;
+    }
+    BOOST_CHECK_EQUAL(count, 10);
+    BOOST_CHECK_EQUAL(sum, 45);
+  }
+
+  // many cycles with a minimal read-ahead byte limit
+  {
+    fles::TimesliceInputArchiveSequence source("test_sequence_%n.tsa", 500,
+                                               3, true, 16, 1);
+    uint64_t count = 0;
+    while (auto timeslice = source.get()) {
+      BOOST_CHECK_EQUAL(timeslice->index(), count % 10);
+      ++count;
+    }
+    BOOST_CHECK_EQUAL(count, 5000);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(archive_sequence_exception_test) {
+  BOOST_CHECK_THROW(fles::TimesliceInputArchiveSequence source("missing_%n"),
+                    std::ios_base::failure);
+  BOOST_CHECK_THROW(fles::TimesliceInputArchiveSequence source("example1.msa"),
+                    std::runtime_error);
+}
@@ -0,0 +1,83 @@
+// Copyright 2026 agent <agent@local>
+#define BOOST_TEST_MODULE test_LoadShedding
+#include <boost/test/unit_test.hpp>
+
+#include "LoadShedding.hpp"
+#include <vector>
+
+BOOST_AUTO_TEST_CASE(disabled_test) {
+  LoadShedding shedding(64, 0, 0);
+  BOOST_CHECK(!shedding.enabled());
+  BOOST_CHECK(!shedding.update(100, 64, 64));
+  for (uint64_t ts = 0; ts < 100; ++ts) {
+    BOOST_CHECK(!shedding.shed(ts));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(adaptation_test) {
+  LoadShedding shedding(64, 0.75, 0.5);
+  BOOST_REQUIRE(shedding.enabled());
+
+  // held off at the start
+  BOOST_CHECK(!shedding.update(0, 64, 10));
+  // full buffer, but processors have taken all work items
+  BOOST_CHECK(!shedding.update(4, 64, 0));
+  BOOST_CHECK(shedding.update(4, 48, 10));
+  BOOST_CHECK_EQUAL(shedding.level(), 1);
+  // held off until a sixteenth of the buffer has been built
+  BOOST_CHECK(!shedding.update(7, 64, 10));
+  BOOST_CHECK(shedding.update(8, 64, 10));
+  BOOST_CHECK_EQUAL(shedding.level(), 2);
+  // between the watermarks
+  BOOST_CHECK(!shedding.update(12, 40, 10));
+  BOOST_CHECK(shedding.update(12, 32, 10));
+  BOOST_CHECK_EQUAL(shedding.level(), 1);
+  BOOST_CHECK(shedding.update(16, 0, 0));
+  BOOST_CHECK_EQUAL(shedding.level(), 0);
+  BOOST_CHECK(!shedding.update(20, 0, 0));
+}
+
+BOOST_AUTO_TEST_CASE(share_test) {
+  LoadShedding shedding(1024, 0.5, 0.25);
+  uint64_t position = 0;
+  for (uint32_t level = 1; level <= shedding.max_level(); ++level) {
+    position += 64;
+    BOOST_REQUIRE(shedding.update(position, 1024, 1));
+    BOOST_REQUIRE_EQUAL(shedding.level(), level);
+    uint64_t shed = 0;
+    for (uint64_t ts = 0; ts < 16000; ++ts) {
+      if (shedding.shed(ts)) {
+        ++shed;
+        // a higher level includes the timeslices of all lower levels
+        BOOST_CHECK_LT(LoadShedding::bucket(ts), level);
+      }
+    }
+    BOOST_CHECK_CLOSE(static_cast<double>(shed), 1000.0 * level, 10.0);
+  }
+  BOOST_CHECK(!shedding.update(position + 64, 1024, 1));
+}
+
+BOOST_AUTO_TEST_CASE(max_share_test) {
+  BOOST_CHECK_EQUAL(LoadShedding(1024, 0.5, 0.25).max_level(), 12);
+  BOOST_CHECK_EQUAL(LoadShedding(1024, 0.5, 0.25, 0.5).max_level(), 8);
+  // never shed every timeslice
+  LoadShedding shedding(1024, 0.5, 0.25, 1.0);
+  BOOST_CHECK_EQUAL(shedding.max_level(), LoadShedding::steps - 1);
+  for (uint64_t position = 64; position <= 64 * LoadShedding::steps;
+       position += 64) {
+    shedding.update(position, 1024, 1);
+  }
+  BOOST_CHECK_EQUAL(shedding.level(), LoadShedding::steps - 1);
+  BOOST_CHECK_LT(shedding.share(), 1.0);
+}
+
+BOOST_AUTO_TEST_CASE(deterministic_test) {
+  LoadShedding a(256, 0.5, 0.25);
+  LoadShedding b(4096, 0.9, 0.1);
+  a.update(16, 256, 1);
+  b.update(256, 4096, 1);
+  BOOST_REQUIRE_EQUAL(a.level(), b.level());
+  for (uint64_t ts = 0; ts < 1000; ++ts) {
+    BOOST_CHECK_EQUAL(a.shed(ts), b.shed(ts));
+  }
+}
@@ -34,3 +34,19 @@ BOOST_AUTO_TEST_CASE(usage_test) {
 
   BOOST_CHECK_EQUAL(count, 1000);
 }
+
+BOOST_AUTO_TEST_CASE(batch_test) {
+  std::unique_ptr<InputBufferReadInterface> data_source(
+      new FlesnetPatternGenerator(20, 7, 1, 10000));
+  fles::MicrosliceReceiver receiver(*data_source);
+
+  std::size_t count = 0;
+  while (count < 1000) {
+    auto batch = receiver.get_batch(64);
+    BOOST_REQUIRE(!batch.empty());
+    BOOST_CHECK_LE(batch.size(), 64);
+    count += batch.size();
+  }
+  BOOST_CHECK(receiver.get_for(std::chrono::milliseconds(100)));
+  BOOST_CHECK(!receiver.eos());
+}
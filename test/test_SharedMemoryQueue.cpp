@@ -0,0 +1,73 @@
+// Copyright 2026 agent <agent@local>
+#define BOOST_TEST_MODULE test_SharedMemoryQueue
+#include <boost/test/unit_test.hpp>
+
+#include "SharedMemoryQueue.hpp"
+#include "TimesliceCompletion.hpp"
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+BOOST_AUTO_TEST_CASE(shared_memory_queue_test) {
+  std::string name = "test_SharedMemoryQueue_" + std::to_string(::getpid());
+  using Queue = fles::SharedMemoryQueue<fles::TimesliceCompletion>;
+  Queue::remove(name);
+  Queue producer_queue(boost::interprocess::create_only, name, 5);
+  BOOST_CHECK_EQUAL(producer_queue.capacity(), 8);
+
+  // producers block on the full queue, consumers on the empty queue
+  constexpr uint64_t items_per_producer = 10000;
+  std::array<uint64_t, 2> sum{{0, 0}};
+  std::array<uint64_t, 2> count{{0, 0}};
+  std::vector<std::thread> consumers;
+  for (size_t i = 0; i < sum.size(); ++i) {
+    consumers.emplace_back([&, i] {
+      Queue queue(boost::interprocess::open_only, name);
+      fles::TimesliceCompletion c;
+      while (queue.pop(c)) {
+        sum[i] += c.ts_pos;
+        ++count[i];
+      }
+    });
+  }
+  std::vector<std::thread> producers;
+  for (uint64_t p = 0; p < 2; ++p) {
+    producers.emplace_back([&, p] {
+      Queue queue(boost::interprocess::open_only, name);
+      for (uint64_t i = 0; i < items_per_producer; ++i) {
+        queue.push({p * items_per_producer + i});
+      }
+    });
+  }
+  for (auto& producer : producers) {
+    producer.join();
+  }
+  producer_queue.close();
+  for (auto& consumer : consumers) {
+    consumer.join();
+  }
+  uint64_t n = 2 * items_per_producer;
+  BOOST_CHECK_EQUAL(count[0] + count[1], n);
+  BOOST_CHECK_EQUAL(sum[0] + sum[1], n * (n - 1) / 2);
+
+  // batch reception after end of stream
+  Queue queue(boost::interprocess::open_only, name);
+  BOOST_CHECK(queue.is_closed());
+  for (uint64_t i = 0; i < 3; ++i) {
+    BOOST_CHECK(queue.try_push({i}));
+  }
+  std::array<fles::TimesliceCompletion, 8> c;
+  BOOST_CHECK_EQUAL(queue.try_pop_batch(c.data(), c.size()), 3);
+  BOOST_CHECK_EQUAL(c[2].ts_pos, 2);
+  BOOST_CHECK(!queue.pop(c[0]));
+  Queue::remove(name);
+
+  Queue empty_queue(boost::interprocess::create_only, name, 4);
+  BOOST_CHECK(!empty_queue.pop_for(c[0], std::chrono::milliseconds(10)));
+  BOOST_CHECK(!empty_queue.is_closed());
+  Queue::remove(name);
+}
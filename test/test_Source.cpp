@@ -0,0 +1,60 @@
+// Copyright 2026 agent <agent@local>
+#define BOOST_TEST_MODULE test_Source
+#include <boost/test/unit_test.hpp>
+
+#include "StorableTimeslice.hpp"
+#include "TimesliceFixture.hpp"
+#include "TimesliceInputArchive.hpp"
+#include "TimesliceOutputArchive.hpp"
+#include "TimesliceSource.hpp"
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+BOOST_FIXTURE_TEST_CASE(archive_batch_test, TimesliceFixture) {
+  auto ts0_ptr = std::make_shared<const fles::StorableTimeslice>(ts0);
+
+  std::string filename("test_batch.tsa");
+  {
+    fles::TimesliceOutputArchive output(filename);
+    for (int i = 0; i < 10; ++i) {
+      output.put(ts0_ptr);
+    }
+  }
+
+  // default implementation
+  fles::TimesliceInputArchive source(filename);
+  BOOST_CHECK_EQUAL(source.get_batch(4).size(), 4);
+  BOOST_CHECK(source.try_get());
+  BOOST_CHECK(source.get_for(std::chrono::milliseconds(1)));
+  BOOST_CHECK_EQUAL(source.get_batch(10).size(), 4);
+  BOOST_CHECK(source.get_batch(10).empty());
+  BOOST_CHECK(source.eos());
+
+  // native implementations
+  fles::TimesliceInputArchivePrefetch prefetch(filename, 2, 4);
+  fles::TimesliceInputArchiveSequence sequence(filename, 2);
+  for (fles::TimesliceSource* s :
+       {static_cast<fles::TimesliceSource*>(&prefetch),
+        static_cast<fles::TimesliceSource*>(&sequence)}) {
+    uint64_t count = 0;
+    if (s->get_for(std::chrono::seconds(10))) {
+      ++count;
+    }
+    while (true) {
+      auto batch = s->get_batch(3);
+      if (batch.empty()) {
+        break;
+      }
+      BOOST_CHECK_LE(batch.size(), 3);
+      for (auto& timeslice : batch) {
+        BOOST_CHECK_EQUAL(*timeslice->content(1, 0), 3);
+      }
+      count += batch.size();
+    }
+    BOOST_CHECK_EQUAL(count, 20);
+    BOOST_CHECK(s->eos());
+    BOOST_CHECK(!s->try_get());
+  }
+}
@@ -0,0 +1,55 @@
+// Copyright 2026 agent <agent@local>
+#define BOOST_TEST_MODULE test_StaggeredOrder
+#include <boost/test/unit_test.hpp>
+
+#include "StaggeredOrder.hpp"
+#include <vector>
+
+BOOST_AUTO_TEST_CASE(natural_order_test) {
+  StaggeredOrder order(5, 1, 20);
+  for (uint64_t p = 0; p < 20; ++p) {
+    BOOST_CHECK_EQUAL(order.timeslice(p), p);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(rotation_test) {
+  StaggeredOrder order(1, 4, 8);
+  const uint64_t expected[] = {1, 2, 3, 0, 5, 6, 7, 4};
+  for (uint64_t p = 0; p < 8; ++p) {
+    BOOST_CHECK_EQUAL(order.timeslice(p), expected[p]);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(permutation_test) {
+  // incomplete last block
+  const uint64_t end = 23;
+  for (uint64_t input = 0; input < 6; ++input) {
+    StaggeredOrder order(input, 5, end);
+    std::vector<bool> seen(end, false);
+    for (uint64_t p = 0; p < end; ++p) {
+      uint64_t ts = order.timeslice(p);
+      BOOST_REQUIRE(ts < end);
+      BOOST_CHECK(!seen[ts]);
+      seen[ts] = true;
+      // timeslices never move to a different block
+      BOOST_CHECK_EQUAL(ts / 5, p / 5);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(stagger_test) {
+  // at each position, the inputs send to pairwise different compute nodes
+  const uint32_t compute_nodes = 4;
+  std::vector<StaggeredOrder> orders;
+  for (uint64_t input = 0; input < compute_nodes; ++input) {
+    orders.emplace_back(input, compute_nodes, 100);
+  }
+  for (uint64_t p = 0; p < 100; ++p) {
+    std::vector<bool> busy(compute_nodes, false);
+    for (auto& order : orders) {
+      uint64_t cn = order.timeslice(p) % compute_nodes;
+      BOOST_CHECK(!busy[cn]);
+      busy[cn] = true;
+    }
+  }
+}
@@ -0,0 +1,86 @@
+// Copyright 2026 agent <agent@local>
+#define BOOST_TEST_MODULE test_StorableTimesliceBuilder
+#include <boost/test/unit_test.hpp>
+
+#include "StorableTimeslice.hpp"
+#include "StorableTimesliceBuilder.hpp"
+#include "TimesliceFixture.hpp"
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
+#include <cstdint>
+#include <sstream>
+
+BOOST_FIXTURE_TEST_CASE(builder_test, TimesliceFixture) {
+  // small capacity hints to force growing and moving of components
+  fles::StorableTimesliceBuilder builder(1, 1, UINT64_MAX, 16);
+  BOOST_CHECK_EQUAL(builder.append_component(2, 1), 0);
+  BOOST_CHECK_EQUAL(builder.append_component(1), 1);
+  builder.append_microslice(1, 0, desc_c, data_c.data());
+  builder.append_microslice(0, 0, desc_a, data_a.data());
+  builder.append_microslice(0, 1, desc_b, data_b.data());
+  BOOST_CHECK_EQUAL(builder.size(), 3 * sizeof(fles::MicrosliceDescriptor) +
+                                        data_a.size() + data_b.size() +
+                                        data_c.size());
+  fles::StorableTimeslice ts1 = builder.finalize();
+  BOOST_CHECK_EQUAL(builder.num_components(), 0);
+
+  BOOST_CHECK_EQUAL(ts1.num_components(), 2);
+  BOOST_CHECK_EQUAL(*ts1.content(0, 1), 11);
+  BOOST_CHECK_EQUAL(*ts1.content(1, 0), 3);
+
+  // serialization has to be identical to conventionally built timeslice
+  std::stringstream s0;
+  std::stringstream s1;
+  {
+    boost::archive::binary_oarchive oa0(s0);
+    oa0 << ts0;
+    boost::archive::binary_oarchive oa1(s1);
+    oa1 << ts1;
+  }
+  BOOST_CHECK(s0.str() == s1.str());
+
+  // both kinds of storage can be mixed in an archive
+  std::stringstream s2;
+  {
+    boost::archive::binary_oarchive oa2(s2);
+    oa2 << ts1;
+    oa2 << ts0;
+    oa2 << ts1;
+  }
+  boost::archive::binary_iarchive ia(s2);
+  for (int i = 0; i < 3; ++i) {
+    fles::StorableTimeslice ts2{0};
+    ia >> ts2;
+    BOOST_CHECK_EQUAL(ts2.num_components(), 2);
+    BOOST_CHECK_EQUAL(*ts2.content(0, 1), 11);
+    BOOST_CHECK_EQUAL(*ts2.content(1, 0), 3);
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE(builder_modify_test, TimesliceFixture) {
+  fles::StorableTimesliceBuilder builder(1, 1);
+  builder.append_component(2);
+  builder.append_microslice(0, 0, desc_a, data_a.data());
+  builder.append_microslice(0, 1, desc_b, data_b.data());
+  fles::StorableTimeslice ts1 = builder.finalize();
+
+  // copies keep the contiguous storage
+  fles::StorableTimeslice ts2(ts1);
+  BOOST_CHECK_EQUAL(*ts2.content(0, 1), 11);
+
+  // appending moves the components to separate buffers
+  ts2.append_component(1);
+  ts2.append_microslice(1, 0, desc_c, data_c.data());
+
+  std::stringstream s0;
+  std::stringstream s2;
+  {
+    boost::archive::binary_oarchive oa0(s0);
+    oa0 << ts0;
+    boost::archive::binary_oarchive oa2(s2);
+    oa2 << ts2;
+  }
+  BOOST_CHECK(s0.str() == s2.str());
+  BOOST_CHECK_EQUAL(ts1.num_components(), 1);
+  BOOST_CHECK_EQUAL(*ts1.content(0, 1), 11);
+}
@@ -0,0 +1,155 @@
+// Copyright 2026 agent <agent@local>
+#define BOOST_TEST_MODULE test_TimesliceBuilderTcp
+#include <boost/test/unit_test.hpp>
+
+#include "ComponentSenderTcp.hpp"
+#include "FlesnetPatternGenerator.hpp"
+#include "PatternChecker.hpp"
+#include "TimesliceBuffer.hpp"
+#include "TimesliceBuilderTcp.hpp"
+#include "TimesliceReceiver.hpp"
+#include <csignal>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+
+constexpr uint32_t num_inputs = 2;
+constexpr uint32_t num_compute_nodes = 2;
+constexpr uint32_t timeslice_size = 10;
+constexpr uint32_t overlap_size = 1;
+
+/// Counts of timeslices received by a compute node.
+struct Result {
+  uint64_t count = 0;
+  uint64_t errors = 0;
+};
+
+/// Check descriptors and contents of a received timeslice.
+bool check_timeslice(const fles::Timeslice& ts,
+                     std::vector<std::unique_ptr<PatternChecker>>& checkers) {
+  if (ts.num_components() != num_inputs ||
+      ts.num_core_microslices() != timeslice_size) {
+    return false;
+  }
+  for (uint64_t c = 0; c < ts.num_components(); ++c) {
+    if (ts.num_microslices(c) != timeslice_size + overlap_size) {
+      return false;
+    }
+    if (checkers.size() <= c) {
+      const auto& desc = ts.descriptor(c, 0);
+      checkers.push_back(
+          PatternChecker::create(desc.sys_id, desc.sys_ver, c));
+    }
+    checkers[c]->reset();
+    for (uint64_t m = 0; m < ts.num_microslices(c); ++m) {
+      // the pattern generator numbers the microslices consecutively
+      if (ts.descriptor(c, m).idx != ts.index() * timeslice_size + m ||
+          !checkers[c]->check(ts.get_microslice(c, m))) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+/// Receive and check the timeslices of a compute node until end-of-stream.
+void receive(const std::string& shm_identifier, Result& result) {
+  fles::TimesliceReceiver receiver(shm_identifier);
+  std::vector<std::unique_ptr<PatternChecker>> checkers;
+  uint64_t last_index = 0;
+  while (auto ts = receiver.get()) {
+    bool in_order = result.count == 0 || ts->index() > last_index;
+    if (!in_order || !check_timeslice(*ts, checkers)) {
+      ++result.errors;
+    }
+    last_index = ts->index();
+    ++result.count;
+  }
+}
+
+/// Transfer timeslices from pattern generators to timeslice buffers via
+/// TCP connections on the loopback interface.
+void run_transfer(const std::string& name,
+                  unsigned short port_offset,
+                  uint32_t max_timeslice_number,
+                  uint32_t typical_content_size,
+                  bool zerocopy) {
+  volatile sig_atomic_t signal_status = 0;
+
+  unsigned short base_port = static_cast<unsigned short>(
+      30000 + ::getpid() % 10000 + port_offset);
+  std::string prefix = "test_TimesliceBuilderTcp_" + name + "_" +
+                       std::to_string(::getpid()) + "_";
+
+  std::vector<std::string> hostnames(num_compute_nodes, "127.0.0.1");
+  std::vector<std::string> services;
+  for (uint32_t c = 0; c < num_compute_nodes; ++c) {
+    services.push_back(std::to_string(base_port + c));
+  }
+
+  std::vector<std::unique_ptr<FlesnetPatternGenerator>> generators;
+  std::vector<std::unique_ptr<ComponentSenderTcp>> senders;
+  for (uint32_t i = 0; i < num_inputs; ++i) {
+    generators.emplace_back(new FlesnetPatternGenerator(
+        20, 10, i, typical_content_size, true, true));
+    senders.emplace_back(new ComponentSenderTcp(
+        i, *generators.back(), hostnames, services, timeslice_size,
+        overlap_size, max_timeslice_number, &signal_status, zerocopy));
+  }
+
+  // small buffers to wrap around several times
+  std::vector<std::unique_ptr<TimesliceBuffer>> buffers;
+  std::vector<std::unique_ptr<TimesliceBuilderTcp>> builders;
+  for (uint32_t c = 0; c < num_compute_nodes; ++c) {
+    buffers.emplace_back(
+        new TimesliceBuffer(prefix + std::to_string(c), 18, 4, num_inputs));
+    builders.emplace_back(new TimesliceBuilderTcp(
+        c, *buffers.back(), static_cast<unsigned short>(base_port + c),
+        num_inputs, num_compute_nodes, timeslice_size, &signal_status));
+  }
+
+  std::vector<Result> results(num_compute_nodes);
+  std::vector<std::thread> threads;
+  for (uint32_t c = 0; c < num_compute_nodes; ++c) {
+    threads.emplace_back(receive, prefix + std::to_string(c),
+                         std::ref(results[c]));
+  }
+  for (auto& builder : builders) {
+    threads.emplace_back(std::ref(*builder));
+  }
+  for (auto& sender : senders) {
+    threads.emplace_back(std::ref(*sender));
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  uint64_t total = 0;
+  for (const auto& result : results) {
+    BOOST_CHECK_EQUAL(result.errors, 0);
+    total += result.count;
+  }
+  BOOST_CHECK_EQUAL(total, max_timeslice_number);
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(copy_test) {
+  run_transfer("copy", 0, 200, 1024, false);
+}
+
+BOOST_AUTO_TEST_CASE(zerocopy_test) {
+  // components exceed the zero-copy threshold; on loopback the kernel
+  // reports the data as copied, and the sender falls back to plain sends
+  run_transfer("zerocopy", 2, 200, 4096, true);
+}
+
+BOOST_AUTO_TEST_CASE(small_component_test) {
+  // many small components to wrap the descriptor buffers
+  run_transfer("small", 4, 1000, 64, true);
+}
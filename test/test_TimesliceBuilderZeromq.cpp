@@ -0,0 +1,207 @@
+// Copyright 2026 agent <agent@local>
+#define BOOST_TEST_MODULE test_TimesliceBuilderZeromq
+#include <boost/test/unit_test.hpp>
+
+#include "ComponentSenderZeromq.hpp"
+#include "FlesnetPatternGenerator.hpp"
+#include "PatternChecker.hpp"
+#include "TimesliceBuffer.hpp"
+#include "TimesliceBuilderZeromq.hpp"
+#include "TimesliceReceiver.hpp"
+#include "ZeromqProtocol.hpp"
+#include <algorithm>
+#include <chrono>
+#include <csignal>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+#include <zmq.h>
+
+namespace {
+
+constexpr uint32_t num_inputs = 2;
+constexpr uint32_t num_compute_nodes = 2;
+constexpr uint32_t timeslice_size = 10;
+constexpr uint32_t overlap_size = 1;
+
+/// Counts of timeslices received by a compute node.
+struct Result {
+  uint64_t count = 0;
+  uint64_t errors = 0;
+};
+
+/// Receive and check the timeslices of a compute node until end-of-stream.
+void receive(const std::string& shm_identifier,
+             uint64_t compute_index,
+             Result& result) {
+  fles::TimesliceReceiver receiver(shm_identifier);
+  std::vector<std::unique_ptr<PatternChecker>> checkers;
+  while (auto ts = receiver.get()) {
+    bool ok = ts->index() == compute_index + result.count * num_compute_nodes &&
+              ts->num_components() == num_inputs;
+    for (uint64_t c = 0; ok && c < ts->num_components(); ++c) {
+      ok = ts->num_microslices(c) == timeslice_size + overlap_size &&
+           ts->get_microslice(c, 0).desc().idx ==
+               ts->get_microslice(0, 0).desc().idx;
+      if (checkers.size() <= c) {
+        const auto& desc = ts->get_microslice(c, 0).desc();
+        checkers.push_back(
+            PatternChecker::create(desc.sys_id, desc.sys_ver, c));
+      }
+      checkers[c]->reset();
+      for (uint64_t m = 0; ok && m < ts->num_microslices(c); ++m) {
+        ok = checkers[c]->check(ts->get_microslice(c, m));
+      }
+    }
+    ++result.count;
+    if (!ok) {
+      ++result.errors;
+    }
+  }
+}
+
+/// A reply received from an input, frames after the timeslice index.
+struct Reply {
+  uint64_t timeslice = 0;
+  std::vector<std::string> frames;
+};
+
+/// Send a request to an input.
+void send_request(void* socket, uint64_t timeslice, uint64_t received) {
+  tl_zeromq::TimesliceRequest request{timeslice, received};
+  int rc = zmq_send(socket, &request, sizeof(request), 0);
+  BOOST_REQUIRE_EQUAL(rc, static_cast<int>(sizeof(request)));
+}
+
+/// Receive a reply from an input.
+Reply receive_reply(void* socket) {
+  Reply reply;
+  zmq_msg_t msg;
+  zmq_msg_init(&msg);
+  int rc = zmq_msg_recv(&msg, socket, 0);
+  BOOST_REQUIRE_EQUAL(rc, static_cast<int>(sizeof(reply.timeslice)));
+  std::copy_n(static_cast<uint8_t*>(zmq_msg_data(&msg)),
+              sizeof(reply.timeslice),
+              reinterpret_cast<uint8_t*>(&reply.timeslice));
+  while (zmq_msg_more(&msg) != 0) {
+    zmq_msg_recv(&msg, socket, 0);
+    reply.frames.emplace_back(static_cast<char*>(zmq_msg_data(&msg)),
+                              zmq_msg_size(&msg));
+  }
+  zmq_msg_close(&msg);
+  return reply;
+}
+
+/// Transfer timeslices from pattern generators to timeslice buffers.
+void run_transfer(const std::string& name,
+                  uint32_t max_timeslice_number,
+                  uint32_t request_window,
+                  std::chrono::milliseconds request_timeout) {
+  volatile sig_atomic_t signal_status = 0;
+  std::unique_ptr<void, std::function<int(void*)>> context(zmq_ctx_new(),
+                                                          zmq_ctx_destroy);
+
+  std::string prefix = "test_TimesliceBuilderZeromq_" + name + "_" +
+                       std::to_string(::getpid()) + "_";
+  std::vector<std::string> addresses;
+  std::vector<std::unique_ptr<FlesnetPatternGenerator>> generators;
+  std::vector<std::unique_ptr<ComponentSenderZeromq>> senders;
+  for (uint32_t i = 0; i < num_inputs; ++i) {
+    addresses.push_back("inproc://" + prefix + std::to_string(i));
+    generators.emplace_back(
+        new FlesnetPatternGenerator(16, 8, i, 256, true, true));
+    senders.emplace_back(new ComponentSenderZeromq(
+        i, *generators.back(), addresses.back(), timeslice_size, overlap_size,
+        max_timeslice_number, &signal_status, context.get()));
+  }
+
+  // small buffers to wrap around several times
+  std::vector<std::unique_ptr<TimesliceBuffer>> buffers;
+  std::vector<std::unique_ptr<TimesliceBuilderZeromq>> builders;
+  for (uint32_t c = 0; c < num_compute_nodes; ++c) {
+    buffers.emplace_back(
+        new TimesliceBuffer(prefix + std::to_string(c), 14, 4, num_inputs));
+    builders.emplace_back(new TimesliceBuilderZeromq(
+        c, *buffers.back(), addresses, num_compute_nodes, timeslice_size,
+        max_timeslice_number, &signal_status, context.get(), request_window,
+        request_timeout));
+  }
+
+  std::vector<Result> results(num_compute_nodes);
+  std::vector<std::thread> threads;
+  for (uint32_t c = 0; c < num_compute_nodes; ++c) {
+    threads.emplace_back(receive, prefix + std::to_string(c), c,
+                         std::ref(results[c]));
+  }
+  for (auto& sender : senders) {
+    threads.emplace_back(std::ref(*sender));
+  }
+  for (auto& builder : builders) {
+    threads.emplace_back(std::ref(*builder));
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  for (uint32_t c = 0; c < num_compute_nodes; ++c) {
+    BOOST_CHECK_EQUAL(results[c].count,
+                      max_timeslice_number / num_compute_nodes);
+    BOOST_CHECK_EQUAL(results[c].errors, 0);
+  }
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(transfer_test) {
+  run_transfer("transfer", 200, 4, std::chrono::milliseconds(5000));
+}
+
+BOOST_AUTO_TEST_CASE(repeated_request_test) {
+  // repeat all requests almost immediately, duplicates have to be ignored
+  run_transfer("repeated", 100, 4, std::chrono::milliseconds(1));
+}
+
+BOOST_AUTO_TEST_CASE(lost_reply_test) {
+  volatile sig_atomic_t signal_status = 0;
+  std::unique_ptr<void, std::function<int(void*)>> context(zmq_ctx_new(),
+                                                          zmq_ctx_destroy);
+  std::string address = "inproc://test_TimesliceBuilderZeromq_lost_" +
+                        std::to_string(::getpid());
+  FlesnetPatternGenerator generator(16, 8, 0, 256, true, true);
+  ComponentSenderZeromq sender(0, generator, address, timeslice_size,
+                               overlap_size, 2, &signal_status,
+                               context.get());
+  std::thread thread(std::ref(sender));
+
+  void* socket = zmq_socket(context.get(), ZMQ_DEALER);
+  BOOST_REQUIRE(socket);
+  zmq_connect(socket, address.c_str());
+
+  // drop the first reply, the repeated request is served again
+  send_request(socket, 0, 0);
+  Reply lost = receive_reply(socket);
+  BOOST_CHECK_EQUAL(lost.timeslice, 0);
+  BOOST_REQUIRE_EQUAL(lost.frames.size(), 2);
+  send_request(socket, 0, 0);
+  Reply reply = receive_reply(socket);
+  BOOST_CHECK_EQUAL(reply.timeslice, 0);
+  BOOST_CHECK(reply.frames == lost.frames);
+
+  // a request confirming the receipt of timeslice 0 is not served again
+  send_request(socket, 1, 1);
+  reply = receive_reply(socket);
+  BOOST_CHECK_EQUAL(reply.timeslice, 1);
+  BOOST_CHECK_EQUAL(reply.frames.size(), 2);
+  send_request(socket, 0, 2);
+
+  // the input ends the run once the receipt of all timeslices is confirmed
+  send_request(socket, tl_zeromq::no_timeslice, 2);
+  thread.join();
+  char buf[8];
+  BOOST_CHECK_EQUAL(zmq_recv(socket, buf, sizeof(buf), ZMQ_DONTWAIT), -1);
+  zmq_close(socket);
+}
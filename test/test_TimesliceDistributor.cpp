@@ -0,0 +1,150 @@
+// Copyright 2026 agent <agent@local>
+#define BOOST_TEST_MODULE test_TimesliceDistributor
+#include <boost/test/unit_test.hpp>
+
+#include "StorableTimeslice.hpp"
+#include "TimesliceCredit.hpp"
+#include "TimesliceDistributor.hpp"
+#include "TimesliceFixture.hpp"
+#include "TimesliceWorker.hpp"
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+#include <zmq.hpp>
+
+BOOST_FIXTURE_TEST_CASE(worker_timeout_test, TimesliceFixture) {
+  std::string address =
+      "ipc://test_TimesliceDistributor_timeout_" + std::to_string(::getpid());
+  fles::TimesliceDistributor distributor(address,
+                                         std::chrono::milliseconds(100));
+  fles::TimesliceWorker worker(address);
+  BOOST_CHECK(!worker.try_get());
+  BOOST_CHECK(!worker.get_for(std::chrono::milliseconds(10)));
+  BOOST_CHECK(!worker.eos());
+
+  distributor.put(std::make_shared<const fles::StorableTimeslice>(ts0));
+  BOOST_CHECK(worker.get_for(std::chrono::seconds(10)));
+  distributor.end_stream();
+  BOOST_CHECK(!worker.get_for(std::chrono::seconds(10)));
+  BOOST_CHECK(worker.eos());
+}
+
+BOOST_FIXTURE_TEST_CASE(distribute_test, TimesliceFixture) {
+  std::string address =
+      "ipc://test_TimesliceDistributor_" + std::to_string(::getpid());
+  fles::TimesliceDistributor distributor(address);
+
+  std::array<uint64_t, 2> count{{0, 0}};
+  std::array<uint64_t, 2> sum{{0, 0}};
+  std::vector<std::thread> workers;
+  for (size_t w = 0; w < count.size(); ++w) {
+    workers.emplace_back([&, w] {
+      fles::TimesliceWorker worker(address, 2);
+      while (auto timeslice = worker.get()) {
+        sum[w] += timeslice->index() + *timeslice->content(1, 0);
+        ++count[w];
+      }
+    });
+  }
+
+  auto make_timeslice = [&](uint64_t index) {
+    auto ts = std::make_shared<fles::StorableTimeslice>(1, index);
+    ts->append_component(1);
+    ts->append_component(1);
+    ts->append_microslice(1, 0, desc_c, data_c.data());
+    return ts;
+  };
+
+  for (uint64_t i = 0; i < 20; ++i) {
+    distributor.put(make_timeslice(i));
+  }
+  // all workers need to be known to receive the end-of-stream message
+  while (distributor.worker_status().size() < workers.size()) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    distributor.put(make_timeslice(100));
+  }
+  distributor.end_stream();
+  for (auto& worker : workers) {
+    worker.join();
+  }
+
+  uint64_t sent = 0;
+  for (auto& status : distributor.worker_status()) {
+    sent += status.sent;
+  }
+  BOOST_CHECK_EQUAL(count[0] + count[1], sent);
+  BOOST_CHECK_GE(sent, 20);
+  BOOST_CHECK_EQUAL(sum[0] + sum[1], 190 + 100 * (sent - 20) + 3 * sent);
+}
+
+BOOST_FIXTURE_TEST_CASE(distribute_end_of_stream_test, TimesliceFixture) {
+  std::string address =
+      "ipc://test_TimesliceDistributor_eos_" + std::to_string(::getpid());
+  fles::TimesliceDistributor distributor(address, std::chrono::seconds(10));
+  auto ts0_ptr = std::make_shared<const fles::StorableTimeslice>(ts0);
+
+  fles::TimesliceWorker worker(address);
+  distributor.put(ts0_ptr);
+  auto timeslice = worker.get();
+  BOOST_REQUIRE(timeslice);
+  timeslice.reset();
+
+  // the distributor waits for the acknowledgement of the final timeslice
+  std::thread end([&] { distributor.end_stream(); });
+
+  // workers connecting at end-of-stream do not wait forever
+  fles::TimesliceWorker late_worker(address);
+  BOOST_CHECK(!late_worker.get());
+  BOOST_CHECK(late_worker.eos());
+
+  BOOST_CHECK(!worker.get());
+  end.join();
+  auto status = distributor.worker_status();
+  BOOST_REQUIRE_EQUAL(status.size(), 2);
+  uint64_t acked = status[0].acked + status[1].acked;
+  BOOST_CHECK_EQUAL(acked, 1);
+  BOOST_CHECK_EQUAL(distributor.lost(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(worker_malformed_test) {
+  std::string address =
+      "ipc://test_TimesliceDistributor_malformed_" + std::to_string(::getpid());
+  zmq::context_t context(1);
+  zmq::socket_t distributor(context, ZMQ_ROUTER);
+  distributor.bind(address.c_str());
+  fles::TimesliceWorker worker(address);
+
+  auto receive_credit = [&](std::string& identity) {
+    zmq::message_t identity_frame;
+    zmq::message_t message;
+    distributor.recv(&identity_frame);
+    distributor.recv(&message);
+    BOOST_REQUIRE_EQUAL(message.size(), sizeof(fles::TimesliceCredit));
+    identity.assign(static_cast<char*>(identity_frame.data()),
+                    identity_frame.size());
+    return *static_cast<fles::TimesliceCredit*>(message.data());
+  };
+
+  std::string identity;
+  fles::TimesliceCredit credit = receive_credit(identity);
+  BOOST_CHECK_EQUAL(credit.acked, 0);
+
+  // a malformed message followed by end-of-stream
+  distributor.send(identity.data(), identity.size(), ZMQ_SNDMORE);
+  distributor.send("garbage", 7);
+  distributor.send(identity.data(), identity.size(), ZMQ_SNDMORE);
+  distributor.send(zmq::message_t());
+  BOOST_CHECK(!worker.get());
+  BOOST_CHECK(worker.eos());
+  BOOST_CHECK_EQUAL(worker.malformed_messages(), 1);
+
+  // the skipped message is acknowledged, so it is not counted as pending
+  credit = receive_credit(identity);
+  BOOST_CHECK_EQUAL(credit.credits, 1);
+  BOOST_CHECK_EQUAL(credit.acked, 1);
+}
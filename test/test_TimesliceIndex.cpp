@@ -0,0 +1,61 @@
+// Copyright 2026 agent <agent@local>
+#define BOOST_TEST_MODULE test_TimesliceIndex
+#include <boost/test/unit_test.hpp>
+
+#include "StorableTimeslice.hpp"
+#include "TimesliceFixture.hpp"
+#include "TimesliceIndex.hpp"
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+BOOST_FIXTURE_TEST_CASE(index_query_test, TimesliceFixture) {
+  const fles::TimesliceIndex& index = ts0.microslice_index();
+  BOOST_CHECK_EQUAL(&index, &ts0.microslice_index());
+  BOOST_CHECK_EQUAL(index.num_components(), 2);
+  BOOST_CHECK_EQUAL(index.size(), 3);
+  BOOST_CHECK_EQUAL(index.idx(0)[1], 2);
+
+  auto range = index.find(0, 2, 3);
+  BOOST_CHECK_EQUAL(range.first, 1);
+  BOOST_CHECK_EQUAL(range.second, 2);
+  auto entry = index.entry(0, range.first);
+  BOOST_CHECK_EQUAL(entry.microslice, 1);
+  BOOST_CHECK_EQUAL(entry.size, 1);
+  BOOST_CHECK_EQUAL(*entry.content, 11);
+  BOOST_CHECK_EQUAL(entry.desc->eq_id, 10);
+  range = index.find(1, 2, 3);
+  BOOST_CHECK_EQUAL(range.first, range.second);
+
+  // merged iteration in time order
+  std::vector<std::pair<uint64_t, uint64_t>> visited;
+  for (const auto& e : index.merged()) {
+    visited.emplace_back(e.idx, e.component);
+    BOOST_CHECK_EQUAL(e.content, ts0.content(e.component, e.microslice));
+  }
+  std::vector<std::pair<uint64_t, uint64_t>> expected{{1, 0}, {1, 1}, {2, 0}};
+  BOOST_CHECK(visited == expected);
+
+  uint64_t count = 0;
+  for (const auto& e : index.window(2, 10)) {
+    BOOST_CHECK_EQUAL(e.idx, 2);
+    ++count;
+  }
+  BOOST_CHECK_EQUAL(count, 1);
+  BOOST_CHECK(index.window(3, 10).begin() == index.window(3, 10).end());
+
+  // the index is rebuilt after modification
+  ts0.append_component(2);
+  fles::MicrosliceDescriptor desc_d = desc_c;
+  desc_d.idx = 5;
+  ts0.append_microslice(2, 0, desc_d, data_c.data());
+  desc_d.idx = 0;
+  ts0.append_microslice(2, 1, desc_d, data_a.data());
+  const fles::TimesliceIndex& index2 = ts0.microslice_index();
+  BOOST_CHECK_EQUAL(index2.num_components(), 3);
+  // unordered microslices are sorted by start time
+  BOOST_CHECK_EQUAL(index2.idx(2)[0], 0);
+  BOOST_CHECK_EQUAL(index2.entry(2, 0).microslice, 1);
+  BOOST_CHECK_EQUAL(*index2.entry(2, 0).content, 7);
+  BOOST_CHECK_EQUAL(index2.merged().begin()->component, 2);
+}
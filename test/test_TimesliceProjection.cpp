@@ -0,0 +1,46 @@
+// Copyright 2026 agent <agent@local>
+#define BOOST_TEST_MODULE test_TimesliceProjection
+#include <boost/test/unit_test.hpp>
+
+#include "ComponentSelection.hpp"
+#include "StorableTimeslice.hpp"
+#include "TimesliceFixture.hpp"
+#include "TimesliceProjection.hpp"
+#include "TimesliceSerializer.hpp"
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+BOOST_FIXTURE_TEST_CASE(projection_test, TimesliceFixture) {
+  auto ts0_ptr = std::make_shared<const fles::StorableTimeslice>(ts0);
+
+  fles::ComponentSelection selection;
+  selection.add(desc_c.sys_id, desc_c.eq_id);
+  fles::TimesliceProjection projection(ts0_ptr, selection.predicate());
+  BOOST_CHECK_EQUAL(projection.index(), 1);
+  BOOST_CHECK_EQUAL(projection.num_components(), 1);
+  BOOST_CHECK_EQUAL(projection.source_component(0), 1);
+  BOOST_CHECK_EQUAL(*projection.content(0, 0), 3);
+
+  fles::TimesliceProjection reordered(ts0_ptr, std::vector<uint64_t>{1, 0});
+  BOOST_CHECK_EQUAL(*reordered.content(1, 1), 11);
+  BOOST_CHECK_THROW(
+      fles::TimesliceProjection(ts0_ptr, std::vector<uint64_t>{2}),
+      std::out_of_range);
+
+  // a projection serializes like a timeslice of the selected components
+  std::stringstream s;
+  {
+    boost::archive::binary_oarchive oa(s);
+    const fles::TimesliceSerializer serializer(projection);
+    oa << serializer;
+  }
+  boost::archive::binary_iarchive ia(s);
+  fles::StorableTimeslice ts1{0};
+  ia >> ts1;
+  BOOST_CHECK_EQUAL(ts1.num_components(), 1);
+  BOOST_CHECK_EQUAL(*ts1.content(0, 0), 3);
+}
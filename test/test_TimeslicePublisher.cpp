@@ -0,0 +1,185 @@
+// Copyright 2026 agent <agent@local>
+#define BOOST_TEST_MODULE test_TimeslicePublisher
+#include <boost/test/unit_test.hpp>
+
+#include "ComponentSelection.hpp"
+#include "StorableTimeslice.hpp"
+#include "TimesliceFixture.hpp"
+#include "TimeslicePublisher.hpp"
+#include "TimesliceSerializer.hpp"
+#include "TimesliceSubscriber.hpp"
+#include <atomic>
+#include <boost/archive/binary_oarchive.hpp>
+#include <chrono>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <zmq.hpp>
+
+namespace {
+/// Receive a timeslice, publishing repeatedly until the subscription is
+/// established.
+std::unique_ptr<fles::Timeslice>
+publish_and_receive(fles::TimeslicePublisher& publisher,
+                    fles::TimesliceSubscriber& subscriber,
+                    std::shared_ptr<const fles::Timeslice> ts) {
+  std::atomic<bool> received{false};
+  std::thread sender([&] {
+    while (!received) {
+      publisher.put(ts);
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+  });
+  auto timeslice = subscriber.get();
+  received = true;
+  sender.join();
+  return timeslice;
+}
+} // namespace
+
+BOOST_FIXTURE_TEST_CASE(publish_subscribe_test, TimesliceFixture) {
+  auto ts0_ptr = std::make_shared<const fles::StorableTimeslice>(ts0);
+
+  for (bool multipart : {false, true}) {
+    std::string address = "ipc://test_TimeslicePublisher_" +
+                          std::to_string(multipart) + "_" +
+                          std::to_string(::getpid());
+    fles::TimeslicePublisher publisher(address, 1, multipart);
+    fles::TimesliceSubscriber subscriber(address);
+    auto timeslice = publish_and_receive(publisher, subscriber, ts0_ptr);
+    BOOST_REQUIRE(timeslice);
+    BOOST_CHECK_EQUAL(timeslice->index(), 1);
+    BOOST_CHECK_EQUAL(timeslice->num_core_microslices(), 1);
+    BOOST_CHECK_EQUAL(timeslice->num_components(), 2);
+    BOOST_CHECK_EQUAL(timeslice->num_microslices(0), 2);
+    BOOST_CHECK_EQUAL(*timeslice->content(0, 1), 11);
+    BOOST_CHECK_EQUAL(*timeslice->content(1, 0), 3);
+    BOOST_CHECK_EQUAL(timeslice->descriptor(1, 0).eq_id, 11);
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE(publish_subscribe_selective_test, TimesliceFixture) {
+  auto ts0_ptr = std::make_shared<const fles::StorableTimeslice>(ts0);
+
+  fles::ComponentSelection selection;
+  selection.add(desc_c.sys_id, desc_c.eq_id);
+  for (bool multipart : {false, true}) {
+    std::string address = "ipc://test_TimeslicePublisher_selective_" +
+                          std::to_string(multipart) + "_" +
+                          std::to_string(::getpid());
+    fles::TimeslicePublisher publisher(address, 1, multipart);
+    fles::TimesliceSubscriber selective(address, selection);
+    fles::TimesliceSubscriber subscriber(address);
+    auto timeslice = publish_and_receive(publisher, selective, ts0_ptr);
+    BOOST_REQUIRE(timeslice);
+    BOOST_CHECK_EQUAL(timeslice->index(), 1);
+    BOOST_CHECK_EQUAL(timeslice->num_components(), 1);
+    BOOST_CHECK_EQUAL(*timeslice->content(0, 0), 3);
+
+    // other subscribers receive the complete timeslice only
+    for (int i = 0; i < 2; ++i) {
+      timeslice = publish_and_receive(publisher, subscriber, ts0_ptr);
+      BOOST_REQUIRE(timeslice);
+      BOOST_CHECK_EQUAL(timeslice->num_components(), 2);
+    }
+    // messages of the selection topic are skipped, not counted as malformed
+    BOOST_CHECK_EQUAL(subscriber.malformed_messages(), 0);
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE(publish_wire_format_test, TimesliceFixture) {
+  auto ts0_ptr = std::make_shared<const fles::StorableTimeslice>(ts0);
+  std::string address =
+      "ipc://test_TimeslicePublisher_wire_" + std::to_string(::getpid());
+  fles::TimeslicePublisher publisher(address);
+  fles::ComponentSelection selection;
+  selection.add(desc_c.sys_id, desc_c.eq_id);
+  fles::TimesliceSubscriber selective(address, selection);
+  zmq::context_t context(1);
+  zmq::socket_t subscriber(context, ZMQ_SUB);
+  subscriber.connect(address.c_str());
+  subscriber.setsockopt(ZMQ_SUBSCRIBE, nullptr, 0);
+
+  std::ostringstream s;
+  {
+    boost::archive::binary_oarchive oa(s);
+    const fles::TimesliceSerializer serializer(ts0);
+    oa << serializer;
+  }
+  const std::string serialized = s.str();
+
+  // publish until both the selection and the complete timeslice arrive
+  bool selected = false;
+  bool complete = false;
+  while (!selected || !complete) {
+    publisher.put(ts0_ptr);
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    zmq::message_t message;
+    while (subscriber.recv(&message, ZMQ_DONTWAIT)) {
+      if (fles::TimeslicePublisher::is_selection_topic(message)) {
+        BOOST_REQUIRE(message.more());
+        subscriber.recv(&message);
+        BOOST_CHECK(!message.more());
+        selected = true;
+        continue;
+      }
+      // a complete timeslice is the single frame of a plain archive
+      BOOST_REQUIRE(!message.more());
+      BOOST_CHECK(std::string(static_cast<char*>(message.data()),
+                              message.size()) == serialized);
+      complete = true;
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(subscriber_timeout_test) {
+  std::string address =
+      "ipc://test_TimeslicePublisher_timeout_" + std::to_string(::getpid());
+  fles::TimeslicePublisher publisher(address);
+  fles::TimesliceSubscriber subscriber(address);
+  BOOST_CHECK(!subscriber.try_get());
+  BOOST_CHECK(!subscriber.get_for(std::chrono::milliseconds(10)));
+  BOOST_CHECK(!subscriber.eos());
+}
+
+BOOST_FIXTURE_TEST_CASE(subscriber_malformed_test, TimesliceFixture) {
+  std::string address =
+      "ipc://test_TimeslicePublisher_malformed_" + std::to_string(::getpid());
+  zmq::context_t context(1);
+  zmq::socket_t publisher(context, ZMQ_PUB);
+  publisher.bind(address.c_str());
+  fles::TimesliceSubscriber subscriber(address);
+
+  // publish malformed messages followed by a timeslice until received twice
+  std::ostringstream s;
+  {
+    boost::archive::binary_oarchive oa(s);
+    const fles::TimesliceSerializer serializer(ts0);
+    oa << serializer;
+  }
+  const std::string serialized = s.str();
+  std::atomic<bool> done{false};
+  std::thread sender([&] {
+    while (!done) {
+      publisher.send("garbage", 7);
+      publisher.send(serialized.data(), serialized.size() / 2);
+      publisher.send(serialized.data(), serialized.size());
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    // end-of-stream
+    publisher.send(zmq::message_t());
+  });
+  for (int i = 0; i < 2; ++i) {
+    auto timeslice = subscriber.get();
+    BOOST_REQUIRE(timeslice);
+    BOOST_CHECK_EQUAL(timeslice->index(), 1);
+  }
+  done = true;
+  while (subscriber.get()) {
+  }
+  sender.join();
+  BOOST_CHECK(subscriber.eos());
+  BOOST_CHECK_GE(subscriber.malformed_messages(), 2);
+}
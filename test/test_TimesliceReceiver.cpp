@@ -0,0 +1,169 @@
+// Copyright 2026 agent <agent@local>
+#define BOOST_TEST_MODULE test_TimesliceReceiver
+#include <boost/test/unit_test.hpp>
+
+#include "MicrosliceDescriptor.hpp"
+#include "TimesliceBuffer.hpp"
+#include "TimesliceReceiver.hpp"
+#include <cstring>
+#include <string>
+#include <unistd.h>
+
+namespace {
+
+std::string shm_identifier(const std::string& name) {
+  return "test_TimesliceReceiver_" + name + "_" + std::to_string(getpid());
+}
+
+// write a component with a single microslice to the buffer
+void write_component(TimesliceBuffer& tsb,
+                     uint32_t input,
+                     uint64_t ts_pos,
+                     uint64_t ts_num) {
+  uint64_t offset = ts_pos * 64;
+  fles::MicrosliceDescriptor md{};
+  md.eq_id = static_cast<uint16_t>(input);
+  md.idx = ts_num;
+  md.size = 8;
+  std::memcpy(&tsb.get_data(input, offset), &md, sizeof(md));
+  tsb.get_desc(input, ts_pos) = {ts_num, offset, sizeof(md) + md.size, 1};
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(component_event_test) {
+  std::string id = shm_identifier("events");
+  TimesliceBuffer tsb(id, 12, 4, 2, true);
+  BOOST_REQUIRE(tsb.has_component_events());
+  fles::TimesliceReceiver receiver(id);
+
+  BOOST_CHECK(!receiver.try_get_component());
+
+  write_component(tsb, 1, 3, 42);
+  tsb.send_component_event(
+      {3, 42, 1, 1, tsb.get_data_size_exp(), tsb.get_desc_size_exp()});
+
+  auto view = receiver.try_get_component();
+  BOOST_REQUIRE(view);
+  BOOST_CHECK_EQUAL(view->index(), 42);
+  BOOST_CHECK_EQUAL(view->component(), 1);
+  BOOST_CHECK_EQUAL(view->num_components(), 1);
+  BOOST_CHECK_EQUAL(view->num_microslices(0), 1);
+  BOOST_CHECK_EQUAL(view->descriptor(0, 0).eq_id, 1);
+  BOOST_CHECK_EQUAL(view->descriptor(0, 0).idx, 42);
+
+  BOOST_CHECK(!receiver.try_get_component());
+}
+
+BOOST_AUTO_TEST_CASE(overwritten_component_test) {
+  std::string id = shm_identifier("overwritten");
+  TimesliceBuffer tsb(id, 12, 4, 2, true);
+  fles::TimesliceReceiver receiver(id);
+
+  // the slot has been reused by a later timeslice in the meantime
+  write_component(tsb, 0, 3 + 16, 58);
+  tsb.send_component_event(
+      {3, 42, 0, 1, tsb.get_data_size_exp(), tsb.get_desc_size_exp()});
+
+  BOOST_CHECK(!receiver.try_get_component());
+}
+
+BOOST_AUTO_TEST_CASE(no_component_events_test) {
+  std::string id = shm_identifier("none");
+  TimesliceBuffer tsb(id, 12, 4, 2);
+  BOOST_CHECK(!tsb.has_component_events());
+  fles::TimesliceReceiver receiver(id);
+
+  BOOST_CHECK(!receiver.try_get_component());
+}
+
+BOOST_AUTO_TEST_CASE(absent_component_test) {
+  std::string id = shm_identifier("absent");
+  TimesliceBuffer tsb(id, 12, 4, 2, false, 0, true);
+  BOOST_CHECK(tsb.has_absent_markers());
+  fles::TimesliceReceiver receiver(id);
+
+  // a late write of input 1 does not affect the marker
+  write_component(tsb, 0, 5, 42);
+  tsb.mark_absent(1, 5, 42);
+  write_component(tsb, 1, 5, 42);
+  BOOST_CHECK(tsb.is_absent(1, 5));
+  BOOST_CHECK(!tsb.is_absent(0, 5));
+
+  // the marker does not apply to a later timeslice in the same slot
+  write_component(tsb, 0, 5 + 16, 58);
+  write_component(tsb, 1, 5 + 16, 58);
+  BOOST_CHECK(!tsb.is_absent(1, 5 + 16));
+
+  tsb.send_work_item(
+      {{42, 5, 1, 2}, tsb.get_data_size_exp(), tsb.get_desc_size_exp()});
+  tsb.send_work_item(
+      {{58, 5 + 16, 1, 2}, tsb.get_data_size_exp(), tsb.get_desc_size_exp()});
+
+  auto ts = receiver.get();
+  BOOST_REQUIRE(ts);
+  BOOST_CHECK_EQUAL(ts->index(), 42);
+  BOOST_CHECK(!ts->absent(0));
+  BOOST_CHECK(ts->absent(1));
+  BOOST_CHECK_EQUAL(ts->num_microslices(1), 0);
+
+  ts = receiver.get();
+  BOOST_REQUIRE(ts);
+  BOOST_CHECK_EQUAL(ts->index(), 58);
+  BOOST_CHECK(!ts->absent(1));
+}
+
+BOOST_AUTO_TEST_CASE(no_absent_markers_test) {
+  std::string id = shm_identifier("unmarked");
+  TimesliceBuffer tsb(id, 12, 4, 2);
+  BOOST_CHECK(!tsb.has_absent_markers());
+  BOOST_CHECK(tsb.get_absent_ptr(1) == nullptr);
+  fles::TimesliceReceiver receiver(id);
+
+  write_component(tsb, 0, 5, 42);
+  write_component(tsb, 1, 5, 42);
+  BOOST_CHECK(!tsb.is_absent(1, 5));
+
+  tsb.send_work_item(
+      {{42, 5, 1, 2}, tsb.get_data_size_exp(), tsb.get_desc_size_exp()});
+
+  auto ts = receiver.get();
+  BOOST_REQUIRE(ts);
+  BOOST_CHECK_EQUAL(ts->index(), 42);
+  BOOST_CHECK(!ts->absent(0));
+  BOOST_CHECK(!ts->absent(1));
+}
+
+BOOST_AUTO_TEST_CASE(pinned_component_test) {
+  std::string id = shm_identifier("pinned");
+  TimesliceBuffer tsb(id, 12, 4, 2, true);
+  fles::TimesliceReceiver receiver(id);
+
+  write_component(tsb, 0, 3, 42);
+  write_component(tsb, 1, 4, 43);
+  tsb.send_component_event(
+      {3, 42, 0, 1, tsb.get_data_size_exp(), tsb.get_desc_size_exp()});
+  tsb.send_component_event(
+      {4, 43, 1, 1, tsb.get_data_size_exp(), tsb.get_desc_size_exp()});
+
+  auto view = receiver.try_get_component();
+  BOOST_REQUIRE(view);
+  BOOST_CHECK_EQUAL(view->index(), 42);
+
+  // the view holds back the release, and the later component has been
+  // acknowledged before it could be pinned
+  tsb.set_acked(6);
+  BOOST_CHECK_EQUAL(tsb.get_releasable(6), 3);
+  BOOST_CHECK(!receiver.try_get_component());
+
+  view.reset();
+  BOOST_CHECK_EQUAL(tsb.get_releasable(6), 6);
+}
+
+BOOST_AUTO_TEST_CASE(releasable_without_events_test) {
+  std::string id = shm_identifier("releasable");
+  TimesliceBuffer tsb(id, 12, 4, 2);
+
+  tsb.set_acked(5);
+  BOOST_CHECK_EQUAL(tsb.get_releasable(5), 5);
+}
@@ -0,0 +1,78 @@
+// Copyright 2026 agent <agent@local>
+#define BOOST_TEST_MODULE test_TimesliceSchedule
+#include <boost/test/unit_test.hpp>
+
+#include "TimesliceSchedule.hpp"
+#include <vector>
+
+BOOST_AUTO_TEST_CASE(initial_epochs_round_robin_test) {
+  TimesliceSchedule schedule(3);
+  uint64_t end = schedule.epoch_size() * schedule.lookahead();
+  for (uint64_t ts = 0; ts < end; ++ts) {
+    BOOST_REQUIRE(schedule.ready(ts));
+    BOOST_CHECK_EQUAL(schedule.compute_node(ts), ts % 3);
+  }
+  BOOST_CHECK(!schedule.ready(end));
+}
+
+BOOST_AUTO_TEST_CASE(weighted_epoch_test) {
+  TimesliceSchedule schedule(2, 8, 1);
+  BOOST_REQUIRE_EQUAL(schedule.epoch_size(), 16);
+  uint64_t begin = schedule.epoch_size();
+
+  schedule.set_weight(0, 1, TimesliceSchedule::max_weight);
+  BOOST_CHECK(!schedule.ready(begin));
+  schedule.set_weight(1, 1, TimesliceSchedule::max_weight / 3);
+  BOOST_REQUIRE(schedule.ready(begin));
+
+  std::vector<uint32_t> count(2);
+  for (uint64_t ts = begin; ts < begin + schedule.epoch_size(); ++ts) {
+    ++count.at(schedule.compute_node(ts));
+  }
+  BOOST_CHECK_EQUAL(count[0], 12);
+  BOOST_CHECK_EQUAL(count[1], 4);
+}
+
+BOOST_AUTO_TEST_CASE(minimum_share_test) {
+  TimesliceSchedule schedule(4, 2, 1);
+  uint64_t begin = schedule.epoch_size();
+  schedule.set_weight(0, 1, TimesliceSchedule::max_weight);
+  for (uint32_t cn = 1; cn < 4; ++cn) {
+    schedule.set_weight(cn, 1, 1);
+  }
+  BOOST_REQUIRE(schedule.ready(begin));
+
+  std::vector<uint32_t> count(4);
+  for (uint64_t ts = begin; ts < begin + schedule.epoch_size(); ++ts) {
+    ++count.at(schedule.compute_node(ts));
+  }
+  BOOST_CHECK_EQUAL(count[0], 5);
+  for (uint32_t cn = 1; cn < 4; ++cn) {
+    BOOST_CHECK_EQUAL(count[cn], 1);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(deterministic_test) {
+  TimesliceSchedule a(5, 4, 1);
+  TimesliceSchedule b(5, 4, 1);
+  const uint32_t weights[] = {3, 16, 7, 1, 9};
+  // announcements arrive in different order
+  for (uint32_t cn = 0; cn < 5; ++cn) {
+    a.set_weight(cn, 1, weights[cn]);
+    b.set_weight(4 - cn, 1, weights[4 - cn]);
+  }
+  uint64_t begin = a.epoch_size();
+  BOOST_REQUIRE(a.ready(begin));
+  BOOST_REQUIRE(b.ready(begin));
+  for (uint64_t ts = begin; ts < begin + a.epoch_size(); ++ts) {
+    BOOST_CHECK_EQUAL(a.compute_node(ts), b.compute_node(ts));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(weight_test) {
+  TimesliceSchedule schedule(2, 8);
+  BOOST_CHECK_EQUAL(schedule.weight(1.0, 0), TimesliceSchedule::max_weight);
+  BOOST_CHECK_EQUAL(schedule.weight(0.5, 0), TimesliceSchedule::max_weight / 2);
+  BOOST_CHECK_EQUAL(schedule.weight(1.0, 8), TimesliceSchedule::max_weight / 2);
+  BOOST_CHECK_EQUAL(schedule.weight(0.0, 0), 1);
+}
@@ -0,0 +1,51 @@
+// Copyright 2026 agent <agent@local>
+#define BOOST_TEST_MODULE test_TimesliceSelectiveInputArchive
+#include <boost/test/unit_test.hpp>
+
+#include "ComponentSelection.hpp"
+#include "StorableTimeslice.hpp"
+#include "TimesliceFixture.hpp"
+#include "TimesliceOutputArchive.hpp"
+#include "TimesliceSelectiveInputArchive.hpp"
+#include <cstdint>
+#include <memory>
+#include <string>
+
+BOOST_FIXTURE_TEST_CASE(archive_selective_test, TimesliceFixture) {
+  auto ts0_ptr = std::make_shared<const fles::StorableTimeslice>(ts0);
+
+  std::string filename("test_selective.tsa");
+  {
+    fles::TimesliceOutputArchive output(filename);
+    output.put(ts0_ptr);
+    output.put(ts0_ptr);
+  }
+
+  fles::ComponentSelection selection;
+  selection.add(desc_c.sys_id, desc_c.eq_id);
+  uint64_t count = 0;
+  fles::TimesliceSelectiveInputArchive source(filename,
+                                              selection.predicate());
+  while (auto timeslice = source.get()) {
+    BOOST_CHECK_EQUAL(timeslice->index(), 1);
+    BOOST_CHECK_EQUAL(timeslice->num_components(), 1);
+    BOOST_CHECK_EQUAL(timeslice->num_microslices(0), 1);
+    BOOST_CHECK_EQUAL(*timeslice->content(0, 0), 3);
+    ++count;
+  }
+  BOOST_CHECK_EQUAL(count, 2);
+  BOOST_CHECK(source.eos());
+  // the first component is skipped except for its first microslice descriptor
+  BOOST_CHECK_EQUAL(source.bytes_skipped(),
+                    2 * (sizeof(fles::MicrosliceDescriptor) + data_a.size() +
+                         data_b.size()));
+
+  fles::TimesliceSelectiveInputArchive all(filename,
+                                           fles::ComponentPredicate());
+  auto timeslice = all.get();
+  BOOST_REQUIRE(timeslice);
+  BOOST_CHECK_EQUAL(timeslice->num_components(), 2);
+  BOOST_CHECK_EQUAL(*timeslice->content(0, 1), 11);
+  BOOST_CHECK_EQUAL(*timeslice->content(1, 0), 3);
+  BOOST_CHECK_EQUAL(all.bytes_skipped(), 0);
+}
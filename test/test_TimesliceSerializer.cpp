@@ -0,0 +1,36 @@
+// Copyright 2026 agent <agent@local>
+#define BOOST_TEST_MODULE test_TimesliceSerializer
+#include <boost/test/unit_test.hpp>
+
+#include "StorableTimeslice.hpp"
+#include "TimesliceFixture.hpp"
+#include "TimesliceSerializer.hpp"
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
+#include <sstream>
+
+BOOST_FIXTURE_TEST_CASE(serializer_test, TimesliceFixture) {
+  // direct serialization has to be identical to StorableTimeslice
+  const fles::Timeslice& ts = ts0;
+  std::stringstream s0;
+  std::stringstream s1;
+  {
+    boost::archive::binary_oarchive oa0(s0);
+    oa0 << ts0;
+    oa0 << ts0;
+    boost::archive::binary_oarchive oa1(s1);
+    const fles::TimesliceSerializer serializer(ts);
+    oa1 << serializer;
+    oa1 << serializer;
+  }
+  BOOST_CHECK(s0.str() == s1.str());
+
+  boost::archive::binary_iarchive ia(s1);
+  for (int i = 0; i < 2; ++i) {
+    fles::StorableTimeslice ts1{0};
+    ia >> ts1;
+    BOOST_CHECK_EQUAL(ts1.num_components(), 2);
+    BOOST_CHECK_EQUAL(*ts1.content(0, 1), 11);
+    BOOST_CHECK_EQUAL(*ts1.content(1, 0), 3);
+  }
+}
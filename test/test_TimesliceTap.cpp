@@ -0,0 +1,99 @@
+// Copyright 2026 agent <agent@local>
+#define BOOST_TEST_MODULE test_TimesliceTap
+#include <boost/test/unit_test.hpp>
+
+#include "MicrosliceDescriptor.hpp"
+#include "TimesliceBuffer.hpp"
+#include "TimesliceTap.hpp"
+#include <cstring>
+#include <string>
+#include <unistd.h>
+
+namespace {
+
+std::string shm_identifier(const std::string& name) {
+  return "test_TimesliceTap_" + name + "_" + std::to_string(getpid());
+}
+
+// write a timeslice with a single microslice per component to the buffer
+void write_timeslice(TimesliceBuffer& tsb, uint64_t ts_pos, uint64_t ts_num) {
+  for (uint32_t c = 0; c < tsb.get_num_input_nodes(); ++c) {
+    uint64_t offset = ts_pos * 64;
+    fles::MicrosliceDescriptor md{};
+    md.eq_id = static_cast<uint16_t>(c);
+    md.idx = ts_num;
+    md.size = 8;
+    std::memcpy(&tsb.get_data(c, offset), &md, sizeof(md));
+    tsb.get_desc(c, ts_pos) = {ts_num, offset, sizeof(md) + md.size, 1};
+  }
+  tsb.send_work_item({{ts_num, ts_pos, 1, tsb.get_num_input_nodes()},
+                      tsb.get_data_size_exp(),
+                      tsb.get_desc_size_exp()});
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_CASE(sampling_test) {
+  std::string id = shm_identifier("sampling");
+  TimesliceBuffer tsb(id, 12, 4, 2, false, 2);
+  BOOST_REQUIRE(tsb.has_tap());
+  fles::TimesliceTap tap(id);
+  BOOST_CHECK_EQUAL(tap.sampling(), 2);
+
+  for (uint64_t ts = 0; ts < 4; ++ts) {
+    write_timeslice(tsb, ts, 100 + ts);
+  }
+  BOOST_CHECK_EQUAL(tsb.get_num_tap_sampled(), 2);
+
+  for (uint64_t ts = 100; ts < 104; ts += 2) {
+    auto timeslice = tap.try_get();
+    BOOST_REQUIRE(timeslice);
+    BOOST_CHECK_EQUAL(timeslice->index(), ts);
+    BOOST_REQUIRE_EQUAL(timeslice->num_components(), 2);
+    BOOST_CHECK_EQUAL(timeslice->num_microslices(1), 1);
+    BOOST_CHECK_EQUAL(timeslice->descriptor(1, 0).eq_id, 1);
+    BOOST_CHECK_EQUAL(timeslice->descriptor(1, 0).idx, ts);
+  }
+  BOOST_CHECK(!tap.try_get());
+  BOOST_CHECK_EQUAL(tap.received(), 2);
+  BOOST_CHECK_EQUAL(tap.lost(), 0);
+
+  tsb.send_end_work_item();
+  BOOST_CHECK(!tap.get());
+  BOOST_CHECK(tap.eos());
+}
+
+BOOST_AUTO_TEST_CASE(released_test) {
+  std::string id = shm_identifier("released");
+  TimesliceBuffer tsb(id, 12, 4, 2, false, 1);
+  fles::TimesliceTap tap(id);
+
+  write_timeslice(tsb, 0, 0);
+  write_timeslice(tsb, 1, 1);
+  tsb.set_acked(1);
+
+  auto timeslice = tap.try_get();
+  BOOST_REQUIRE(timeslice);
+  BOOST_CHECK_EQUAL(timeslice->index(), 1);
+  BOOST_CHECK_EQUAL(tap.overwritten(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(lost_test) {
+  std::string id = shm_identifier("lost");
+  TimesliceBuffer tsb(id, 12, 5, 1, false, 1);
+  fles::TimesliceTap tap(id);
+
+  for (uint64_t ts = 0; ts < 20; ++ts) {
+    write_timeslice(tsb, ts, ts);
+  }
+  BOOST_CHECK_EQUAL(tap.sampled(), 20);
+  BOOST_CHECK_EQUAL(tap.lost(), 4);
+}
+
+BOOST_AUTO_TEST_CASE(no_tap_test) {
+  std::string id = shm_identifier("none");
+  TimesliceBuffer tsb(id, 12, 4, 2);
+  BOOST_CHECK(!tsb.has_tap());
+  BOOST_CHECK_THROW(fles::TimesliceTap tap(id),
+                    boost::interprocess::interprocess_exception);
+}
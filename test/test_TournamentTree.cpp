@@ -0,0 +1,52 @@
+// Copyright 2026 agent <agent@local>
+#define BOOST_TEST_MODULE test_TournamentTree
+#include <boost/test/unit_test.hpp>
+
+#include "TournamentTree.hpp"
+#include <algorithm>
+#include <random>
+#include <vector>
+
+BOOST_AUTO_TEST_CASE(initial_test) {
+  TournamentTree tree(5);
+  BOOST_CHECK_EQUAL(tree.size(), 5);
+  BOOST_CHECK_EQUAL(tree.min_index(), 0);
+  BOOST_CHECK_EQUAL(tree.min_value(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(single_test) {
+  TournamentTree tree(1);
+  tree.update(0, 42);
+  BOOST_CHECK_EQUAL(tree.min_index(), 0);
+  BOOST_CHECK_EQUAL(tree.min_value(), 42);
+}
+
+BOOST_AUTO_TEST_CASE(advance_test) {
+  TournamentTree tree(3);
+  tree.update(0, 4);
+  tree.update(2, 3);
+  BOOST_CHECK_EQUAL(tree.min_index(), 1);
+  tree.update(1, 5);
+  BOOST_CHECK_EQUAL(tree.min_index(), 2);
+  BOOST_CHECK_EQUAL(tree.min_value(), 3);
+  tree.update(2, 4);
+  // lower index wins on ties
+  BOOST_CHECK_EQUAL(tree.min_index(), 0);
+  BOOST_CHECK_EQUAL(tree.min_value(), 4);
+}
+
+BOOST_AUTO_TEST_CASE(random_test) {
+  const std::size_t size = 100;
+  TournamentTree tree(size);
+  std::vector<uint64_t> values(size);
+  std::mt19937 rng(1);
+  for (int i = 0; i < 10000; ++i) {
+    std::size_t index = rng() % size;
+    values[index] += rng() % 4;
+    tree.update(index, values[index]);
+    auto it = std::min_element(values.begin(), values.end());
+    BOOST_REQUIRE_EQUAL(tree.min_index(), it - values.begin());
+    BOOST_REQUIRE_EQUAL(tree.min_value(), *it);
+    BOOST_REQUIRE_EQUAL(tree.value(index), values[index]);
+  }
+}
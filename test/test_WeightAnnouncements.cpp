@@ -0,0 +1,34 @@
+// Copyright 2026 agent <agent@local>
+#define BOOST_TEST_MODULE test_WeightAnnouncements
+#include <boost/test/unit_test.hpp>
+
+#include "WeightAnnouncements.hpp"
+
+BOOST_AUTO_TEST_CASE(initial_test) {
+  WeightAnnouncements announcements(3, 2);
+  BOOST_CHECK_EQUAL(announcements.end(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(announce_test) {
+  WeightAnnouncements announcements(3, 2);
+  announcements.announce(2, 5);
+  BOOST_CHECK_EQUAL(announcements.end(), 3);
+  BOOST_CHECK_EQUAL(announcements.weight(2), 5);
+
+  // skipped epochs inherit the announced weight
+  announcements.announce(5, 7);
+  BOOST_CHECK_EQUAL(announcements.end(), 6);
+  for (uint64_t epoch = 3; epoch <= 5; ++epoch) {
+    BOOST_CHECK_EQUAL(announcements.weight(epoch), 7);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(wrap_test) {
+  WeightAnnouncements announcements(2, 0);
+  for (uint64_t epoch = 0; epoch < 20; ++epoch) {
+    announcements.announce(epoch, static_cast<uint32_t>(epoch % 16 + 1));
+    for (uint64_t e = epoch < 3 ? 0 : epoch - 3; e <= epoch; ++e) {
+      BOOST_CHECK_EQUAL(announcements.weight(e), e % 16 + 1);
+    }
+  }
+}